@@ -39,6 +39,18 @@ Corryvreckan::Corryvreckan(std::string config_file_name,
                            const std::vector<std::string>& detector_options)
     : terminate_(false), has_run_(false), mod_mgr_(std::make_unique<ModuleManager>()) {
 
+    // Store the arguments to reproduce this configuration in the processes for partitions of the run
+    worker_arguments_ = {"-c", std::filesystem::absolute(config_file_name).string()};
+    for(const auto& option : module_options) {
+        worker_arguments_.insert(worker_arguments_.end(), {"-o", option});
+    }
+    for(const auto& option : detector_options) {
+        worker_arguments_.insert(worker_arguments_.end(), {"-g", option});
+    }
+    if(Log::getReportingLevel() != LogLevel::NONE) {
+        worker_arguments_.insert(worker_arguments_.end(), {"-v", Log::getStringFromLevel(Log::getReportingLevel())});
+    }
+
     // Load the global configuration
     conf_mgr_ = std::make_unique<ConfigManager>(std::move(config_file_name),
                                                 std::initializer_list<std::string>({"Corryvreckan", ""}),
@@ -82,8 +94,8 @@ Corryvreckan::Corryvreckan(std::string config_file_name,
         Log::setFormat(LogFormat::DEFAULT);
     }
 
-    // Open log file to write output to
-    if(global_config.has("log_file")) {
+    // Open log file to write output to, the output of partitions of the run is already redirected to their own log file
+    if(global_config.has("log_file") && global_config.get<int>("partition", -1) < 0) {
         // NOTE: this stream should be available for the duration of the logging
         log_file_.open(global_config.getPath("log_file"), std::ios_base::out | std::ios_base::trunc);
         LOG(TRACE) << "Added log stream to file " << global_config.getPath("log_file");
@@ -122,7 +134,8 @@ void Corryvreckan::load() {
     // Use existing output directory if it exists
     bool create_output_dir = true;
     if(std::filesystem::is_directory(directory)) {
-        if(global_config.get<bool>("purge_output_directory", false)) {
+        // Processes of partitions of the run share the output directory of the driving process
+        if(global_config.get<bool>("purge_output_directory", false) && global_config.get<int>("partition", -1) < 0) {
             LOG(DEBUG) << "Deleting previous output directory " << directory;
             std::filesystem::remove_all(directory);
         } else {
@@ -138,6 +151,8 @@ void Corryvreckan::load() {
         }
         // Change to the new/existing output directory
         gSystem->ChangeDirectory(directory.c_str());
+        // Processes for partitions of the run are started from here and have to write to the same directory
+        worker_arguments_.insert(worker_arguments_.end(), {"-o", "output_directory=\"" + directory + "\""});
     } catch(std::invalid_argument& e) {
         LOG(ERROR) << "Cannot create output directory " << directory << ": " << e.what()
                    << ". Using current directory instead.";
@@ -148,6 +163,7 @@ void Corryvreckan::load() {
 
     // Load the modules from the configuration
     if(!terminate_) {
+        mod_mgr_->setWorkerArguments(worker_arguments_);
         mod_mgr_->load(conf_mgr_.get());
     } else {
         LOG(INFO) << "Skip loading modules because termination is requested";
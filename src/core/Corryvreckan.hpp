@@ -18,6 +18,7 @@
 #include <fstream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "config/ConfigManager.hpp"
 #include "module/ModuleManager.hpp"
@@ -89,6 +90,9 @@ namespace corryvreckan {
         // Log file if specified
         std::ofstream log_file_;
 
+        // Command line arguments to start the processes for individual partitions of the run
+        std::vector<std::string> worker_arguments_;
+
         // All managers in the framework
         std::unique_ptr<ModuleManager> mod_mgr_;
         std::unique_ptr<ConfigManager> conf_mgr_;
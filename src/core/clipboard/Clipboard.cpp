@@ -12,8 +12,64 @@
 #include "exceptions.h"
 #include "objects/Object.hpp"
 
+#include <deque>
+#include <shared_mutex>
+
 using namespace corryvreckan;
 
+namespace {
+    /**
+     * @brief Registry of all collections known to any clipboard, assigning a fixed index to each type and key
+     */
+    struct CollectionRegistry {
+        std::shared_mutex mutex;
+        std::unordered_map<std::type_index, std::unordered_map<std::string, size_t>> indices;
+        // Deque to keep references to the entries valid while new collections are registered
+        std::deque<std::pair<std::type_index, std::string>> keys;
+    };
+
+    CollectionRegistry& collection_registry() {
+        static CollectionRegistry registry;
+        return registry;
+    }
+} // namespace
+
+size_t Clipboard::collection_index(const std::type_index& type, const std::string& key, bool create) {
+    auto& registry = collection_registry();
+    {
+        std::shared_lock<std::shared_mutex> lock(registry.mutex);
+        auto type_it = registry.indices.find(type);
+        if(type_it != registry.indices.end()) {
+            auto key_it = type_it->second.find(key);
+            if(key_it != type_it->second.end()) {
+                return key_it->second;
+            }
+        }
+    }
+    if(!create) {
+        return std::numeric_limits<size_t>::max();
+    }
+
+    std::unique_lock<std::shared_mutex> lock(registry.mutex);
+    auto element = registry.indices[type].emplace(key, registry.keys.size());
+    if(element.second) {
+        registry.keys.emplace_back(type, key);
+    }
+    return element.first->second;
+}
+
+const Clipboard::CollectionKey& Clipboard::collection_key(size_t index) {
+    auto& registry = collection_registry();
+    std::shared_lock<std::shared_mutex> lock(registry.mutex);
+    return registry.keys.at(index);
+}
+
+std::shared_ptr<Clipboard> Clipboard::share_persistent(const Clipboard& other) {
+    auto clipboard = std::make_shared<Clipboard>();
+    clipboard->persistent_data_ = other.persistent_data_;
+    return clipboard;
+}
+
 bool Clipboard::isEventDefined() const {
     return (event_ != nullptr);
 }
@@ -35,21 +91,23 @@ std::shared_ptr<Event> Clipboard::getEvent() const {
 }
 
 void Clipboard::clear() {
-    // Loop over all data types
-    for(auto& block : data_) {
-        // Loop over all stored collections of this type
-        for(auto& set : block.second) {
-            for(auto& obj : (*std::static_pointer_cast<ObjectVector>(set.second))) {
-                // All objects are destroyed together in this clear function at the end of the event. To avoid costly
-                // reverse-iterations through the TRef dependency hash lists, we just tell ROOT not to care about possible
-                // TRef-dependants and to just destroy the object directly by resetting the `kMustCleanup` bit.
-                obj->ResetBit(kMustCleanup);
-            }
+    // Loop over all collections filled during this event
+    for(const auto& index : used_collections_) {
+        auto& collection = collections_[index];
+        auto objects = std::static_pointer_cast<ObjectVector>(collection.objects);
+        for(auto& obj : (*objects)) {
+            // All objects are destroyed together in this clear function at the end of the event. To avoid costly
+            // reverse-iterations through the TRef dependency hash lists, we just tell ROOT not to care about possible
+            // TRef-dependants and to just destroy the object directly by resetting the `kMustCleanup` bit.
+            obj->ResetBit(kMustCleanup);
         }
-    }
 
-    // Clear the data
-    data_.clear();
+        // Clear the data, keeping the allocated vector for the next event
+        objects->clear();
+        collection.used = false;
+    }
+    used_collections_.clear();
+    all_data_.clear();
 
     // Resetting the event definition:
     event_.reset();
@@ -58,7 +116,7 @@ void Clipboard::clear() {
 std::vector<std::string> Clipboard::listCollections() const {
     std::vector<std::string> collections;
 
-    for(const auto& block : data_) {
+    for(const auto& block : getAll()) {
         std::string line(corryvreckan::demangle(block.first.name()));
         line += ": ";
         for(const auto& set : block.second) {
@@ -72,5 +130,13 @@ std::vector<std::string> Clipboard::listCollections() const {
 }
 
 const ClipboardData& Clipboard::getAll() const {
-    return data_;
+    // Collect all non-empty collections, sorted by type and key
+    all_data_.clear();
+    for(const auto& index : used_collections_) {
+        const auto& collection = collections_[index];
+        if(!std::static_pointer_cast<ObjectVector>(collection.objects)->empty()) {
+            all_data_[collection.id->first][collection.id->second] = collection.objects;
+        }
+    }
+    return all_data_;
 }
@@ -12,10 +12,14 @@
 #define CORRYVRECKAN_CLIPBOARD_H
 
 #include <iostream>
+#include <limits>
+#include <map>
 #include <memory>
 #include <string>
 #include <typeindex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "core/utils/log.h"
 #include "core/utils/type.h"
@@ -25,6 +29,33 @@
 namespace corryvreckan {
     using ClipboardData = std::map<std::type_index, std::map<std::string, std::shared_ptr<void>>>;
 
+    /**
+     * @brief Handle to a collection of objects of one type and key on the clipboard event storage
+     *
+     * Handles are obtained once from \ref Clipboard::registerCollection, typically when initializing a module, and provide
+     * direct access to the collection without looking up the type and key for every event. A handle is valid for all
+     * clipboards, including the separate clipboards of concurrently processed events.
+     */
+    template <typename T> class CollectionHandle {
+        friend class Clipboard;
+
+    public:
+        /**
+         * @brief Construct an invalid handle, to be replaced by a registered one before use
+         */
+        CollectionHandle() = default;
+
+        /**
+         * @brief Check whether the handle has been registered
+         * @return True if the handle refers to a collection, false otherwise
+         */
+        bool valid() const { return index_ != std::numeric_limits<size_t>::max(); }
+
+    private:
+        explicit CollectionHandle(size_t index) : index_(index) {}
+        size_t index_{std::numeric_limits<size_t>::max()};
+    };
+
     class ReadonlyClipboard {
     public:
         /**
@@ -66,8 +97,8 @@ namespace corryvreckan {
          */
         template <typename T> size_t count_objects(const ClipboardData& storage_element, const std::string& key) const;
 
-        // Persistent clipboard storage
-        ClipboardData persistent_data_;
+        // Persistent clipboard storage, possibly shared between multiple event clipboards
+        std::shared_ptr<ClipboardData> persistent_data_{std::make_shared<ClipboardData>()};
     };
 
     /**
@@ -75,7 +106,8 @@ namespace corryvreckan {
      *
      * The Clipboard class is used to transfer information between modules during the event processing. \ref Objects can be
      * placed on the clipboard, and retrieved by their name. At the end of each event, the clipboard is
-     * wiped clean.
+     * wiped clean. Objects created via make_pooled are thereby returned to their memory pool and their memory is reused for
+     * the objects of the following events.
      *
      * In addition, a permanent clipboard storage area for variables of type double is provided, which allow to exchange
      * information which should outlast a single event. This is dubbed the "persistent storage"
@@ -84,6 +116,11 @@ namespace corryvreckan {
         friend class ModuleManager;
 
     public:
+        /**
+         * @brief Construct the clipboard with empty event and persistent storage
+         */
+        Clipboard() = default;
+
         /**
          * @brief Method to add a vector of objects to the clipboard
          * @param objects Shared pointer to vector of objects to be stored
@@ -117,6 +154,37 @@ namespace corryvreckan {
          */
         template <typename T> size_t countObjects(const std::string& key = "") const;
 
+        /**
+         * @brief Register a collection of objects for direct access via a handle
+         * @param key Identifying key of the collection. Defaults to empty key
+         * @return Handle to the collection, valid for all clipboards
+         *
+         * Registering the same type and key several times returns handles to the same collection. The collection is shared
+         * with the methods taking string keys, i.e. objects stored via a handle can be retrieved via their key and vice
+         * versa.
+         */
+        template <typename T> static CollectionHandle<T> registerCollection(const std::string& key = "");
+
+        /**
+         * @brief Method to add a vector of objects to a registered collection
+         * @param objects Vector of objects to be stored, of the collection type or derived from it
+         * @param handle  Handle of the collection
+         */
+        template <typename T, typename U>
+        void putData(std::vector<std::shared_ptr<T>> objects, const CollectionHandle<U>& handle);
+
+        /**
+         * @brief Method to retrieve the objects of a registered collection
+         * @param handle Handle of the collection
+         */
+        template <typename T> std::vector<std::shared_ptr<T>>& getData(const CollectionHandle<T>& handle) const;
+
+        /**
+         * @brief Method to count the number of objects of a registered collection
+         * @param handle Handle of the collection
+         */
+        template <typename T> size_t countObjects(const CollectionHandle<T>& handle) const;
+
         /**
          * @brief Check whether an event has been defined
          * @return true if an event has been defined, false otherwise
@@ -172,6 +240,14 @@ namespace corryvreckan {
         const ClipboardData& getAll() const;
 
     private:
+        /**
+         * @brief Construct a clipboard with empty event storage, sharing the persistent storage of another clipboard
+         * @param other Clipboard to share the persistent storage with
+         *
+         * This is used to provide an independent event storage to each of the concurrently processed events.
+         */
+        static std::shared_ptr<Clipboard> share_persistent(const Clipboard& other);
+
         /**
          * @brief Clear the event storage of the clipboard
          */
@@ -191,17 +267,55 @@ namespace corryvreckan {
                       bool append = false);
 
         /**
-         * Helper to remove a set of objects from the clipboard
-         * @param  storage_element Storage element concerned
-         * @param  objects         Objects to be removed
-         * @param  key             Key under which objects should be searched
+         * Helper to put new data into a collection of the event storage
+         * @param index   Index of the collection
+         * @param objects Data to be stored
          */
-        template <typename T>
-        void
-        remove_data(ClipboardData& storage_element, const std::vector<std::shared_ptr<T>>& objects, const std::string& key);
+        template <typename T> void put_event_data(size_t index, std::vector<std::shared_ptr<T>> objects);
+
+        /**
+         * Helper to access the objects of a collection of the event storage
+         * @param index Index of the collection
+         * @return Pointer to the object vector of the collection, nullptr if the collection does not hold any objects
+         */
+        template <typename T> std::vector<std::shared_ptr<T>>* get_event_data(size_t index) const;
+
+        // Type and key identifying a collection
+        using CollectionKey = std::pair<std::type_index, std::string>;
+
+        /**
+         * @brief Look up the index of a collection in the registry shared by all clipboards
+         * @param type   Type of the collection objects
+         * @param key    Key of the collection
+         * @param create Flag whether the collection should be registered if it is not known yet
+         * @return Index of the collection, or maximum value of size_t if not registered and creation was not requested
+         */
+        static size_t collection_index(const std::type_index& type, const std::string& key, bool create);
+
+        /**
+         * @brief Retrieve type and key of a registered collection
+         * @param index Index of the collection
+         * @return Reference to the type and key of the collection, which remains valid for the lifetime of the program
+         */
+        static const CollectionKey& collection_key(size_t index);
+
+        /**
+         * @brief Storage of one collection on the event storage
+         *
+         * The object vector is kept when the clipboard is cleared, such that its memory can be reused for the next event.
+         */
+        struct Collection {
+            std::shared_ptr<void> objects;
+            const CollectionKey* id{nullptr};
+            bool used{false};
+        };
 
-        // Container for data, list of all data held
-        ClipboardData data_;
+        // Collections of the event storage, indexed by the collection index of the registry
+        std::vector<Collection> collections_;
+        // Indices of the collections which have been used since the last clear
+        std::vector<size_t> used_collections_;
+        // Snapshot of all event data in the layout of the persistent storage, provided by getAll()
+        mutable ClipboardData all_data_;
 
         // Store the current time slice:
         std::shared_ptr<Event> event_{};
@@ -11,46 +11,112 @@
 #include "exceptions.h"
 
 #include <algorithm>
+#include <iterator>
+#include <type_traits>
 
 namespace corryvreckan {
 
     template <typename T> void Clipboard::putData(std::vector<std::shared_ptr<T>> objects, const std::string& key) {
-        put_data(data_, std::move(objects), key);
+        // Do not insert empty sets:
+        if(objects.empty()) {
+            return;
+        }
+
+        // We use getBaseType here to always store objects as their base class types to be able to fetch them easily.
+        // E.g. derived track classes will be stored as Track objects and can be fetched as such
+        put_event_data(collection_index(T::getBaseType(), key, true), std::move(objects));
     }
 
     template <typename T> void Clipboard::removeData(std::shared_ptr<T> object, const std::string& key) {
-        remove_data(data_, std::vector<std::shared_ptr<T>>{std::move(object)}, key);
+        std::vector<std::shared_ptr<T>> objects{std::move(object)};
+        removeData(objects, key);
     }
 
     template <typename T> void Clipboard::removeData(std::vector<std::shared_ptr<T>>& objects, const std::string& key) {
-        remove_data(data_, std::move(objects), key);
+        auto* data = get_event_data<T>(collection_index(typeid(T), key, false));
+        if(data == nullptr) {
+            return;
+        }
+        for(const auto& object : objects) {
+            auto object_iterator = std::find(data->begin(), data->end(), object);
+            if(object_iterator != data->end()) {
+                data->erase(object_iterator);
+            }
+        }
     }
 
     template <typename T> std::vector<std::shared_ptr<T>>& Clipboard::getData(const std::string& key) const {
-        return get_data<T>(data_, key);
+        auto* data = get_event_data<T>(collection_index(typeid(T), key, false));
+        if(data == nullptr) {
+            // Hand out an empty vector, emptied again in case the previous caller modified it
+            static thread_local std::vector<std::shared_ptr<T>> empty;
+            empty.clear();
+            return empty;
+        }
+        return *data;
     }
 
     template <typename T> size_t Clipboard::countObjects(const std::string& key) const {
-        return count_objects<T>(data_, key);
+        // Decide whether we should count all or just the ones identified by a key:
+        if(!key.empty()) {
+            auto* data = get_event_data<T>(collection_index(typeid(T), key, false));
+            return (data == nullptr ? 0 : data->size());
+        }
+
+        size_t number_of_objects = 0;
+        for(const auto& index : used_collections_) {
+            if(collections_[index].id->first == typeid(T)) {
+                number_of_objects +=
+                    std::static_pointer_cast<std::vector<std::shared_ptr<T>>>(collections_[index].objects)->size();
+            }
+        }
+        return number_of_objects;
+    }
+
+    template <typename T> CollectionHandle<T> Clipboard::registerCollection(const std::string& key) {
+        return CollectionHandle<T>(collection_index(T::getBaseType(), key, true));
+    }
+
+    template <typename T, typename U>
+    void Clipboard::putData(std::vector<std::shared_ptr<T>> objects, const CollectionHandle<U>& handle) {
+        static_assert(std::is_base_of<U, T>::value, "objects have to be of the collection type or derived from it");
+        if(!objects.empty()) {
+            put_event_data(handle.index_, std::move(objects));
+        }
+    }
+
+    template <typename T> std::vector<std::shared_ptr<T>>& Clipboard::getData(const CollectionHandle<T>& handle) const {
+        auto* data = get_event_data<T>(handle.index_);
+        if(data == nullptr) {
+            static thread_local std::vector<std::shared_ptr<T>> empty;
+            empty.clear();
+            return empty;
+        }
+        return *data;
+    }
+
+    template <typename T> size_t Clipboard::countObjects(const CollectionHandle<T>& handle) const {
+        auto* data = get_event_data<T>(handle.index_);
+        return (data == nullptr ? 0 : data->size());
     }
 
     template <typename T>
     void Clipboard::putPersistentData(std::vector<std::shared_ptr<T>> objects, const std::string& key) {
-        put_data(persistent_data_, std::move(objects), key, true);
+        put_data(*persistent_data_, std::move(objects), key, true);
     }
 
     template <typename T>
     std::vector<std::shared_ptr<T>>& ReadonlyClipboard::getPersistentData(const std::string& key) const {
-        return get_data<T>(persistent_data_, key);
+        return get_data<T>(*persistent_data_, key);
     }
 
     template <typename T> size_t ReadonlyClipboard::countPersistentObjects(const std::string& key) const {
-        return count_objects<T>(persistent_data_, key);
+        return count_objects<T>(*persistent_data_, key);
     }
 
     // Translate raw pointers to their shared pointers on storage. Fail if not found.
     template <typename T> void Clipboard::copyToPersistentData(std::vector<T*> references, const std::string& key) {
-        auto from_volatile = get_data<T>(data_, key);
+        auto from_volatile = getData<T>(key);
         std::vector<std::shared_ptr<T>> to_persistent;
 
         // Clear vector of duplicates:
@@ -68,7 +134,7 @@ namespace corryvreckan {
         }
 
         // Ship off to persistent storage
-        put_data(persistent_data_, std::move(to_persistent), key, true);
+        put_data(*persistent_data_, std::move(to_persistent), key, true);
     }
 
     template <typename T>
@@ -109,34 +175,47 @@ namespace corryvreckan {
         }
     }
 
-    template <typename T>
-    void Clipboard::remove_data(ClipboardData& storage_element,
-                                const std::vector<std::shared_ptr<T>>& objects,
-                                const std::string& key) {
+    template <typename T> void Clipboard::put_event_data(size_t index, std::vector<std::shared_ptr<T>> objects) {
+        if(index >= collections_.size()) {
+            collections_.resize(index + 1);
+        }
+        auto& collection = collections_[index];
+        if(!collection.used) {
+            collection.used = true;
+            collection.id = &collection_key(index);
+            used_collections_.push_back(index);
+        }
 
-        // Try to get existing objects:
-        if(storage_element.count(typeid(T)) == 0 || storage_element.at(typeid(T)).count(key) == 0) {
+        // Reuse the vector kept from previous events, all collections of one key share the same base type
+        if(collection.objects == nullptr) {
+            collection.objects = std::make_shared<std::vector<std::shared_ptr<T>>>(std::move(objects));
             return;
         }
-        auto data = std::static_pointer_cast<std::vector<std::shared_ptr<T>>>(storage_element.at(typeid(T)).at(key));
-        for(const auto& object : objects) {
-            auto object_iterator = std::find(data->begin(), data->end(), object);
-            if(object_iterator != data->end()) {
-                data->erase(object_iterator);
-            }
+        auto existing_elements = std::static_pointer_cast<std::vector<std::shared_ptr<T>>>(collection.objects);
+        if(!existing_elements->empty()) {
+            LOG(WARNING) << "Dataset of type " << corryvreckan::demangle(typeid(T).name()) << " already exists for key \""
+                         << collection.id->second << "\", ignoring new data";
+            return;
         }
+        existing_elements->assign(std::make_move_iterator(objects.begin()), std::make_move_iterator(objects.end()));
+    }
 
-        // If we removed all objects, drop the key:
-        if(data->empty()) {
-            storage_element.at(typeid(T)).erase(key);
+    template <typename T> std::vector<std::shared_ptr<T>>* Clipboard::get_event_data(size_t index) const {
+        if(index >= collections_.size() || !collections_[index].used) {
+            return nullptr;
         }
+        auto* data = static_cast<std::vector<std::shared_ptr<T>>*>(collections_[index].objects.get());
+        return (data->empty() ? nullptr : data);
     }
 
     template <typename T>
     std::vector<std::shared_ptr<T>>& ReadonlyClipboard::get_data(const ClipboardData& storage_element,
                                                                  const std::string& key) const {
         if(storage_element.count(typeid(T)) == 0 || storage_element.at(typeid(T)).count(key) == 0) {
-            return *std::make_shared<std::vector<std::shared_ptr<T>>>();
+            // Hand out an empty vector, emptied again in case the previous caller modified it
+            static thread_local std::vector<std::shared_ptr<T>> empty;
+            empty.clear();
+            return empty;
         }
         return *std::static_pointer_cast<std::vector<std::shared_ptr<T>>>(storage_element.at(typeid(T)).at(key));
     }
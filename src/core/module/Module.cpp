@@ -39,6 +39,42 @@ std::string Module::getUniqueName() const {
     return unique_name;
 }
 
+void Module::merge_histograms() {
+    for(auto& histogram : histograms_) {
+        histogram->merge();
+    }
+}
+
+std::shared_ptr<StageTimer> Module::create_stage_timer(const std::string& stage) {
+    auto timer = make_stage_timer(stage, "execution_time_" + stage, "Execution time of " + stage);
+    stage_timers_.push_back(timer);
+    return timer;
+}
+
+double Module::get_partition_begin_time() {
+    const auto& global_config = getConfigManager()->getGlobalConfiguration();
+    if(!global_config.has("_partition_begin") || !global_config.get<bool>("_partition_by_time")) {
+        return 0;
+    }
+    return global_config.get<double>("_partition_begin");
+}
+
+std::shared_ptr<StageTimer> Module::create_execution_timer() {
+    return make_stage_timer("run", "execution_time", "Execution time");
+}
+
+std::shared_ptr<StageTimer>
+Module::make_stage_timer(const std::string& stage, const std::string& histogram_name, const std::string& histogram_title) {
+    Histogram<TH1D> histogram;
+    if(profiling_) {
+        auto bins = StageTimer::getHistogramBins();
+        auto title = histogram_title + ";time per event [ms];events";
+        histogram = create_histogram<TH1D>(
+            histogram_name.c_str(), title.c_str(), static_cast<int>(bins.size() - 1), bins.data());
+    }
+    return std::make_shared<StageTimer>(stage, histogram);
+}
+
 void Module::set_identifier(ModuleIdentifier identifier) {
     identifier_ = std::move(identifier);
 }
@@ -15,6 +15,9 @@
 #include "core/clipboard/Clipboard.hpp"
 #include "core/config/ConfigManager.hpp"
 #include "core/detector/Detector.hpp"
+#include "core/utils/ObjectPool.hpp"
+#include "core/utils/StageTimer.hpp"
+#include "core/utils/ThreadedHistogram.hpp"
 #include "exceptions.h"
 
 namespace corryvreckan {
@@ -132,7 +135,85 @@ namespace corryvreckan {
          */
         TDirectory* getROOTDirectory() const;
 
+        /**
+         * @brief Check if this module is able to process independent events concurrently
+         * @return True if the module supports multithreading, false otherwise
+         */
+        bool canParallelize() const { return can_parallelize_; }
+
+        /**
+         * @brief Check if this module processes independent events concurrently in the current run
+         * @return True if multithreading is enabled for this module, false otherwise
+         */
+        bool multithreadingEnabled() const { return parallelize_; }
+
+        /**
+         * @brief Check if the results of this module can be combined when the run is split into partitions
+         * @return True if the module supports partitions, false otherwise
+         */
+        bool canPartition() const { return can_partition_; }
+
     protected:
+        /**
+         * @brief Declare that this module is able to process independent events concurrently
+         * @note Has to be called from the constructor of the module
+         *
+         * Modules calling this method guarantee that their run() method only modifies data local to the event or histograms
+         * created via \ref create_histogram, and only reads member variables which are not altered during the event loop.
+         */
+        void allow_multithreading() { can_parallelize_ = true; }
+
+        /**
+         * @brief Declare that the results of this module cannot be combined from partitions processed by separate processes
+         * @note Has to be called from the constructor of the module
+         *
+         * Only histograms and persistent clipboard data of partitions are merged. Modules which write their own output
+         * files or keep their results in member variables until finalize() have to call this method.
+         */
+        void disallow_partitions() { can_partition_ = false; }
+
+        /**
+         * @brief Create a histogram which can be filled from concurrently processed events
+         * @param args Arguments passed to the constructor of the ROOT histogram
+         * @return Handle to the histogram
+         *
+         * The histogram is attached to the current ROOT directory. If multithreading is enabled for this module, one copy
+         * is filled per thread and all copies are merged before the module is finalized, otherwise it is a plain ROOT
+         * histogram.
+         */
+        template <typename T, typename... Args> Histogram<T> create_histogram(Args&&... args);
+
+        /**
+         * @brief Create a single histogram shared by all concurrently processed events
+         * @param args Arguments passed to the constructor of the ROOT histogram
+         * @return Handle to the histogram
+         *
+         * Intended for histograms with many bins, for which a copy per thread would take up too much memory. If
+         * multithreading is enabled for this module, every fill acquires a lock.
+         */
+        template <typename T, typename... Args> Histogram<T> create_shared_histogram(Args&&... args);
+
+        /**
+         * @brief Create a timer measuring the execution time of a stage of the event processing of this module
+         * @param stage Name of the stage
+         * @return Timer to be used in the run() method via StageTimer::measure()
+         * @note Has to be called from the initialize() method of the module
+         *
+         * The accumulated time of all stages is reported at the end of the run. If profiling is enabled, the duration of
+         * every measurement is filled into a histogram stored in the ROOT directory of the module.
+         */
+        std::shared_ptr<StageTimer> create_stage_timer(const std::string& stage);
+
+        /**
+         * @brief Get the time at which the partition of the run processed by this process begins
+         * @return Begin of the partition if the run is split into partitions of its run time, zero otherwise
+         * @note Has to be called from the initialize() method of the module
+         *
+         * Events starting before this time are skipped by the framework. Modules defining events can start directly at this
+         * time instead of defining all preceding events.
+         */
+        double get_partition_begin_time();
+
         /**
          * @brief Get the module configuration for internal use
          * @return Configuration of the module
@@ -230,8 +311,53 @@ namespace corryvreckan {
 
         // List of detectors to act on
         std::vector<std::shared_ptr<Detector>> m_detectors;
+
+        /**
+         * @brief Enable or disable concurrent event processing for this module
+         * @param parallelize True if events should be processed concurrently
+         */
+        void set_parallelize(bool parallelize) { parallelize_ = parallelize; }
+        bool can_parallelize_{false};
+        bool parallelize_{false};
+        bool can_partition_{true};
+
+        /**
+         * @brief Merge all thread-local histograms created by this module
+         */
+        void merge_histograms();
+        std::vector<std::shared_ptr<ThreadedHistogramInterface>> histograms_;
+
+        /**
+         * @brief Enable or disable the filling of execution time histograms
+         * @param profiling True if execution time histograms should be created
+         */
+        void set_profiling(bool profiling) { profiling_ = profiling; }
+        bool profiling_{false};
+
+        /**
+         * @brief Create the timer measuring the execution time of the run() method of this module
+         * @return Timer for the full event processing of the module
+         */
+        std::shared_ptr<StageTimer> create_execution_timer();
+        std::shared_ptr<StageTimer>
+        make_stage_timer(const std::string& stage, const std::string& histogram_name, const std::string& histogram_title);
+        std::vector<std::shared_ptr<StageTimer>> stage_timers_;
     };
 
+    template <typename T, typename... Args> Histogram<T> Module::create_histogram(Args&&... args) {
+        // Copies per thread are only required if events are processed concurrently
+        auto histogram = std::make_shared<ThreadedHistogram<T>>(parallelize_, std::forward<Args>(args)...);
+        histograms_.push_back(histogram);
+        return histogram;
+    }
+
+    template <typename T, typename... Args> Histogram<T> Module::create_shared_histogram(Args&&... args) {
+        auto histogram = std::make_shared<ThreadedHistogram<T>>(
+            typename ThreadedHistogram<T>::Shared(), parallelize_, std::forward<Args>(args)...);
+        histograms_.push_back(histogram);
+        return histogram;
+    }
+
 } // namespace corryvreckan
 
 #endif // CORRYVRECKAN_MODULE_H
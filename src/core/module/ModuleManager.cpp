@@ -10,19 +10,48 @@
 #include <Math/DisplacementVector2D.h>
 #include <Math/Vector2D.h>
 #include <Math/Vector3D.h>
+#include <TBranch.h>
+#include <TClass.h>
 #include <TFile.h>
+#include <TH1.h>
+#include <TKey.h>
+#include <TList.h>
+#include <TParameter.h>
+#include <TROOT.h>
 #include <TSystem.h>
+#include <TTree.h>
 
 // Local include files
 #include "ModuleManager.hpp"
+#include "core/utils/ROOT.h"
 #include "core/utils/log.h"
+#include "core/utils/type.h"
 #include "exceptions.h"
+#include "objects/objects.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstring>
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iomanip>
+#include <list>
+#include <set>
+#include <spawn.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#ifdef __APPLE__
+#include <mach-o/dyld.h>
+#endif
 
 #define CORRYVRECKAN_MODULE_PREFIX "libCorryvreckanModule"
 #define CORRYVRECKAN_GENERATOR_FUNCTION "corryvreckan_module_generator"
@@ -31,6 +60,8 @@
 #define CORRYVRECKAN_AUX_FUNCTION "corryvreckan_module_exclude_aux"
 #define CORRYVRECKAN_TYPE_FUNCTION "corryvreckan_detector_types"
 
+extern char** environ; // NOLINT
+
 using namespace corryvreckan;
 
 // Default constructor
@@ -41,11 +72,87 @@ ModuleManager::ModuleManager() : m_reference(nullptr), m_terminate(false) {
 
 void ModuleManager::load(ConfigManager* conf_mgr) {
     conf_manager_ = conf_mgr;
+    Configuration& global_config = conf_manager_->getGlobalConfiguration();
+
+    // Check if events should be processed concurrently
+    multithreading_ = global_config.get<bool>("multithreading", false);
+    if(multithreading_) {
+        workers_ = global_config.get<unsigned int>("workers", std::max(std::thread::hardware_concurrency(), 2u) - 1);
+        if(workers_ == 0) {
+            throw InvalidValueError(global_config, "workers", "number of workers should be strictly more than zero");
+        }
+        buffer_per_worker_ = global_config.get<unsigned int>("buffer_per_worker", 256);
+        if(buffer_per_worker_ == 0) {
+            throw InvalidValueError(
+                global_config, "buffer_per_worker", "buffer per worker should be strictly more than zero");
+        }
+
+        // Histograms and directories are accessed from multiple threads, ROOT needs to be prepared for this
+        ROOT::EnableThreadSafety();
+        LOG(STATUS) << "Multithreading enabled, processing events in " << workers_ << " worker threads";
+    }
+
+    // Check if execution time histograms should be created
+    profiling_ = global_config.get<bool>("profiling", false);
+
+    // Check if the run should be split into partitions processed by separate processes
+    partitions_ = global_config.get<unsigned int>("partitions", 1);
+    if(partitions_ == 0) {
+        throw InvalidValueError(global_config, "partitions", "number of partitions should be strictly more than zero");
+    }
+    if(partitions_ > 1) {
+        // The partition index is only set for the processes started by the driving process
+        partition_ = global_config.get<int>("partition", -1);
+        if(partition_ >= static_cast<int>(partitions_)) {
+            throw InvalidValueError(
+                global_config, "partition", "partition index should be smaller than number of partitions");
+        }
+
+        // Partitions cover equal fractions of the run time if given, of the number of events otherwise
+        double range = 0;
+        if(global_config.has("run_time")) {
+            partition_by_time_ = true;
+            range = global_config.get<double>("run_time");
+        } else if(global_config.has("number_of_events")) {
+            range = global_config.get<double>("number_of_events");
+        }
+        if(range <= 0) {
+            throw InvalidCombinationError(global_config,
+                                          {"partitions", "run_time", "number_of_events"},
+                                          "splitting the run into partitions requires a positive run time or number of "
+                                          "events");
+        }
+        if(partition_ >= 0) {
+            auto index = static_cast<unsigned int>(partition_);
+            partition_begin_ = range * index / partitions_;
+            partition_end_ = range * (index + 1) / partitions_;
+            if(!partition_by_time_) {
+                partition_begin_ = std::floor(partition_begin_);
+                partition_end_ = std::floor(partition_end_);
+            }
+
+            // Provide the range of this partition to modules which can skip the preceding data, e.g. reading from files
+            global_config.set<bool>("_partition_by_time", partition_by_time_, true);
+            global_config.set<double>("_partition_begin", partition_begin_, true);
+            global_config.set<double>("_partition_end", partition_end_, true);
+            LOG(STATUS) << "Processing partition " << partition_ << " of " << partitions_ << ", "
+                        << (partition_by_time_ ? "run time " + Units::display(partition_begin_, {"ns", "us", "ms", "s"}) +
+                                                     " to " + Units::display(partition_end_, {"ns", "us", "ms", "s"})
+                                               : "events " + std::to_string(static_cast<long>(partition_begin_)) + " to " +
+                                                     std::to_string(static_cast<long>(partition_end_)));
+        } else {
+            LOG(STATUS) << "Splitting run into " << partitions_ << " partitions processed by separate processes";
+        }
+    }
 
     load_detectors();
     load_modules();
 }
 
+void ModuleManager::setWorkerArguments(std::vector<std::string> arguments) {
+    worker_arguments_ = std::move(arguments);
+}
+
 void ModuleManager::load_detectors() {
     Configuration& global_config = conf_manager_->getGlobalConfiguration();
 
@@ -101,6 +208,10 @@ void ModuleManager::load_modules() {
     global_config.setAlias("histogram_file", "histogramFile");
     auto path = std::string(gSystem->pwd()) + "/" + global_config.get<std::string>("histogram_file", "histograms");
     path = std::filesystem::path(path).replace_extension("root");
+    if(partition_ >= 0) {
+        // Every partition of the run writes its own file, merged by the driving process
+        path = partition_path(path, static_cast<unsigned int>(partition_), "root").string();
+    }
 
     if(std::filesystem::is_regular_file(path)) {
         if(global_config.get<bool>("deny_overwrite", false)) {
@@ -283,6 +394,24 @@ void ModuleManager::load_modules() {
             mod->set_identifier(identifier);
             mod->setReference(m_reference);
 
+            // Enable concurrent event processing if requested and supported by the module
+            if(multithreading_) {
+                if(mod->canParallelize()) {
+                    mod->set_parallelize(true);
+                } else {
+                    LOG(INFO) << "Module " << identifier.getUniqueName()
+                              << " does not support multithreading, events will be processed sequentially";
+                }
+            }
+
+            // Partitions only merge histograms and persistent data, other output of the module would be lost
+            if(partitions_ > 1 && !mod->canPartition()) {
+                throw InvalidValueError(global_config,
+                                        "partitions",
+                                        "module " + identifier.getUniqueName() +
+                                            " writes output which cannot be merged from partitions");
+            }
+
             // Add the new module to the run list
             m_modules.emplace_back(std::move(mod));
             id_to_module_[identifier] = --m_modules.end();
@@ -519,6 +648,47 @@ std::vector<std::pair<ModuleIdentifier, Module*>> ModuleManager::create_detector
     return modules;
 }
 
+StatusCode ModuleManager::run_module(const std::shared_ptr<Module>& module, const std::shared_ptr<Clipboard>& clipboard) {
+    // Measure the execution time until the end of this function
+    auto timer = module_execution_time_.at(module.get())->measure();
+
+    // Set run module section header
+    std::string old_section_name = Log::getSection();
+    std::string section_name = "R:";
+    section_name += module->getUniqueName();
+    Log::setSection(section_name);
+    // Set module specific settings
+    auto old_settings = set_module_before(module->getUniqueName(), module->get_configuration());
+    // Change to the output file directory
+    module->getROOTDirectory()->cd();
+
+    StatusCode check = module->run(clipboard);
+
+    // Reset logging
+    Log::setSection(old_section_name);
+    set_module_after(old_settings);
+
+    return check;
+}
+
+void ModuleManager::print_progress(const std::shared_ptr<Event>& event) {
+    auto kilo_or_mega = [](const double& input) {
+        bool mega = (input > 1e6 ? true : false);
+        auto value = (mega ? input * 1e-6 : input * 1e-3);
+        std::stringstream output;
+        output << std::fixed << std::setprecision(mega ? 2 : 1) << value << (mega ? "M" : "k");
+        return output.str();
+    };
+
+    LOG_PROGRESS(STATUS, "event_loop") << "Ev: " << kilo_or_mega(m_events) << " "
+                                       << "Px: " << kilo_or_mega(m_pixels) << " "
+                                       << "Tr: " << kilo_or_mega(m_tracks) << " (" << std::setprecision(3)
+                                       << (static_cast<double>(m_tracks) / m_events) << "/ev)"
+                                       << (event != nullptr
+                                               ? " t = " + Units::display(event->start(), {"ns", "us", "ms", "s"})
+                                               : "");
+}
+
 // Run the analysis loop - this initializes, runs and finalizes all modules
 void ModuleManager::run() {
     Configuration& global_config = conf_manager_->getGlobalConfiguration();
@@ -536,33 +706,30 @@ void ModuleManager::run() {
     m_tracks = 0;
     m_pixels = 0;
 
+    // Process the partitions of the run in separate processes
+    if(partitions_ > 1 && partition_ < 0) {
+        run_partitions();
+        return;
+    }
+
+    if(multithreading_) {
+        if(std::none_of(m_modules.begin(), m_modules.end(), [](const auto& module) {
+               return module->multithreadingEnabled();
+           })) {
+            LOG(WARNING) << "None of the modules supports multithreading, processing events sequentially";
+        } else {
+            run_multithreaded(number_of_events, number_of_tracks, eventloop_print_freq, run_time);
+            return;
+        }
+    }
+
     while(1) {
         bool run = true;
+        auto position = Event::Position::DURING;
 
         // Run all modules
         for(auto& module : m_modules) {
-            // Get current time
-            auto start = std::chrono::steady_clock::now();
-
-            // Set run module section header
-            std::string old_section_name = Log::getSection();
-            std::string section_name = "R:";
-            section_name += module->getUniqueName();
-            Log::setSection(section_name);
-            // Set module specific settings
-            auto old_settings = set_module_before(module->getUniqueName(), module->get_configuration());
-            // Change to the output file directory
-            module->getROOTDirectory()->cd();
-
-            StatusCode check = module->run(m_clipboard);
-
-            // Reset logging
-            Log::setSection(old_section_name);
-            set_module_after(old_settings);
-
-            // Update execution time
-            auto end = std::chrono::steady_clock::now();
-            module_execution_time_[module.get()] += static_cast<std::chrono::duration<long double>>(end - start).count();
+            StatusCode check = run_module(module, m_clipboard);
 
             if(check == StatusCode::DeadTime) {
                 // If status code indicates dead time, just silently continue with next event:
@@ -575,33 +742,29 @@ void ModuleManager::run() {
                 // If the returned status code asks for end-of-run, finish module list and finish:
                 run = false;
             }
+
+            // Skip the remaining modules for events outside of the partition processed by this process
+            position = partition_position(m_clipboard);
+            if(position != Event::Position::DURING) {
+                break;
+            }
         }
 
         // Increment event number
         m_events++;
 
-        // Print statistics:
-        m_tracks += static_cast<int>(m_clipboard->countObjects<Track>());
-        m_pixels += static_cast<int>(m_clipboard->countObjects<Pixel>());
+        if(position == Event::Position::DURING) {
+            // Print statistics:
+            m_tracks += static_cast<int>(m_clipboard->countObjects<Track>());
+            m_pixels += static_cast<int>(m_clipboard->countObjects<Pixel>());
+        } else {
+            // Stop once the end of the partition has been reached
+            partition_skipped_++;
+            run = run && (position == Event::Position::BEFORE);
+        }
 
         if(m_events % eventloop_print_freq == 0) {
-
-            auto kilo_or_mega = [](const double& input) {
-                bool mega = (input > 1e6 ? true : false);
-                auto value = (mega ? input * 1e-6 : input * 1e-3);
-                std::stringstream output;
-                output << std::fixed << std::setprecision(mega ? 2 : 1) << value << (mega ? "M" : "k");
-                return output.str();
-            };
-
-            LOG_PROGRESS(STATUS, "event_loop")
-                << "Ev: " << kilo_or_mega(m_events) << " "
-                << "Px: " << kilo_or_mega(m_pixels) << " "
-                << "Tr: " << kilo_or_mega(m_tracks) << " (" << std::setprecision(3)
-                << (static_cast<double>(m_tracks) / m_events) << "/ev)"
-                << (m_clipboard->isEventDefined()
-                        ? " t = " + Units::display(m_clipboard->getEvent()->start(), {"ns", "us", "ms", "s"})
-                        : "");
+            print_progress(m_clipboard->isEventDefined() ? m_clipboard->getEvent() : nullptr);
         }
 
         // Check if we have reached the maximum number of events
@@ -633,6 +796,312 @@ void ModuleManager::run() {
     }
 }
 
+/**
+ * The modules are split in two sequences. All modules up to the first module with multithreading enabled are executed on
+ * the main thread for every event, this includes the event loaders and the module defining the event. The rest of the
+ * module sequence is submitted to the thread pool with a separate clipboard for every event. As soon as a module without
+ * multithreading support is encountered in this second sequence, the remaining modules are resubmitted as ordered job
+ * which is only executed once all previous events have been completed. This guarantees that e.g. output writers receive
+ * the events in the order they were defined.
+ *
+ * The event and track limits are checked on the main thread, events already submitted to the pool at the time a limit is
+ * reached are still processed.
+ */
+void ModuleManager::run_multithreaded(int number_of_events, int number_of_tracks, int print_frequency, double run_time) {
+    auto first_concurrent = std::find_if(
+        m_modules.begin(), m_modules.end(), [](const auto& module) { return module->multithreadingEnabled(); });
+    const ModuleList sequential_modules(m_modules.begin(), first_concurrent);
+    const ModuleList concurrent_modules(first_concurrent, m_modules.end());
+
+    for(const auto& module : concurrent_modules) {
+        if(!module->multithreadingEnabled()) {
+            LOG(DEBUG) << "Module " << module->getUniqueName() << " will receive events in order of their definition";
+        }
+    }
+
+    // Create the thread pool, the buffered queue holds the events waiting for in-order processing:
+    ThreadPool::registerThreadCount(workers_);
+    ThreadPool thread_pool(
+        workers_,
+        workers_ * buffer_per_worker_,
+        workers_ * buffer_per_worker_,
+        [log_level = corryvreckan::Log::getReportingLevel(), log_format = corryvreckan::Log::getFormat()]() {
+            // Initialize the threads to the same log level and format as the master setting
+            corryvreckan::Log::setReportingLevel(log_level);
+            corryvreckan::Log::setFormat(log_format);
+        });
+
+    // Set by any module requesting to end the run from a worker thread
+    std::atomic<bool> end_run{false};
+
+    // Clipboards of completed events are reused for new events, keeping the memory of their collections
+    std::vector<std::shared_ptr<Clipboard>> idle_clipboards;
+    std::mutex idle_clipboards_mutex;
+    auto release_clipboard = [&](std::shared_ptr<Clipboard> clipboard) {
+        clipboard->clear();
+        std::lock_guard<std::mutex> lock(idle_clipboards_mutex);
+        idle_clipboards.push_back(std::move(clipboard));
+    };
+
+    // Process the modules of an event starting from the given position, re-submitting as ordered job if required
+    std::function<void(std::shared_ptr<Clipboard>, uint64_t, ModuleList::const_iterator, bool)> process_event;
+    process_event = [&](std::shared_ptr<Clipboard> clipboard,
+                        uint64_t event_id,
+                        ModuleList::const_iterator module_it,
+                        bool in_order) {
+        for(; module_it != concurrent_modules.end(); ++module_it) {
+            const auto& module = *module_it;
+
+            // Modules without multithreading support have to wait for all previous events to be completed
+            if(!in_order && !module->multithreadingEnabled()) {
+                // A rejected job would never complete, raise an error which stops the pool and releases the wait
+                auto future = thread_pool.submit(event_id, process_event, clipboard, event_id, module_it, true);
+                if(!future.valid()) {
+                    end_run = true;
+                    throw RuntimeError("could not queue event " + std::to_string(event_id) + " for in-order processing");
+                }
+                return;
+            }
+
+            StatusCode check = run_module(module, clipboard);
+            if(check == StatusCode::DeadTime) {
+                break;
+            } else if(check == StatusCode::Failure) {
+                end_run = true;
+                break;
+            } else if(check == StatusCode::EndRun) {
+                end_run = true;
+            }
+        }
+
+        m_tracks += static_cast<int>(clipboard->countObjects<Track>());
+        m_pixels += static_cast<int>(clipboard->countObjects<Pixel>());
+        release_clipboard(std::move(clipboard));
+
+        // Release the next event waiting for in-order processing
+        thread_pool.markComplete(event_id);
+    };
+
+    uint64_t event_id = 0;
+    std::shared_ptr<Event> event;
+    while(1) {
+        // Propagate exceptions thrown by the modules on the worker threads
+        thread_pool.checkException();
+
+        bool run = true;
+        bool submit = true;
+        std::shared_ptr<Clipboard> clipboard;
+        {
+            std::lock_guard<std::mutex> lock(idle_clipboards_mutex);
+            if(!idle_clipboards.empty()) {
+                clipboard = std::move(idle_clipboards.back());
+                idle_clipboards.pop_back();
+            }
+        }
+        if(clipboard == nullptr) {
+            clipboard = Clipboard::share_persistent(*m_clipboard);
+        }
+
+        // Run all modules which need to be executed on the main thread
+        auto position = Event::Position::DURING;
+        for(auto& module : sequential_modules) {
+            StatusCode check = run_module(module, clipboard);
+
+            if(check == StatusCode::DeadTime) {
+                // If status code indicates dead time, just silently continue with next event:
+                submit = false;
+                break;
+            } else if(check == StatusCode::Failure) {
+                // If the status code indicates failure, break immediately and finish:
+                submit = false;
+                run = false;
+                break;
+            } else if(check == StatusCode::EndRun) {
+                // If the returned status code asks for end-of-run, finish module list and finish:
+                run = false;
+            }
+
+            // Skip the remaining modules for events outside of the partition processed by this process
+            position = partition_position(clipboard);
+            if(position != Event::Position::DURING) {
+                submit = false;
+                break;
+            }
+        }
+
+        // Events before the partition are skipped, the end of the partition stops the run
+        if(position != Event::Position::DURING) {
+            partition_skipped_++;
+            run = run && (position == Event::Position::BEFORE);
+        }
+
+        // Increment event number
+        m_events++;
+
+        // Keep the event definition, the clipboard is cleared by the worker thread
+        if(clipboard->isEventDefined()) {
+            event = clipboard->getEvent();
+        }
+
+        // Hand the event over to the worker threads
+        if(submit) {
+            thread_pool.submit(process_event, clipboard, event_id++, concurrent_modules.cbegin(), false);
+        } else {
+            release_clipboard(std::move(clipboard));
+        }
+
+        if(m_events % print_frequency == 0) {
+            print_progress(event);
+        }
+
+        // Check if we have reached the maximum number of events
+        if(number_of_events > -1 && m_events >= number_of_events) {
+            break;
+        }
+
+        if(event != nullptr && run_time > 0.0 && event->start() >= run_time) {
+            break;
+        }
+
+        // Check if we have reached the maximum number of tracks
+        if(number_of_tracks > -1 && m_tracks >= number_of_tracks) {
+            break;
+        }
+
+        // Check if any of the modules return a value saying it should stop
+        if(!run || end_run) {
+            break;
+        }
+
+        // Check for user termination and stop the event loop:
+        if(m_terminate) {
+            break;
+        }
+    }
+
+    // Wait for all submitted events to be processed
+    LOG(STATUS) << "Waiting for " << thread_pool.queueSize() << " queued events to finish processing";
+    thread_pool.wait();
+    thread_pool.checkException();
+    thread_pool.destroy();
+
+    // Print final statistics including all events completed after the end of the event loop
+    print_progress(event);
+}
+
+Event::Position ModuleManager::partition_position(const std::shared_ptr<Clipboard>& clipboard) const {
+    if(partition_ < 0 || !clipboard->isEventDefined()) {
+        return Event::Position::DURING;
+    }
+
+    auto value = (partition_by_time_ ? clipboard->getEvent()->start() : static_cast<double>(m_events));
+    if(value < partition_begin_) {
+        return Event::Position::BEFORE;
+    } else if(value >= partition_end_) {
+        return Event::Position::AFTER;
+    }
+    return Event::Position::DURING;
+}
+
+std::filesystem::path ModuleManager::partition_path(const std::filesystem::path& histogram_file,
+                                                    unsigned int partition,
+                                                    const std::string& extension) {
+    return histogram_file.parent_path() /
+           (histogram_file.stem().string() + "_partition" + std::to_string(partition) + "." + extension);
+}
+
+/**
+ * Path of the running executable, used to start the processes for the individual partitions with the same build
+ */
+static std::string executable_path() {
+#ifdef __APPLE__
+    char buffer[PATH_MAX];
+    uint32_t size = sizeof(buffer);
+    if(_NSGetExecutablePath(buffer, &size) == 0) {
+        return std::string(buffer);
+    }
+#else
+    std::error_code error;
+    auto path = std::filesystem::read_symlink("/proc/self/exe", error);
+    if(!error) {
+        return path.string();
+    }
+#endif
+    // Fall back to searching the executable in the PATH
+    return "corry";
+}
+
+/**
+ * Every partition is processed by a separate instance of the executable, started with the command line arguments of this
+ * process and the index of the partition as additional option. The output of each instance is redirected to a log file
+ * next to the main ROOT file. This process waits for all instances to complete, their results are merged when finalizing.
+ */
+void ModuleManager::run_partitions() {
+    Configuration& global_config = conf_manager_->getGlobalConfiguration();
+    auto histogram_file = global_config.getPath("histogram_file");
+    auto executable = executable_path();
+
+    std::vector<pid_t> processes;
+    std::string spawn_error;
+    for(unsigned int partition = 0; partition < partitions_; partition++) {
+        std::vector<std::string> arguments{executable};
+        arguments.insert(arguments.end(), worker_arguments_.begin(), worker_arguments_.end());
+        arguments.emplace_back("-o");
+        arguments.emplace_back("partition=" + std::to_string(partition));
+
+        std::vector<char*> argv;
+        for(auto& argument : arguments) {
+            argv.push_back(argument.data());
+        }
+        argv.push_back(nullptr);
+
+        // Redirect all output of the process to its log file
+        auto log_path = partition_path(histogram_file, partition, "log").string();
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, log_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        posix_spawn_file_actions_adddup2(&actions, STDOUT_FILENO, STDERR_FILENO);
+
+        pid_t pid = 0;
+        auto error = posix_spawnp(&pid, executable.c_str(), &actions, nullptr, argv.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        if(error != 0) {
+            spawn_error = "Cannot start process for partition " + std::to_string(partition) + ": " + std::strerror(error);
+            break;
+        }
+
+        LOG(INFO) << "Started process " << pid << " for partition " << partition << ", writing log to " << log_path;
+        processes.push_back(pid);
+    }
+
+    // Wait for all started processes, also if not all of them could be started
+    std::vector<unsigned int> failed;
+    for(unsigned int partition = 0; partition < processes.size(); partition++) {
+        int status = 0;
+        while(waitpid(processes[partition], &status, 0) < 0) {
+            if(errno != EINTR) {
+                status = -1;
+                break;
+            }
+        }
+        if(WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+            LOG(STATUS) << "Partition " << partition << " completed";
+        } else {
+            LOG(ERROR) << "Partition " << partition << " failed, see "
+                       << partition_path(histogram_file, partition, "log").string() << " for details";
+            failed.push_back(partition);
+        }
+    }
+
+    if(!spawn_error.empty()) {
+        throw RuntimeError(spawn_error);
+    }
+    if(!failed.empty()) {
+        throw RuntimeError("Processing failed for " + std::to_string(failed.size()) + " of " +
+                           std::to_string(partitions_) + " partitions");
+    }
+}
+
 void ModuleManager::terminate() {
     m_terminate = true;
 }
@@ -683,6 +1152,9 @@ void ModuleManager::initializeAll() {
         module->getROOTDirectory()->cd();
 
         LOG_PROGRESS(STATUS, "MOD_INIT_LOOP") << "Initializing \"" << module->getUniqueName() << "\"";
+        // Register the module for timing, the map is not altered during the event loop
+        module->set_profiling(profiling_);
+        module_execution_time_[module.get()] = module->create_execution_timer();
         // Initialize the module
         module->initialize();
 
@@ -696,6 +1168,15 @@ void ModuleManager::initializeAll() {
 void ModuleManager::finalizeAll() {
     Configuration& global_config = conf_manager_->getGlobalConfiguration();
 
+    // The processes of individual partitions only store their results, which are finalized by the driving process
+    if(partition_ >= 0) {
+        write_partition();
+        return;
+    }
+    if(partitions_ > 1) {
+        merge_partitions();
+    }
+
     // Create read-only version of permanent storage element from event clipboard:
     auto readonly_clipboard = std::static_pointer_cast<ReadonlyClipboard>(m_clipboard);
 
@@ -712,6 +1193,9 @@ void ModuleManager::finalizeAll() {
         // Change to our ROOT directory
         module->getROOTDirectory()->cd();
 
+        // Combine the histograms filled by the individual threads
+        module->merge_histograms();
+
         // Finalise the module
         module->finalize(readonly_clipboard);
 
@@ -787,6 +1271,243 @@ void ModuleManager::finalizeAll() {
 
     // Check the timing for all events
     timing();
+
+    // Write the machine-readable timing summary
+    if(global_config.has("profiling_file")) {
+        write_profile(global_config.getPath("profiling_file"));
+    }
+}
+
+/**
+ * Persistent objects are stored in one tree per type, with one branch per key and a single entry holding all objects. The
+ * histograms are written to the module directories as usual. Only the events of this partition are counted.
+ */
+void ModuleManager::write_partition() {
+    LOG(STATUS) << "===================| Writing partition |====================";
+    m_events -= partition_skipped_;
+
+    for(auto& module : m_modules) {
+        // Combine the histograms filled by the individual threads
+        module->merge_histograms();
+
+        // Store all ROOT objects:
+        module->getROOTDirectory()->Write();
+        module->set_ROOT_directory(nullptr);
+    }
+
+    auto* directory = m_histogramFile->mkdir("partition");
+    if(directory == nullptr) {
+        throw RuntimeError("Cannot create partition directory in " + std::string(m_histogramFile->GetName()));
+    }
+    directory->cd();
+
+    {
+        // Acquire ROOT TProcessID resource lock and reset PIDs:
+        auto root_lock = root_process_lock();
+
+        // Store the history of all objects before writing, references may point to objects of other trees
+        std::list<std::vector<Object*>> branch_objects;
+        std::list<std::vector<Object*>*> branch_addresses;
+        std::vector<TTree*> trees;
+        for(auto& type : *m_clipboard->persistent_data_) {
+            auto type_name = corryvreckan::demangle(type.first.name());
+            auto* tree = new TTree(type_name.c_str(), ("Persistent " + type_name + " objects").c_str());
+            for(auto& block : type.second) {
+                auto& objects = branch_objects.emplace_back();
+                for(auto& object : *std::static_pointer_cast<ObjectVector>(block.second)) {
+                    object->petrifyHistory();
+                    objects.push_back(object.get());
+                }
+                branch_addresses.push_back(&objects);
+                tree->Bronch(block.first.empty() ? "global" : block.first.c_str(),
+                             "std::vector<corryvreckan::Object*>",
+                             &branch_addresses.back());
+                LOG(DEBUG) << "Storing " << objects.size() << " persistent " << type_name << " objects with key \""
+                           << block.first << "\"";
+            }
+            trees.push_back(tree);
+        }
+        for(auto* tree : trees) {
+            tree->Fill();
+        }
+
+        TParameter<int>("events", m_events).Write();
+        TParameter<int>("tracks", m_tracks).Write();
+        TParameter<int>("pixels", m_pixels).Write();
+        directory->Write();
+    }
+
+    m_histogramFile->Close();
+    LOG(STATUS) << "Wrote output file of partition " << partition_ << " with " << m_events << " events to "
+                << conf_manager_->getGlobalConfiguration().getPath("histogram_file");
+
+    // Check the timing for all events of this partition
+    timing();
+}
+
+/**
+ * Add all objects of a directory in the output file of a partition to the corresponding directory of the main ROOT file.
+ * Objects which can be merged, such as histograms, are added to the existing object of the same name, other objects are
+ * only stored if no such object exists yet.
+ */
+static void merge_directory(TDirectory* source, TDirectory* target, const std::string& exclude = "") {
+    std::set<std::string> names;
+    TIter next(source->GetListOfKeys());
+    while(auto* key = static_cast<TKey*>(next())) {
+        // Only the latest cycle of every key is taken into account
+        std::string name = key->GetName();
+        if(name == exclude || !names.insert(name).second) {
+            continue;
+        }
+        key = source->GetKey(name.c_str());
+
+        auto* object_class = TClass::GetClass(key->GetClassName());
+        if(object_class != nullptr && object_class->InheritsFrom(TDirectory::Class())) {
+            auto* target_directory = target->GetDirectory(name.c_str());
+            if(target_directory == nullptr) {
+                target_directory = target->mkdir(name.c_str());
+            }
+            merge_directory(source->GetDirectory(name.c_str()), target_directory);
+            continue;
+        }
+
+        auto* object = key->ReadObj();
+        auto* histogram = dynamic_cast<TH1*>(object);
+        auto* existing = target->FindObject(name.c_str());
+        if(existing == nullptr) {
+            // Keep the object in the directory to be written to the main ROOT file
+            if(histogram != nullptr) {
+                histogram->SetDirectory(target);
+            } else {
+                target->Append(object);
+            }
+            continue;
+        }
+
+        auto merge = existing->IsA()->GetMerge();
+        if(merge != nullptr) {
+            TList list;
+            list.Add(object);
+            merge(existing, &list, nullptr);
+        } else {
+            LOG(DEBUG) << "Cannot merge object " << name << " of class " << key->GetClassName() << ", keeping first one";
+        }
+        if(histogram != nullptr) {
+            histogram->SetDirectory(nullptr);
+        }
+        delete object;
+    }
+}
+
+using PersistentCreatorMap = std::map<std::string, std::function<void(Clipboard&, std::vector<Object*>&, std::string)>>;
+
+/**
+ * Adds lambda function to take ownership of objects read from a partition file and store them as persistent data with
+ * their base type, under which they were stored on the clipboard of the partition
+ */
+template <typename T> static void add_persistent_creator(PersistentCreatorMap& map) {
+    map[corryvreckan::demangle(typeid(T).name())] =
+        [](Clipboard& clipboard, std::vector<Object*>& objects, std::string key) {
+            std::vector<std::shared_ptr<T>> data;
+            data.reserve(objects.size());
+            for(auto* object : objects) {
+                data.emplace_back(static_cast<T*>(object));
+            }
+            clipboard.putPersistentData(std::move(data), key);
+        };
+}
+
+void ModuleManager::merge_partitions() {
+    LOG(STATUS) << "===================| Merging partitions |===================";
+    auto histogram_file = conf_manager_->getGlobalConfiguration().getPath("histogram_file");
+
+    // Merge the partitions into the histograms of this process, which have never been filled
+    for(auto& module : m_modules) {
+        module->merge_histograms();
+    }
+
+    PersistentCreatorMap creators;
+    add_persistent_creator<Cluster>(creators);
+    add_persistent_creator<MCParticle>(creators);
+    add_persistent_creator<Pixel>(creators);
+    add_persistent_creator<SpidrSignal>(creators);
+    add_persistent_creator<Track>(creators);
+    add_persistent_creator<Waveform>(creators);
+
+    for(unsigned int partition = 0; partition < partitions_; partition++) {
+        auto path = partition_path(histogram_file, partition, "root").string();
+        std::unique_ptr<TFile> file(TFile::Open(path.c_str(), "READ"));
+        if(file == nullptr || file->IsZombie()) {
+            throw RuntimeError("Cannot open output file " + path + " of partition " + std::to_string(partition));
+        }
+        auto* directory = file->GetDirectory("partition");
+        if(directory == nullptr) {
+            throw RuntimeError("Output file " + path + " does not contain the results of partition " +
+                               std::to_string(partition));
+        }
+        LOG_PROGRESS(STATUS, "MERGE_LOOP") << "Merging partition " << partition << " from " << path;
+
+        // Add the histograms of all modules
+        merge_directory(file.get(), m_histogramFile.get(), "partition");
+
+        // Add the event counters
+        for(auto& counter : {std::make_pair("events", &m_events),
+                             std::make_pair("tracks", &m_tracks),
+                             std::make_pair("pixels", &m_pixels)}) {
+            std::unique_ptr<TParameter<int>> parameter(dynamic_cast<TParameter<int>*>(directory->Get(counter.first)));
+            if(parameter != nullptr) {
+                *counter.second += parameter->GetVal();
+            }
+        }
+
+        // Acquire ROOT TProcessID resource lock and reset PIDs:
+        auto root_lock = root_process_lock();
+
+        // Read all persistent objects before resolving their history, which may refer to objects of other trees
+        std::list<std::pair<std::string, std::vector<Object*>*>> blocks;
+        std::list<PersistentCreatorMap::mapped_type*> block_creators;
+        TIter next(directory->GetListOfKeys());
+        while(auto* key = static_cast<TKey*>(next())) {
+            if(std::string(key->GetClassName()) != "TTree") {
+                continue;
+            }
+            auto* tree = static_cast<TTree*>(key->ReadObj());
+            auto creator = creators.find(tree->GetName());
+            if(creator == creators.end()) {
+                LOG(WARNING) << "Cannot store persistent objects of type " << tree->GetName() << " from partition "
+                             << partition;
+                continue;
+            }
+
+            TIter next_branch(tree->GetListOfBranches());
+            while(auto* branch = static_cast<TBranch*>(next_branch())) {
+                std::string key_name = branch->GetName();
+                blocks.emplace_back(key_name == "global" ? "" : key_name, new std::vector<Object*>());
+                block_creators.push_back(&creator->second);
+                tree->SetBranchAddress(branch->GetName(), &blocks.back().second);
+            }
+            tree->GetEntry(0);
+        }
+
+        // Resolve the history and hand the objects over to the persistent storage of this process
+        for(auto& block : blocks) {
+            for(auto* object : *block.second) {
+                object->loadHistory();
+            }
+        }
+        auto creator = block_creators.begin();
+        for(auto& block : blocks) {
+            for(auto* object : *block.second) {
+                object->ResetBit(kIsReferenced);
+            }
+            LOG(DEBUG) << "Adding " << block.second->size() << " persistent objects with key \"" << block.first << "\"";
+            (**creator++)(*m_clipboard, *block.second, block.first);
+            delete block.second;
+        }
+    }
+
+    LOG(STATUS) << "Merged " << partitions_ << " partitions with " << m_events << " events in total";
+    print_progress(nullptr);
 }
 
 // Display timing statistics for each module, over all events and per event
@@ -794,12 +1515,82 @@ void ModuleManager::timing() {
     LOG(STATUS) << "===============| Wall-clock timing (seconds) |================";
     for(auto& module : m_modules) {
         auto identifier = module->get_identifier().getIdentifier();
+        auto execution_time = module_execution_time_[module.get()]->getTotalTime();
         LOG(STATUS) << std::setw(20) << module->get_configuration().getName() << (identifier.empty() ? "   " : " : ")
-                    << std::setw(10) << identifier << "  --  " << std::fixed << std::setprecision(5)
-                    << module_execution_time_[module.get()] << "s = " << std::setprecision(6)
-                    << 1000 * module_execution_time_[module.get()] / m_events << "ms/evt";
+                    << std::setw(10) << identifier << "  --  " << std::fixed << std::setprecision(5) << execution_time
+                    << "s = " << std::setprecision(6) << 1000 * execution_time / m_events << "ms/evt";
+        for(auto& stage : module->stage_timers_) {
+            LOG(STATUS) << std::setw(36) << stage->getName() << "  --  " << std::fixed << std::setprecision(5)
+                        << stage->getTotalTime() << "s = " << std::setprecision(6)
+                        << 1000 * stage->getTotalTime() / m_events << "ms/evt";
+        }
     }
     LOG(STATUS) << "==============================================================";
+    LOG(STATUS) << "Peak resident memory: " << std::fixed << std::setprecision(1)
+                << static_cast<double>(peak_memory()) / 1024. << "MB";
+}
+
+long ModuleManager::peak_memory() {
+    struct rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    // Reported in bytes instead of kilobytes
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
+
+void ModuleManager::write_profile(const std::string& path) {
+    std::ofstream file(path);
+    if(!file) {
+        throw RuntimeError("Cannot create profiling summary file " + path);
+    }
+
+    bool json = (std::filesystem::path(path).extension() == ".json");
+    if(json) {
+        file << "{" << std::endl;
+        file << "  \"events\": " << m_events << "," << std::endl;
+        file << "  \"workers\": " << (multithreading_ ? workers_ : 0) << "," << std::endl;
+        file << "  \"peak_memory_kb\": " << peak_memory() << "," << std::endl;
+        file << "  \"modules\": [";
+    } else {
+        file << "module,stage,calls,total_s,ms_per_event" << std::endl;
+    }
+
+    file << std::setprecision(9);
+    bool first_module = true;
+    for(auto& module : m_modules) {
+        // Full module followed by all stages:
+        std::vector<std::shared_ptr<StageTimer>> timers{module_execution_time_[module.get()]};
+        timers.insert(timers.end(), module->stage_timers_.begin(), module->stage_timers_.end());
+
+        if(json) {
+            file << (first_module ? "" : ",") << std::endl;
+            file << "    {\"module\": \"" << module->getUniqueName() << "\", \"stages\": [";
+            first_module = false;
+        }
+        for(size_t i = 0; i < timers.size(); i++) {
+            const auto& timer = timers[i];
+            auto per_event = (m_events > 0 ? 1000 * timer->getTotalTime() / m_events : 0.);
+            if(json) {
+                file << (i == 0 ? "" : ",") << std::endl;
+                file << "      {\"stage\": \"" << timer->getName() << "\", \"calls\": " << timer->getCount()
+                     << ", \"total_s\": " << timer->getTotalTime() << ", \"ms_per_event\": " << per_event << "}";
+            } else {
+                file << module->getUniqueName() << "," << timer->getName() << "," << timer->getCount() << ","
+                     << timer->getTotalTime() << "," << per_event << std::endl;
+            }
+        }
+        if(json) {
+            file << std::endl << "    ]}";
+        }
+    }
+
+    if(json) {
+        file << std::endl << "  ]" << std::endl << "}" << std::endl;
+    }
+    LOG(STATUS) << "Wrote profiling summary to " << path;
 }
 
 // Helper functions to set the module specific log settings if necessary
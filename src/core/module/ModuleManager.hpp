@@ -9,8 +9,12 @@
 #ifndef CORRYVRECKAN_MODULE_MANAGER_H
 #define CORRYVRECKAN_MODULE_MANAGER_H
 
+#include <atomic>
+#include <filesystem>
 #include <fstream>
 #include <map>
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include <TBrowser.h>
@@ -22,6 +26,7 @@
 #include "core/config/ConfigManager.hpp"
 #include "core/detector/Detector.hpp"
 #include "core/detector/PixelDetector.hpp"
+#include "core/utils/ThreadPool.hpp"
 
 namespace corryvreckan {
 
@@ -33,6 +38,15 @@ namespace corryvreckan {
      * modules, each of which is initialised, run on each event and finalized. It does not define what an event is, merely
      * runs each module sequentially and passes the clipboard between them (erasing it at the end of each run sequence). When
      * an module returns a Failure code, the event processing will stop.
+     *
+     * If multithreading is enabled, the leading modules which do not support concurrent processing (such as event loaders
+     * and the event-defining module) are executed on the main thread. The remaining modules are executed for multiple events
+     * in parallel by a pool of worker threads, each event with its own clipboard. Modules without multithreading support
+     * placed after the first concurrent module are guaranteed to process the events in the order they were defined.
+     *
+     * Large runs can furthermore be split into partitions of their run time or event range. The manager then acts as driver
+     * which starts a separate process for every partition, merges the histograms, persistent clipboard data and event
+     * counters written by these processes and finally finalizes all modules on the combined result.
      */
     class ModuleManager {
         using ModuleList = std::list<std::shared_ptr<Module>>;
@@ -66,6 +80,12 @@ namespace corryvreckan {
         // Member functions
         void load(ConfigManager* conf_mgr);
 
+        /**
+         * @brief Set the command line arguments used to start the processes of individual partitions of the run
+         * @param arguments Arguments reproducing the configuration of this process, excluding the executable
+         */
+        void setWorkerArguments(std::vector<std::string> arguments);
+
         void run();
         void initializeAll();
         void finalizeAll();
@@ -81,6 +101,75 @@ namespace corryvreckan {
     private:
         void timing();
 
+        /**
+         * @brief Get the peak resident memory of the process
+         * @return Maximum resident set size in kilobytes
+         */
+        static long peak_memory();
+
+        /**
+         * @brief Write the execution times of all modules and their stages to a file
+         * @param path Path of the file, written in JSON format if the extension is .json and as CSV otherwise
+         */
+        void write_profile(const std::string& path);
+
+        /**
+         * @brief Run a single module on the given clipboard and record its execution time
+         * @param module Module to execute
+         * @param clipboard Clipboard of the event to be processed
+         * @return Status code returned by the module
+         */
+        StatusCode run_module(const std::shared_ptr<Module>& module, const std::shared_ptr<Clipboard>& clipboard);
+
+        /**
+         * @brief Print the event loop progress to the terminal
+         * @param event Most recently defined event, nullptr if no event is defined
+         */
+        void print_progress(const std::shared_ptr<Event>& event);
+
+        /**
+         * @brief Run the event loop with concurrent processing of independent events
+         * @param number_of_events Maximum number of events to process or -1 for no limit
+         * @param number_of_tracks Maximum number of tracks to reconstruct or -1 for no limit
+         * @param print_frequency Number of events between two progress printouts
+         * @param run_time Time in the run after which the processing should stop, negative for no limit
+         */
+        void run_multithreaded(int number_of_events, int number_of_tracks, int print_frequency, double run_time);
+
+        /**
+         * @brief Position of the event currently on the clipboard with respect to the partition processed by this process
+         * @param clipboard Clipboard of the event
+         * @return DURING if the event belongs to the partition, no partition is processed or the event is not yet defined,
+         *         BEFORE or AFTER otherwise
+         */
+        Event::Position partition_position(const std::shared_ptr<Clipboard>& clipboard) const;
+
+        /**
+         * @brief Start a separate process for every partition of the run and wait for all of them to complete
+         */
+        void run_partitions();
+
+        /**
+         * @brief Write the histograms, the persistent clipboard data and the event counters of this partition to its file
+         */
+        void write_partition();
+
+        /**
+         * @brief Combine the output files of all partitions with the histograms and persistent data of this process
+         */
+        void merge_partitions();
+
+        /**
+         * @brief Get the path of an output file belonging to a single partition of the run
+         * @param histogram_file Path of the main ROOT file of the run
+         * @param partition Index of the partition
+         * @param extension Extension of the file
+         * @return Path of the file in the directory of the main ROOT file, named after it and the partition
+         */
+        static std::filesystem::path partition_path(const std::filesystem::path& histogram_file,
+                                                    unsigned int partition,
+                                                    const std::string& extension);
+
         void load_detectors();
         void load_modules();
 
@@ -99,9 +188,26 @@ namespace corryvreckan {
         std::ofstream log_file_;
 
         std::unique_ptr<TFile> m_histogramFile;
-        int m_events;
-        int m_tracks;
-        int m_pixels;
+        std::atomic<int> m_events;
+        std::atomic<int> m_tracks;
+        std::atomic<int> m_pixels;
+
+        // Concurrent processing of events
+        bool multithreading_{false};
+        unsigned int workers_{1};
+        unsigned int buffer_per_worker_{256};
+
+        // Creation of execution time histograms
+        bool profiling_{false};
+
+        // Partitioning of the run into separate processes
+        unsigned int partitions_{1};
+        int partition_{-1};
+        bool partition_by_time_{false};
+        double partition_begin_{0};
+        double partition_end_{0};
+        std::atomic<int> partition_skipped_{0};
+        std::vector<std::string> worker_arguments_;
 
         /**
          * @brief Create unique modules
@@ -136,7 +242,7 @@ namespace corryvreckan {
         std::tuple<LogLevel, LogFormat> set_module_before(const std::string&, const Configuration& config);
         void set_module_after(std::tuple<LogLevel, LogFormat> prev);
 
-        std::map<Module*, long double> module_execution_time_;
+        std::map<Module*, std::shared_ptr<StageTimer>> module_execution_time_;
     };
 } // namespace corryvreckan
 
@@ -0,0 +1,169 @@
+/**
+ * @file
+ * @brief Pooled allocation of objects which are created and destroyed for every event
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_OBJECT_POOL_H
+#define CORRYVRECKAN_OBJECT_POOL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace corryvreckan {
+
+    /**
+     * @brief Pool of memory chunks of fixed size and alignment
+     *
+     * Released chunks are kept in a cache of the releasing thread and handed out again on the next allocation instead of
+     * being returned to the system. Since objects are frequently created on one thread and released on another, e.g. when
+     * event loaders run on the main thread and the event is processed by a worker, the thread caches exchange batches of
+     * chunks via a shared reserve. The memory held by the pool therefore corresponds to the peak number of objects alive
+     * at any time, it is not returned to the system before the end of the program.
+     */
+    template <std::size_t Size, std::size_t Alignment> class MemoryPool {
+    public:
+        /**
+         * @brief Obtain a chunk from the pool, allocating a new one if none is available
+         * @return Pointer to uninitialized memory of the pool chunk size
+         */
+        static void* allocate() {
+            if(!cache_destroyed_) {
+                auto& chunks = local_cache().chunks;
+                if(chunks.empty()) {
+                    reserve().take(chunks);
+                }
+                if(!chunks.empty()) {
+                    void* chunk = chunks.back();
+                    chunks.pop_back();
+                    return chunk;
+                }
+            }
+            return new_chunk();
+        }
+
+        /**
+         * @brief Return a chunk to the pool
+         * @param chunk Pointer to memory obtained from \ref allocate
+         */
+        static void deallocate(void* chunk) noexcept {
+            if(cache_destroyed_) {
+                reserve().give(&chunk, 1);
+                return;
+            }
+            auto& chunks = local_cache().chunks;
+            chunks.push_back(chunk);
+            if(chunks.size() >= 2 * batch_size) {
+                reserve().give(chunks.data() + chunks.size() - batch_size, batch_size);
+                chunks.resize(chunks.size() - batch_size);
+            }
+        }
+
+    private:
+        // Number of chunks exchanged with the shared reserve at once
+        static constexpr std::size_t batch_size = 256;
+
+        static void* new_chunk() {
+            if constexpr(Alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__) {
+                return ::operator new(Size, std::align_val_t(Alignment));
+            } else {
+                return ::operator new(Size);
+            }
+        }
+
+        /**
+         * @brief Chunks available to all threads, protected by a mutex
+         */
+        struct Reserve {
+            void take(std::vector<void*>& chunks) {
+                std::lock_guard<std::mutex> lock(mutex);
+                auto count = std::min(batch_size, available.size());
+                chunks.insert(chunks.end(), available.end() - static_cast<std::ptrdiff_t>(count), available.end());
+                available.resize(available.size() - count);
+            }
+            void give(void* const* chunks, std::size_t count) {
+                std::lock_guard<std::mutex> lock(mutex);
+                available.insert(available.end(), chunks, chunks + count);
+            }
+
+            std::mutex mutex;
+            std::vector<void*> available;
+        };
+
+        /**
+         * @brief Chunks cached by a single thread, handed to the shared reserve when the thread ends
+         */
+        struct Cache {
+            ~Cache() {
+                cache_destroyed_ = true;
+                reserve().give(chunks.data(), chunks.size());
+            }
+            std::vector<void*> chunks;
+        };
+
+        // The reserve is never destroyed since objects might still be released during static destruction
+        static Reserve& reserve() {
+            static auto* reserve = new Reserve();
+            return *reserve;
+        }
+        static Cache& local_cache() {
+            static thread_local Cache cache;
+            return cache;
+        }
+        static inline thread_local bool cache_destroyed_{false};
+    };
+
+    /**
+     * @brief Allocator serving single objects from a \ref MemoryPool
+     *
+     * Used with std::allocate_shared, the object and the control block of the shared pointer are placed in one chunk of the
+     * pool, such that neither requires a call to the system allocator once the pool is filled.
+     */
+    template <typename T> class PoolAllocator {
+    public:
+        using value_type = T;
+
+        PoolAllocator() noexcept = default;
+        template <typename U> PoolAllocator(const PoolAllocator<U>&) noexcept {} // NOLINT
+
+        T* allocate(std::size_t n) {
+            if(n == 1) {
+                return static_cast<T*>(MemoryPool<sizeof(T), alignof(T)>::allocate());
+            }
+            return std::allocator<T>().allocate(n);
+        }
+        void deallocate(T* ptr, std::size_t n) noexcept {
+            if(n == 1) {
+                MemoryPool<sizeof(T), alignof(T)>::deallocate(ptr);
+            } else {
+                std::allocator<T>().deallocate(ptr, n);
+            }
+        }
+
+        template <typename U> bool operator==(const PoolAllocator<U>&) const noexcept { return true; }
+        template <typename U> bool operator!=(const PoolAllocator<U>&) const noexcept { return false; }
+    };
+
+    /**
+     * @brief Create an object in pooled memory, to be used instead of std::make_shared for objects created every event
+     * @param args Arguments passed to the constructor of the object
+     * @return Shared pointer to the new object
+     *
+     * The memory is recycled as soon as the last reference is dropped, usually when the clipboard is cleared at the end of
+     * the event, and reused for objects of the same type created in subsequent events.
+     */
+    template <typename T, typename... Args> std::shared_ptr<T> make_pooled(Args&&... args) {
+        return std::allocate_shared<T>(PoolAllocator<T>(), std::forward<Args>(args)...);
+    }
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_OBJECT_POOL_H
@@ -0,0 +1,164 @@
+/**
+ * @file
+ * @brief Dedicated thread reading input data ahead of its processing into a bounded queue
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_READ_AHEAD_THREAD_H
+#define CORRYVRECKAN_READ_AHEAD_THREAD_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "log.h"
+
+namespace corryvreckan {
+
+    /**
+     * @brief Thread calling a read function repeatedly and queueing its results in order, used to move the reading and
+     * decoding of input files off the processing of events
+     *
+     * Up to a maximum number of items are read ahead, the thread waits for the consumer when the queue is full. Reading
+     * ends when the read function returns false. An exception thrown by the read function ends the reading as well and is
+     * rethrown to the consumer once all items read before have been retrieved.
+     *
+     * @tparam T Type of the items read, items are reused to avoid allocations where the read function allows
+     */
+    template <typename T> class ReadAheadThread {
+    public:
+        /**
+         * @brief Start the reader thread with the log level and format of the calling thread
+         * @param read           Function filling the given item and returning false if no item is left to read
+         * @param max_queue_size Maximum number of items read ahead
+         */
+        ReadAheadThread(std::function<bool(T&)> read, size_t max_queue_size)
+            : read_(std::move(read)), max_queue_size_(std::max<size_t>(max_queue_size, 1)) {
+            auto log_level = Log::getReportingLevel();
+            auto log_format = Log::getFormat();
+            thread_ = std::thread([this, log_level, log_format]() {
+                Log::setReportingLevel(log_level);
+                Log::setFormat(log_format);
+                work();
+            });
+        }
+
+        /**
+         * @brief Stop reading and wait for the thread to finish
+         */
+        ~ReadAheadThread() { stop(); }
+
+        /// @{
+        /**
+         * @brief Read-ahead threads can neither be copied nor moved
+         */
+        ReadAheadThread(const ReadAheadThread&) = delete;
+        ReadAheadThread& operator=(const ReadAheadThread&) = delete;
+        ReadAheadThread(ReadAheadThread&&) = delete;
+        ReadAheadThread& operator=(ReadAheadThread&&) = delete;
+        /// @}
+
+        /**
+         * @brief Retrieve the next item, waiting for it to be read if necessary
+         * @param item Item to fill, the previous content is handed back to the reader for reuse
+         * @return True if an item has been retrieved, false if all items have been read
+         *
+         * Rethrows the exception of the read function after all items read before it have been retrieved.
+         */
+        bool next(T& item) {
+            std::unique_lock<std::mutex> lock{mutex_};
+            item_condition_.wait(lock, [this]() { return !items_.empty() || finished_; });
+            if(items_.empty()) {
+                if(exception_ != nullptr) {
+                    std::rethrow_exception(std::exchange(exception_, nullptr));
+                }
+                return false;
+            }
+
+            std::swap(item, items_.front());
+            spare_.push_back(std::move(items_.front()));
+            items_.pop_front();
+            lock.unlock();
+            space_condition_.notify_one();
+            return true;
+        }
+
+        /**
+         * @brief Stop reading and wait for the thread to finish, items not yet retrieved are discarded
+         */
+        void stop() {
+            if(!thread_.joinable()) {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock{mutex_};
+            stop_ = true;
+            lock.unlock();
+            space_condition_.notify_one();
+            thread_.join();
+        }
+
+    private:
+        void work() {
+            while(true) {
+                // Wait for space in the queue and take an item returned by the consumer for reuse if available
+                std::unique_lock<std::mutex> lock{mutex_};
+                space_condition_.wait(lock, [this]() { return stop_ || items_.size() < max_queue_size_; });
+                if(stop_) {
+                    return;
+                }
+                T item{};
+                if(!spare_.empty()) {
+                    item = std::move(spare_.back());
+                    spare_.pop_back();
+                }
+                lock.unlock();
+
+                bool success = false;
+                std::exception_ptr exception;
+                try {
+                    success = read_(item);
+                } catch(...) {
+                    exception = std::current_exception();
+                }
+
+                lock.lock();
+                if(success) {
+                    items_.push_back(std::move(item));
+                } else {
+                    exception_ = exception;
+                    finished_ = true;
+                }
+                lock.unlock();
+                item_condition_.notify_one();
+                if(!success) {
+                    return;
+                }
+            }
+        }
+
+        std::function<bool(T&)> read_;
+        size_t max_queue_size_;
+        std::thread thread_;
+
+        std::mutex mutex_;
+        std::condition_variable item_condition_;
+        std::condition_variable space_condition_;
+        std::deque<T> items_;
+        std::deque<T> spare_;
+        std::exception_ptr exception_;
+        bool finished_{};
+        bool stop_{};
+    };
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_READ_AHEAD_THREAD_H
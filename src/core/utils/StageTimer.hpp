@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @brief Definition of timers measuring the execution time of processing stages
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_STAGE_TIMER_H
+#define CORRYVRECKAN_STAGE_TIMER_H
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <TH1D.h>
+
+#include "ThreadedHistogram.hpp"
+
+namespace corryvreckan {
+
+    /**
+     * @brief Timer accumulating the execution time of one processing stage over all events
+     *
+     * The time is measured by \ref Scope objects obtained from \ref measure, which add the time passed between their
+     * creation and destruction, or an explicit call to Scope::stop(), to the timer. Timers can be used from concurrently
+     * processed events without locking. If a histogram is attached, the duration of every measurement is filled in addition.
+     */
+    class StageTimer {
+    public:
+        /**
+         * @brief Measurement of a single execution of the stage, ending when the object goes out of scope
+         */
+        class Scope {
+        public:
+            explicit Scope(StageTimer* timer) : timer_(timer), start_(std::chrono::steady_clock::now()) {}
+            ~Scope() { stop(); }
+
+            /**
+             * @brief End the measurement before the object goes out of scope. Subsequent calls have no effect.
+             */
+            void stop() {
+                if(timer_ != nullptr) {
+                    timer_->add(std::chrono::steady_clock::now() - start_);
+                    timer_ = nullptr;
+                }
+            }
+
+            /// @{
+            /**
+             * @brief Measurements can neither be copied nor moved
+             */
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+            Scope(Scope&&) = delete;
+            Scope& operator=(Scope&&) = delete;
+            /// @}
+
+        private:
+            StageTimer* timer_;
+            std::chrono::steady_clock::time_point start_;
+        };
+
+        /**
+         * @brief Construct a timer
+         * @param name      Name of the measured stage
+         * @param histogram Histogram to fill with the duration of every measurement in milliseconds, or nullptr
+         */
+        explicit StageTimer(std::string name, Histogram<TH1D> histogram = nullptr)
+            : name_(std::move(name)), histogram_(std::move(histogram)) {}
+
+        /**
+         * @brief Start a measurement
+         * @return Measurement adding to this timer when it goes out of scope
+         */
+        Scope measure() { return Scope(this); }
+
+        /**
+         * @brief Add the duration of one execution of the stage
+         * @param duration Measured duration
+         */
+        void add(std::chrono::steady_clock::duration duration) {
+            auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+            total_.fetch_add(static_cast<int64_t>(nanoseconds), std::memory_order_relaxed);
+            count_.fetch_add(1, std::memory_order_relaxed);
+            if(histogram_ != nullptr) {
+                histogram_->Fill(static_cast<double>(nanoseconds) * 1e-6);
+            }
+        }
+
+        /**
+         * @brief Get the name of the measured stage
+         * @return Name of the stage
+         */
+        const std::string& getName() const { return name_; }
+
+        /**
+         * @brief Get the accumulated execution time of all measurements
+         * @return Total time in seconds
+         */
+        double getTotalTime() const { return static_cast<double>(total_.load(std::memory_order_relaxed)) * 1e-9; }
+
+        /**
+         * @brief Get the number of measurements
+         * @return Number of executions of the stage
+         */
+        uint64_t getCount() const { return count_.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Bin edges for execution time histograms, logarithmically spaced from 1ns to 100s in milliseconds
+         * @return Vector with the lower bin edges and the upper edge of the last bin
+         */
+        static std::vector<double> getHistogramBins() {
+            std::vector<double> edges;
+            for(int i = 0; i <= 220; i++) {
+                edges.push_back(std::pow(10., -6. + static_cast<double>(i) / 20.));
+            }
+            return edges;
+        }
+
+    private:
+        std::string name_;
+        std::atomic<int64_t> total_{0};
+        std::atomic<uint64_t> count_{0};
+        Histogram<TH1D> histogram_;
+    };
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_STAGE_TIMER_H
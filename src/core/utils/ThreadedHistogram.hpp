@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @brief Definition of histograms which can be filled concurrently from multiple threads
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_THREADED_HISTOGRAM_H
+#define CORRYVRECKAN_THREADED_HISTOGRAM_H
+
+#include <memory>
+#include <mutex>
+#include <utility>
+
+#include <ROOT/TThreadedObject.hxx>
+#include <TDirectory.h>
+
+namespace corryvreckan {
+
+    /**
+     * @brief Common interface of all thread-local histograms, used by the framework to merge them
+     */
+    class ThreadedHistogramInterface {
+    public:
+        /**
+         * @brief Required virtual destructor
+         */
+        virtual ~ThreadedHistogramInterface() = default;
+
+        /**
+         * @brief Merge all thread-local copies into one histogram attached to the directory of creation
+         */
+        virtual void merge() = 0;
+    };
+
+    /**
+     * @brief Histogram holding either a single ROOT histogram or one independent copy per thread
+     *
+     * Without threading, this is a plain ROOT histogram attached to the ROOT directory active at creation, identical to
+     * histograms created directly by the module. With threading, all filling operations are forwarded to the copy owned by
+     * the calling thread, such that modules processing events concurrently do not need any locking. The framework merges
+     * all copies into a single histogram before the module is finalized. The merged histogram is attached to the ROOT
+     * directory which was active when this object was created and is written to the output file together with all other
+     * objects of the module. Histograms with a large number of bins can instead be shared by all threads, in which case
+     * every filling operation is protected by a lock.
+     */
+    template <typename T> class ThreadedHistogram : public ThreadedHistogramInterface {
+    public:
+        /**
+         * @brief Tag selecting a single histogram shared by all threads
+         */
+        struct Shared {};
+
+        /**
+         * @brief Construct the histogram, or the model from which the thread-local copies are cloned
+         * @param threaded True if the histogram is filled concurrently and requires one copy per thread
+         * @param args Arguments passed to the constructor of the underlying ROOT histogram
+         */
+        template <typename... Args>
+        explicit ThreadedHistogram(bool threaded, Args&&... args) : directory_(gDirectory) {
+            if(threaded) {
+                threaded_ = std::make_unique<ROOT::TThreadedObject<T>>(std::forward<Args>(args)...);
+            } else {
+                // The histogram is owned by the current ROOT directory
+                histogram_ = new T(std::forward<Args>(args)...);
+            }
+        }
+
+        /**
+         * @brief Construct a single histogram shared by all threads
+         * @param threaded True if the histogram is filled concurrently and filling has to be protected by a lock
+         * @param args Arguments passed to the constructor of the underlying ROOT histogram
+         */
+        template <typename... Args>
+        ThreadedHistogram(Shared, bool threaded, Args&&... args)
+            : directory_(gDirectory), histogram_(new T(std::forward<Args>(args)...)) {
+            if(threaded) {
+                mutex_ = std::make_unique<std::mutex>();
+            }
+        }
+
+        /**
+         * @brief Fill the histogram, or its copy of the calling thread
+         * @param args Arguments passed to the Fill method of the underlying ROOT histogram
+         * @return Return value of the underlying Fill method
+         */
+        template <typename... Args> auto Fill(Args&&... args) {
+            if(mutex_ != nullptr) {
+                std::lock_guard<std::mutex> lock(*mutex_);
+                return histogram_->Fill(std::forward<Args>(args)...);
+            }
+            if(histogram_ != nullptr) {
+                return histogram_->Fill(std::forward<Args>(args)...);
+            }
+            return threaded_->Get()->Fill(std::forward<Args>(args)...);
+        }
+
+        /**
+         * @brief Access the histogram
+         * @return The histogram if it is not threaded or merging already took place, the copy of the calling thread
+         * otherwise
+         * @warning Shared histograms are returned without holding the lock and must not be modified concurrently
+         */
+        T* get() { return histogram_ != nullptr ? histogram_ : threaded_->Get().get(); }
+
+        /**
+         * @brief Merge the thread-local copies. Subsequent calls and calls for histograms without threading have no effect.
+         */
+        void merge() override {
+            if(histogram_ != nullptr) {
+                return;
+            }
+            histogram_ = threaded_->SnapshotMerge().release();
+            histogram_->SetDirectory(directory_);
+        }
+
+    private:
+        TDirectory* directory_;
+        std::unique_ptr<ROOT::TThreadedObject<T>> threaded_;
+        T* histogram_{nullptr};
+        std::unique_ptr<std::mutex> mutex_;
+    };
+
+    /**
+     * @brief Handle to a histogram which can be filled from concurrently processed events
+     */
+    template <typename T> using Histogram = std::shared_ptr<ThreadedHistogram<T>>;
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_THREADED_HISTOGRAM_H
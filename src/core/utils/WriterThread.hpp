@@ -0,0 +1,207 @@
+/**
+ * @file
+ * @brief Dedicated thread executing write tasks handed over through a bounded queue
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_WRITER_THREAD_H
+#define CORRYVRECKAN_WRITER_THREAD_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "log.h"
+
+namespace corryvreckan {
+
+    /**
+     * @brief Thread executing tasks in order of their submission, used to move the writing of output data off the
+     * processing of events
+     *
+     * Tasks are queued up to a maximum number, further submissions block until the writer has caught up. The first
+     * exception thrown by a task stops the writer and is rethrown to the submitting thread on the next call to \ref submit
+     * or \ref finish. The depth of the queue and the time spent waiting for free space are recorded for statistics.
+     */
+    class WriterThread {
+    public:
+        /**
+         * @brief Start the writer thread with the log level and format of the calling thread
+         * @param max_queue_size Maximum number of tasks waiting to be executed
+         */
+        explicit WriterThread(size_t max_queue_size) : max_queue_size_(std::max<size_t>(max_queue_size, 1)) {
+            auto log_level = Log::getReportingLevel();
+            auto log_format = Log::getFormat();
+            thread_ = std::thread([this, log_level, log_format]() {
+                Log::setReportingLevel(log_level);
+                Log::setFormat(log_format);
+                work();
+            });
+        }
+
+        /**
+         * @brief Execute all remaining tasks and stop the thread, exceptions of tasks are discarded
+         */
+        ~WriterThread() {
+            try {
+                finish();
+            } catch(...) {
+                // Errors should have been reported by an explicit call to finish
+            }
+        }
+
+        /// @{
+        /**
+         * @brief Writer threads can neither be copied nor moved
+         */
+        WriterThread(const WriterThread&) = delete;
+        WriterThread& operator=(const WriterThread&) = delete;
+        WriterThread(WriterThread&&) = delete;
+        WriterThread& operator=(WriterThread&&) = delete;
+        /// @}
+
+        /**
+         * @brief Queue a task for execution, waiting for free space in the queue if necessary
+         * @param task Task to execute on the writer thread
+         */
+        void submit(std::function<void()> task) {
+            std::unique_lock<std::mutex> lock{mutex_};
+            if(tasks_.size() >= max_queue_size_ && exception_ == nullptr) {
+                auto start = std::chrono::steady_clock::now();
+                space_condition_.wait(lock, [this]() { return tasks_.size() < max_queue_size_ || exception_ != nullptr; });
+                stall_time_ += std::chrono::steady_clock::now() - start;
+                stall_count_++;
+            }
+            if(exception_ != nullptr) {
+                std::rethrow_exception(exception_);
+            }
+
+            tasks_.push_back(std::move(task));
+            depth_sum_ += tasks_.size();
+            depth_max_ = std::max(depth_max_, tasks_.size());
+            submit_count_++;
+            lock.unlock();
+            task_condition_.notify_one();
+        }
+
+        /**
+         * @brief Wait for all queued tasks to be executed and stop the thread
+         *
+         * Rethrows the exception of a failed task. Calls after the thread has been stopped have no effect.
+         */
+        void finish() {
+            if(!thread_.joinable()) {
+                return;
+            }
+
+            std::unique_lock<std::mutex> lock{mutex_};
+            stop_ = true;
+            lock.unlock();
+            task_condition_.notify_one();
+            thread_.join();
+
+            if(exception_ != nullptr) {
+                std::rethrow_exception(std::exchange(exception_, nullptr));
+            }
+        }
+
+        /**
+         * @brief Get the maximum number of tasks queued at once
+         * @return Maximum depth of the queue
+         */
+        size_t getMaxQueueDepth() const {
+            std::lock_guard<std::mutex> lock{mutex_};
+            return depth_max_;
+        }
+
+        /**
+         * @brief Get the mean number of tasks queued, sampled at every submission including the submitted task
+         * @return Mean depth of the queue
+         */
+        double getMeanQueueDepth() const {
+            std::lock_guard<std::mutex> lock{mutex_};
+            return submit_count_ == 0 ? 0. : static_cast<double>(depth_sum_) / static_cast<double>(submit_count_);
+        }
+
+        /**
+         * @brief Get the number of submissions which had to wait for free space in the queue
+         * @return Number of stalled submissions
+         */
+        uint64_t getStallCount() const {
+            std::lock_guard<std::mutex> lock{mutex_};
+            return stall_count_;
+        }
+
+        /**
+         * @brief Get the total time submissions waited for free space in the queue
+         * @return Stall time in seconds
+         */
+        double getStallTime() const {
+            std::lock_guard<std::mutex> lock{mutex_};
+            return std::chrono::duration<double>(stall_time_).count();
+        }
+
+    private:
+        void work() {
+            while(true) {
+                std::unique_lock<std::mutex> lock{mutex_};
+                task_condition_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+                if(tasks_.empty()) {
+                    return;
+                }
+                auto task = std::move(tasks_.front());
+                lock.unlock();
+
+                // The task is only removed from the queue after its execution, such that it counts towards the depth
+                std::exception_ptr exception;
+                try {
+                    task();
+                } catch(...) {
+                    exception = std::current_exception();
+                }
+
+                lock.lock();
+                tasks_.pop_front();
+                if(exception != nullptr) {
+                    exception_ = exception;
+                    tasks_.clear();
+                    lock.unlock();
+                    space_condition_.notify_all();
+                    return;
+                }
+                lock.unlock();
+                space_condition_.notify_all();
+            }
+        }
+
+        size_t max_queue_size_;
+        std::thread thread_;
+
+        mutable std::mutex mutex_;
+        std::condition_variable task_condition_;
+        std::condition_variable space_condition_;
+        std::deque<std::function<void()>> tasks_;
+        std::exception_ptr exception_;
+        bool stop_{};
+
+        // Statistics of the queue depth and the time spent waiting for the writer
+        uint64_t submit_count_{};
+        uint64_t depth_sum_{};
+        size_t depth_max_{};
+        uint64_t stall_count_{};
+        std::chrono::steady_clock::duration stall_time_{};
+    };
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_WRITER_THREAD_H
@@ -10,15 +10,20 @@
 
 #include "AlignmentDUTResidual.h"
 
+#include <Minuit2/Minuit2Minimizer.h>
 #include <TProfile.h>
 #include <TVirtualFitter.h>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace corryvreckan;
 
 // Global container declarations
 TrackVector AlignmentDUTResidual::globalTracks;
 std::shared_ptr<Detector> AlignmentDUTResidual::globalDetector;
 ThreadPool* AlignmentDUTResidual::thread_pool;
+size_t AlignmentDUTResidual::fcn_calls;
 
 AlignmentDUTResidual::AlignmentDUTResidual(Configuration& config, std::shared_ptr<Detector> detector)
     : Module(config, detector), m_detector(detector) {
@@ -32,10 +37,12 @@ AlignmentDUTResidual::AlignmentDUTResidual(Configuration& config, std::shared_pt
     config_.setDefault<size_t>("max_associated_clusters", 1);
     config_.setDefault<double>("max_track_chi2ndof", 10.);
     config_.setDefault<unsigned int>("workers", std::max(std::thread::hardware_concurrency() - 1, 1u));
+    config_.setDefault<bool>("analytic_gradient", false);
 
     m_workers = config.get<unsigned int>("workers");
     nIterations = config_.get<size_t>("iterations");
     m_pruneTracks = config_.get<bool>("prune_tracks");
+    m_analyticGradient = config_.get<bool>("analytic_gradient");
 
     m_alignPosition = config_.get<bool>("align_position");
     m_alignOrientation = config_.get<bool>("align_orientation");
@@ -227,110 +234,333 @@ void AlignmentDUTResidual::MinimiseResiduals(Int_t&, Double_t*, Double_t& result
 
     LOG_PROGRESS(INFO, "t") << "Refit of " << result_futures.size() << " track, MINUIT iteration " << fitIterations;
     fitIterations++;
+    AlignmentDUTResidual::fcn_calls++;
     AlignmentDUTResidual::thread_pool->wait();
 }
 
-void AlignmentDUTResidual::finalize(const std::shared_ptr<ReadonlyClipboard>& clipboard) {
+ResidualChi2::ResidualChi2(std::shared_ptr<Detector> detector,
+                           const ResidualData* data,
+                           ThreadPool* thread_pool,
+                           ResidualChi2Calls* calls)
+    : detector_(std::move(detector)), data_(data), thread_pool_(thread_pool), calls_(calls) {}
 
-    if(m_discardedtracks > 0) {
-        LOG(STATUS) << "Discarded " << m_discardedtracks << " input tracks.";
+double ResidualChi2::DoEval(const double* par) const {
+    calls_->value++;
+    evaluate(par);
+    return value_;
+}
+
+double ResidualChi2::DoDerivative(const double* par, unsigned int coordinate) const {
+    calls_->gradient++;
+    evaluate(par);
+    return gradient_.at(coordinate);
+}
+
+void ResidualChi2::Gradient(const double* par, double* grad) const {
+    calls_->gradient++;
+    evaluate(par);
+    std::copy(gradient_.begin(), gradient_.end(), grad);
+}
+
+void ResidualChi2::FdF(const double* par, double& value, double* grad) const {
+    calls_->value++;
+    calls_->gradient++;
+    evaluate(par);
+    value = value_;
+    std::copy(gradient_.begin(), gradient_.end(), grad);
+}
+
+/**
+ * The local intercept of a track with point p and direction d is l = a - a_z / b_z * b with a = Q (p - t) and b = Q d, where
+ * t is the detector displacement and Q the rotation from global to local coordinates. Its derivatives follow from the
+ * derivatives of a and b, which are -Q e_j for the displacement along axis j and Q' (p - t) and Q' d for a rotation angle
+ * with rotation derivative Q'. The loop over the clusters has no branches and operates on contiguous arrays, such that it
+ * can be vectorized by the compiler.
+ */
+static std::array<double, 7> evaluate_residuals(const ResidualData& data,
+                                                size_t begin,
+                                                size_t end,
+                                                const std::array<double, 3>& t,
+                                                const std::array<double, 9>& q,
+                                                const std::array<std::array<double, 9>, 3>& dq) {
+    double chi2 = 0.;
+    std::array<double, 6> grad{};
+
+    for(size_t i = begin; i < end; i++) {
+        const double wx = data.point_x[i] - t[0];
+        const double wy = data.point_y[i] - t[1];
+        const double wz = data.point_z[i] - t[2];
+        const double dx = data.direction_x[i];
+        const double dy = data.direction_y[i];
+        const double dz = data.direction_z[i];
+        const double f = data.projection[i];
+
+        const double ax = q[0] * wx + q[1] * wy + q[2] * wz;
+        const double ay = q[3] * wx + q[4] * wy + q[5] * wz;
+        const double az = q[6] * wx + q[7] * wy + q[8] * wz;
+        const double bx = q[0] * dx + q[1] * dy + q[2] * dz;
+        const double by = q[3] * dx + q[4] * dy + q[5] * dz;
+        const double bz = q[6] * dx + q[7] * dy + q[8] * dz;
+        const double r = az / bz;
+
+        // Weighted residuals in local coordinates
+        const double ex = ax - f * r * bx - data.cluster_x[i];
+        const double ey = ay - f * r * by - data.cluster_y[i];
+        const double gx = 2. * data.weight_x[i] * ex;
+        const double gy = 2. * data.weight_y[i] * ey;
+        chi2 += 0.5 * (gx * ex + gy * ey);
+
+        // Displacement along axis j, which does not change the direction in local coordinates
+        for(size_t j = 0; j < 3; j++) {
+            const double dr = -q[6 + j] / bz;
+            grad[j] += gx * (-q[j] - f * dr * bx) + gy * (-q[3 + j] - f * dr * by);
+        }
+
+        // Rotation angle k
+        for(size_t k = 0; k < 3; k++) {
+            const auto& m = dq[k];
+            const double dax = m[0] * wx + m[1] * wy + m[2] * wz;
+            const double day = m[3] * wx + m[4] * wy + m[5] * wz;
+            const double daz = m[6] * wx + m[7] * wy + m[8] * wz;
+            const double dbx = m[0] * dx + m[1] * dy + m[2] * dz;
+            const double dby = m[3] * dx + m[4] * dy + m[5] * dz;
+            const double dbz = m[6] * dx + m[7] * dy + m[8] * dz;
+            const double dr = (daz - r * dbz) / bz;
+            grad[3 + k] += gx * (dax - f * (dr * bx + r * dbx)) + gy * (day - f * (dr * by + r * dby));
+        }
     }
 
-    // Make the fitting object
-    TVirtualFitter* residualFitter = TVirtualFitter::Fitter(nullptr, 50);
-    residualFitter->SetFCN(MinimiseResiduals);
+    return {chi2, grad[0], grad[1], grad[2], grad[3], grad[4], grad[5]};
+}
 
-    // Set the global parameters
-    AlignmentDUTResidual::globalTracks = clipboard->getPersistentData<Track>(m_detector->getName());
+void ResidualChi2::evaluate(const double* par) const {
+    if(cached_ && std::equal(parameters_.begin(), parameters_.end(), par)) {
+        return;
+    }
 
-    // Create thread pool:
-    ThreadPool::registerThreadCount(m_workers);
-    AlignmentDUTResidual::thread_pool =
-        new ThreadPool(m_workers,
-                       m_workers * 1024,
-                       [log_level = corryvreckan::Log::getReportingLevel(), log_format = corryvreckan::Log::getFormat()]() {
-                           // clang-format on
-                           // Initialize the threads to the same log level and format as the master setting
-                           corryvreckan::Log::setReportingLevel(log_level);
-                           corryvreckan::Log::setFormat(log_format);
-                       });
-
-    // Set the printout arguments of the fitter
-    Double_t arglist[10];
-    arglist[0] = -1;
-    residualFitter->ExecuteCommand("SET PRINT", arglist, 1);
+    // Rotation from global to local coordinates for the given angles, as defined by the orientation mode of the detector
+    auto rotation = [this, par](const XYZVector& angles) {
+        detector_->displacement(XYZPoint(par[0], par[1], par[2]));
+        detector_->rotation(angles);
+        detector_->update();
+        std::array<double, 9> matrix{};
+        detector_->toLocal().Rotation().GetComponents(matrix.begin());
+        return matrix;
+    };
 
-    // Set some fitter parameters
-    arglist[0] = 1000;  // number of function calls
-    arglist[1] = 0.001; // tolerance
+    // Derivatives of the rotation with respect to the angles, from central differences of the rotation matrix only
+    const double step = 1e-6;
+    std::array<std::array<double, 9>, 3> dq{};
+    for(size_t k = 0; k < 3; k++) {
+        std::array<double, 3> angles_up{par[3], par[4], par[5]};
+        std::array<double, 3> angles_down{par[3], par[4], par[5]};
+        angles_up[k] += step;
+        angles_down[k] -= step;
+        auto up = rotation(XYZVector(angles_up[0], angles_up[1], angles_up[2]));
+        auto down = rotation(XYZVector(angles_down[0], angles_down[1], angles_down[2]));
+        for(size_t i = 0; i < 9; i++) {
+            dq[k][i] = (up[i] - down[i]) / (2. * step);
+        }
+    }
 
-    // Store the alignment shifts per detector:
-    std::vector<double> shiftsX;
-    std::vector<double> shiftsY;
-    std::vector<double> rotX;
-    std::vector<double> rotY;
-    std::vector<double> rotZ;
+    // Apply the new alignment conditions
+    auto q = rotation(XYZVector(par[3], par[4], par[5]));
+    std::array<double, 3> t{par[0], par[1], par[2]};
+    LOG(DEBUG) << "Updated parameters for " << detector_->getName();
+
+    // Evaluate the residuals in batches, summed in a fixed order for reproducible results
+    auto size = data_->size();
+    auto batch_size = std::max<size_t>(1024, size / (4 * std::max(ThreadPool::threadCount(), 1u)) + 1);
+    std::vector<std::shared_future<std::array<double, 7>>> result_futures;
+    for(size_t begin = 0; begin < size; begin += batch_size) {
+        auto end = std::min(begin + batch_size, size);
+        result_futures.push_back(thread_pool_->submit(
+            [this, begin, end, &t, &q, &dq]() { return evaluate_residuals(*data_, begin, end, t, q, dq); }));
+    }
+
+    value_ = 0.;
+    gradient_.fill(0.);
+    for(auto& result_future : result_futures) {
+        auto result = result_future.get();
+        value_ += result[0];
+        for(size_t i = 0; i < 6; i++) {
+            gradient_[i] += result[i + 1];
+        }
+    }
+    thread_pool_->wait();
+
+    std::copy(par, par + 6, parameters_.begin());
+    cached_ = true;
+
+    LOG_PROGRESS(INFO, "t") << "Evaluated residuals of " << size << " clusters, pass " << calls_->passes;
+    calls_->passes++;
+}
+
+void AlignmentDUTResidual::finalize(const std::shared_ptr<ReadonlyClipboard>& clipboard) {
+
+    if(m_discardedtracks > 0) {
+        LOG(STATUS) << "Discarded " << m_discardedtracks << " input tracks.";
+    }
 
-    AlignmentDUTResidual::globalDetector = m_detector;
     auto name = m_detector->getName();
+    auto tracks = clipboard->getPersistentData<Track>(name);
 
     size_t n_getAssociatedClusters = 0;
     // count associated clusters:
-    for(auto& track : AlignmentDUTResidual::globalTracks) {
-        auto associatedClusters = track->getAssociatedClusters(name);
-        for(auto& associatedCluster : associatedClusters) {
-            std::string detectorID = associatedCluster->detectorID();
-            if(detectorID != name) {
-                continue;
-            }
+    for(auto& track : tracks) {
+        if(!track->getAssociatedClusters(name).empty()) {
             n_getAssociatedClusters++;
-            break;
         }
     }
-    if(n_getAssociatedClusters < AlignmentDUTResidual::globalTracks.size() / 2) {
-        LOG(WARNING) << "Only "
-                     << 100 * static_cast<double>(n_getAssociatedClusters) /
-                            static_cast<double>(AlignmentDUTResidual::globalTracks.size())
+    if(n_getAssociatedClusters < tracks.size() / 2) {
+        LOG(WARNING) << "Only " << 100 * static_cast<double>(n_getAssociatedClusters) / static_cast<double>(tracks.size())
                      << "% of all tracks have associated clusters on detector " << name;
     } else {
-        LOG(INFO) << 100 * static_cast<double>(n_getAssociatedClusters) /
-                         static_cast<double>(AlignmentDUTResidual::globalTracks.size())
+        LOG(INFO) << 100 * static_cast<double>(n_getAssociatedClusters) / static_cast<double>(tracks.size())
                   << "% of all tracks have associated clusters on detector " << name;
     }
 
+    // Create thread pool:
+    ThreadPool::registerThreadCount(m_workers);
+    auto pool = std::make_unique<ThreadPool>(
+        m_workers,
+        m_workers * 1024,
+        [log_level = corryvreckan::Log::getReportingLevel(), log_format = corryvreckan::Log::getFormat()]() {
+            // Initialize the threads to the same log level and format as the master setting
+            corryvreckan::Log::setReportingLevel(log_level);
+            corryvreckan::Log::setFormat(log_format);
+        });
+
+    // Store the alignment shifts per detector:
+    std::vector<double> shiftsX;
+    std::vector<double> shiftsY;
+    std::vector<double> rotX;
+    std::vector<double> rotY;
+    std::vector<double> rotZ;
+
     LOG(STATUS) << name << " initial alignment: " << std::endl
                 << "T" << Units::display(m_detector->displacement(), {"mm", "um"}) << " R"
                 << Units::display(m_detector->rotation(), {"deg"});
 
-    // Add the parameters to the fitter (z displacement not allowed to move!)
-    if(m_alignPosition && m_alignPosition_axes.find('x') != std::string::npos) {
-        residualFitter->SetParameter(0, (name + "_displacementX").c_str(), m_detector->displacement().X(), 0.01, -50, 50);
-    } else {
-        residualFitter->SetParameter(0, (name + "_displacementX").c_str(), m_detector->displacement().X(), 0, -50, 50);
-    }
-    if(m_alignPosition && m_alignPosition_axes.find('y') != std::string::npos) {
-        residualFitter->SetParameter(1, (name + "_displacementY").c_str(), m_detector->displacement().Y(), 0.01, -50, 50);
-    } else {
-        residualFitter->SetParameter(1, (name + "_displacementY").c_str(), m_detector->displacement().Y(), 0, -50, 50);
-    }
+    auto align_position = [&](char axis) {
+        return m_alignPosition && m_alignPosition_axes.find(axis) != std::string::npos ? 0.01 : 0.;
+    };
+    auto align_orientation = [&](char axis) {
+        return m_alignOrientation && m_alignOrientation_axes.find(axis) != std::string::npos ? 0.001 : 0.;
+    };
 
-    // Z is never changed:
-    residualFitter->SetParameter(2, (name + "_displacementZ").c_str(), m_detector->displacement().Z(), 0, -10, 500);
+    // Minimization of the residuals, which updates the detector to the optimised alignment parameters
+    std::function<void()> minimise;
 
-    if(m_alignOrientation && m_alignOrientation_axes.find('x') != std::string::npos) {
-        residualFitter->SetParameter(3, (name + "_rotationX").c_str(), m_detector->rotation().X(), 0.001, -6.30, 6.30);
-    } else {
-        residualFitter->SetParameter(3, (name + "_rotationX").c_str(), m_detector->rotation().X(), 0, -6.30, 6.30);
-    }
-    if(m_alignOrientation && m_alignOrientation_axes.find('y') != std::string::npos) {
-        residualFitter->SetParameter(4, (name + "_rotationY").c_str(), m_detector->rotation().Y(), 0.001, -6.30, 6.30);
-    } else {
-        residualFitter->SetParameter(4, (name + "_rotationY").c_str(), m_detector->rotation().Y(), 0, -6.30, 6.30);
-    }
-    if(m_alignOrientation && m_alignOrientation_axes.find('z') != std::string::npos) {
-        residualFitter->SetParameter(5, (name + "_rotationZ").c_str(), m_detector->rotation().Z(), 0.001, -6.30, 6.30);
+    // Minuit2 with analytic gradient
+    ResidualData data;
+    ResidualChi2Calls calls;
+    std::unique_ptr<ResidualChi2> residual_chi2;
+    std::unique_ptr<ROOT::Minuit2::Minuit2Minimizer> minimizer;
+
+    // Minuit with numerical derivatives
+    TVirtualFitter* residualFitter = nullptr;
+    Double_t arglist[10];
+
+    if(m_analyticGradient) {
+        // Store the track intercepts and cluster positions, the tracks are not changed by the alignment of the detector
+        for(auto& track : tracks) {
+            auto point = track->getState(name);
+            auto direction = track->getDirection(name);
+            for(auto& associatedCluster : track->getAssociatedClusters(name)) {
+                auto position = associatedCluster->local();
+                data.point_x.push_back(point.X());
+                data.point_y.push_back(point.Y());
+                data.point_z.push_back(point.Z());
+                data.direction_x.push_back(direction.X());
+                data.direction_y.push_back(direction.Y());
+                data.direction_z.push_back(direction.Z());
+                // GBL tracks provide their intercept with the detector directly
+                data.projection.push_back(track->getType() == "GblTrack" ? 0. : 1.);
+                data.cluster_x.push_back(position.X());
+                data.cluster_y.push_back(position.Y());
+                data.weight_x.push_back(1. / (associatedCluster->errorX() * associatedCluster->errorX()));
+                data.weight_y.push_back(1. / (associatedCluster->errorY() * associatedCluster->errorY()));
+            }
+        }
+
+        residual_chi2 = std::make_unique<ResidualChi2>(m_detector, &data, pool.get(), &calls);
+        minimizer = std::make_unique<ROOT::Minuit2::Minuit2Minimizer>(ROOT::Minuit2::kMigrad);
+        minimizer->SetPrintLevel(0);
+        minimizer->SetMaxFunctionCalls(1000);
+        minimizer->SetTolerance(0.001);
+        minimizer->SetFunction(*residual_chi2);
+
+        // Add the parameters to the minimizer, parameters without step size are fixed
+        auto add_parameter = [&](unsigned int index, const std::string& parameter, double value, double step, double limit) {
+            if(step > 0) {
+                minimizer->SetLimitedVariable(index, name + "_" + parameter, value, step, -limit, limit);
+            } else {
+                minimizer->SetFixedVariable(index, name + "_" + parameter, value);
+            }
+        };
+        add_parameter(0, "displacementX", m_detector->displacement().X(), align_position('x'), 50);
+        add_parameter(1, "displacementY", m_detector->displacement().Y(), align_position('y'), 50);
+        // Z is never changed:
+        add_parameter(2, "displacementZ", m_detector->displacement().Z(), 0., 0.);
+        add_parameter(3, "rotationX", m_detector->rotation().X(), align_orientation('x'), 6.30);
+        add_parameter(4, "rotationY", m_detector->rotation().Y(), align_orientation('y'), 6.30);
+        add_parameter(5, "rotationZ", m_detector->rotation().Z(), align_orientation('z'), 6.30);
+
+        minimise = [&]() {
+            if(!minimizer->Minimize()) {
+                LOG(WARNING) << "Minimization of residuals did not converge, status " << minimizer->Status();
+            }
+
+            // Set the alignment parameters of this plane to be the optimised values from the alignment
+            const double* par = minimizer->X();
+            m_detector->displacement(XYZPoint(par[0], par[1], par[2]));
+            m_detector->rotation(XYZVector(par[3], par[4], par[5]));
+            m_detector->update();
+        };
     } else {
-        residualFitter->SetParameter(5, (name + "_rotationZ").c_str(), m_detector->rotation().Z(), 0, -6.30, 6.30);
+        // Make the fitting object
+        residualFitter = TVirtualFitter::Fitter(nullptr, 50);
+        residualFitter->SetFCN(MinimiseResiduals);
+
+        // Set the global parameters
+        AlignmentDUTResidual::globalTracks = tracks;
+        AlignmentDUTResidual::globalDetector = m_detector;
+        AlignmentDUTResidual::thread_pool = pool.get();
+        AlignmentDUTResidual::fcn_calls = 0;
+
+        // Set the printout arguments of the fitter
+        arglist[0] = -1;
+        residualFitter->ExecuteCommand("SET PRINT", arglist, 1);
+
+        // Set some fitter parameters
+        arglist[0] = 1000;  // number of function calls
+        arglist[1] = 0.001; // tolerance
+
+        // Add the parameters to the fitter (z displacement not allowed to move!)
+        residualFitter->SetParameter(
+            0, (name + "_displacementX").c_str(), m_detector->displacement().X(), align_position('x'), -50, 50);
+        residualFitter->SetParameter(
+            1, (name + "_displacementY").c_str(), m_detector->displacement().Y(), align_position('y'), -50, 50);
+        residualFitter->SetParameter(2, (name + "_displacementZ").c_str(), m_detector->displacement().Z(), 0, -10, 500);
+        residualFitter->SetParameter(
+            3, (name + "_rotationX").c_str(), m_detector->rotation().X(), align_orientation('x'), -6.30, 6.30);
+        residualFitter->SetParameter(
+            4, (name + "_rotationY").c_str(), m_detector->rotation().Y(), align_orientation('y'), -6.30, 6.30);
+        residualFitter->SetParameter(
+            5, (name + "_rotationZ").c_str(), m_detector->rotation().Z(), align_orientation('z'), -6.30, 6.30);
+
+        minimise = [&]() {
+            // Fit this plane (minimising global track chi2)
+            residualFitter->ExecuteCommand("MIGRAD", arglist, 2);
+
+            // Set the alignment parameters of this plane to be the optimised values from the alignment
+            m_detector->displacement(XYZPoint(
+                residualFitter->GetParameter(0), residualFitter->GetParameter(1), residualFitter->GetParameter(2)));
+            m_detector->rotation(XYZVector(
+                residualFitter->GetParameter(3), residualFitter->GetParameter(4), residualFitter->GetParameter(5)));
+            m_detector->update();
+        };
     }
 
     for(size_t iteration = 0; iteration < nIterations; iteration++) {
@@ -338,15 +568,7 @@ void AlignmentDUTResidual::finalize(const std::shared_ptr<ReadonlyClipboard>& cl
         auto old_position = m_detector->displacement();
         auto old_orientation = m_detector->rotation();
 
-        // Fit this plane (minimising global track chi2)
-        residualFitter->ExecuteCommand("MIGRAD", arglist, 2);
-
-        // Set the alignment parameters of this plane to be the optimised values from the alignment
-        m_detector->displacement(
-            XYZPoint(residualFitter->GetParameter(0), residualFitter->GetParameter(1), residualFitter->GetParameter(2)));
-        m_detector->rotation(
-            XYZVector(residualFitter->GetParameter(3), residualFitter->GetParameter(4), residualFitter->GetParameter(5)));
-        m_detector->update();
+        minimise();
 
         // Store corrections:
         shiftsX.push_back(static_cast<double>(Units::convert(m_detector->displacement().X() - old_position.X(), "um")));
@@ -397,7 +619,15 @@ void AlignmentDUTResidual::finalize(const std::shared_ptr<ReadonlyClipboard>& cl
     align_correction_rotZ->GetYaxis()->SetTitle("correction [#mum]");
     align_correction_rotZ->Write(graph_name.c_str());
 
+    if(m_analyticGradient) {
+        LOG(INFO) << "Minuit2 called the function " << calls.value << " times and its gradient " << calls.gradient
+                  << " times, evaluated in " << calls.passes << " passes over the residuals";
+    } else {
+        LOG(INFO) << "Minuit called the function " << AlignmentDUTResidual::fcn_calls << " times";
+    }
+
     // Clean up local track storage
     AlignmentDUTResidual::globalTracks.clear();
     AlignmentDUTResidual::globalDetector.reset();
+    AlignmentDUTResidual::thread_pool = nullptr;
 }
@@ -8,11 +8,16 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <Math/IFunction.h>
 #include <TCanvas.h>
 #include <TGraph.h>
 #include <TH1F.h>
 #include <TH2F.h>
+#include <array>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include <vector>
 
 #include "core/module/Module.hpp"
 #include "core/utils/ThreadPool.hpp"
@@ -21,6 +26,86 @@
 #include "objects/Track.hpp"
 
 namespace corryvreckan {
+
+    /**
+     * @brief Track intercepts and associated cluster positions in structure-of-arrays layout, one entry per cluster
+     *
+     * The track is represented by a point and its direction at the detector in global coordinates. Tracks whose intercept
+     * does not depend on the detector position, such as GBL tracks providing their state at the detector, have a
+     * projection factor of zero, otherwise the track is propagated to the detector plane.
+     */
+    struct ResidualData {
+        std::vector<double> point_x, point_y, point_z;
+        std::vector<double> direction_x, direction_y, direction_z;
+        std::vector<double> projection;
+        // Local cluster position and inverse variance of the position
+        std::vector<double> cluster_x, cluster_y;
+        std::vector<double> weight_x, weight_y;
+
+        size_t size() const { return cluster_x.size(); }
+    };
+
+    /**
+     * @brief Number of calls of the residual function by the minimizer and of passes over the data
+     */
+    struct ResidualChi2Calls {
+        size_t value{};
+        size_t gradient{};
+        size_t passes{};
+    };
+
+    /**
+     * @brief Sum of squared residuals normalized by the cluster position errors as function of the six alignment
+     * parameters of the detector, with analytic gradient
+     *
+     * The parameters are the displacement along x, y and z followed by the three rotation angles. Evaluating the function
+     * updates the detector to the given parameters. The residuals of all clusters are evaluated in batches on the given
+     * thread pool, providing the value and the gradient from the same pass over the data.
+     */
+    class ResidualChi2 : public ROOT::Math::IGradientFunctionMultiDim {
+    public:
+        /**
+         * @brief Construct the function
+         * @param detector Detector to align
+         * @param data Track intercepts and clusters
+         * @param thread_pool Thread pool to evaluate batches of residuals on
+         * @param calls Counters of the calls of value and gradient, and of the passes over the data
+         *
+         * The counters are held outside of the function object, since the minimizer operates on a clone of it.
+         */
+        ResidualChi2(std::shared_ptr<Detector> detector,
+                     const ResidualData* data,
+                     ThreadPool* thread_pool,
+                     ResidualChi2Calls* calls);
+
+        ResidualChi2* Clone() const override { return new ResidualChi2(*this); }
+        unsigned int NDim() const override { return 6; }
+
+        void Gradient(const double* par, double* grad) const override;
+        void FdF(const double* par, double& value, double* grad) const override;
+
+    private:
+        double DoEval(const double* par) const override;
+        double DoDerivative(const double* par, unsigned int coordinate) const override;
+
+        /**
+         * @brief Evaluate value and gradient unless they are cached for the given parameters
+         * @param par Alignment parameters
+         */
+        void evaluate(const double* par) const;
+
+        std::shared_ptr<Detector> detector_;
+        const ResidualData* data_;
+        ThreadPool* thread_pool_;
+        ResidualChi2Calls* calls_;
+
+        // Result of the last evaluation
+        mutable bool cached_{};
+        mutable std::array<double, 6> parameters_{};
+        mutable double value_{};
+        mutable std::array<double, 6> gradient_{};
+    };
+
     /** @ingroup Modules
      * @brief Module to do function
      *
@@ -61,10 +146,12 @@ namespace corryvreckan {
         static TrackVector globalTracks;
         static std::shared_ptr<Detector> globalDetector;
         static ThreadPool* thread_pool;
+        static size_t fcn_calls;
 
         unsigned int m_workers;
         size_t nIterations;
         bool m_pruneTracks;
+        bool m_analyticGradient;
         bool m_alignPosition;
         bool m_alignOrientation;
         std::string m_alignPosition_axes;
@@ -14,6 +14,7 @@
 
 // Local
 #include "AlignmentMillepede.h"
+#include "core/utils/ThreadPool.hpp"
 #include "objects/Cluster.hpp"
 
 using namespace corryvreckan;
@@ -33,6 +34,7 @@ AlignmentMillepede::AlignmentMillepede(Configuration& config, std::vector<std::s
     config_.setDefault<int>("number_of_stddev", 0);
     config_.setDefault<double>("convergence", 0.00001);
     config_.setDefaultArray<double>("sigmas", {0.05, 0.05, 0.5, 0.005, 0.005, 0.005});
+    config_.setDefault<bool>("incremental", false);
 
     m_excludeDUT = config_.get<bool>("exclude_dut");
     m_dofs = config_.getArray<bool>("dofs");
@@ -42,10 +44,20 @@ AlignmentMillepede::AlignmentMillepede(Configuration& config, std::vector<std::s
     m_nstdev = config_.get<int>("number_of_stddev");
     m_convergence = config_.get<double>("convergence");
     m_sigmas = config_.getArray<double>("sigmas");
+    m_incremental = config_.get<bool>("incremental");
 
     if(m_dofs.size() != 6) {
         throw InvalidValueError(config_, "dofs", "Invalid number of degrees of freedom.");
     }
+
+    if(m_incremental) {
+        // Tracks are only seen once, so they cannot be refitted within the global fit
+        m_iterate = false;
+        // Every thread adds its tracks to its own normal equations, events can be processed concurrently
+        allow_multithreading();
+        // The normal equations are not stored with the results of a partition
+        disallow_partitions();
+    }
 }
 
 //=============================================================================
@@ -73,6 +85,13 @@ void AlignmentMillepede::initialize() {
         const std::string on = m_dofs[i] ? "ON" : "OFF";
         LOG(INFO) << labels[i] << "\t" << on;
     }
+
+    // In incremental mode, the tracks are fitted during the event loop using the initial geometry.
+    if(m_incremental) {
+        LOG(INFO) << "Accumulating the normal equations during the event loop, a single global fit will be performed";
+        const double startfact = 100.;
+        reset(num_regular_detectors(!m_excludeDUT), startfact);
+    }
 }
 
 // During run, just pick up tracks and save them till the end
@@ -80,6 +99,27 @@ StatusCode AlignmentMillepede::run(const std::shared_ptr<Clipboard>& clipboard)
 
     // Get the tracks
     auto tracks = clipboard->getData<Track>();
+
+    if(m_incremental) {
+        // Add the tracks to the normal equations of this thread right away instead of storing them
+        const size_t nPlanes = num_regular_detectors(!m_excludeDUT);
+        auto& accumulator = getAccumulator();
+        std::vector<double> trackParams(2 * m_nalc + 2, 0.);
+        for(auto& track : tracks) {
+            if(track->getNClusters() != nPlanes) {
+                ++accumulator.nSkipped;
+                continue;
+            }
+            std::fill(trackParams.begin(), trackParams.end(), 0.);
+            const auto equations = getEquations(track.get(), nPlanes);
+            if(fitTrack(equations, trackParams, false, 1, accumulator.cgmat, accumulator.bgvec)) {
+                ++accumulator.nTracks;
+            } else {
+                ++accumulator.nOutliers;
+            }
+        }
+        return StatusCode::Success;
+    }
     TrackVector alignmenttracks;
     std::map<std::string, std::vector<Cluster*>> alignmentclusters;
 
@@ -108,7 +148,7 @@ StatusCode AlignmentMillepede::run(const std::shared_ptr<Clipboard>& clipboard)
 void AlignmentMillepede::finalize(const std::shared_ptr<ReadonlyClipboard>& clipboard) {
 
     LOG(INFO) << "Millepede alignment";
-    auto alignmenttracks = clipboard->getPersistentData<Track>();
+    auto alignmenttracks = m_incremental ? TrackVector() : clipboard->getPersistentData<Track>();
 
     size_t nPlanes = num_regular_detectors(!m_excludeDUT);
     LOG(INFO) << "Aligning " << nPlanes << " planes";
@@ -119,24 +159,29 @@ void AlignmentMillepede::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
         const double startfact = 100.;
         // Initialise all matrices and vectors.
         reset(nPlanes, startfact);
-        LOG(INFO) << "Feeding Millepede with " << alignmenttracks.size() << " tracks...";
-        // Feed Millepede with tracks.
-        unsigned int nSkipped = 0;
-        unsigned int nOutliers = 0;
-        for(auto& track : alignmenttracks) {
-            if(track->getNClusters() != nPlanes) {
-                ++nSkipped;
-                continue;
+        if(m_incremental) {
+            // Use the normal equations accumulated during the event loop.
+            m_nAccumulated = mergeAccumulators();
+        } else {
+            LOG(INFO) << "Feeding Millepede with " << alignmenttracks.size() << " tracks...";
+            // Feed Millepede with tracks.
+            unsigned int nSkipped = 0;
+            unsigned int nOutliers = 0;
+            for(auto& track : alignmenttracks) {
+                if(track->getNClusters() != nPlanes) {
+                    ++nSkipped;
+                    continue;
+                }
+                if(!putTrack(track.get(), nPlanes)) {
+                    ++nOutliers;
+                }
             }
-            if(!putTrack(track.get(), nPlanes)) {
-                ++nOutliers;
+            if(nSkipped > 0) {
+                LOG(INFO) << "Skipped " << nSkipped << " tracks with less than " << nPlanes << " clusters.";
+            }
+            if(nOutliers > 0) {
+                LOG(INFO) << "Rejected " << nOutliers << " outlier tracks.";
             }
-        }
-        if(nSkipped > 0) {
-            LOG(INFO) << "Skipped " << nSkipped << " tracks with less than " << nPlanes << " clusters.";
-        }
-        if(nOutliers > 0) {
-            LOG(INFO) << "Rejected " << nOutliers << " outlier tracks.";
         }
         // Do the global fit.
         LOG(INFO) << "Determining global parameters...";
@@ -154,6 +199,9 @@ void AlignmentMillepede::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
         // Update the module positions and orientations.
         LOG(INFO) << "Updating geometry...";
         updateGeometry();
+        // Without stored tracks, there is nothing to refit with the new geometry.
+        if(m_incremental)
+            break;
 
         // Update the cluster coordinates based on the new geometry.
         for(auto& track : alignmenttracks) {
@@ -168,6 +216,13 @@ void AlignmentMillepede::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
         if(converg < m_convergence)
             break;
     }
+
+    // Now list the new alignment parameters
+    for(const auto& det : get_regular_detectors(!m_excludeDUT)) {
+        LOG(STATUS) << det->getName() << " new alignment: " << std::endl
+                    << "T" << Units::display(det->displacement(), {"mm", "um"}) << " R"
+                    << Units::display(det->rotation(), {"deg"});
+    }
 }
 
 //=============================================================================
@@ -259,6 +314,22 @@ void AlignmentMillepede::addConstraint(const std::vector<double>& dercs, const d
 //=============================================================================
 bool AlignmentMillepede::putTrack(Track* track, const size_t nPlanes) {
 
+    auto equations = getEquations(track, nPlanes);
+    // Vector containing the track parameters
+    std::vector<double> trackParams(2 * m_nalc + 2, 0.);
+    // Fit the track.
+    const unsigned int iteration = 1;
+    const bool ok = fitTrack(equations, trackParams, false, iteration, m_cgmat, m_bgvec);
+    if(ok)
+        m_equations.push_back(std::move(equations));
+    return ok;
+}
+
+//=============================================================================
+// Build the equations for the measurements of one track
+//=============================================================================
+std::vector<AlignmentMillepede::Equation> AlignmentMillepede::getEquations(Track* track, const size_t nPlanes) const {
+
     std::vector<Equation> equations;
     const size_t nParameters = 6 * nPlanes;
     // Global derivatives
@@ -300,7 +371,7 @@ bool AlignmentMillepede::putTrack(Track* track, const size_t nPlanes) {
         const double errx = cluster->errorX();
         const double erry = cluster->errorY();
         // Get the internal plane index in Millepede.
-        const unsigned int plane = m_millePlanes[detector->getName()];
+        const unsigned int plane = m_millePlanes.at(detector->getName());
         // Set the local derivatives for the X equation.
         std::vector<double> derlc = {1., zg, 0., 0.};
         // Set the global derivatives (see LHCb-2005-101) for the X equation.
@@ -348,14 +419,62 @@ bool AlignmentMillepede::putTrack(Track* track, const size_t nPlanes) {
         // Store the Y equation.
         addEquation(equations, derlc, dergb, dernl, dernli, dernls, yg, erry);
     }
-    // Vector containing the track parameters
-    std::vector<double> trackParams(2 * m_nalc + 2, 0.);
-    // Fit the track.
-    const unsigned int iteration = 1;
-    const bool ok = fitTrack(equations, trackParams, false, iteration);
-    if(ok)
-        m_equations.push_back(equations);
-    return ok;
+    return equations;
+}
+
+//=============================================================================
+// Get the normal equations of the calling thread
+//=============================================================================
+AlignmentMillepede::Accumulator& AlignmentMillepede::getAccumulator() {
+
+    // Every thread of the pool has a fixed slot, such that the normal equations are summed in a fixed order
+    const auto slot = ThreadPool::threadNum();
+    std::lock_guard<std::mutex> lock{m_accumulatorMutex};
+    if(slot >= m_accumulators.size()) {
+        m_accumulators.resize(slot + 1);
+    }
+    auto& accumulator = m_accumulators[slot];
+    if(accumulator == nullptr) {
+        accumulator = std::make_unique<Accumulator>();
+        accumulator->cgmat.assign(m_nagb, std::vector<double>(m_nagb, 0.));
+        accumulator->bgvec.assign(m_nagb, 0.);
+    }
+    return *accumulator;
+}
+
+//=============================================================================
+// Sum the normal equations of all threads
+//=============================================================================
+size_t AlignmentMillepede::mergeAccumulators() {
+
+    size_t nTracks = 0;
+    size_t nSkipped = 0;
+    size_t nOutliers = 0;
+    size_t nThreads = 0;
+    for(const auto& slot : m_accumulators) {
+        if(slot == nullptr) {
+            continue;
+        }
+        const auto& accumulator = *slot;
+        ++nThreads;
+        for(unsigned int i = 0; i < m_nagb; ++i) {
+            m_bgvec[i] += accumulator.bgvec[i];
+            for(unsigned int j = 0; j < m_nagb; ++j) {
+                m_cgmat[i][j] += accumulator.cgmat[i][j];
+            }
+        }
+        nTracks += accumulator.nTracks;
+        nSkipped += accumulator.nSkipped;
+        nOutliers += accumulator.nOutliers;
+    }
+    LOG(INFO) << "Accumulated " << nTracks << " tracks from " << nThreads << " thread(s).";
+    if(nSkipped > 0) {
+        LOG(INFO) << "Skipped " << nSkipped << " tracks with less clusters than planes.";
+    }
+    if(nOutliers > 0) {
+        LOG(INFO) << "Rejected " << nOutliers << " outlier tracks.";
+    }
+    return nTracks;
 }
 
 //=============================================================================
@@ -368,7 +487,7 @@ void AlignmentMillepede::addEquation(std::vector<Equation>& equations,
                                      const std::vector<int>& dernli,
                                      const std::vector<double>& slopes,
                                      const double rmeas,
-                                     const double sigma) {
+                                     const double sigma) const {
 
     if(sigma <= 0.) {
         LOG(ERROR) << "Invalid cluster error (" << sigma << ")";
@@ -412,7 +531,9 @@ void AlignmentMillepede::addEquation(std::vector<Equation>& equations,
 bool AlignmentMillepede::fitTrack(const std::vector<Equation>& equations,
                                   std::vector<double>& trackParams,
                                   const bool singlefit,
-                                  const unsigned int iteration) {
+                                  const unsigned int iteration,
+                                  std::vector<std::vector<double>>& cgmat,
+                                  std::vector<double>& bgvec) const {
 
     std::vector<double> blvec(m_nalc, 0.);
     std::vector<std::vector<double>> clmat(m_nalc, std::vector<double>(m_nalc, 0.));
@@ -511,7 +632,18 @@ bool AlignmentMillepede::fitTrack(const std::vector<Equation>& equations,
 
     // Local operations are finished. Track is accepted.
     // Third loop: update the global parameters (other matrices).
-    m_clcmat.assign(m_nagb, std::vector<double>(m_nalc, 0.));
+    // Buffers for the global/local terms, reused for all tracks fitted by the same thread.
+    static thread_local std::vector<std::vector<double>> clcmat;
+    static thread_local std::vector<std::vector<double>> corrm;
+    static thread_local std::vector<double> corrv;
+    clcmat.resize(m_nagb);
+    for(auto& row : clcmat) {
+        row.assign(m_nalc, 0.);
+    }
+    if(corrm.size() != m_nagb) {
+        corrm.assign(m_nagb, std::vector<double>(m_nagb, 0.));
+        corrv.assign(m_nagb, 0.);
+    }
     unsigned int nagbn = 0;
     std::vector<int> indnz(m_nagb, -1);
     std::vector<int> indbk(m_nagb, 0);
@@ -527,12 +659,12 @@ bool AlignmentMillepede::fitTrack(const std::vector<Equation>& equations,
         // First of all, the global/global terms.
         for(size_t i = 0; i < nG; ++i) {
             const size_t j = static_cast<size_t>(equation.indG[i]);
-            m_bgvec[j] += w * rmeas * equation.derG[i];
-            LOG(DEBUG) << "bgvec[" << j << "] = " << m_bgvec[j];
+            bgvec[j] += w * rmeas * equation.derG[i];
+            LOG(DEBUG) << "bgvec[" << j << "] = " << bgvec[j];
             for(size_t k = 0; k < nG; ++k) {
                 const size_t n = static_cast<size_t>(equation.indG[k]);
-                m_cgmat[j][n] += w * equation.derG[i] * equation.derG[k];
-                LOG(DEBUG) << "cgmat[" << j << "][" << n << "] = " << m_cgmat[j][n];
+                cgmat[j][n] += w * equation.derG[i] * equation.derG[k];
+                LOG(DEBUG) << "cgmat[" << j << "][" << n << "] = " << cgmat[j][n];
             }
         }
         // Now we have also rectangular matrices containing global/local terms.
@@ -551,21 +683,21 @@ bool AlignmentMillepede::fitTrack(const std::vector<Equation>& equations,
             // Now fill the rectangular matrix.
             for(size_t k = 0; k < nL; ++k) {
                 const size_t ij = static_cast<size_t>(equation.indL[k]);
-                m_clcmat[static_cast<size_t>(ik)][ij] += w * equation.derG[i] * equation.derL[k];
-                LOG(DEBUG) << "clcmat[" << ik << "][" << ij << "] = " << m_clcmat[static_cast<size_t>(ik)][ij];
+                clcmat[static_cast<size_t>(ik)][ij] += w * equation.derG[i] * equation.derL[k];
+                LOG(DEBUG) << "clcmat[" << ik << "][" << ij << "] = " << clcmat[static_cast<size_t>(ik)][ij];
             }
         }
     }
 
     // Third loop is finished, now we update the correction matrices.
-    multiplyAVAt(clmat, m_clcmat, m_corrm, m_nalc, nagbn);
-    multiplyAX(m_clcmat, blvec, m_corrv, m_nalc, nagbn);
+    multiplyAVAt(clmat, clcmat, corrm, m_nalc, nagbn);
+    multiplyAX(clcmat, blvec, corrv, m_nalc, nagbn);
     for(size_t i = 0; i < nagbn; ++i) {
         const size_t j = static_cast<size_t>(indbk[i]);
-        m_bgvec[j] -= m_corrv[i];
+        bgvec[j] -= corrv[i];
         for(size_t k = 0; k < nagbn; ++k) {
             const size_t ik = static_cast<size_t>(indbk[k]);
-            m_cgmat[j][ik] -= m_corrm[i][k];
+            cgmat[j][ik] -= corrm[i][k];
         }
     }
     return true;
@@ -618,8 +750,6 @@ bool AlignmentMillepede::reset(const size_t nPlanes, const double startfact) {
     const unsigned int nRows = m_nagb + static_cast<unsigned int>(m_constraints.size());
     m_bgvec.resize(nRows, 0.);
     m_cgmat.assign(nRows, std::vector<double>(nRows, 0.));
-    m_corrv.assign(m_nagb, 0.);
-    m_corrm.assign(m_nagb, std::vector<double>(m_nagb, 0.));
     m_dparm.assign(m_nagb, 0.);
 
     // Define the sigmas for each parameter.
@@ -665,7 +795,7 @@ bool AlignmentMillepede::fitGlobal() {
 
     const unsigned int nMaxIterations = 10;
     unsigned int iteration = 1;
-    unsigned int nGoodTracks = static_cast<unsigned int>(nTracks);
+    unsigned int nGoodTracks = static_cast<unsigned int>(m_incremental ? m_nAccumulated : nTracks);
     while(iteration <= nMaxIterations) {
         if(nGoodTracks == 0) {
             LOG(ERROR) << "No tracks to work with after outlier rejection.";
@@ -785,7 +915,7 @@ bool AlignmentMillepede::fitGlobal() {
             }
             std::fill(trackParams.begin(), trackParams.end(), 0.);
             // Refit the track.
-            bool ok = fitTrack(equations, trackParams, false, iteration);
+            bool ok = fitTrack(equations, trackParams, false, iteration, m_cgmat, m_bgvec);
             // Cache the track state.
             for(unsigned int j = 0; j < m_nalc; ++j) {
                 localParams[i][j] = trackParams[2 * j];
@@ -942,7 +1072,9 @@ int AlignmentMillepede::invertMatrix(std::vector<std::vector<double>>& v, std::v
 //=============================================================================
 // Simplified version.
 //=============================================================================
-int AlignmentMillepede::invertMatrixLocal(std::vector<std::vector<double>>& v, std::vector<double>& b, const size_t n) {
+int AlignmentMillepede::invertMatrixLocal(std::vector<std::vector<double>>& v,
+                                          std::vector<double>& b,
+                                          const size_t n) const {
 
     int rank = 0;
     const double eps = 0.0000000000001;
@@ -1051,7 +1183,7 @@ bool AlignmentMillepede::multiplyAX(const std::vector<std::vector<double>>& a,
                                     const std::vector<double>& x,
                                     std::vector<double>& y,
                                     const unsigned int n,
-                                    const unsigned int m) {
+                                    const unsigned int m) const {
 
     // Y = A * X, where
     //   A = general M-by-N matrix
@@ -1075,7 +1207,7 @@ bool AlignmentMillepede::multiplyAVAt(const std::vector<std::vector<double>>& v,
                                       const std::vector<std::vector<double>>& a,
                                       std::vector<std::vector<double>>& w,
                                       const unsigned int n,
-                                      const unsigned int m) {
+                                      const unsigned int m) const {
 
     // W = A * V * AT, where
     //   V = symmetric N-by-N matrix
@@ -11,6 +11,11 @@
 #ifndef AlignmentMillepede_H
 #define AlignmentMillepede_H 1
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "core/module/Module.hpp"
 #include "objects/Track.hpp"
 
@@ -34,7 +39,7 @@ namespace corryvreckan {
         void finalize(const std::shared_ptr<ReadonlyClipboard>& clipboard) override;
 
         /**
-         * @brief Collect tracks for alignment
+         * @brief Collect tracks for alignment, or add them to the normal equations directly in incremental mode
          * @param clipboard Pointer to the central clipboard to store and fetch information
          * @return Status code of the event processing
          */
@@ -60,6 +65,14 @@ namespace corryvreckan {
             /// Coefficients
             std::vector<double> coefficients;
         };
+        /// Normal equations of the global parameters accumulated by one thread in incremental mode.
+        struct Accumulator {
+            std::vector<std::vector<double>> cgmat;
+            std::vector<double> bgvec;
+            size_t nTracks = 0;
+            size_t nSkipped = 0;
+            size_t nOutliers = 0;
+        };
 
         /// (Re-)initialise matrices and vectors.
         bool reset(const size_t nPlanes, const double startfact);
@@ -69,6 +82,12 @@ namespace corryvreckan {
         void addConstraint(const std::vector<double>& dercs, const double rhs);
         /// Add the equations for one track and do the local fit.
         bool putTrack(Track* track, const size_t nPlanes);
+        /// Build the equations for the measurements of one track.
+        std::vector<Equation> getEquations(Track* track, const size_t nPlanes) const;
+        /// Get the accumulator of the calling thread, creating it if necessary.
+        Accumulator& getAccumulator();
+        /// Merge the normal equations of all threads into the global matrix and vector.
+        size_t mergeAccumulators();
         /// Store the parameters for one measurement.
         void addEquation(std::vector<Equation>& equations,
                          const std::vector<double>& derlc,
@@ -77,13 +96,15 @@ namespace corryvreckan {
                          const std::vector<int>& dernli,
                          const std::vector<double>& dernls,
                          const double rmeas,
-                         const double sigma);
+                         const double sigma) const;
 
-        // Perform local parameters fit using the equations for one track.
+        // Perform local parameters fit using the equations for one track and add it to the given normal equations.
         bool fitTrack(const std::vector<Equation>& equations,
                       std::vector<double>& trackParams,
                       const bool singlefit,
-                      const unsigned int iteration);
+                      const unsigned int iteration,
+                      std::vector<std::vector<double>>& cgmat,
+                      std::vector<double>& bgvec) const;
 
         // Perform global parameters fit.
         bool fitGlobal();
@@ -93,7 +114,7 @@ namespace corryvreckan {
         /// Matrix inversion and solution for global fit.
         int invertMatrix(std::vector<std::vector<double>>& v, std::vector<double>& b, const size_t n);
         // Matrix inversion and solution for local fit.
-        int invertMatrixLocal(std::vector<std::vector<double>>& v, std::vector<double>& b, const size_t n);
+        int invertMatrixLocal(std::vector<std::vector<double>>& v, std::vector<double>& b, const size_t n) const;
 
         /// Return the limit in chi2 / ndof for n sigmas.
         double chi2Limit(const int n, const int nd) const;
@@ -102,13 +123,13 @@ namespace corryvreckan {
                         const std::vector<double>& x,
                         std::vector<double>& y,
                         const unsigned int n,
-                        const unsigned int m);
+                        const unsigned int m) const;
         /// Multiply matrices
         bool multiplyAVAt(const std::vector<std::vector<double>>& v,
                           const std::vector<std::vector<double>>& a,
                           std::vector<std::vector<double>>& w,
                           const unsigned int n,
-                          const unsigned int m);
+                          const unsigned int m) const;
 
         /// Number of global derivatives
         unsigned int m_nagb;
@@ -131,11 +152,8 @@ namespace corryvreckan {
         std::vector<double> m_psigm;
 
         std::vector<std::vector<double>> m_cgmat;
-        std::vector<std::vector<double>> m_corrm;
-        std::vector<std::vector<double>> m_clcmat;
 
         std::vector<double> m_bgvec;
-        std::vector<double> m_corrv;
         std::vector<double> m_diag;
 
         /// Difference in misalignment parameters with respect to initial values.
@@ -168,6 +186,14 @@ namespace corryvreckan {
         bool m_fix_all;
         /// It can be also reasonable to include the DUT in the alignment
         bool m_excludeDUT;
+
+        /// Accumulate the normal equations during the event loop instead of storing the tracks.
+        bool m_incremental;
+        /// Number of tracks the global fit is based on in incremental mode.
+        size_t m_nAccumulated = 0;
+        /// Normal equations accumulated by each thread in incremental mode, indexed by the number of the thread.
+        std::vector<std::unique_ptr<Accumulator>> m_accumulators;
+        std::mutex m_accumulatorMutex;
     };
 } // namespace corryvreckan
 
@@ -11,6 +11,9 @@
 #include "AlignmentTrackChi2.h"
 
 #include <TVirtualFitter.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <numeric>
 
 using namespace corryvreckan;
@@ -31,10 +34,12 @@ AlignmentTrackChi2::AlignmentTrackChi2(Configuration& config, std::vector<std::s
     config_.setDefault<size_t>("max_associated_clusters", 1);
     config_.setDefault<double>("max_track_chi2ndof", 10.);
     config_.setDefault<unsigned int>("workers", std::max(std::thread::hardware_concurrency() - 1, 1u));
+    config_.setDefault<bool>("analytic_gradient", false);
 
     m_workers = config.get<unsigned int>("workers");
     nIterations = config_.get<size_t>("iterations");
     m_pruneTracks = config_.get<bool>("prune_tracks");
+    m_analyticGradient = config_.get<bool>("analytic_gradient");
 
     m_alignPosition = config_.get<bool>("align_position");
     if(m_alignPosition) {
@@ -162,6 +167,281 @@ void AlignmentTrackChi2::MinimiseTrackChi2(Int_t&, Double_t*, Double_t& result,
     AlignmentTrackChi2::thread_pool->wait();
 }
 
+// ========================================
+//  Refit of cached straight line tracks
+// ========================================
+
+TrackChi2::TrackChi2(std::shared_ptr<Detector> detector,
+                     size_t plane,
+                     TrackCache* cache,
+                     const std::vector<size_t>* tracks,
+                     double constant_chi2,
+                     ThreadPool* thread_pool)
+    : detector_(std::move(detector)), plane_(plane), cache_(cache), tracks_(tracks), constant_chi2_(constant_chi2),
+      thread_pool_(thread_pool) {}
+
+double TrackChi2::DoEval(const double* par) const {
+    evaluate(par);
+    return value_;
+}
+
+double TrackChi2::DoDerivative(const double* par, unsigned int coordinate) const {
+    evaluate(par);
+    return gradient_.at(coordinate);
+}
+
+void TrackChi2::Gradient(const double* par, double* grad) const {
+    evaluate(par);
+    std::copy(gradient_.begin(), gradient_.end(), grad);
+}
+
+void TrackChi2::FdF(const double* par, double& value, double* grad) const {
+    evaluate(par);
+    value = value_;
+    std::copy(gradient_.begin(), gradient_.end(), grad);
+}
+
+/**
+ * Each track is refitted by solving the decoupled weighted least squares problems x = x0 + tx * z and y = y0 + ty * z in
+ * closed form, as done by the StraightLineTrack fit. The clusters on the aligned plane are first moved to their global
+ * position g = R * l + t for the current alignment. For those clusters, the derivatives of their global position are e_j
+ * for the displacement along axis j and R' * l for a rotation angle with rotation derivative R'. Tracks with a singular
+ * fit do not contribute.
+ */
+static std::array<double, 7> refit_tracks(TrackCache& cache,
+                                          const std::vector<size_t>& tracks,
+                                          size_t begin,
+                                          size_t end,
+                                          size_t plane,
+                                          const std::array<double, 3>& t,
+                                          const std::array<double, 9>& r,
+                                          const std::array<std::array<double, 9>, 3>& dr) {
+    double chi2 = 0.;
+    std::array<double, 6> grad{};
+
+    for(size_t index = begin; index < end; index++) {
+        const auto first = cache.offsets[tracks[index]];
+        const auto last = cache.offsets[tracks[index] + 1];
+
+        // Update the global positions of the clusters on the aligned plane
+        for(size_t i = first; i < last; i++) {
+            if(cache.plane[i] == plane) {
+                const double lx = cache.local_x[i];
+                const double ly = cache.local_y[i];
+                const double lz = cache.local_z[i];
+                cache.global_x[i] = r[0] * lx + r[1] * ly + r[2] * lz + t[0];
+                cache.global_y[i] = r[3] * lx + r[4] * ly + r[5] * lz + t[1];
+                cache.global_z[i] = r[6] * lx + r[7] * ly + r[8] * lz + t[2];
+            }
+        }
+
+        // Weighted sums of the decoupled fits in x and y
+        double sx = 0., sxz = 0., sxzz = 0., sxm = 0., sxmz = 0.;
+        double sy = 0., syz = 0., syzz = 0., sym = 0., symz = 0.;
+        for(size_t i = first; i < last; i++) {
+            const double z = cache.global_z[i];
+            const double wx = cache.weight_x[i];
+            const double wy = cache.weight_y[i];
+            sx += wx;
+            sxz += wx * z;
+            sxzz += wx * z * z;
+            sxm += wx * cache.global_x[i];
+            sxmz += wx * cache.global_x[i] * z;
+            sy += wy;
+            syz += wy * z;
+            syzz += wy * z * z;
+            sym += wy * cache.global_y[i];
+            symz += wy * cache.global_y[i] * z;
+        }
+        const double det_x = sx * sxzz - sxz * sxz;
+        const double det_y = sy * syzz - syz * syz;
+        if(std::fabs(det_x) < std::numeric_limits<double>::epsilon() ||
+           std::fabs(det_y) < std::numeric_limits<double>::epsilon()) {
+            continue;
+        }
+        const double x0 = (sxzz * sxm - sxz * sxmz) / det_x;
+        const double tx = (sx * sxmz - sxz * sxm) / det_x;
+        const double y0 = (syzz * sym - syz * symz) / det_y;
+        const double ty = (sy * symz - syz * sym) / det_y;
+
+        // Chi2 of the refitted track and its derivatives from the clusters on the aligned plane
+        for(size_t i = first; i < last; i++) {
+            const double z = cache.global_z[i];
+            const double gx = 2. * cache.weight_x[i] * (cache.global_x[i] - x0 - tx * z);
+            const double gy = 2. * cache.weight_y[i] * (cache.global_y[i] - y0 - ty * z);
+            chi2 += 0.25 * (gx * gx / cache.weight_x[i] + gy * gy / cache.weight_y[i]);
+
+            const double on_plane = (cache.plane[i] == plane ? 1. : 0.);
+            grad[0] += on_plane * gx;
+            grad[1] += on_plane * gy;
+            grad[2] += on_plane * (-gx * tx - gy * ty);
+
+            const double lx = cache.local_x[i];
+            const double ly = cache.local_y[i];
+            const double lz = cache.local_z[i];
+            for(size_t k = 0; k < 3; k++) {
+                const auto& m = dr[k];
+                const double dgx = m[0] * lx + m[1] * ly + m[2] * lz;
+                const double dgy = m[3] * lx + m[4] * ly + m[5] * lz;
+                const double dgz = m[6] * lx + m[7] * ly + m[8] * lz;
+                grad[3 + k] += on_plane * (gx * (dgx - tx * dgz) + gy * (dgy - ty * dgz));
+            }
+        }
+    }
+
+    return {chi2, grad[0], grad[1], grad[2], grad[3], grad[4], grad[5]};
+}
+
+void TrackChi2::evaluate(const double* par) const {
+    if(cached_ && std::equal(parameters_.begin(), parameters_.end(), par)) {
+        return;
+    }
+
+    // Rotation from local to global coordinates for the given angles, as defined by the orientation mode of the detector
+    auto rotation = [this, par](const XYZVector& angles) {
+        detector_->displacement(XYZPoint(par[0], par[1], par[2]));
+        detector_->rotation(angles);
+        detector_->update();
+        std::array<double, 9> matrix{};
+        detector_->toGlobal().Rotation().GetComponents(matrix.begin());
+        return matrix;
+    };
+
+    // Derivatives of the rotation with respect to the angles, from central differences of the rotation matrix only
+    const double step = 1e-6;
+    std::array<std::array<double, 9>, 3> dr{};
+    for(size_t k = 0; k < 3; k++) {
+        std::array<double, 3> angles_up{par[3], par[4], par[5]};
+        std::array<double, 3> angles_down{par[3], par[4], par[5]};
+        angles_up[k] += step;
+        angles_down[k] -= step;
+        auto up = rotation(XYZVector(angles_up[0], angles_up[1], angles_up[2]));
+        auto down = rotation(XYZVector(angles_down[0], angles_down[1], angles_down[2]));
+        for(size_t i = 0; i < 9; i++) {
+            dr[k][i] = (up[i] - down[i]) / (2. * step);
+        }
+    }
+
+    // Apply the new alignment conditions
+    auto r = rotation(XYZVector(par[3], par[4], par[5]));
+    std::array<double, 3> t{par[0], par[1], par[2]};
+
+    // Refit the tracks in batches, summed in a fixed order for reproducible results
+    auto size = tracks_->size();
+    auto batch_size = std::max<size_t>(256, size / (4 * std::max(ThreadPool::threadCount(), 1u)) + 1);
+    std::vector<std::shared_future<std::array<double, 7>>> result_futures;
+    for(size_t begin = 0; begin < size; begin += batch_size) {
+        auto end = std::min(begin + batch_size, size);
+        result_futures.push_back(thread_pool_->submit([this, begin, end, &t, &r, &dr]() {
+            return refit_tracks(*cache_, *tracks_, begin, end, plane_, t, r, dr);
+        }));
+    }
+
+    value_ = constant_chi2_;
+    gradient_.fill(0.);
+    for(auto& result_future : result_futures) {
+        auto result = result_future.get();
+        value_ += result[0];
+        for(size_t i = 0; i < 6; i++) {
+            gradient_[i] += result[i + 1];
+        }
+    }
+    thread_pool_->wait();
+
+    std::copy(par, par + 6, parameters_.begin());
+    cached_ = true;
+}
+
+bool AlignmentTrackChi2::fill_cache(const TrackVector& tracks) {
+    if(std::any_of(
+           tracks.begin(), tracks.end(), [](const auto& track) { return track->getType() != "StraightLineTrack"; })) {
+        return false;
+    }
+
+    m_cache = TrackCache();
+    m_cachePlanes = get_regular_detectors(false);
+    std::map<std::string, size_t> planes;
+    for(size_t plane = 0; plane < m_cachePlanes.size(); plane++) {
+        planes.emplace(m_cachePlanes[plane]->getName(), plane);
+    }
+
+    for(auto& track : tracks) {
+        for(auto* cluster : track->getClusters()) {
+            auto plane = planes.find(cluster->detectorID());
+            if(plane == planes.end()) {
+                LOG(WARNING) << "Track cluster on unknown detector " << cluster->detectorID() << ", not using cached tracks";
+                return false;
+            }
+            auto local = cluster->local();
+            auto global = cluster->global();
+            m_cache.plane.push_back(plane->second);
+            m_cache.local_x.push_back(local.X());
+            m_cache.local_y.push_back(local.Y());
+            m_cache.local_z.push_back(local.Z());
+            m_cache.global_x.push_back(global.X());
+            m_cache.global_y.push_back(global.Y());
+            m_cache.global_z.push_back(global.Z());
+            m_cache.weight_x.push_back(1. / (cluster->errorX() * cluster->errorX()));
+            m_cache.weight_y.push_back(1. / (cluster->errorY() * cluster->errorY()));
+        }
+        m_cache.offsets.push_back(m_cache.plane.size());
+    }
+
+    LOG(INFO) << "Stored " << m_cache.plane.size() << " clusters of " << m_cache.tracks()
+              << " straight line tracks for refitting";
+    return true;
+}
+
+std::array<double, 6> AlignmentTrackChi2::minimize_cached(const std::shared_ptr<Detector>& detector, size_t plane) {
+    // Only the tracks with a cluster on the aligned plane change, the chi2 of all other tracks is summed once
+    std::vector<size_t> tracks;
+    std::vector<size_t> other_tracks;
+    for(size_t track = 0; track < m_cache.tracks(); track++) {
+        auto first = m_cache.plane.begin() + static_cast<std::ptrdiff_t>(m_cache.offsets[track]);
+        auto last = m_cache.plane.begin() + static_cast<std::ptrdiff_t>(m_cache.offsets[track + 1]);
+        (std::find(first, last, plane) != last ? tracks : other_tracks).push_back(track);
+    }
+    std::array<double, 3> t{};
+    std::array<double, 9> r{};
+    std::array<std::array<double, 9>, 3> dr{};
+    auto constant_chi2 = refit_tracks(m_cache, other_tracks, 0, other_tracks.size(), m_cachePlanes.size(), t, r, dr)[0];
+
+    TrackChi2 track_chi2(detector, plane, &m_cache, &tracks, constant_chi2, AlignmentTrackChi2::thread_pool);
+    ROOT::Minuit2::Minuit2Minimizer minimizer(ROOT::Minuit2::kMigrad);
+    minimizer.SetPrintLevel(0);
+    minimizer.SetMaxFunctionCalls(1000);
+    minimizer.SetTolerance(0.001);
+    minimizer.SetFunction(track_chi2);
+
+    // Add the parameters to the minimizer (z displacement not allowed to move!)
+    auto name = detector->getName();
+    auto add_parameter = [&](unsigned int index, const std::string& parameter, double value, bool free, double limit) {
+        if(free) {
+            minimizer.SetLimitedVariable(index, name + "_" + parameter, value, index < 3 ? 0.01 : 0.001, -limit, limit);
+        } else {
+            minimizer.SetFixedVariable(index, name + "_" + parameter, value);
+        }
+    };
+    add_parameter(0, "displacementX", detector->displacement().X(), m_alignPosition, 50);
+    add_parameter(1, "displacementY", detector->displacement().Y(), m_alignPosition, 50);
+    add_parameter(2, "displacementZ", detector->displacement().Z(), false, 0);
+    add_parameter(3, "rotationX", detector->rotation().X(), m_alignOrientation, 6.30);
+    add_parameter(4, "rotationY", detector->rotation().Y(), m_alignOrientation, 6.30);
+    add_parameter(5, "rotationZ", detector->rotation().Z(), m_alignOrientation, 6.30);
+
+    LOG(DEBUG) << "Refitting " << tracks.size() << " tracks with clusters on detector " << name;
+    if(!minimizer.Minimize()) {
+        LOG(WARNING) << "Minimization of track chi2 for detector " << name << " did not converge, status "
+                     << minimizer.Status();
+    }
+
+    // Move the clusters of the cache to the final alignment of the detector
+    std::array<double, 6> result{};
+    std::copy(minimizer.X(), minimizer.X() + 6, result.begin());
+    track_chi2(result.data());
+    return result;
+}
+
 // ==================================================================
 //  The finalise function - effectively the brains of the alignment!
 // ==================================================================
@@ -172,13 +452,13 @@ void AlignmentTrackChi2::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
         LOG(INFO) << "Discarded " << m_discardedtracks << " input tracks.";
     }
 
-    // Make the fitting object
-    TVirtualFitter* residualFitter = TVirtualFitter::Fitter(nullptr, 50);
-    residualFitter->SetFCN(MinimiseTrackChi2);
-
     // Set the global parameters
     AlignmentTrackChi2::globalTracks = clipboard->getPersistentData<Track>();
 
+    // If requested, straight line tracks are refitted from a compact copy of their clusters, all other track models are
+    // refitted in full
+    auto use_cache = m_analyticGradient && fill_cache(AlignmentTrackChi2::globalTracks);
+
     // Create thread pool:
     ThreadPool::registerThreadCount(m_workers);
     AlignmentTrackChi2::thread_pool =
@@ -191,14 +471,21 @@ void AlignmentTrackChi2::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
                            corryvreckan::Log::setFormat(log_format);
                        });
 
-    // Set the printout arguments of the fitter
-    Double_t arglist[10];
-    arglist[0] = -1;
-    residualFitter->ExecuteCommand("SET PRINT", arglist, 1);
+    // The fitting object is only required for tracks which are refitted in full
+    TVirtualFitter* residualFitter = nullptr;
+    Double_t arglist[10]{};
+    if(!use_cache) {
+        residualFitter = TVirtualFitter::Fitter(nullptr, 50);
+        residualFitter->SetFCN(MinimiseTrackChi2);
 
-    // Set some fitter parameters
-    arglist[0] = 1000;  // number of function calls
-    arglist[1] = 0.001; // tolerance
+        // Set the printout arguments of the fitter
+        arglist[0] = -1;
+        residualFitter->ExecuteCommand("SET PRINT", arglist, 1);
+
+        // Set some fitter parameters
+        arglist[0] = 1000;  // number of function calls
+        arglist[1] = 0.001; // tolerance
+    }
 
     // Store the alignment shifts per detector:
     std::map<std::string, std::vector<double>> shiftsX;
@@ -226,52 +513,65 @@ void AlignmentTrackChi2::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
             // Say that this is the detector we align
             AlignmentTrackChi2::globalDetector = detector;
 
-            detNum = det;
-            // Add the parameters to the fitter (z displacement not allowed to move!)
-            if(m_alignPosition) {
-                residualFitter->SetParameter(
-                    det * 6 + 0, (detectorID + "_displacementX").c_str(), detector->displacement().X(), 0.01, -50, 50);
-                residualFitter->SetParameter(
-                    det * 6 + 1, (detectorID + "_displacementY").c_str(), detector->displacement().Y(), 0.01, -50, 50);
-
-            } else {
-                residualFitter->SetParameter(
-                    det * 6 + 0, (detectorID + "_displacementX").c_str(), detector->displacement().X(), 0, -50, 50);
-                residualFitter->SetParameter(
-                    det * 6 + 1, (detectorID + "_displacementY").c_str(), detector->displacement().Y(), 0, -50, 50);
-            }
-            residualFitter->SetParameter(
-                det * 6 + 2, (detectorID + "_displacementZ").c_str(), detector->displacement().Z(), 0, -10, 500);
+            auto old_position = detector->displacement();
+            auto old_orientation = detector->rotation();
 
-            if(m_alignOrientation) {
-                residualFitter->SetParameter(
-                    det * 6 + 3, (detectorID + "_rotationX").c_str(), detector->rotation().X(), 0.001, -6.30, 6.30);
-                residualFitter->SetParameter(
-                    det * 6 + 4, (detectorID + "_rotationY").c_str(), detector->rotation().Y(), 0.001, -6.30, 6.30);
-                residualFitter->SetParameter(
-                    det * 6 + 5, (detectorID + "_rotationZ").c_str(), detector->rotation().Z(), 0.001, -6.30, 6.30);
+            std::array<double, 6> result{};
+            if(use_cache) {
+                // Refit the cached tracks with clusters on this plane
+                auto plane = static_cast<size_t>(std::find(m_cachePlanes.begin(), m_cachePlanes.end(), detector) -
+                                                 m_cachePlanes.begin());
+                result = minimize_cached(detector, plane);
             } else {
+                detNum = det;
+                // Add the parameters to the fitter (z displacement not allowed to move!)
+                if(m_alignPosition) {
+                    residualFitter->SetParameter(
+                        det * 6 + 0, (detectorID + "_displacementX").c_str(), detector->displacement().X(), 0.01, -50, 50);
+                    residualFitter->SetParameter(
+                        det * 6 + 1, (detectorID + "_displacementY").c_str(), detector->displacement().Y(), 0.01, -50, 50);
+
+                } else {
+                    residualFitter->SetParameter(
+                        det * 6 + 0, (detectorID + "_displacementX").c_str(), detector->displacement().X(), 0, -50, 50);
+                    residualFitter->SetParameter(
+                        det * 6 + 1, (detectorID + "_displacementY").c_str(), detector->displacement().Y(), 0, -50, 50);
+                }
                 residualFitter->SetParameter(
-                    det * 6 + 3, (detectorID + "_rotationX").c_str(), detector->rotation().X(), 0, -6.30, 6.30);
-                residualFitter->SetParameter(
-                    det * 6 + 4, (detectorID + "_rotationY").c_str(), detector->rotation().Y(), 0, -6.30, 6.30);
-                residualFitter->SetParameter(
-                    det * 6 + 5, (detectorID + "_rotationZ").c_str(), detector->rotation().Z(), 0, -6.30, 6.30);
+                    det * 6 + 2, (detectorID + "_displacementZ").c_str(), detector->displacement().Z(), 0, -10, 500);
+
+                if(m_alignOrientation) {
+                    residualFitter->SetParameter(
+                        det * 6 + 3, (detectorID + "_rotationX").c_str(), detector->rotation().X(), 0.001, -6.30, 6.30);
+                    residualFitter->SetParameter(
+                        det * 6 + 4, (detectorID + "_rotationY").c_str(), detector->rotation().Y(), 0.001, -6.30, 6.30);
+                    residualFitter->SetParameter(
+                        det * 6 + 5, (detectorID + "_rotationZ").c_str(), detector->rotation().Z(), 0.001, -6.30, 6.30);
+                } else {
+                    residualFitter->SetParameter(
+                        det * 6 + 3, (detectorID + "_rotationX").c_str(), detector->rotation().X(), 0, -6.30, 6.30);
+                    residualFitter->SetParameter(
+                        det * 6 + 4, (detectorID + "_rotationY").c_str(), detector->rotation().Y(), 0, -6.30, 6.30);
+                    residualFitter->SetParameter(
+                        det * 6 + 5, (detectorID + "_rotationZ").c_str(), detector->rotation().Z(), 0, -6.30, 6.30);
+                }
+
+                // Fit this plane (minimising global track chi2)
+                LOG(DEBUG) << "fitting residuals for detetcor " << detector->getName();
+                residualFitter->ExecuteCommand("MIGRAD", arglist, 2);
+
+                for(int i = 0; i < 6; i++) {
+                    result[static_cast<size_t>(i)] = residualFitter->GetParameter(det * 6 + i);
+                }
             }
-            auto old_position = detector->displacement();
-            auto old_orientation = detector->rotation();
-
-            // Fit this plane (minimising global track chi2)
-            LOG(DEBUG) << "fitting residuals for detetcor " << detector->getName();
-            residualFitter->ExecuteCommand("MIGRAD", arglist, 2);
 
             // Retrieve fit results:
-            auto displacementX = residualFitter->GetParameter(det * 6 + 0);
-            auto displacementY = residualFitter->GetParameter(det * 6 + 1);
-            auto displacementZ = residualFitter->GetParameter(det * 6 + 2);
-            auto rotationX = residualFitter->GetParameter(det * 6 + 3);
-            auto rotationY = residualFitter->GetParameter(det * 6 + 4);
-            auto rotationZ = residualFitter->GetParameter(det * 6 + 5);
+            auto displacementX = result[0];
+            auto displacementY = result[1];
+            auto displacementZ = result[2];
+            auto rotationX = result[3];
+            auto rotationY = result[4];
+            auto rotationZ = result[5];
 
             // Store corrections:
             shiftsX[detectorID].push_back(
@@ -291,12 +591,17 @@ void AlignmentTrackChi2::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
 
             // Now that this device is fitted, set parameter errors to 0 so that they
             // are not fitted again
-            residualFitter->SetParameter(det * 6 + 0, (detectorID + "_displacementX").c_str(), displacementX, 0, -50, 50);
-            residualFitter->SetParameter(det * 6 + 1, (detectorID + "_displacementY").c_str(), displacementY, 0, -50, 50);
-            residualFitter->SetParameter(det * 6 + 2, (detectorID + "_displacementZ").c_str(), displacementZ, 0, -10, 500);
-            residualFitter->SetParameter(det * 6 + 3, (detectorID + "_rotationX").c_str(), rotationX, 0, -6.30, 6.30);
-            residualFitter->SetParameter(det * 6 + 4, (detectorID + "_rotationY").c_str(), rotationY, 0, -6.30, 6.30);
-            residualFitter->SetParameter(det * 6 + 5, (detectorID + "_rotationZ").c_str(), rotationZ, 0, -6.30, 6.30);
+            if(!use_cache) {
+                residualFitter->SetParameter(
+                    det * 6 + 0, (detectorID + "_displacementX").c_str(), displacementX, 0, -50, 50);
+                residualFitter->SetParameter(
+                    det * 6 + 1, (detectorID + "_displacementY").c_str(), displacementY, 0, -50, 50);
+                residualFitter->SetParameter(
+                    det * 6 + 2, (detectorID + "_displacementZ").c_str(), displacementZ, 0, -10, 500);
+                residualFitter->SetParameter(det * 6 + 3, (detectorID + "_rotationX").c_str(), rotationX, 0, -6.30, 6.30);
+                residualFitter->SetParameter(det * 6 + 4, (detectorID + "_rotationY").c_str(), rotationY, 0, -6.30, 6.30);
+                residualFitter->SetParameter(det * 6 + 5, (detectorID + "_rotationZ").c_str(), rotationZ, 0, -6.30, 6.30);
+            }
 
             // Set the alignment parameters of this plane to be the optimised values
             // from the alignment
@@ -363,4 +668,5 @@ void AlignmentTrackChi2::finalize(const std::shared_ptr<ReadonlyClipboard>& clip
     // Clean up local track storage
     AlignmentTrackChi2::globalTracks.clear();
     AlignmentTrackChi2::globalDetector.reset();
+    m_cache = TrackCache();
 }
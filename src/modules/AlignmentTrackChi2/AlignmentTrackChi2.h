@@ -13,11 +13,15 @@
 
 // ROOT includes
 #include <Math/Functor.h>
+#include <Math/IFunction.h>
 #include <Minuit2/Minuit2Minimizer.h>
 #include <TError.h>
 #include <TGraph.h>
 #include <TH1F.h>
 #include <TProfile.h>
+#include <array>
+#include <memory>
+#include <vector>
 
 #include "core/module/Module.hpp"
 #include "core/utils/ThreadPool.hpp"
@@ -26,6 +30,79 @@
 
 namespace corryvreckan {
 
+    /**
+     * @brief Clusters of straight line tracks in structure-of-arrays layout, stored consecutively per track
+     *
+     * The clusters of track i are found between offsets[i] and offsets[i + 1]. Their global positions are updated from the
+     * local positions whenever the alignment of their detector changes.
+     */
+    struct TrackCache {
+        std::vector<size_t> offsets{0};
+        std::vector<size_t> plane;
+        std::vector<double> local_x, local_y, local_z;
+        std::vector<double> global_x, global_y, global_z;
+        std::vector<double> weight_x, weight_y;
+
+        size_t tracks() const { return offsets.size() - 1; }
+    };
+
+    /**
+     * @brief Sum of the chi2 of all straight line tracks refitted to the clusters of the cache, as function of the six
+     * alignment parameters of one detector, with analytic gradient
+     *
+     * The parameters are the displacement along x, y and z followed by the three rotation angles. Evaluating the function
+     * updates the detector and the global positions of its clusters in the cache. Only the tracks with a cluster on the
+     * detector are refitted, the chi2 of all other tracks is constant. Since the track parameters minimize the chi2 of each
+     * track, the gradient follows from the derivatives of the residuals on the detector at fixed track parameters.
+     */
+    class TrackChi2 : public ROOT::Math::IGradientFunctionMultiDim {
+    public:
+        /**
+         * @brief Construct the function for one detector
+         * @param detector Detector to align
+         * @param plane Index of the detector in the cache
+         * @param cache Clusters of all tracks
+         * @param tracks Indices of the tracks with a cluster on the detector
+         * @param constant_chi2 Summed chi2 of all other tracks
+         * @param thread_pool Thread pool to refit batches of tracks on
+         */
+        TrackChi2(std::shared_ptr<Detector> detector,
+                  size_t plane,
+                  TrackCache* cache,
+                  const std::vector<size_t>* tracks,
+                  double constant_chi2,
+                  ThreadPool* thread_pool);
+
+        TrackChi2* Clone() const override { return new TrackChi2(*this); }
+        unsigned int NDim() const override { return 6; }
+
+        void Gradient(const double* par, double* grad) const override;
+        void FdF(const double* par, double& value, double* grad) const override;
+
+    private:
+        double DoEval(const double* par) const override;
+        double DoDerivative(const double* par, unsigned int coordinate) const override;
+
+        /**
+         * @brief Evaluate value and gradient unless they are cached for the given parameters
+         * @param par Alignment parameters
+         */
+        void evaluate(const double* par) const;
+
+        std::shared_ptr<Detector> detector_;
+        size_t plane_;
+        TrackCache* cache_;
+        const std::vector<size_t>* tracks_;
+        double constant_chi2_;
+        ThreadPool* thread_pool_;
+
+        // Result of the last evaluation
+        mutable bool cached_{};
+        mutable std::array<double, 6> parameters_{};
+        mutable double value_{};
+        mutable std::array<double, 6> gradient_{};
+    };
+
     /** @ingroup Modules
      */
     class AlignmentTrackChi2 : public Module {
@@ -41,6 +118,22 @@ namespace corryvreckan {
 
     private:
         static void MinimiseTrackChi2(Int_t& npar, Double_t* grad, Double_t& result, Double_t* par, Int_t flag);
+
+        /**
+         * @brief Store the clusters of straight line tracks in the track cache
+         * @param tracks Tracks to store
+         * @return True if all tracks are straight line tracks and have been stored, false otherwise
+         */
+        bool fill_cache(const TrackVector& tracks);
+
+        /**
+         * @brief Minimize the chi2 of the cached tracks with respect to the alignment of one detector
+         * @param detector Detector to align
+         * @param plane Index of the detector in the cache
+         * @return Alignment parameters at the minimum
+         */
+        std::array<double, 6> minimize_cached(const std::shared_ptr<Detector>& detector, size_t plane);
+
         // Member variables
         int m_discardedtracks{};
 
@@ -53,11 +146,16 @@ namespace corryvreckan {
         unsigned int m_workers;
         size_t nIterations;
         bool m_pruneTracks;
+        bool m_analyticGradient;
         bool m_alignPosition;
         bool m_alignOrientation;
         size_t m_maxAssocClusters;
         double m_maxTrackChi2;
 
+        // Clusters of all straight line tracks, with the detectors in the order of their planes in the cache
+        TrackCache m_cache;
+        std::vector<std::shared_ptr<Detector>> m_cachePlanes;
+
         std::map<std::string, TGraph*> align_correction_shiftX;
         std::map<std::string, TGraph*> align_correction_shiftY;
         std::map<std::string, TGraph*> align_correction_rotX;
@@ -17,6 +17,9 @@ using namespace std;
 Clustering4D::Clustering4D(Configuration& config, std::shared_ptr<Detector> detector)
     : Module(config, detector), m_detector(detector) {
 
+    // Events are clustered independently, the module can process multiple events concurrently
+    allow_multithreading();
+
     // Backwards compatibility: also allow timing_cut to be used for time_cut_abs
     config_.setAlias("time_cut_abs", "timing_cut", true);
     config_.setAlias("neighbor_radius_row", "neighbour_radius_row", true);
@@ -44,64 +47,68 @@ Clustering4D::Clustering4D(Configuration& config, std::shared_ptr<Detector> dete
 
 void Clustering4D::initialize() {
 
+    // Clipboard collections accessed for every event
+    pixel_collection_ = Clipboard::registerCollection<Pixel>(m_detector->getName());
+    cluster_collection_ = Clipboard::registerCollection<Cluster>(m_detector->getName());
+
     // Cluster plots
     std::string title = m_detector->getName() + " Cluster size;cluster size;events";
-    clusterSize = new TH1F("clusterSize", title.c_str(), 100, -0.5, 99.5);
+    clusterSize = create_histogram<TH1F>("clusterSize", title.c_str(), 100, -0.5, 99.5);
     title = m_detector->getName() + " Cluster seed charge;cluster seed charge [e];events";
-    clusterSeedCharge = new TH1F("clusterSeedCharge", title.c_str(), 256, -0.5, 255.5);
+    clusterSeedCharge = create_histogram<TH1F>("clusterSeedCharge", title.c_str(), 256, -0.5, 255.5);
     title = m_detector->getName() + " Cluster Width - Rows;cluster width [rows];events";
-    clusterWidthRow = new TH1F("clusterWidthRow", title.c_str(), 25, -0.5, 24.5);
+    clusterWidthRow = create_histogram<TH1F>("clusterWidthRow", title.c_str(), 25, -0.5, 24.5);
     title = m_detector->getName() + " Cluster Width - Columns;cluster width [columns];events";
-    clusterWidthColumn = new TH1F("clusterWidthColumn", title.c_str(), 100, -0.5, 99.5);
+    clusterWidthColumn = create_histogram<TH1F>("clusterWidthColumn", title.c_str(), 100, -0.5, 99.5);
     title = m_detector->getName() + " Cluster Charge;cluster charge [e];events";
-    clusterCharge = new TH1F("clusterCharge", title.c_str(), 5000, -0.5, 49999.5);
+    clusterCharge = create_histogram<TH1F>("clusterCharge", title.c_str(), 5000, -0.5, 49999.5);
     title = m_detector->getName() + " Cluster Charge (1px clusters);cluster charge [e];events";
-    clusterCharge_1px = new TH1F("clusterCharge_1px", title.c_str(), 256, -0.5, 255.5);
+    clusterCharge_1px = create_histogram<TH1F>("clusterCharge_1px", title.c_str(), 256, -0.5, 255.5);
     title = m_detector->getName() + " Cluster Charge (2px clusters);cluster charge [e];events";
-    clusterCharge_2px = new TH1F("clusterCharge_2px", title.c_str(), 256, -0.5, 255.5);
+    clusterCharge_2px = create_histogram<TH1F>("clusterCharge_2px", title.c_str(), 256, -0.5, 255.5);
     title = m_detector->getName() + " Cluster Charge (3px clusters);cluster charge [e];events";
-    clusterCharge_3px = new TH1F("clusterCharge_3px", title.c_str(), 256, -0.5, 255.5);
+    clusterCharge_3px = create_histogram<TH1F>("clusterCharge_3px", title.c_str(), 256, -0.5, 255.5);
     title = m_detector->getName() + " Cluster Position (Global);x [mm];y [mm];events";
-    clusterPositionGlobal = new TH2F("clusterPositionGlobal",
-                                     title.c_str(),
-                                     400,
-                                     -m_detector->getSize().X() / 1.5,
-                                     m_detector->getSize().X() / 1.5,
-                                     400,
-                                     -m_detector->getSize().Y() / 1.5,
-                                     m_detector->getSize().Y() / 1.5);
+    clusterPositionGlobal = create_histogram<TH2F>("clusterPositionGlobal",
+                                                   title.c_str(),
+                                                   400,
+                                                   -m_detector->getSize().X() / 1.5,
+                                                   m_detector->getSize().X() / 1.5,
+                                                   400,
+                                                   -m_detector->getSize().Y() / 1.5,
+                                                   m_detector->getSize().Y() / 1.5);
     title = m_detector->getName() + " Cluster Position (Local);x [px];y [px];events";
-    clusterPositionLocal = new TH2F("clusterPositionLocal",
-                                    title.c_str(),
-                                    m_detector->nPixels().X(),
-                                    -0.5,
-                                    m_detector->nPixels().X() - 0.5,
-                                    m_detector->nPixels().Y(),
-                                    -0.5,
-                                    m_detector->nPixels().Y() - 0.5);
+    clusterPositionLocal = create_histogram<TH2F>("clusterPositionLocal",
+                                                  title.c_str(),
+                                                  m_detector->nPixels().X(),
+                                                  -0.5,
+                                                  m_detector->nPixels().X() - 0.5,
+                                                  m_detector->nPixels().Y(),
+                                                  -0.5,
+                                                  m_detector->nPixels().Y() - 0.5);
 
     title = ";cluster timestamp [ns]; # events";
-    clusterTimes = new TH1F("clusterTimes", title.c_str(), 3e6, 0, 3e9);
+    clusterTimes = create_shared_histogram<TH1F>("clusterTimes", title.c_str(), 3e6, 0, 3e9);
     title = m_detector->getName() + " Cluster multiplicity;clusters;events";
-    clusterMultiplicity = new TH1F("clusterMultiplicity", title.c_str(), 50, -0.5, 49.5);
+    clusterMultiplicity = create_histogram<TH1F>("clusterMultiplicity", title.c_str(), 50, -0.5, 49.5);
     title =
         m_detector->getName() + " pixel - seed pixel timestamp (all pixels w/o seed);ts_{pixel} - ts_ {seed} [ns];events";
-    pxTimeMinusSeedTime = new TH1F("pxTimeMinusSeedTime", title.c_str(), 1000, -99.5 * 1.5625, 900.5 * 1.5625);
+    pxTimeMinusSeedTime = create_histogram<TH1F>("pxTimeMinusSeedTime", title.c_str(), 1000, -99.5 * 1.5625, 900.5 * 1.5625);
     title = m_detector->getName() +
             " pixel - seed pixel timestamp (all pixels w/o seed);ts_{pixel} - ts_ {seed} [ns]; pixel charge [e];events";
-    pxTimeMinusSeedTime_vs_pxCharge =
-        new TH2F("pxTimeMinusSeedTime_vs_pxCharge", title.c_str(), 1000, -99.5 * 1.5625, 900.5 * 1.5625, 256, -0.5, 255.5);
+    pxTimeMinusSeedTime_vs_pxCharge = create_histogram<TH2F>(
+        "pxTimeMinusSeedTime_vs_pxCharge", title.c_str(), 1000, -99.5 * 1.5625, 900.5 * 1.5625, 256, -0.5, 255.5);
     title = m_detector->getName() +
             " pixel - seed pixel timestamp (all pixels w/o seed);ts_{pixel} - ts_ {seed} [ns]; pixel charge [e];events";
-    pxTimeMinusSeedTime_vs_pxCharge_2px = new TH2F(
+    pxTimeMinusSeedTime_vs_pxCharge_2px = create_histogram<TH2F>(
         "pxTimeMinusSeedTime_vs_pxCharge_2px", title.c_str(), 1000, -99.5 * 1.5625, 900.5 * 1.5625, 256, -0.5, 255.5);
     title = m_detector->getName() +
             " pixel - seed pixel timestamp (all pixels w/o seed);ts_{pixel} - ts_ {seed} [ns]; pixel charge [e];events";
-    pxTimeMinusSeedTime_vs_pxCharge_3px = new TH2F(
+    pxTimeMinusSeedTime_vs_pxCharge_3px = create_histogram<TH2F>(
         "pxTimeMinusSeedTime_vs_pxCharge_3px", title.c_str(), 1000, -99.5 * 1.5625, 900.5 * 1.5625, 256, -0.5, 255.5);
     title = m_detector->getName() +
             " pixel - seed pixel timestamp (all pixels w/o seed);ts_{pixel} - ts_ {seed} [ns]; pixel charge [e];events";
-    pxTimeMinusSeedTime_vs_pxCharge_4px = new TH2F(
+    pxTimeMinusSeedTime_vs_pxCharge_4px = create_histogram<TH2F>(
         "pxTimeMinusSeedTime_vs_pxCharge_4px", title.c_str(), 1000, -99.5 * 1.5625, 900.5 * 1.5625, 256, -0.5, 255.5);
 
     // Get resolution in time of detector and calculate time cut to be applied
@@ -117,7 +124,7 @@ bool Clustering4D::sortByTime(const std::shared_ptr<Pixel>& pixel1, const std::s
 StatusCode Clustering4D::run(const std::shared_ptr<Clipboard>& clipboard) {
 
     // Get the pixels
-    auto pixels = clipboard->getData<Pixel>(m_detector->getName());
+    auto pixels = clipboard->getData(pixel_collection_);
     if(pixels.empty()) {
         LOG(DEBUG) << "Detector " << m_detector->getName() << " does not have any pixels on the clipboard";
         clusterMultiplicity->Fill(0);
@@ -132,53 +139,131 @@ StatusCode Clustering4D::run(const std::shared_ptr<Clipboard>& clipboard) {
     // Make the cluster storage
     ClusterVector deviceClusters;
 
-    // Keep track of which pixels are used
-    map<Pixel*, bool> used;
+    // Keep track of which pixels are used, indexed by their position in the time-sorted list
+    std::vector<char> used(totalPixels, false);
+
+    // Determine the extent of the hit pixel matrix. Bounds are taken from the data rather than the detector geometry since
+    // pixel indices may also be negative, e.g. for axial coordinates of hexagonal pixel matrices
+    auto col_range = std::minmax_element(pixels.begin(), pixels.end(), [](const auto& px1, const auto& px2) {
+        return px1->column() < px2->column();
+    });
+    auto row_range = std::minmax_element(
+        pixels.begin(), pixels.end(), [](const auto& px1, const auto& px2) { return px1->row() < px2->row(); });
+    const int min_col = (*col_range.first)->column();
+    const int min_row = (*row_range.first)->row();
+    const auto n_cols = static_cast<size_t>((*col_range.second)->column() - min_col + 1);
+    const auto n_rows = static_cast<size_t>((*row_range.second)->row() - min_row + 1);
+    auto cell_of = [&](const Pixel* px) {
+        return static_cast<size_t>(px->column() - min_col) * n_rows + static_cast<size_t>(px->row() - min_row);
+    };
+
+    // Occupancy grid of pixels active within the time window of the current seed. Each cell holds the index of the first
+    // pixel in a singly-linked list of all active pixels on this column and row, linked through next_pixel. The grid buffer
+    // is kept per thread and cleared sparsely after use, such that its allocation does not scale with the event rate.
+    static thread_local std::vector<int> grid;
+    if(grid.size() < n_cols * n_rows) {
+        grid.resize(n_cols * n_rows, -1);
+    }
+    std::vector<int> next_pixel(totalPixels, -1);
+    size_t window_end = 0;
+
+    // Search range on the grid around each cluster pixel. The detector decides on the neighbor relation itself, the box
+    // only needs to enclose all candidates - for hexagonal pixels the column radius applies in both directions
+    const int search_radius_col = std::max(neighbor_radius_col_, neighbor_radius_row_);
+    const int search_radius_row = search_radius_col;
+
+    std::vector<size_t> queue;
+    std::vector<int> candidates;
 
     // Start to cluster
-    for(size_t iP = 0; iP < pixels.size(); iP++) {
+    for(size_t iP = 0; iP < totalPixels; iP++) {
         Pixel* pixel = pixels[iP].get();
 
         // Check if pixel is used
-        if(used[pixel]) {
+        if(used[iP]) {
             continue;
         }
 
-        // Make the new cluster object
-        auto cluster = std::make_shared<Cluster>();
-        LOG(DEBUG) << "==== New cluster";
+        // Activate all pixels compatible in time with the seed. All pixels earlier than the seed have already been used
+        double clusterTime = pixel->timestamp();
+        while(window_end < totalPixels && abs(pixels[window_end]->timestamp() - clusterTime) <= time_cut_) {
+            auto& head = grid[cell_of(pixels[window_end].get())];
+            next_pixel[window_end] = head;
+            head = static_cast<int>(window_end);
+            window_end++;
+        }
 
-        // Keep adding hits to the cluster until no more are found
+        // Find all pixels connected to the seed by visiting the grid neighborhood of each pixel added
+        auto cluster = make_pooled<Cluster>();
         cluster->addPixel(pixel);
-        double clusterTime = pixel->timestamp();
-        used[pixel] = true;
-        LOG(DEBUG) << "Adding pixel: " << pixel->column() << "," << pixel->row();
-        size_t nPixels = 0;
-        while(cluster->size() != nPixels) {
-
-            nPixels = cluster->size();
-            // Loop over all pixels
-            for(size_t iNeighbour = (iP + 1); iNeighbour < totalPixels; iNeighbour++) {
-                auto neighbor = pixels[iNeighbour];
-                // Check if they are compatible in time with the cluster pixels
-                if(abs(neighbor->timestamp() - clusterTime) > time_cut_)
-                    break;
-
-                // Check if they have been used
-                if(used[neighbor.get()])
-                    continue;
+        used[iP] = true;
+        queue.assign(1, iP);
+        for(size_t iQ = 0; iQ < queue.size(); iQ++) {
+            const auto* current = pixels[queue[iQ]].get();
+
+            // Collect unused active pixels in the search box, unlinking used ones on the way
+            candidates.clear();
+            const int col_low = std::max(current->column() - search_radius_col, min_col);
+            const int col_high = std::min(current->column() + search_radius_col, min_col + static_cast<int>(n_cols) - 1);
+            const int row_low = std::max(current->row() - search_radius_row, min_row);
+            const int row_high = std::min(current->row() + search_radius_row, min_row + static_cast<int>(n_rows) - 1);
+            for(int col = col_low; col <= col_high; col++) {
+                for(int row = row_low; row <= row_high; row++) {
+                    auto* link = &grid[static_cast<size_t>(col - min_col) * n_rows + static_cast<size_t>(row - min_row)];
+                    while(*link >= 0) {
+                        if(used[static_cast<size_t>(*link)]) {
+                            *link = next_pixel[static_cast<size_t>(*link)];
+                            continue;
+                        }
+                        candidates.push_back(*link);
+                        link = &next_pixel[static_cast<size_t>(*link)];
+                    }
+                }
+            }
 
+            std::sort(candidates.begin(), candidates.end());
+            for(const auto& candidate : candidates) {
                 // Check if they are touching cluster pixels
-                if(!m_detector->isNeighbor(neighbor, cluster, neighbor_radius_row_, neighbor_radius_col_))
+                if(!m_detector->isNeighbor(pixels[static_cast<size_t>(candidate)], cluster, neighbor_radius_row_,
+                                           neighbor_radius_col_)) {
                     continue;
+                }
+                cluster->addPixel(pixels[static_cast<size_t>(candidate)].get());
+                used[static_cast<size_t>(candidate)] = true;
+                queue.push_back(static_cast<size_t>(candidate));
+            }
+        }
 
-                // Add to cluster
-                cluster->addPixel(neighbor.get());
-                clusterTime = (neighbor->timestamp() < clusterTime) ? neighbor->timestamp() : clusterTime;
-                used[neighbor.get()] = true;
-                LOG(DEBUG) << "Adding pixel: " << neighbor->column() << "," << neighbor->row() << " time "
-                           << Units::display(neighbor->timestamp(), {"ns", "us", "s"});
+        // Build the final cluster from the connected pixels in time order. Pixels only connected to the cluster through
+        // later pixels are picked up in subsequent passes, such that pixel order and split flag do not depend on the grid
+        if(queue.size() > 1) {
+            std::sort(queue.begin() + 1, queue.end());
+            cluster = make_pooled<Cluster>();
+            LOG(DEBUG) << "==== New cluster";
+            cluster->addPixel(pixel);
+            LOG(DEBUG) << "Adding pixel: " << pixel->column() << "," << pixel->row();
+            queue.front() = totalPixels;
+            size_t nPixels = 0;
+            while(cluster->size() != nPixels) {
+                nPixels = cluster->size();
+                for(auto& iNeighbour : queue) {
+                    // Skip the seed and pixels added in previous passes
+                    if(iNeighbour == totalPixels) {
+                        continue;
+                    }
+                    const auto& neighbor = pixels[iNeighbour];
+                    if(!m_detector->isNeighbor(neighbor, cluster, neighbor_radius_row_, neighbor_radius_col_)) {
+                        continue;
+                    }
+                    cluster->addPixel(neighbor.get());
+                    iNeighbour = totalPixels;
+                    LOG(DEBUG) << "Adding pixel: " << neighbor->column() << "," << neighbor->row() << " time "
+                               << Units::display(neighbor->timestamp(), {"ns", "us", "s"});
+                }
             }
+        } else {
+            LOG(DEBUG) << "==== New cluster";
+            LOG(DEBUG) << "Adding pixel: " << pixel->column() << "," << pixel->row();
         }
 
         // Finalise the cluster and save it
@@ -232,10 +317,26 @@ StatusCode Clustering4D::run(const std::shared_ptr<Clipboard>& clipboard) {
         deviceClusters.push_back(cluster);
     }
 
+    // Leave the grid empty for the next event processed by this thread
+    for(const auto& pixel : pixels) {
+        grid[cell_of(pixel.get())] = -1;
+    }
+
+    // Release the grid if it is far larger than the average hit matrix extent of recent events, such that a single event
+    // with a wide spread of pixel indices does not keep its memory allocated for the rest of the run
+    static thread_local double average_grid_size = 0;
+    static thread_local size_t grid_events = 0;
+    grid_events = std::min<size_t>(grid_events + 1, 64);
+    average_grid_size += (static_cast<double>(n_cols * n_rows) - average_grid_size) / static_cast<double>(grid_events);
+    if(grid.size() > (1 << 16) && static_cast<double>(grid.size()) > 8 * average_grid_size) {
+        LOG(DEBUG) << "Releasing clustering grid of " << grid.size() << " cells";
+        std::vector<int>().swap(grid);
+    }
+
     clusterMultiplicity->Fill(static_cast<double>(deviceClusters.size()));
 
     // Put the clusters on the clipboard
-    clipboard->putData(deviceClusters, m_detector->getName());
+    clipboard->putData(deviceClusters, cluster_collection_);
     LOG(DEBUG) << "Made " << deviceClusters.size() << " clusters for device " << m_detector->getName();
 
     return StatusCode::Success;
@@ -14,6 +14,7 @@
 #include <TCanvas.h>
 #include <TH1F.h>
 #include <TH2F.h>
+#include <algorithm>
 #include <iostream>
 #include "core/module/Module.hpp"
 #include "objects/Cluster.hpp"
@@ -35,28 +36,30 @@ namespace corryvreckan {
 
     private:
         std::shared_ptr<Detector> m_detector;
+        CollectionHandle<Pixel> pixel_collection_;
+        CollectionHandle<Cluster> cluster_collection_;
         static bool sortByTime(const std::shared_ptr<Pixel>& pixel1, const std::shared_ptr<Pixel>& pixel2);
         void calculateClusterCentre(Cluster*);
         bool closeInTime(Pixel*, Cluster*);
 
         // Cluster histograms
-        TH1F* clusterSize;
-        TH1F* clusterSeedCharge;
-        TH1F* clusterWidthRow;
-        TH1F* clusterWidthColumn;
-        TH1F* clusterCharge;
-        TH1F* clusterCharge_1px;
-        TH1F* clusterCharge_2px;
-        TH1F* clusterCharge_3px;
-        TH2F* clusterPositionGlobal;
-        TH2F* clusterPositionLocal;
-        TH1F* clusterTimes;
-        TH1F* clusterMultiplicity;
-        TH1F* pxTimeMinusSeedTime;
-        TH2F* pxTimeMinusSeedTime_vs_pxCharge;
-        TH2F* pxTimeMinusSeedTime_vs_pxCharge_2px;
-        TH2F* pxTimeMinusSeedTime_vs_pxCharge_3px;
-        TH2F* pxTimeMinusSeedTime_vs_pxCharge_4px;
+        Histogram<TH1F> clusterSize;
+        Histogram<TH1F> clusterSeedCharge;
+        Histogram<TH1F> clusterWidthRow;
+        Histogram<TH1F> clusterWidthColumn;
+        Histogram<TH1F> clusterCharge;
+        Histogram<TH1F> clusterCharge_1px;
+        Histogram<TH1F> clusterCharge_2px;
+        Histogram<TH1F> clusterCharge_3px;
+        Histogram<TH2F> clusterPositionGlobal;
+        Histogram<TH2F> clusterPositionLocal;
+        Histogram<TH1F> clusterTimes;
+        Histogram<TH1F> clusterMultiplicity;
+        Histogram<TH1F> pxTimeMinusSeedTime;
+        Histogram<TH2F> pxTimeMinusSeedTime_vs_pxCharge;
+        Histogram<TH2F> pxTimeMinusSeedTime_vs_pxCharge_2px;
+        Histogram<TH2F> pxTimeMinusSeedTime_vs_pxCharge_3px;
+        Histogram<TH2F> pxTimeMinusSeedTime_vs_pxCharge_4px;
 
         double time_cut_;
         int neighbor_radius_row_;
@@ -17,6 +17,9 @@ using namespace std;
 ClusteringSpatial::ClusteringSpatial(Configuration& config, std::shared_ptr<Detector> detector)
     : Module(config, detector), m_detector(detector) {
 
+    // Events are clustered independently, the module can process multiple events concurrently
+    allow_multithreading();
+
     config_.setDefault<bool>("use_trigger_timestamp", false);
     config_.setDefault<bool>("charge_weighting", true);
     config_.setDefault<bool>("reject_by_roi", false);
@@ -28,74 +31,96 @@ ClusteringSpatial::ClusteringSpatial(Configuration& config, std::shared_ptr<Dete
 
 void ClusteringSpatial::initialize() {
 
+    // Clipboard collections accessed for every event
+    pixel_collection_ = Clipboard::registerCollection<Pixel>(m_detector->getName());
+    cluster_collection_ = Clipboard::registerCollection<Cluster>(m_detector->getName());
+
     // Cluster plots
     std::string title = m_detector->getName() + " Cluster size;cluster size;events";
-    clusterSize = new TH1F("clusterSize", title.c_str(), 100, -0.5, 99.5);
+    clusterSize = create_histogram<TH1F>("clusterSize", title.c_str(), 100, -0.5, 99.5);
     title = m_detector->getName() + " Cluster seed charge;cluster seed charge [e];events";
-    clusterSeedCharge = new TH1F("clusterSeedCharge", title.c_str(), 256, -0.5, 255.5);
+    clusterSeedCharge = create_histogram<TH1F>("clusterSeedCharge", title.c_str(), 256, -0.5, 255.5);
     title = m_detector->getName() + " Cluster Width - Rows;cluster width [rows];events";
-    clusterWidthRow = new TH1F("clusterWidthRow", title.c_str(), 25, -0.5, 24.5);
+    clusterWidthRow = create_histogram<TH1F>("clusterWidthRow", title.c_str(), 25, -0.5, 24.5);
     title = m_detector->getName() + " Cluster Width - Columns;cluster width [columns];events";
-    clusterWidthColumn = new TH1F("clusterWidthColumn", title.c_str(), 100, -0.5, 99.5);
+    clusterWidthColumn = create_histogram<TH1F>("clusterWidthColumn", title.c_str(), 100, -0.5, 99.5);
     title = m_detector->getName() + " Cluster Charge;cluster charge [e];events";
-    clusterCharge = new TH1F("clusterCharge", title.c_str(), 5000, -0.5, 49999.5);
+    clusterCharge = create_histogram<TH1F>("clusterCharge", title.c_str(), 5000, -0.5, 49999.5);
     title = m_detector->getName() + " Cluster Position (Global);x [mm];y [mm];events";
-    clusterPositionGlobal = new TH2F("clusterPositionGlobal",
-                                     title.c_str(),
-                                     400,
-                                     -m_detector->getSize().X() / 1.5,
-                                     m_detector->getSize().X() / 1.5,
-                                     400,
-                                     -m_detector->getSize().Y() / 1.5,
-                                     m_detector->getSize().Y() / 1.5);
+    clusterPositionGlobal = create_histogram<TH2F>("clusterPositionGlobal",
+                                                   title.c_str(),
+                                                   400,
+                                                   -m_detector->getSize().X() / 1.5,
+                                                   m_detector->getSize().X() / 1.5,
+                                                   400,
+                                                   -m_detector->getSize().Y() / 1.5,
+                                                   m_detector->getSize().Y() / 1.5);
     title = m_detector->getName() + " Cluster Position (Local);x [px];y [px];events";
-    clusterPositionLocal = new TH2F("clusterPositionLocal",
-                                    title.c_str(),
-                                    m_detector->nPixels().X(),
-                                    -0.5,
-                                    m_detector->nPixels().X() - 0.5,
-                                    m_detector->nPixels().Y(),
-                                    -0.5,
-                                    m_detector->nPixels().Y() - 0.5);
+    clusterPositionLocal = create_histogram<TH2F>("clusterPositionLocal",
+                                                  title.c_str(),
+                                                  m_detector->nPixels().X(),
+                                                  -0.5,
+                                                  m_detector->nPixels().X() - 0.5,
+                                                  m_detector->nPixels().Y(),
+                                                  -0.5,
+                                                  m_detector->nPixels().Y() - 0.5);
 
     title = ";cluster timestamp [ns]; # events";
-    clusterTimes = new TH1F("clusterTimes", title.c_str(), 3e6, 0, 3e9);
+    clusterTimes = create_shared_histogram<TH1F>("clusterTimes", title.c_str(), 3e6, 0, 3e9);
     title = m_detector->getName() + " Cluster multiplicity;clusters;events";
-    clusterMultiplicity = new TH1F("clusterMultiplicity", title.c_str(), 50, -0.5, 49.5);
+    clusterMultiplicity = create_histogram<TH1F>("clusterMultiplicity", title.c_str(), 50, -0.5, 49.5);
 }
 
 StatusCode ClusteringSpatial::run(const std::shared_ptr<Clipboard>& clipboard) {
 
     // Get the pixels
-    auto pixels = clipboard->getData<Pixel>(m_detector->getName());
+    auto pixels = clipboard->getData(pixel_collection_);
     if(pixels.empty()) {
         LOG(DEBUG) << "Detector " << m_detector->getName() << " does not have any pixels on the clipboard";
         return StatusCode::Success;
     }
 
-    // Make the cluster container and the maps for clustering
+    // Make the cluster container
     ClusterVector deviceClusters;
-    map<std::shared_ptr<Pixel>, bool> used;
-    map<int, map<int, std::shared_ptr<Pixel>>> hitmap;
-    bool addedPixel;
 
     // Get the device dimensions
     int nRows = m_detector->nPixels().Y();
     int nCols = m_detector->nPixels().X();
 
-    // Pre-fill the hitmap with pixels
-    for(auto pixel : pixels) {
-        hitmap[pixel->column()][pixel->row()] = pixel;
+    // Dense hit map of the pixel matrix, holding the index of the pixel found at each position or -1 for empty cells. The
+    // buffer is kept per thread and only the filled cells are cleared after each event, so it is allocated only once
+    static thread_local std::vector<int> hitmap;
+    const auto n_cells = static_cast<size_t>(nCols) * static_cast<size_t>(nRows);
+    if(hitmap.size() < n_cells) {
+        hitmap.resize(n_cells, -1);
+    }
+    auto cell_of = [nRows](int col, int row) {
+        return static_cast<size_t>(col) * static_cast<size_t>(nRows) + static_cast<size_t>(row);
+    };
+    auto in_matrix = [nRows, nCols](int col, int row) { return col >= 0 && col < nCols && row >= 0 && row < nRows; };
+
+    // Pre-fill the hitmap with pixels. Pixels outside the matrix can never be reached as neighbors and are not stored
+    for(size_t iP = 0; iP < pixels.size(); iP++) {
+        if(in_matrix(pixels[iP]->column(), pixels[iP]->row())) {
+            hitmap[cell_of(pixels[iP]->column(), pixels[iP]->row())] = static_cast<int>(iP);
+        }
     }
 
-    for(auto pixel : pixels) {
-        if(used[pixel]) {
+    // Keep track of which pixels are used, indexed by their position on the clipboard
+    std::vector<char> used(pixels.size(), false);
+
+    // Somewhere to store found neighbors
+    std::vector<size_t> neighbors;
+
+    for(size_t iP = 0; iP < pixels.size(); iP++) {
+        if(used[iP]) {
             continue;
         }
+        auto* pixel = pixels[iP].get();
 
         // New pixel => new cluster
-        auto cluster = std::make_shared<Cluster>();
-        cluster->addPixel(&*pixel);
+        auto cluster = make_pooled<Cluster>();
+        cluster->addPixel(pixel);
 
         if(useTriggerTimestamp) {
             if(!clipboard->getEvent()->triggerList().empty()) {
@@ -114,48 +139,32 @@ StatusCode ClusteringSpatial::run(const std::shared_ptr<Clipboard>& clipboard) {
             cluster->setTimestamp(pixel->timestamp());
         }
 
-        used[pixel] = true;
-        addedPixel = true;
-        // Somewhere to store found neighbors
-        PixelVector neighbors;
+        used[iP] = true;
 
         // Now we check the neighbors and keep adding more hits while there are connected pixels
-        while(addedPixel) {
-
-            addedPixel = false;
+        while(pixel != nullptr) {
             for(int row = pixel->row() - 1; row <= pixel->row() + 1; row++) {
-                // If out of bounds for row
-                if(row < 0 || row >= nRows) {
-                    continue;
-                }
-
                 for(int col = pixel->column() - 1; col <= pixel->column() + 1; col++) {
-                    // If out of bounds for column
-                    if(col < 0 || col >= nCols) {
-                        continue;
-                    }
-
-                    // If no pixel in this position, or is already in a cluster, do nothing
-                    if(!hitmap[col][row]) {
+                    // If out of bounds, no pixel in this position, or is already in a cluster, do nothing
+                    if(!in_matrix(col, row)) {
                         continue;
                     }
-                    if(used[hitmap[col][row]]) {
+                    auto index = hitmap[cell_of(col, row)];
+                    if(index < 0 || used[static_cast<size_t>(index)]) {
                         continue;
                     }
 
-                    // Otherwise add the pixel to the cluster and store it as a found
-                    // neighbor
-                    cluster->addPixel(&*hitmap[col][row]);
-                    used[hitmap[col][row]] = true;
-                    neighbors.push_back(hitmap[col][row]);
+                    // Otherwise add the pixel to the cluster and store it as a found neighbor
+                    cluster->addPixel(pixels[static_cast<size_t>(index)].get());
+                    used[static_cast<size_t>(index)] = true;
+                    neighbors.push_back(static_cast<size_t>(index));
                 }
             }
 
-            // If we have neighbors that have not yet been checked, continue
-            // looking for more pixels
-            if(neighbors.size() > 0) {
-                addedPixel = true;
-                pixel = neighbors.back();
+            // If we have neighbors that have not yet been checked, continue looking for more pixels
+            pixel = nullptr;
+            if(!neighbors.empty()) {
+                pixel = pixels[neighbors.back()].get();
                 neighbors.pop_back();
             }
         }
@@ -184,9 +193,16 @@ StatusCode ClusteringSpatial::run(const std::shared_ptr<Clipboard>& clipboard) {
         deviceClusters.push_back(cluster);
     }
 
+    // Leave the hitmap empty for the next event processed by this thread
+    for(const auto& pixel : pixels) {
+        if(in_matrix(pixel->column(), pixel->row())) {
+            hitmap[cell_of(pixel->column(), pixel->row())] = -1;
+        }
+    }
+
     clusterMultiplicity->Fill(static_cast<double>(deviceClusters.size()));
 
-    clipboard->putData(deviceClusters, m_detector->getName());
+    clipboard->putData(deviceClusters, cluster_collection_);
     LOG(DEBUG) << "Put " << deviceClusters.size() << " clusters on the clipboard for detector " << m_detector->getName()
                << ". From " << pixels.size() << " pixels";
 
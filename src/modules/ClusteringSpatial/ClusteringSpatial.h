@@ -34,19 +34,21 @@ namespace corryvreckan {
 
     private:
         std::shared_ptr<Detector> m_detector;
+        CollectionHandle<Pixel> pixel_collection_;
+        CollectionHandle<Cluster> cluster_collection_;
 
         void calculateClusterCentre(Cluster*);
 
         // Cluster histograms
-        TH1F* clusterSize;
-        TH1F* clusterSeedCharge;
-        TH1F* clusterWidthRow;
-        TH1F* clusterWidthColumn;
-        TH1F* clusterCharge;
-        TH1F* clusterMultiplicity;
-        TH2F* clusterPositionGlobal;
-        TH2F* clusterPositionLocal;
-        TH1F* clusterTimes;
+        Histogram<TH1F> clusterSize;
+        Histogram<TH1F> clusterSeedCharge;
+        Histogram<TH1F> clusterWidthRow;
+        Histogram<TH1F> clusterWidthColumn;
+        Histogram<TH1F> clusterCharge;
+        Histogram<TH1F> clusterMultiplicity;
+        Histogram<TH2F> clusterPositionGlobal;
+        Histogram<TH2F> clusterPositionLocal;
+        Histogram<TH1F> clusterTimes;
 
         bool useTriggerTimestamp;
         bool chargeWeighting;
@@ -78,6 +78,13 @@ EventDefinitionM26::EventDefinitionM26(Configuration& config, std::vector<std::s
 }
 
 void EventDefinitionM26::initialize() {
+    // Skip the data before the partition of the run processed by this process
+    auto partition_begin = get_partition_begin_time();
+    if(partition_begin > skip_time_) {
+        LOG(INFO) << "Skipping data before partition start at " << Units::display(partition_begin, {"us", "ms", "s"});
+        skip_time_ = partition_begin;
+    }
+
     timebetweenMimosaEvents_ =
         new TH1F("htimebetweenTimes", "time between two mimosa frames; time /us; #entries", 1000, -0.5, 995.5);
     timebetweenTLUEvents_ =
@@ -9,11 +9,38 @@
  */
 
 #include "EventLoaderATLASpix.h"
+#include <array>
 #include <regex>
 
 using namespace corryvreckan;
 using namespace std;
 
+namespace {
+    // Lookup table for the decoding of gray encoded timestamps of up to 10 bits, generated at compile time
+    constexpr std::array<uint16_t, 1024> gray_lut = [] {
+        std::array<uint16_t, 1024> lut{};
+        for(uint32_t gray = 0; gray < lut.size(); ++gray) {
+            uint32_t bin = gray;
+            for(uint32_t shifted = gray >> 1; shifted != 0; shifted >>= 1) {
+                bin ^= shifted;
+            }
+            lut[gray] = static_cast<uint16_t>(bin);
+        }
+        return lut;
+    }();
+
+    // Every entry of the table has to encode back to its gray code
+    constexpr bool gray_lut_valid() {
+        for(uint32_t gray = 0; gray < gray_lut.size(); ++gray) {
+            if((gray_lut[gray] ^ (gray_lut[gray] >> 1U)) != gray) {
+                return false;
+            }
+        }
+        return true;
+    }
+    static_assert(gray_lut_valid(), "Invalid gray code lookup table");
+} // namespace
+
 EventLoaderATLASpix::EventLoaderATLASpix(Configuration& config, std::shared_ptr<Detector> detector)
     : Module(config, detector), m_detector(detector) {
 
@@ -38,6 +65,10 @@ EventLoaderATLASpix::EventLoaderATLASpix(Configuration& config, std::shared_ptr<
 }
 
 uint32_t EventLoaderATLASpix::gray_decode(uint32_t gray) {
+    if(gray < gray_lut.size()) {
+        return gray_lut[gray];
+    }
+
     uint32_t bin = gray;
     while(gray >>= 1) {
         bin ^= gray;
@@ -416,7 +447,7 @@ bool EventLoaderATLASpix::read_caribou_data() { // return false when reaching eo
         LOG(DEBUG) << "Adding time_offset of " << m_time_offset << " to pixel timestamp. New pixel timestamp: " << timestamp;
 
         // since calibration is not implemented yet, set charge = tot
-        auto pixel = std::make_shared<Pixel>(m_detector->getName(), col, row, tot, tot, timestamp);
+        auto pixel = make_pooled<Pixel>(m_detector->getName(), col, row, tot, tot, timestamp);
 
         // FIXME: implement conversion from ToT to charge:
         // thres-->e: 1620e/0.15V, or 1080e/100mV
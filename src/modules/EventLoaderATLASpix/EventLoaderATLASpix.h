@@ -18,7 +18,6 @@
 #include <dirent.h>
 #include <fstream>
 #include <iostream>
-#include <queue>
 #include <sstream>
 #include <stdio.h>
 #include <string.h>
@@ -26,6 +25,7 @@
 #include "objects/Cluster.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/Track.hpp"
+#include "tools/time_sorted_buffer.h"
 
 namespace corryvreckan {
     /** @ingroup Modules
@@ -43,9 +43,9 @@ namespace corryvreckan {
 
     private:
         /*
-         * @brief Converts gray encoded data to binary number
+         * @brief Converts gray encoded data to binary number, using a lookup table for values of up to 10 bits
          */
-        uint32_t gray_decode(uint32_t gray);
+        static uint32_t gray_decode(uint32_t gray);
 
         /*
          * @brief Read data in the format written by the Caribou readout system and fill time-sorted buffer
@@ -53,14 +53,8 @@ namespace corryvreckan {
          */
         bool read_caribou_data();
 
-        // custom comparator for time-sorted priority_queue
-        struct CompareTimeGreater {
-            bool operator()(const std::shared_ptr<Pixel> a, const std::shared_ptr<Pixel> b) {
-                return a->timestamp() > b->timestamp();
-            }
-        };
-        // Buffer of timesorted pixel hits: (need to use greater here!)
-        std::priority_queue<std::shared_ptr<Pixel>, PixelVector, CompareTimeGreater> sorted_pixels_;
+        // Buffer of timesorted pixel hits, using buckets of 1us
+        TimeSortedBuffer<std::shared_ptr<Pixel>> sorted_pixels_{Units::get<double>(1, "us")};
 
         std::shared_ptr<Detector> m_detector;
         std::string m_filename;
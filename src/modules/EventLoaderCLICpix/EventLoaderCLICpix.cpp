@@ -48,7 +48,7 @@ void EventLoaderCLICpix::initialize() {
     }
 
     // Open the data file for later
-    m_file.open(m_filename.c_str());
+    m_file.open(m_filename);
 
     // Make histograms for debugging
     hHitMap = new TH2F("hitMap", "hitMap", 64, -0.5, 63.5, 64, -0.5, 63.5);
@@ -70,11 +70,11 @@ StatusCode EventLoaderCLICpix::run(const std::shared_ptr<Clipboard>& clipboard)
     // Pixel container, shutter information
     PixelVector pixels;
     double shutterStartTime = 0, shutterStopTime = 0;
-    string data;
+    std::string_view data;
 
     int npixels = 0;
     // Read file and load data
-    while(getline(m_file, data)) {
+    while(m_file.getline(data)) {
 
         //    LOG(TRACE) <<"Data: "<<data;
 
@@ -83,34 +83,34 @@ StatusCode EventLoaderCLICpix::run(const std::shared_ptr<Clipboard>& clipboard)
             break;
 
         // Check if this is a header/shutter/power info
-        if(data.find("PWR_RISE") != string::npos || data.find("PWR_FALL") != string::npos)
+        if(data.find("PWR_RISE") != std::string_view::npos || data.find("PWR_FALL") != std::string_view::npos)
             continue;
-        if(data.find("SHT_RISE") != string::npos) {
+        if(data.find("SHT_RISE") != std::string_view::npos) {
             // Read the shutter start time
-            long int timeInt;
-            string name;
-            istringstream header(data);
-            header >> name >> timeInt;
+            long int timeInt = 0;
+            next_token(data);
+            next_integer(data, timeInt);
             shutterStartTime = static_cast<double>(timeInt) / (0.04);
             LOG(TRACE) << "Shutter rise time: " << Units::display(shutterStartTime, {"ns", "us", "s"});
             continue;
         }
-        if(data.find("SHT_FALL") != string::npos) {
+        if(data.find("SHT_FALL") != std::string_view::npos) {
             // Read the shutter stop time
-            long int timeInt;
-            string name;
-            istringstream header(data);
-            header >> name >> timeInt;
+            long int timeInt = 0;
+            next_token(data);
+            next_integer(data, timeInt);
             shutterStopTime = static_cast<double>(timeInt) / (0.04);
             LOG(TRACE) << "Shutter fall time: " << Units::display(shutterStopTime, {"ns", "us", "s"});
             continue;
         }
 
         // Otherwise load data
-        int row, col, counter, tot(0);
+        int row = 0, col = 0, counter = 0, tot(0);
         LOG(TRACE) << "Pixel data: " << data;
-        istringstream pixelData(data);
-        pixelData >> col >> row >> counter >> tot;
+        next_integer(data, col);
+        next_integer(data, row);
+        next_integer(data, counter);
+        next_integer(data, tot);
         tot++;
         row = 63 - row;
         LOG(TRACE) << "New pixel: " << col << "," << row << " with tot " << tot;
@@ -124,7 +124,7 @@ StatusCode EventLoaderCLICpix::run(const std::shared_ptr<Clipboard>& clipboard)
             continue;
 
         // when calibration is not available, set charge = tot
-        auto pixel = std::make_shared<Pixel>(m_detector->getName(), col, row, tot, tot, 0);
+        auto pixel = make_pooled<Pixel>(m_detector->getName(), col, row, tot, tot, 0);
         pixels.push_back(pixel);
         npixels++;
         hHitMap->Fill(col, row);
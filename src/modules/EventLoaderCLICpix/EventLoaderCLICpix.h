@@ -23,6 +23,7 @@
 #include "objects/Cluster.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/Track.hpp"
+#include "tools/line_reader.h"
 
 namespace corryvreckan {
     /** @ingroup Modules
@@ -44,7 +45,7 @@ namespace corryvreckan {
         // Member variables
         int m_eventNumber;
         std::string m_filename;
-        std::ifstream m_file;
+        LineReader m_file;
 
         TH2F* hHitMap;
         TH1F* hPixelToT;
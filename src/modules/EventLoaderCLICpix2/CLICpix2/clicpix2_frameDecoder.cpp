@@ -6,6 +6,23 @@
 
 using namespace caribou;
 
+namespace {
+    // FNV-1a hash over the entries of a lookup table
+    template <typename T, size_t N> constexpr uint64_t lut_checksum(const std::array<T, N>& lut) {
+        uint64_t hash = 0xcbf29ce484222325;
+        for(const auto& entry : lut) {
+            hash ^= entry;
+            hash *= 0x100000001b3;
+        }
+        return hash;
+    }
+
+    // The generated tables have to reproduce the lookup tables previously stored in the source code
+    static_assert(lut_checksum(clicpix2_frameDecoder::lfsr13_lut) == 0x25D92EBD501A01CC, "Invalid LFSR13 lookup table");
+    static_assert(lut_checksum(clicpix2_frameDecoder::lfsr8_lut) == 0xD432AD4DB9C60EF8, "Invalid LFSR8 lookup table");
+    static_assert(lut_checksum(clicpix2_frameDecoder::lfsr5_lut) == 0x7DE5F7337E11E9BE, "Invalid LFSR5 lookup table");
+} // namespace
+
 const clicpix2_frameDecoder::WORD_TYPE clicpix2_frameDecoder::DELIMITER(1, 0xf7);
 
 clicpix2_frameDecoder::clicpix2_frameDecoder(const bool pixelCompression,
@@ -15,7 +32,9 @@ clicpix2_frameDecoder::clicpix2_frameDecoder(const bool pixelCompression,
 
     // Resolve and store long-counter states:
     for(const auto& pixel : pixel_conf) {
-        counter_config[pixel.first.first][pixel.first.second] = pixel.second.GetLongCounter();
+        if(pixel.first.first < CLICPIX2_ROW && pixel.first.second < CLICPIX2_COL) {
+            counter_config[pixel.first.first][pixel.first.second] = pixel.second.GetLongCounter();
+        }
     }
 }
 
@@ -55,6 +74,7 @@ pearydata clicpix2_frameDecoder::getZerosuppressedFrame() {
 
 std::vector<clicpix2_frameDecoder::WORD_TYPE> clicpix2_frameDecoder::repackageFrame(const std::vector<uint32_t>& frame) {
     std::vector<WORD_TYPE> data;
+    data.reserve(2 * frame.size());
     for(auto const& it : frame) {
         data.emplace_back((it >> 17) & 0x1, (it >> 8) & 0xFF); // MSByte
         data.emplace_back((it >> 16) & 0x1, it & 0xFF);        // LSByte
@@ -269,11 +289,12 @@ void clicpix2_frameDecoder::decodeCounter() {
                 continue;
             }
 
+            const auto latches = matrix[r][c].GetLatches();
             if(counter_config[r][c]) {
-                matrix[r][c].SetCounter(lfsr13_lut[matrix[r][c].GetLatches() & 0x1fff]);
+                matrix[r][c].SetCounter(lfsr13_lut[latches & 0x1fff]);
             } else {
-                matrix[r][c].SetTOT(lfsr5_lut[(matrix[r][c].GetLatches() >> 8) & 0x1f]);
-                matrix[r][c].SetTOA(lfsr8_lut[matrix[r][c].GetLatches() & 0xff]);
+                matrix[r][c].SetTOT(lfsr5_lut[(latches >> 8) & 0x1f]);
+                matrix[r][c].SetTOA(lfsr8_lut[latches & 0xff]);
             }
         }
     }
@@ -13,6 +13,30 @@
 
 namespace caribou {
 
+    /* Generate the lookup table from the state of a Fibonacci XNOR LFSR to its count
+     *
+     * The register shifts towards the most significant bit and feeds back the inverted parity of the tapped bits. Starting
+     * from the cleared register, the state reached after n clock cycles is mapped to n. The all-ones lock-up state is never
+     * reached and is not part of the table.
+     */
+    template <typename T, size_t N> constexpr std::array<T, N> make_lfsr_lut(const uint32_t taps) {
+        // A register of n bits cycles through N = 2^n - 1 states, which is also the mask of its bits
+        const auto mask = static_cast<uint32_t>(N);
+        std::array<T, N> lut{};
+        uint32_t state = 0;
+        for(size_t count = 0; count < N; ++count) {
+            lut[state] = static_cast<T>(count);
+            uint32_t parity = state & taps;
+            parity ^= parity >> 16;
+            parity ^= parity >> 8;
+            parity ^= parity >> 4;
+            parity ^= parity >> 2;
+            parity ^= parity >> 1;
+            state = ((state << 1) | (~parity & 0x1)) & mask;
+        }
+        return lut;
+    }
+
     class clicpix2_frameDecoder {
 
         // Internal class representing a SERDES word
@@ -68,7 +92,7 @@ namespace caribou {
         // Configuration
         bool pixelCompressionEnabled;
         bool DCandSuperPixelCompressionEnabled;
-        std::map<size_t, std::map<size_t, bool>> counter_config; // [row][column]
+        std::array<std::array<bool, CLICPIX2_COL>, CLICPIX2_ROW> counter_config{}; // [row][column]
 
     public:
         clicpix2_frameDecoder(const bool pixelCompressionEnabled,
@@ -79,9 +103,11 @@ namespace caribou {
         pearydata getZerosuppressedFrame();
 
         pixelReadout get(const unsigned int row, const unsigned int column) { return matrix[row][column]; };
-        static const uint16_t lfsr13_lut[8191];
-        static const uint8_t lfsr8_lut[255];
-        static const uint8_t lfsr5_lut[31];
+
+        // Lookup tables from the LFSR states of the counters to their values, generated at compile time
+        static constexpr std::array<uint16_t, 8191> lfsr13_lut = make_lfsr_lut<uint16_t, 8191>(0x100D);
+        static constexpr std::array<uint8_t, 255> lfsr8_lut = make_lfsr_lut<uint8_t, 255>(0xB8);
+        static constexpr std::array<uint8_t, 31> lfsr5_lut = make_lfsr_lut<uint8_t, 31>(0x14);
 
         /** Overloaded ostream operator for simple printing of pixel data
          */
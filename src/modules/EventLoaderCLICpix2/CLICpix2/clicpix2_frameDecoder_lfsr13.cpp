@@ -1,416 +0,0 @@
-// It contains LUT for lfsr13 counter
-#include "clicpix2_frameDecoder.hpp"
-
-using namespace caribou;
-
-const uint16_t clicpix2_frameDecoder::lfsr13_lut[8191] = {
-    0,    1,    2,    1857, 8101, 3,    1858, 7704, 8102, 3714, 3687, 4,    1859, 1932, 1989, 7705, 8103, 1622, 4757, 3715,
-    3688, 3115, 1370, 5,    5162, 1860, 1933, 3183, 1767, 1990, 7706, 719,  332,  8104, 1623, 3789, 7217, 4758, 3716, 3009,
-    3689, 3846, 6790, 3116, 1371, 8011, 7907, 6,    5163, 2731, 2490, 1861, 1934, 7614, 5544, 3184, 2234, 1768, 1991, 5818,
-    5571, 7707, 720,  6674, 1502, 333,  8105, 5040, 7553, 1624, 3790, 1721, 7218, 7019, 4284, 4759, 3717, 1881, 3597, 3010,
-    3690, 1445, 7757, 3847, 6791, 3162, 3624, 3117, 270,  1372, 8012, 2407, 2576, 7908, 7,    1509, 7366, 5164, 2732, 3227,
-    1099, 2491, 1862, 1899, 1935, 4972, 2450, 7615, 5545, 37,   671,  3185, 2235, 5863, 3200, 1769, 1992, 3325, 3479, 5819,
-    7444, 5572, 7708, 7876, 6614, 721,  6675, 1842, 7901, 1503, 334,  7401, 5325, 8106, 5041, 5448, 7554, 1280, 3896, 1625,
-    3791, 6857, 4077, 1722, 7219, 3025, 3978, 7020, 4285, 6069, 4588, 4760, 232,  3718, 1882, 3864, 4347, 3598, 3011, 4031,
-    4667, 3691, 1446, 7675, 7116, 7758, 3848, 192,  6792, 4091, 2696, 3163, 3625, 5006, 6548, 3118, 271,  6810, 5123, 1373,
-    8013, 3921, 7428, 2408, 1532, 2577, 7909, 4675, 340,  8,    1510, 7374, 2569, 7367, 5165, 1677, 7140, 2733, 3228, 5619,
-    1100, 1573, 4491, 2492, 1863, 7407, 4270, 1900, 1936, 2842, 4060, 4973, 2451, 4127, 456,  7616, 6562, 5546, 38,   629,
-    5703, 672,  3186, 1135, 1524, 2236, 5864, 2189, 4146, 3201, 1770, 5143, 1993, 5646, 5072, 3326, 3480, 2628, 5804, 5820,
-    7445, 6221, 3093, 5573, 7709, 7822, 4866, 7877, 860,  6615, 722,  5676, 883,  6676, 1843, 994,  1365, 7902, 1504, 1894,
-    5320, 335,  7402, 7817, 5326, 2528, 5331, 8107, 5042, 3908, 7094, 5449, 7555, 2708, 6644, 1281, 3897, 5998, 4307, 1626,
-    253,  3792, 6858, 1747, 6829, 4078, 1723, 7921, 5115, 7220, 3026, 1032, 5309, 3979, 7021, 734,  4286, 5084, 4252, 6070,
-    4589, 6844, 6700, 4761, 233,  5783, 2533, 3719, 1883, 4503, 3756, 3865, 6187, 4348, 3599, 50,   2956, 3012, 4032, 2884,
-    263,  4668, 3692, 5336, 4296, 1447, 7676, 6197, 7117, 5182, 8024, 7759, 3849, 7127, 2472, 193,  6793, 4157, 2651, 4092,
-    2697, 2919, 7720, 3164, 2462, 3626, 5007, 5277, 5057, 6549, 3119, 7151, 6802, 272,  6811, 1542, 242,  5124, 1374, 7564,
-    8014, 1110, 6572, 3922, 7429, 870,  2003, 2409, 1533, 7454, 1945, 2578, 7910, 7228, 280,  4676, 5172, 341,  9,    8112,
-    3699, 1511, 7375, 2244, 8005, 2570, 7368, 4264, 2522, 5166, 1678, 3548, 7141, 2127, 2144, 2734, 3229, 3611, 517,  5620,
-    1101, 6870, 5728, 1574, 4492, 6730, 4433, 2493, 5047, 1864, 7408, 1684, 3366, 4271, 1901, 5343, 3913, 1937, 2843, 5481,
-    2945, 4061, 4974, 8036, 2452, 5019, 6746, 4128, 457,  658,  4539, 7617, 6563, 3263, 3283, 5547, 39,   21,   3302, 630,
-    5267, 5704, 673,  6584, 1423, 3187, 1136, 4604, 2400, 1525, 2237, 3359, 6689, 5865, 2190, 2762, 4147, 6897, 3566, 3202,
-    1771, 2996, 2971, 5144, 1994, 7099, 6303, 5647, 5073, 4406, 3578, 3327, 2641, 3481, 2629, 5504, 1219, 5805, 5821, 7287,
-    7420, 7446, 6222, 3738, 5104, 3094, 5574, 6464, 7710, 5454, 3554, 7823, 4867, 706,  2156, 7878, 861,  7524, 6758, 6616,
-    723,  6429, 6141, 5677, 2909, 884,  6677, 1245, 685,  1844, 995,  4455, 3683, 1366, 7903, 2486, 5036, 1505, 1895, 7872,
-    5321, 228,  4663, 336,  7403, 2838, 5642, 7818, 5327, 4303, 6696, 2529, 5332, 7147, 7560, 8108, 2518, 5043, 3909, 1419,
-    2992, 7095, 5450, 6425, 4659, 7556, 2709, 2313, 4422, 6645, 1282, 4733, 3898, 5984, 180,  5999, 4308, 1399, 2713, 1627,
-    254,  472,  2317, 3793, 6859, 154,  4699, 1748, 7084, 6830, 4079, 3133, 5917, 1724, 7922, 5376, 1438, 5116, 7221, 4426,
-    2511, 3027, 1033, 8131, 5310, 3534, 7389, 3980, 7022, 6399, 392,  735,  4287, 3072, 1181, 5085, 4253, 6499, 7476, 6071,
-    7807, 4590, 6845, 6957, 806,  6701, 4762, 6649, 7667, 234,  5784, 1073, 2133, 2534, 3720, 1286, 1884, 6127, 4019, 4504,
-    3757, 6366, 4325, 3866, 6188, 1479, 2017, 4349, 3600, 6029, 6348, 51,   1355, 2957, 3013, 4737, 3430, 4033, 2885, 4223,
-    3840, 264,  4669, 4485, 3902, 3693, 5337, 2150, 4297, 7661, 4479, 1448, 7677, 6412, 4194, 6198, 7118, 6714, 1963, 5183,
-    8025, 557,  6929, 7760, 5988, 3850, 7128, 3403, 7503, 2473, 194,  6103, 184,  6794, 4158, 3381, 4528, 2652, 4093, 3507,
-    2698, 4046, 444,  2920, 7721, 4720, 3662, 3165, 2463, 7741, 415,  3627, 5008, 6379, 7000, 5278, 6634, 5058, 6550, 5201,
-    6003, 3120, 7152, 1791, 7750, 6803, 273,  6723, 1412, 6812, 1543, 5881, 243,  1488, 3081, 5125, 1375, 4312, 481,  7565,
-    8015, 1403, 3244, 1111, 6573, 612,  8078, 3923, 1737, 7430, 871,  1323, 4950, 2004, 2410, 2286, 7108, 1534, 7455, 7533,
-    3272, 1946, 2579, 6879, 7911, 2717, 5792, 7229, 281,  7463, 4166, 4677, 5173, 5872, 1454, 342,  10,   1631, 2740, 8113,
-    6819, 3700, 1512, 3034, 2851, 7376, 2245, 6230, 3110, 8006, 2571, 1094, 5443, 7369, 4265, 4861, 2523, 5778, 258,  5167,
-    1679, 5476, 6298, 3549, 7142, 1394, 801,  2128, 2145, 1786, 476,  2735, 5773, 3230, 3612, 6172, 6980, 518,  5621, 1915,
-    6540, 1102, 6871, 6532, 6453, 5729, 1575, 531,  4493, 3389, 7541, 6731, 4434, 1081, 2321, 2494, 5048, 3235, 3797, 1865,
-    7409, 7683, 2197, 1685, 3746, 3367, 4272, 5489, 1040, 1902, 5344, 1550, 3617, 3914, 1938, 6863, 6418, 2844, 5482, 1015,
-    2946, 214,  7354, 4062, 4975, 7341, 2341, 8037, 2453, 8069, 7786, 5020, 6747, 1648, 4553, 4129, 2874, 458,  659,  979,
-    5948, 4540, 7618, 158,  4998, 6564, 3264, 6524, 1234, 3284, 5548, 4703, 40,   1341, 6602, 22,   3303, 73,   1150, 631,
-    5268, 603,  86,   5705, 674,  7066, 2049, 6585, 6177, 1424, 3188, 1752, 782,  1137, 4605, 4899, 6784, 2401, 1526, 1567,
-    7088, 2238, 3360, 700,  6690, 1067, 3834, 5866, 2191, 1009, 7270, 2763, 4148, 2277, 7989, 6898, 3567, 1809, 7305, 3203,
-    6834, 1772, 2997, 6985, 7182, 2972, 5145, 958,  4083, 1995, 7100, 523,  7276, 6304, 5648, 4200, 5074, 5934, 7602, 4407,
-    3579, 2675, 3055, 3328, 2642, 4941, 1705, 3482, 2630, 2170, 5753, 5505, 4242, 1220, 5806, 6484, 3137, 5822, 7288, 7940,
-    3155, 7421, 7447, 5721, 2985, 6223, 3739, 581,  5105, 2089, 1610, 3095, 5575, 5921, 2103, 6465, 7711, 1728, 5626, 5455,
-    3555, 2769, 6204, 7824, 1022, 4868, 707,  588,  5888, 2157, 7879, 8138, 2688, 862,  7525, 6445, 3348, 6759, 6617, 4805,
-    724,  7926, 1920, 6430, 6142, 2264, 2360, 5678, 2910, 1314, 2073, 885,  6678, 5380, 4882, 1246, 5299, 686,  1845, 7974,
-    5835, 996,  4456, 921,  8098, 3684, 1367, 5159, 329,  7904, 2487, 5568, 5037, 1878, 1442, 1506, 1896, 4969, 3322, 7873,
-    5322, 3893, 4585, 229,  4664, 6545, 5120, 337,  1674, 7404, 2839, 1132, 5140, 5643, 7819, 5673, 5317, 5328, 4304, 250,
-    5112, 6697, 2530, 2953, 5333, 7124, 4154, 7148, 7561, 1107, 7225, 8109, 2519, 2141, 4430, 5044, 3910, 4536, 3280, 1420,
-    3356, 2993, 7096, 7284, 6461, 5451, 6426, 1242, 5033, 4660, 7557, 2515, 4656, 2710, 2314, 5914, 4423, 6396, 3069, 6646,
-    1283, 6124, 6026, 4734, 3899, 4476, 6926, 5985, 181,  3659, 412,  6000, 6720, 4309, 1400, 2283, 6876, 2714, 1628, 3031,
-    5440, 255,  473,  5770, 6537, 2318, 3794, 1037, 6860, 7338, 8066, 155,  4700, 1338, 7063, 1749, 7085, 3831, 7302, 6831,
-    4080, 3052, 1702, 3134, 5718, 5918, 1725, 8135, 4802, 7923, 5377, 7971, 326,  1439, 5117, 1671, 5314, 7222, 4427, 6458,
-    2512, 6121, 4473, 3028, 1034, 7335, 3049, 8132, 5311, 4470, 5402, 3535, 7390, 2603, 5405, 3981, 3538, 7023, 6400, 898,
-    4379, 393,  736,  4916, 7393, 4288, 3073, 5468, 3885, 1182, 5086, 8157, 4254, 2374, 6091, 6500, 7477, 4825, 2606, 6072,
-    7808, 7652, 5408, 4591, 6846, 3447, 4001, 6958, 7995, 807,  6702, 1969, 3984, 4763, 6650, 5734, 1495, 7668, 235,  3541,
-    221,  5785, 1074, 2096, 2134, 6904, 5189, 2535, 3721, 7026, 1580, 1287, 1885, 6403, 6911, 6128, 4020, 102,  5223, 4505,
-    2117, 3758, 6367, 373,  7200, 4326, 3867, 901,  7893, 6189, 1480, 6290, 4577, 2018, 4350, 4382, 3601, 396,  3495, 6030,
-    6349, 7852, 5526, 52,   1356, 4185, 7637, 2958, 3014, 739,  536,  4738, 507,  3431, 4034, 4919, 7585, 2886, 4224, 7244,
-    1617, 3841, 265,  7361, 7396, 4670, 4486, 3088, 3903, 4498, 4291, 3694, 5338, 8031, 3573, 2151, 4298, 5979, 7802, 7662,
-    4480, 5196, 3076, 1449, 5471, 7678, 6413, 777,  953,  4195, 6199, 2355, 3888, 7119, 6715, 5435, 1666, 1964, 5184, 7632,
-    8026, 6263, 2826, 558,  6930, 3640, 1185, 7761, 5989, 3394, 5089, 3851, 7129, 6268, 765,  3404, 2935, 7504, 2474, 305,
-    8160, 195,  6104, 4631, 7546, 185,  6795, 4257, 2831, 4159, 3382, 1603, 4529, 5216, 5972, 2653, 4094, 2377, 1202, 3508,
-    2699, 6094, 2554, 4047, 445,  2789, 4619, 2921, 648,  7722, 4721, 3941, 355,  3663, 3166, 6503, 1272, 2464, 7742, 4853,
-    1124, 416,  3628, 7480, 5009, 4828, 142,  6380, 7001, 3957, 1164, 5279, 6635, 7494, 3774, 5059, 6551, 2609, 5423, 5202,
-    6736, 6004, 3121, 6075, 563,  7153, 1792, 1815, 3783, 7751, 6804, 2563, 7811, 274,  6724, 5098, 1413, 4013, 7655, 6813,
-    1544, 2335, 2669, 5882, 244,  6920, 7646, 1489, 3082, 5417, 5411, 5126, 4594, 1376, 4313, 4439, 7311, 482,  7566, 6935,
-    6849, 8016, 1404, 1086, 5665, 3245, 1112, 3645, 6574, 5595, 3418, 613,  8079, 5235, 3450, 3924, 1738, 548,  4004, 7431,
-    872,  5358, 130,  1324, 5257, 4951, 2005, 2218, 6961, 2411, 2287, 4362, 1714, 7109, 1535, 7998, 5635, 7456, 7534, 2082,
-    3273, 95,   7795, 1947, 2580, 810,  3806, 6880, 7912, 6705, 2326, 2718, 5793, 2026, 1190, 7230, 3253, 282,  7464, 1463,
-    424,  4167, 4678, 1972, 4069, 5174, 5873, 3102, 5132, 1455, 343,  3987, 11,   4766, 2499, 1632, 2741, 3209, 7766, 8114,
-    6820, 1954, 2660, 3701, 1513, 6653, 2542, 3035, 3292, 2852, 7377, 5737, 6312, 2246, 6231, 6767, 3710, 3111, 8007, 2727,
-    1498, 2572, 1095, 7440, 5444, 3860, 7671, 7370, 4266, 4056, 5068, 4862, 2524, 5994, 6840, 5779, 259,  5053, 238,  5168,
-    3544, 1680, 5477, 4600, 2967, 6299, 3550, 6137, 224,  7143, 1395, 468,  1434, 802,  2129, 1351, 2146, 3399, 3377, 1787,
-    477,  3240, 5788, 2736, 5774, 1782, 1077, 3231, 3613, 5944, 1230, 6173, 696,  6981, 519,  7936, 2099, 5622, 1916, 4878,
-    1874, 6541, 1103, 2137, 5029, 6872, 6533, 5714, 6454, 894,  5464, 5730, 1576, 6907, 3491, 532,  4494, 5192, 3636, 3390,
-    7542, 351,  1120, 6732, 5094, 4435, 1082, 4358, 3802, 2322, 2495, 2538, 3856, 5049, 3236, 1778, 1870, 3798, 1866, 3724,
-    7410, 7029, 1382, 7684, 2198, 5582, 4982, 1686, 3747, 6625, 5656, 3368, 4273, 1583, 5556, 5490, 3728, 1041, 1903, 1290,
-    4101, 5345, 1551, 2587, 3003, 3618, 3915, 7134, 1888, 1939, 6864, 7414, 6419, 4319, 6406, 2845, 5483, 7348, 5928, 1016,
-    2947, 406,  3441, 215,  7355, 3768, 6914, 4063, 6131, 4976, 7342, 7033, 817,  2342, 8038, 2384, 4023, 2454, 8070, 1386,
-    4961, 7787, 5021, 5605, 6748, 4776, 2862, 1649, 4554, 292,  105,  4130, 2875, 7732, 5226, 459,  660,  4838, 6014, 980,
-    7514, 5949, 4541, 6273, 4508, 7619, 159,  7688, 3590, 4999, 6565, 2120, 7865, 3265, 6525, 3148, 1235, 7193, 770,  3285,
-    5549, 3761, 2202, 4704, 41,   6370, 5586, 1342, 6603, 5899, 8054, 23,   2899, 3304, 74,   5846, 6153, 1151, 632,  376,
-    4339, 5269, 604,  793,  3314, 87,   5706, 7203, 675,  4329, 4986, 7067, 2050, 5959, 4786, 6586, 6178, 6991, 3409, 1425,
-    3189, 3870, 1690, 1753, 4445, 783,  1138, 904,  7039, 4606, 4900, 1051, 4752, 6785, 2402, 3222, 7896, 1527, 1568, 6216,
-    7089, 3751, 6192, 2239, 3361, 2940, 4401, 701,  6691, 175,  6952, 1068, 3835, 6629, 1483, 5867, 6293, 2192, 1010, 4894,
-    7177, 7271, 2764, 2259, 4580, 4149, 2278, 5765, 321,  7990, 6899, 4180, 3568, 760,  1598, 1810, 7306, 5660, 2021, 3204,
-    6835, 3372, 4353, 1773, 2998, 7509, 7188, 6986, 4396, 7183, 2973, 823,  4385, 5146, 959,  7317, 4277, 4084, 1996, 3604,
-    2479, 7101, 524,  2978, 7277, 2110, 2348, 6305, 5649, 399,  488,  4201, 5075, 3498, 2209, 5935, 7603, 4112, 495,  4408,
-    1209, 3580, 2676, 3813, 1587, 3056, 3329, 6033, 6061, 2643, 4942, 6164, 5560, 1706, 3483, 6352, 2631, 7855, 2061, 2171,
-    5754, 7050, 2424, 5506, 4243, 4519, 5248, 1221, 5807, 5529, 4565, 6485, 5494, 3138, 5823, 55,   310,  7289, 7941, 828,
-    7211, 3156, 7422, 5613, 1359, 7448, 5722, 3732, 2986, 6360, 4188, 6224, 3740, 208,  7596, 582,  5106, 3653, 3995, 2090,
-    1611, 7488, 7640, 3096, 2961, 5576, 5922, 1045, 4390, 2104, 6466, 8165, 3017, 7712, 1729, 1907, 5151, 5627, 5456, 200,
-    3556, 8044, 6472, 2770, 6205, 7572, 742,  7825, 1023, 4711, 539,  4869, 708,  4208, 4813, 589,  6887, 5889, 2158, 3515,
-    4741, 7880, 8139, 1294, 7012, 2689, 863,  510,  3676, 7526, 6446, 574,  3349, 366,  946,  6760, 6618, 3434, 4105, 4806,
-    725,  4037, 5349, 7927, 1921, 964,  6109, 6431, 2390, 6143, 2265, 8171, 6941, 2361, 5679, 4922, 3970, 2911, 1315, 6972,
-    8090, 2074, 886,  7588, 6679, 2889, 1555, 5381, 4883, 7322, 4636, 1247, 5300, 435,  121,  687,  1846, 4227, 2591, 7975,
-    2752, 5836, 997,  7247, 7166, 4457, 922,  6323, 1855, 8099, 3685, 1930, 1620, 1368, 5160, 717,  330,  3007, 3844, 7905,
-    2488, 7612, 5816, 5569, 5038, 7551, 4282, 1879, 1443, 3622, 268,  1507, 7364, 1897, 4970, 669,  3198, 3323, 7874, 6612,
-    7399, 5323, 3894, 6855, 3023, 4586, 230,  4029, 4665, 190,  4089, 6546, 5121, 3919, 4673, 338,  1675, 7138, 4489, 7405,
-    2840, 454,  6560, 1133, 1522, 5141, 5644, 5802, 3091, 7820, 5674, 881,  1892, 5318, 5329, 3906, 2706, 4305, 251,  7919,
-    5113, 732,  5082, 6698, 2531, 4501, 48,   2954, 5334, 4294, 8022, 7125, 4155, 7718, 2460, 7149, 6800, 7562, 1108, 2001,
-    1943, 7226, 8110, 3697, 4262, 2520, 2142, 3609, 6868, 4431, 5045, 5341, 3911, 8034, 5017, 4537, 3281, 19,   6582, 1421,
-    3357, 6687, 3564, 2994, 7097, 3576, 2639, 7285, 7418, 6462, 5452, 2154, 6756, 6427, 1243, 683,  2484, 5034, 4661, 2836,
-    4301, 7558, 2516, 6423, 4657, 4731, 5982, 2711, 2315, 152,  3131, 5915, 4424, 2509, 7387, 6397, 3070, 7474, 7805, 6647,
-    7665, 1284, 6125, 4323, 2015, 6027, 4735, 3428, 4483, 3900, 4477, 6410, 6712, 6927, 5986, 6101, 182,  3505, 4044, 3660,
-    413,  6377, 5199, 6001, 6721, 1410, 3079, 4310, 1401, 8076, 1735, 2284, 7106, 6877, 2715, 4164, 1452, 1629, 3032, 2849,
-    1092, 5441, 256,  5474, 1392, 474,  5771, 1913, 6538, 529,  3387, 2319, 3795, 7681, 5487, 1038, 6861, 6416, 7352, 7339,
-    8067, 4551, 2872, 156,  4996, 4701, 1339, 1148, 84,   7064, 1750, 780,  1565, 7086, 3832, 1007, 2275, 7303, 6832, 956,
-    4081, 4198, 5932, 3053, 1703, 2168, 6482, 3135, 5719, 2983, 1608, 5919, 1726, 6202, 1020, 8136, 2686, 4803, 7924, 2358,
-    2071, 5378, 7972, 5833, 5157, 327,  1440, 4967, 3891, 5118, 1672, 5671, 5315, 2951, 7122, 7223, 4428, 4534, 7282, 6459,
-    2513, 4654, 3067, 6122, 4474, 410,  6718, 3029, 5438, 1035, 7336, 7061, 7300, 3050, 8133, 4800, 1669, 5312, 4471, 7333,
-    4468, 5403, 3536, 4914, 7391, 8155, 2372, 2604, 5406, 3445, 1967, 3982, 3539, 219,  5187, 7024, 6401, 5221, 2115, 899,
-    7891, 4380, 394,  5524, 7635, 737,  4917, 7583, 7359, 7394, 4289, 8029, 5977, 3074, 5469, 2353, 3886, 7630, 6261, 1183,
-    5087, 6266, 303,  8158, 4255, 2829, 5970, 2375, 6092, 4617, 646,  6501, 1270, 7478, 4826, 1162, 3772, 2607, 6073, 561,
-    2561, 7809, 7653, 2333, 6918, 5409, 4592, 6933, 6847, 3643, 5593, 3448, 4002, 5356, 2216, 6959, 7996, 5633, 7793, 808,
-    6703, 1188, 3251, 1970, 4067, 3985, 4764, 7764, 2658, 6651, 5735, 6310, 2725, 1496, 7669, 4054, 5992, 236,  3542, 6135,
-    222,  1349, 3397, 5786, 1075, 5942, 7934, 2097, 2135, 5027, 5462, 6905, 5190, 1118, 5092, 2536, 3854, 3722, 7027, 4980,
-    5654, 1581, 1288, 4099, 7132, 1886, 6404, 7346, 404,  6912, 6129, 2382, 4021, 5603, 4774, 103,  5224, 4836, 6271, 4506,
-    2118, 7863, 768,  3759, 6368, 8052, 2897, 374,  4337, 7201, 4327, 4784, 3407, 3868, 902,  7037, 3220, 7894, 6190, 2938,
-    173,  1481, 6291, 2257, 4578, 4178, 758,  2019, 4351, 7507, 821,  4383, 3602, 2477, 2346, 397,  3496, 493,  1207, 6031,
-    6059, 6350, 7853, 2422, 5246, 5527, 53,   308,  5611, 1357, 4186, 206,  3651, 7638, 2959, 8163, 3015, 198,  8042, 740,
-    537,  4206, 3513, 4739, 508,  3674, 944,  3432, 4035, 6107, 2388, 4920, 3968, 7586, 2887, 4634, 119,  4225, 7245, 7164,
-    1928, 1618, 3842, 7610, 7549, 266,  7362, 6610, 7397, 4027, 188,  4671, 4487, 452,  5800, 3089, 3904, 2704, 5080, 4499,
-    4292, 2458, 6798, 3695, 4260, 5339, 8032, 6580, 3562, 3574, 2152, 6754, 2834, 4299, 5980, 150,  2507, 7803, 7663, 3426,
-    4481, 6099, 3503, 5197, 3077, 8074, 4162, 1450, 5472, 1390, 3385, 7679, 6414, 2870, 4994, 778,  1563, 954,  4196, 6480,
-    1606, 6200, 2356, 2069, 4965, 3889, 7120, 4532, 4652, 6716, 5436, 4798, 1667, 4912, 8153, 1965, 5185, 5219, 5522, 7633,
-    8027, 5975, 6259, 6264, 2827, 644,  1268, 559,  2559, 6931, 3641, 2214, 7791, 1186, 7762, 2656, 4052, 5990, 3395, 5940,
-    5025, 5090, 3852, 4097, 7130, 2380, 5601, 6269, 766,  8050, 4782, 3405, 2936, 171,  756,  7505, 2475, 1205, 6057, 306,
-    5609, 8161, 196,  3511, 942,  6105, 4632, 117,  7608, 7547, 186,  450,  2702, 6796, 4258, 6752, 2832, 3424, 6097, 4160,
-    3383, 2868, 6478, 1604, 4530, 4650, 8151, 5217, 5973, 1266, 2557, 2654, 4050, 4095, 2378, 4780, 754,  1203, 3509, 940,
-    448,  2700, 6095, 2866, 4648, 2555, 4048, 938,  446,  936,  934,  2790, 4620, 844,  2792, 2922, 649,  2304, 4622, 7723,
-    4722, 846,  5691, 3942, 4117, 356,  3664, 2794, 2924, 3167, 6504, 1653, 2443, 1273, 2465, 651,  2306, 7743, 4854, 3341,
-    1125, 500,  4624, 417,  3629, 7725, 4558, 7481, 5010, 4724, 296,  4829, 143,  2436, 848,  6381, 5693, 7002, 3958, 7953,
-    2815, 1165, 5280, 3944, 4119, 6636, 7495, 971,  5906, 3775, 5060, 358,  6552, 3666, 109,  2610, 5424, 2033, 2796, 5203,
-    6737, 4413, 2926, 6005, 3122, 3169, 4134, 6076, 619,  564,  7154, 6506, 1655, 1793, 1816, 2776, 3178, 3784, 7752, 2445,
-    1275, 6805, 2564, 855,  7812, 2879, 2467, 275,  6725, 653,  1214, 5099, 1414, 2308, 1176, 4014, 7656, 7736, 7745, 6814,
-    4856, 1545, 2336, 2044, 1804, 2670, 5883, 3343, 1127, 245,  6921, 8061, 6116, 7647, 1490, 502,  3083, 4626, 1197, 5418,
-    5412, 5230, 419,  5127, 4595, 463,  3631, 1377, 4314, 7727, 3585, 4440, 6211, 7312, 483,  4560, 7483, 7567, 6936, 8085,
-    664,  6850, 8017, 5012, 4726, 1405, 1087, 2681, 5666, 7578, 298,  3246, 1113, 4831, 5241, 3646, 6575, 145,  6254, 5596,
-    3419, 2299, 2438, 614,  850,  8080, 5236, 3462, 4842, 3451, 3925, 6383, 5695, 1739, 549,  7778, 6018, 4005, 7432, 7004,
-    873,  3960, 6049, 5359, 131,  6243, 7955, 1325, 5258, 4690, 2817, 4952, 2006, 1167, 3467, 2219, 984,  6962, 2412, 5282,
-    3946, 2288, 4363, 3818, 5538, 1715, 7110, 4121, 6638, 1536, 7999, 7518, 5636, 4217, 7497, 7457, 7535, 973,  4236, 2083,
-    3274, 5908, 3879, 96,   7796, 4847, 3777, 1948, 5062, 2581, 811,  5953, 1592, 3807, 6881, 360,  6554, 7913, 6706, 4545,
-    3061, 2327, 2719, 3668, 5794, 111,  748,  2027, 1191, 3456, 2612, 7231, 3254, 5367, 5426, 283,  7465, 2035, 6662, 1464,
-    2618, 425,  4168, 2798, 5205, 4679, 1973, 6277, 30,   4070, 5175, 6739, 4415, 5874, 3103, 6438, 5133, 7237, 2928, 1456,
-    344,  6007, 4512, 3988, 12,   3124, 7623, 4767, 2500, 3334, 3171, 1633, 4136, 2742, 3210, 7831, 3930, 7767, 8115, 6078,
-    621,  6821, 1955, 1640, 6388, 2661, 3702, 566,  1514, 7156, 163,  6654, 2543, 6038, 6508, 3036, 3293, 7075, 1657, 2853,
-    7378, 1795, 7692, 5738, 2179, 6313, 2247, 1818, 2778, 6232, 6768, 5389, 7701, 3711, 3112, 3180, 3786, 8008, 2728, 6671,
-    1499, 3594, 7754, 2573, 1096, 2447, 3476, 7441, 5445, 1277, 6066, 3861, 7672, 5003, 6807, 7371, 2566, 4267, 4057, 5700,
-    4143, 5069, 4863, 857,  7814, 2525, 5995, 1744, 1029, 6841, 5780, 2881, 260,  2469, 2648, 5054, 239,  6569, 277,  5169,
-    3545, 2124, 6727, 1681, 5478, 655,  3260, 4601, 2397, 2968, 6300, 1216, 5101, 3551, 6138, 2906, 7869, 225,  7144, 1416,
-    2310, 1396, 469,  5373, 1435, 389,  1178, 803,  2130, 4016, 6345, 1352, 2147, 7658, 554,  3400, 3378, 4717, 7738, 1788,
-    7747, 478,  3241, 4947, 3269, 5789, 2737, 6816, 4858, 5775, 1783, 6169, 6529, 1078, 3232, 1547, 3614, 2338, 7783, 5945,
-    1231, 6599, 2046, 6174, 697,  1064, 1806, 6982, 520,  2672, 4938, 7937, 3152, 2100, 5623, 5885, 3345, 1917, 4879, 5296,
-    5565, 1875, 6542, 1129, 247,  1104, 2138, 1239, 5030, 6023, 6923, 6873, 6534, 8063, 1699, 5715, 6455, 6118, 2600, 895,
-    5465, 4822, 7649, 5731, 1492, 1577, 6908, 7197, 4574, 3492, 533,  504,  3085, 4495, 5193, 774,  5432, 3637, 3391, 4628,
-    7543, 1199, 2551, 352,  1121, 139,  5420, 6733, 5095, 4010, 5414, 4436, 1083, 5232, 545,  4359, 1711, 3803, 2323, 421,
-    5129, 2496, 2539, 3289, 7437, 3857, 5050, 4597, 465,  3237, 1779, 4875, 1871, 3488, 3633, 3799, 1867, 1379, 5553, 3725,
-    7411, 4316, 3765, 7030, 1383, 289,  7729, 7685, 3587, 2199, 5583, 6150, 3311, 4983, 1687, 4442, 6213, 3748, 6626, 4891,
-    5762, 5657, 3369, 7314, 4274, 485,  2206, 1584, 5557, 2058, 4562, 5491, 3729, 6357, 7485, 1042, 1904, 7569, 4708, 1291,
-    7009, 4102, 5346, 6938, 8087, 1552, 2588, 2749, 714,  3004, 3619, 666,  6852, 3916, 7135, 878,  1889, 45,   8019, 1940,
-    6865, 5014, 2636, 7415, 6420, 4728, 7471, 4320, 6407, 6374, 1407, 2846, 1089, 5484, 7349, 81,   2272, 5929, 1017, 2683,
-    5668, 2948, 407,  7058, 7330, 3442, 216,  7580, 7356, 300,  5967, 3769, 6915, 5590, 3248, 4064, 6132, 1346, 1115, 4977,
-    7343, 4833, 7860, 7034, 3217, 818,  2343, 5243, 3648, 8039, 2385, 3965, 6607, 4024, 2455, 6577, 147,  8071, 1387, 2066,
-    4962, 5519, 6256, 7788, 5022, 5598, 6054, 5606, 6749, 3421, 1263, 4777, 2863, 841,  2301, 1650, 2440, 4555, 293,  2812,
-    5903, 106,  4131, 616,  852,  2876, 7733, 2041, 8058, 5227, 460,  8082, 661,  5238, 6251, 4839, 6015, 6046, 3464, 981,
-    7515, 4214, 4844, 5950, 4542, 3453, 5364, 6274, 27,   4509, 7620, 3927, 6385, 160,  7689, 2176, 6668, 3591, 5000, 5697,
-    1741, 6566, 2121, 2903, 7866, 6342, 551,  3266, 6526, 7780, 4935, 3149, 1236, 6020, 4819, 7194, 771,  136,  4007, 3286,
-    7434, 5550, 3762, 3308, 5759, 2203, 4705, 7006, 875,  42,   6371, 78,   7055, 5587, 1343, 3962, 6604, 6051, 1260, 5900,
-    8055, 6248, 5361, 24,   2900, 6339, 133,  3305, 75,   6245, 6336, 5847, 1832, 6154, 1152, 7957, 1327, 633,  377,  5850,
-    1835, 4340, 5270, 5260, 4692, 605,  794,  1307, 3315, 7845, 2819, 88,   5707, 4954, 6157, 7204, 676,  2008, 1155, 4330,
-    4987, 2429, 1169, 7068, 3469, 2051, 5960, 7838, 7960, 4787, 6587, 2221, 986,  6179, 6992, 595,  1330, 3410, 1426, 6964,
-    3190, 2414, 636,  3871, 1691, 5511, 5284, 1754, 4446, 1470, 3948, 784,  1139, 2290, 380,  905,  5853, 7040, 4607, 4365,
-    3820, 4901, 1052, 8178, 1985, 4753, 6786, 5540, 1717, 2403, 3223, 1838, 7897, 4343, 7112, 1528, 1569, 4123, 2624, 6217,
-    7090, 6640, 4248, 3752, 6193, 5273, 1538, 2240, 8001, 3362, 2941, 5263, 6893, 4402, 702,  7520, 5638, 6692, 176,  4695,
-    8127, 6953, 1069, 4219, 3836, 7499, 4524, 6630, 1484, 608,  7459, 5868, 6294, 797,  7537, 2193, 1011, 975,  6520, 4895,
-    6780, 7178, 7272, 4238, 2085, 2765, 2260, 1310, 3318, 4581, 4150, 3276, 5910, 2279, 5766, 7967, 322,  4375, 3881, 7991,
-    6900, 98,   7848, 4181, 3569, 7798, 2822, 761,  1599, 3937, 4849, 1811, 3779, 7307, 5661, 5253, 91,   2022, 3205, 1950,
-    5064, 6836, 3373, 1226, 5710, 4354, 1774, 2583, 2999, 813,  4957, 7510, 7189, 5895, 5955, 6987, 4397, 6948, 1594, 7184,
-    2974, 3809, 6160, 824,  7207, 4386, 5147, 6883, 362,  960,  7318, 431,  5812, 4278, 4085, 6556, 7915, 1997, 3605, 679,
-    2480, 2011, 6708, 7102, 525,  4547, 2164, 2979, 7278, 3063, 2368, 2111, 2349, 1158, 2329, 6306, 2721, 5650, 400,  4333,
-    4174, 489,  4202, 3670, 5796, 5076, 3499, 4990, 4794, 2210, 5936, 113,  7604, 750,  4644, 4113, 496,  2432, 2029, 4409,
-    1210, 1172, 1193, 3581, 2677, 3458, 7774, 3814, 5534, 1588, 3057, 2614, 7233, 3330, 6034, 7071, 3472, 6062, 2644, 3256,
-    5369, 4943, 6165, 5292, 5561, 4570, 5428, 1707, 3484, 285,  2054, 6353, 2632, 7467, 5963, 7856, 2062, 2808, 2037, 2172,
-    6664, 5755, 7051, 1828, 7841, 2425, 5507, 1466, 2620, 4244, 4520, 6516, 7963, 5249, 1222, 427,  5808, 4170, 4790, 5530,
-    4566, 2804, 2800, 6486, 5495, 6490, 5207, 3139, 5824, 4681, 6590, 56,   2224, 311,  7290, 1975, 6279, 7942, 829,  3521,
-    1762, 7212, 3157, 32,   4072, 7423, 5614, 989,  1360, 6182, 5177, 7449, 5723, 6741, 5499, 3733, 2987, 4417, 6494, 6361,
-    4189, 6995, 5876, 6225, 3105, 3741, 209,  598,  7984, 7597, 583,  6440, 5135, 5107, 3654, 1333, 3044, 3996, 2091, 7239,
-    1612, 2930, 5211, 7489, 7641, 3413, 1458, 3097, 2962, 1429, 346,  5577, 5923, 6009, 3143, 1046, 4747, 4391, 2105, 4514,
-    3990, 6467, 8166, 6967, 3193, 3018, 7713, 14,   3126, 1730, 1908, 5828, 5152, 7886, 7625, 5628, 5457, 4769, 2417, 201,
-    3557, 2502, 639,  8045, 6473, 5686, 3336, 2771, 3173, 6206, 7573, 4685, 3874, 743,  7826, 1635, 4138, 1024, 4712, 6594,
-    1694, 540,  4870, 2744, 709,  3212, 5514, 4209, 4814, 1255, 7833, 590,  6888, 8122, 3932, 5890, 2159, 7769, 5287, 3516,
-    1757, 4742, 7881, 8117, 6080, 8140, 1295, 60,   2228, 7013, 2690, 623,  6823, 864,  511,  4449, 3677, 1473, 1957, 7527,
-    6447, 1642, 5747, 575,  3350, 6390, 6085, 367,  947,  3951, 2663, 6761, 3704, 6619, 3435, 787,  315,  4106, 4807, 568,
-    1516, 726,  4038, 1142, 7294, 5350, 7928, 7158, 1922, 165,  8145, 965,  6110, 2293, 6656, 6432, 2391, 383,  2545, 6144,
-    2266, 6040, 4929, 8172, 1979, 6942, 2362, 6510, 3038, 5680, 4923, 908,  5856, 3971, 2912, 3295, 7077, 1316, 6973, 914,
-    8091, 6283, 1659, 2075, 887,  2855, 7043, 7589, 6680, 7380, 4610, 2890, 1556, 7946, 1797, 5382, 7694, 4884, 7323, 1300,
-    4368, 4637, 1248, 5740, 2181, 5301, 436,  65,   3823, 122,  688,  6315, 1847, 2249, 4904, 4228, 2592, 833,  1820, 7976,
-    2753, 3525, 2780, 5837, 998,  6234, 1055, 7248, 8181, 7167, 4458, 6770, 5391, 923,  6324, 7257, 8190, 1856, 8100, 7703,
-    3713, 3686, 1931, 1988, 1621, 4756, 3114, 1369, 5161, 3182, 1766, 718,  331,  3788, 7216, 3008, 3845, 6789, 8010, 7906,
-    2730, 2489, 7613, 5543, 2233, 5817, 5570, 6673, 1501, 5039, 7552, 1720, 7018, 4283, 1880, 3596, 1444, 7756, 3161, 3623,
-    269,  2406, 2575, 1508, 7365, 3226, 1098, 1898, 4971, 2449, 36,   670,  5862, 3199, 3324, 3478, 7443, 7875, 6613, 1841,
-    7900, 7400, 5324, 5447, 1279, 3895, 6856, 4076, 3024, 3977, 6068, 4587, 231,  3863, 4346, 4030, 4666, 7674, 7115, 191,
-    4090, 2695, 5005, 6547, 6809, 5122, 3920, 7427, 1531, 4674, 339,  7373, 2568, 1676, 7139, 5618, 1572, 4490, 7406, 4269,
-    2841, 4059, 4126, 455,  6561, 628,  5702, 1134, 1523, 2188, 4145, 5142, 5645, 5071, 2627, 5803, 6220, 3092, 7821, 4865,
-    859,  5675, 882,  993,  1364, 1893, 5319, 7816, 2527, 5330, 3907, 7093, 2707, 6643, 5997, 4306, 252,  1746, 6828, 7920,
-    5114, 1031, 5308, 733,  5083, 4251, 6843, 6699, 5782, 2532, 4502, 3755, 6186, 49,   2955, 2883, 262,  5335, 4295, 6196,
-    5181, 8023, 7126, 2471, 4156, 2650, 2918, 7719, 2461, 5276, 5056, 7150, 6801, 1541, 241,  7563, 1109, 6571, 869,  2002,
-    7453, 1944, 7227, 279,  5171, 8111, 3698, 2243, 8004, 4263, 2521, 3547, 2126, 2143, 3610, 516,  6869, 5727, 6729, 4432,
-    5046, 1683, 3365, 5342, 3912, 5480, 2944, 8035, 5018, 6745, 657,  4538, 3262, 3282, 20,   3301, 5266, 6583, 1422, 4603,
-    2399, 3358, 6688, 2761, 6896, 3565, 2995, 2970, 7098, 6302, 4405, 3577, 2640, 5503, 1218, 7286, 7419, 3737, 5103, 6463,
-    5453, 3553, 705,  2155, 7523, 6757, 6428, 6140, 2908, 1244, 684,  4454, 3682, 2485, 5035, 7871, 227,  4662, 2837, 5641,
-    4302, 6695, 7146, 7559, 2517, 1418, 2991, 6424, 4658, 2312, 4421, 4732, 5983, 179,  1398, 2712, 471,  2316, 153,  4698,
-    7083, 3132, 5916, 5375, 1437, 4425, 2510, 8130, 3533, 7388, 6398, 391,  3071, 1180, 6498, 7475, 7806, 6956, 805,  6648,
-    7666, 1072, 2132, 1285, 6126, 4018, 6365, 4324, 1478, 2016, 6028, 6347, 1354, 4736, 3429, 4222, 3839, 4484, 3901, 2149,
-    7660, 4478, 6411, 4193, 6713, 1962, 556,  6928, 5987, 3402, 7502, 6102, 183,  3380, 4527, 3506, 4045, 443,  4719, 3661,
-    7740, 414,  6378, 6999, 6633, 5200, 6002, 1790, 7749, 6722, 1411, 5880, 1487, 3080, 4311, 480,  1402, 3243, 611,  8077,
-    1736, 1322, 4949, 2285, 7107, 7532, 3271, 6878, 2716, 5791, 7462, 4165, 5871, 1453, 1630, 2739, 6818, 3033, 2850, 6229,
-    3109, 1093, 5442, 4860, 5777, 257,  5475, 6297, 1393, 800,  1785, 475,  5772, 6171, 6979, 1914, 6539, 6531, 6452, 530,
-    3388, 7540, 1080, 2320, 3234, 3796, 7682, 2196, 3745, 5488, 1039, 1549, 3616, 6862, 6417, 1014, 213,  7353, 7340, 2340,
-    8068, 7785, 1647, 4552, 2873, 978,  5947, 157,  4997, 6523, 1233, 4702, 1340, 6601, 72,   1149, 602,  85,   7065, 2048,
-    6176, 1751, 781,  4898, 6783, 1566, 7087, 699,  1066, 3833, 1008, 7269, 2276, 7988, 1808, 7304, 6833, 6984, 7181, 957,
-    4082, 522,  7275, 4199, 5933, 7601, 2674, 3054, 4940, 1704, 2169, 5752, 4241, 6483, 3136, 7939, 3154, 5720, 2984, 580,
-    2088, 1609, 5920, 2102, 1727, 5625, 2768, 6203, 1021, 587,  5887, 8137, 2687, 6444, 3347, 4804, 7925, 1919, 2263, 2359,
-    1313, 2072, 5379, 4881, 5298, 7973, 5834, 920,  8097, 5158, 328,  5567, 1877, 1441, 4968, 3321, 3892, 4584, 6544, 5119,
-    1673, 1131, 5139, 5672, 5316, 249,  5111, 2952, 7123, 4153, 1106, 7224, 2140, 4429, 4535, 3279, 3355, 7283, 6460, 1241,
-    5032, 2514, 4655, 5913, 6395, 3068, 6123, 6025, 4475, 6925, 3658, 411,  6719, 2282, 6875, 3030, 5439, 5769, 6536, 1036,
-    7337, 8065, 1337, 7062, 3830, 7301, 3051, 1701, 5717, 8134, 4801, 7970, 325,  1670, 5313, 6457, 6120, 4472, 7334, 3048,
-    4469, 5401, 2602, 5404, 3537, 897,  4378, 4915, 7392, 5467, 3884, 8156, 2373, 6090, 4824, 2605, 7651, 5407, 3446, 4000,
-    7994, 1968, 3983, 5733, 1494, 3540, 220,  2095, 6903, 5188, 7025, 1579, 6402, 6910, 101,  5222, 2116, 372,  7199, 900,
-    7892, 6289, 4576, 4381, 395,  3494, 7851, 5525, 4184, 7636, 738,  535,  506,  4918, 7584, 7243, 1616, 7360, 7395, 3087,
-    4497, 4290, 8030, 3572, 5978, 7801, 5195, 3075, 5470, 776,  952,  2354, 3887, 5434, 1665, 7631, 6262, 2825, 3639, 1184,
-    3393, 5088, 6267, 764,  2934, 304,  8159, 4630, 7545, 4256, 2830, 1602, 5215, 5971, 2376, 1201, 6093, 2553, 2788, 4618,
-    647,  3940, 354,  6502, 1271, 4852, 1123, 7479, 4827, 141,  3956, 1163, 7493, 3773, 2608, 5422, 6735, 6074, 562,  1814,
-    3782, 2562, 7810, 5097, 4012, 7654, 2334, 2668, 6919, 7645, 5416, 5410, 4593, 4438, 7310, 6934, 6848, 1085, 5664, 3644,
-    5594, 3417, 5234, 3449, 547,  4003, 5357, 129,  5256, 2217, 6960, 4361, 1713, 7997, 5634, 2081, 94,   7794, 809,  3805,
-    6704, 2325, 2025, 1189, 3252, 1462, 423,  1971, 4068, 3101, 5131, 3986, 4765, 2498, 3208, 7765, 1953, 2659, 6652, 2541,
-    3291, 5736, 6311, 6766, 3709, 2726, 1497, 7439, 3859, 7670, 4055, 5067, 5993, 6839, 5052, 237,  3543, 4599, 2966, 6136,
-    223,  467,  1433, 1350, 3398, 3376, 3239, 5787, 1781, 1076, 5943, 1229, 695,  7935, 2098, 4877, 1873, 2136, 5028, 5713,
-    893,  5463, 6906, 3490, 5191, 3635, 350,  1119, 5093, 4357, 3801, 2537, 3855, 1777, 1869, 3723, 7028, 1381, 5581, 4981,
-    6624, 5655, 1582, 5555, 3727, 1289, 4100, 2586, 3002, 7133, 1887, 7413, 4318, 6405, 7347, 5927, 405,  3440, 3767, 6913,
-    6130, 7032, 816,  2383, 4022, 1385, 4960, 5604, 4775, 2861, 291,  104,  7731, 5225, 4837, 6013, 7513, 6272, 4507, 7687,
-    3589, 2119, 7864, 3147, 7192, 769,  3760, 2201, 6369, 5585, 5898, 8053, 2898, 5845, 6152, 375,  4338, 792,  3313, 7202,
-    4328, 4985, 5958, 4785, 6990, 3408, 3869, 1689, 4444, 903,  7038, 1050, 4751, 3221, 7895, 6215, 3750, 6191, 2939, 4400,
-    174,  6951, 6628, 1482, 6292, 4893, 7176, 2258, 4579, 5764, 320,  4179, 759,  1597, 5659, 2020, 3371, 4352, 7508, 7187,
-    4395, 822,  4384, 7316, 4276, 3603, 2478, 2977, 2109, 2347, 398,  487,  3497, 2208, 4111, 494,  1208, 3812, 1586, 6032,
-    6060, 6163, 5559, 6351, 7854, 2060, 7049, 2423, 4518, 5247, 5528, 4564, 5493, 54,   309,  827,  7210, 5612, 1358, 3731,
-    6359, 4187, 207,  7595, 3652, 3994, 7487, 7639, 2960, 1044, 4389, 8164, 3016, 1906, 5150, 199,  8043, 6471, 7571, 741,
-    4710, 538,  4207, 4812, 6886, 3514, 4740, 1293, 7011, 509,  3675, 573,  365,  945,  3433, 4104, 4036, 5348, 963,  6108,
-    2389, 8170, 6940, 4921, 3969, 6971, 8089, 7587, 2888, 1554, 7321, 4635, 434,  120,  4226, 2590, 2751, 7246, 7165, 6322,
-    1854, 1929, 1619, 716,  3006, 3843, 7611, 5815, 7550, 4281, 3621, 267,  7363, 668,  3197, 6611, 7398, 6854, 3022, 4028,
-    189,  4088, 3918, 4672, 7137, 4488, 453,  6559, 1521, 5801, 3090, 880,  1891, 3905, 2705, 7918, 731,  5081, 4500, 47,
-    4293, 8021, 7717, 2459, 6799, 2000, 1942, 3696, 4261, 3608, 6867, 5340, 8033, 5016, 18,   6581, 6686, 3563, 3575, 2638,
-    7417, 2153, 6755, 682,  2483, 2835, 4300, 6422, 4730, 5981, 151,  3130, 2508, 7386, 7473, 7804, 7664, 4322, 2014, 3427,
-    4482, 6409, 6711, 6100, 3504, 4043, 6376, 5198, 1409, 3078, 8075, 1734, 7105, 4163, 1451, 2848, 1091, 5473, 1391, 1912,
-    528,  3386, 7680, 5486, 6415, 7351, 4550, 2871, 4995, 1147, 83,   779,  1564, 1006, 2274, 955,  4197, 5931, 2167, 6481,
-    2982, 1607, 6201, 1019, 2685, 2357, 2070, 5832, 5156, 4966, 3890, 5670, 2950, 7121, 4533, 7281, 4653, 3066, 409,  6717,
-    5437, 7060, 7299, 4799, 1668, 7332, 4467, 4913, 8154, 2371, 3444, 1966, 218,  5186, 5220, 2114, 7890, 5523, 7634, 7582,
-    7358, 8028, 5976, 2352, 7629, 6260, 6265, 302,  2828, 5969, 4616, 645,  1269, 1161, 3771, 560,  2560, 2332, 6917, 6932,
-    3642, 5592, 5355, 2215, 5632, 7792, 1187, 3250, 4066, 7763, 2657, 6309, 2724, 4053, 5991, 6134, 1348, 3396, 5941, 7933,
-    5026, 5461, 1117, 5091, 3853, 4979, 5653, 4098, 7131, 7345, 403,  2381, 5602, 4773, 4835, 6270, 7862, 767,  8051, 2896,
-    4336, 4783, 3406, 7036, 3219, 2937, 172,  2256, 4177, 757,  7506, 820,  2476, 2345, 492,  1206, 6058, 2421, 5245, 307,
-    5610, 205,  3650, 8162, 197,  8041, 4205, 3512, 3673, 943,  6106, 2387, 3967, 4633, 118,  7163, 1927, 7609, 7548, 6609,
-    4026, 187,  451,  5799, 2703, 5079, 2457, 6797, 4259, 6579, 3561, 6753, 2833, 149,  2506, 3425, 6098, 3502, 8073, 4161,
-    1389, 3384, 2869, 4993, 1562, 6479, 1605, 2068, 4964, 4531, 4651, 4797, 4911, 8152, 5218, 5521, 5974, 6258, 643,  1267,
-    2558, 2213, 7790, 2655, 4051, 5939, 5024, 4096, 2379, 5600, 8049, 4781, 170,  755,  1204, 6056, 5608, 3510, 941,  116,
-    7607, 449,  2701, 6751, 3423, 6096, 2867, 6477, 4649, 8150, 1265, 2556, 4049, 4779, 753,  939,  447,  2865, 4647, 937,
-    935,  933,  843,  2791, 2303, 4621, 845,  5690, 4116, 2793, 2923, 1652, 2442, 650,  2305, 3340, 499,  4623, 7724, 4557,
-    4723, 295,  2435, 847,  5692, 7952, 2814, 3943, 4118, 970,  5905, 357,  3665, 108,  2032, 2795, 4412, 2925, 3168, 4133,
-    618,  6505, 1654, 2775, 3177, 2444, 1274, 854,  2878, 2466, 652,  1213, 2307, 1175, 7735, 7744, 4855, 2043, 1803, 3342,
-    1126, 8060, 6115, 501,  4625, 1196, 5229, 418,  462,  3630, 7726, 3584, 6210, 4559, 7482, 8084, 663,  5011, 4725, 2680,
-    7577, 297,  4830, 5240, 144,  6253, 2298, 2437, 849,  3461, 4841, 6382, 5694, 7777, 6017, 7003, 3959, 6048, 6242, 7954,
-    4689, 2816, 1166, 3466, 983,  5281, 3945, 3817, 5537, 4120, 6637, 7517, 4216, 7496, 972,  4235, 5907, 3878, 4846, 3776,
-    5061, 5952, 1591, 359,  6553, 4544, 3060, 3667, 110,  747,  3455, 2611, 5366, 5425, 2034, 6661, 2617, 2797, 5204, 6276,
-    29,   6738, 4414, 6437, 7236, 2927, 6006, 4511, 3123, 7622, 3333, 3170, 4135, 7830, 3929, 6077, 620,  1639, 6387, 565,
-    7155, 162,  6037, 6507, 7074, 1656, 1794, 7691, 2178, 1817, 2777, 5388, 7700, 3179, 3785, 6670, 3593, 7753, 2446, 3475,
-    1276, 6065, 5002, 6806, 2565, 5699, 4142, 856,  7813, 1743, 1028, 2880, 2468, 2647, 6568, 276,  2123, 6726, 654,  3259,
-    2396, 1215, 5100, 2905, 7868, 1415, 2309, 5372, 388,  1177, 4015, 6344, 7657, 553,  4716, 7737, 7746, 4946, 3268, 6815,
-    4857, 6168, 6528, 1546, 2337, 7782, 6598, 2045, 1063, 1805, 2671, 4937, 3151, 5884, 3344, 5295, 5564, 1128, 246,  1238,
-    6022, 6922, 8062, 1698, 6117, 2599, 4821, 7648, 1491, 7196, 4573, 503,  3084, 773,  5431, 4627, 1198, 2550, 138,  5419,
-    4009, 5413, 5231, 544,  1710, 420,  5128, 3288, 7436, 4596, 464,  4874, 3487, 3632, 1378, 5552, 4315, 3764, 288,  7728,
-    3586, 6149, 3310, 4441, 6212, 4890, 5761, 7313, 484,  2205, 2057, 4561, 6356, 7484, 7568, 4707, 7008, 6937, 8086, 2748,
-    713,  665,  6851, 877,  44,   8018, 5013, 2635, 4727, 7470, 6373, 1406, 1088, 80,   2271, 2682, 5667, 7057, 7329, 7579,
-    299,  5966, 5589, 3247, 1345, 1114, 4832, 7859, 3216, 5242, 3647, 3964, 6606, 6576, 146,  2065, 5518, 6255, 5597, 6053,
-    3420, 1262, 840,  2300, 2439, 2811, 5902, 615,  851,  2040, 8057, 8081, 5237, 6250, 6045, 3463, 4213, 4843, 3452, 5363,
-    26,   3926, 6384, 2175, 6667, 5696, 1740, 2902, 6341, 550,  7779, 4934, 6019, 4818, 135,  4006, 7433, 3307, 5758, 7005,
-    874,  77,   7054, 3961, 6050, 1259, 6247, 5360, 6338, 132,  6244, 6335, 1831, 7956, 1326, 5849, 1834, 5259, 4691, 1306,
-    7844, 2818, 4953, 6156, 2007, 1154, 2428, 1168, 3468, 7837, 7959, 2220, 985,  594,  1329, 6963, 2413, 635,  5510, 5283,
-    1469, 3947, 2289, 379,  5852, 4364, 3819, 8177, 1984, 5539, 1716, 1837, 4342, 7111, 4122, 2623, 6639, 4247, 5272, 1537,
-    8000, 5262, 6892, 7519, 5637, 4694, 8126, 4218, 7498, 4523, 607,  7458, 796,  7536, 974,  6519, 6779, 4237, 2084, 1309,
-    3317, 3275, 5909, 7966, 4374, 3880, 97,   7847, 7797, 2821, 3936, 4848, 3778, 5252, 90,   1949, 5063, 1225, 5709, 2582,
-    812,  4956, 5894, 5954, 6947, 1593, 3808, 6159, 7206, 6882, 361,  430,  5811, 6555, 7914, 678,  2010, 6707, 4546, 2163,
-    3062, 2367, 1157, 2328, 2720, 4332, 4173, 3669, 5795, 4989, 4793, 112,  749,  4643, 2431, 2028, 1171, 1192, 3457, 7773,
-    5533, 2613, 7232, 7070, 3471, 3255, 5368, 5291, 4569, 5427, 284,  2053, 7466, 5962, 2807, 2036, 6663, 1827, 7840, 1465,
-    2619, 6515, 7962, 426,  4169, 4789, 2803, 2799, 6489, 5206, 4680, 6589, 2223, 1974, 6278, 3520, 1761, 31,   4071, 988,
-    6181, 5176, 6740, 5498, 4416, 6493, 6994, 5875, 3104, 597,  7983, 6439, 5134, 1332, 3043, 7238, 2929, 5210, 3412, 1457,
-    1428, 345,  6008, 3142, 4746, 4513, 3989, 6966, 3192, 13,   3125, 5827, 7885, 7624, 4768, 2416, 2501, 638,  5685, 3335,
-    3172, 4684, 3873, 1634, 4137, 6593, 1693, 2743, 3211, 5513, 1254, 7832, 8121, 3931, 7768, 5286, 1756, 8116, 6079, 59,
-    2227, 622,  6822, 4448, 1472, 1956, 1641, 5746, 6389, 6084, 3950, 2662, 3703, 786,  314,  567,  1515, 1141, 7293, 7157,
-    164,  8144, 2292, 6655, 382,  2544, 6039, 4928, 1978, 6509, 3037, 907,  5855, 3294, 7076, 913,  6282, 1658, 2854, 7042,
-    7379, 4609, 7945, 1796, 7693, 1299, 4367, 5739, 2180, 64,   3822, 6314, 2248, 4903, 832,  1819, 3524, 2779, 6233, 1054,
-    8180, 6769, 5390, 7256, 8189, 7702, 3712, 1987, 4755, 3113, 3181, 1765, 3787, 7215, 6788, 8009, 2729, 5542, 2232, 6672,
-    1500, 1719, 7017, 3595, 7755, 3160, 2405, 2574, 3225, 1097, 2448, 35,   5861, 3477, 7442, 1840, 7899, 5446, 1278, 4075,
-    3976, 6067, 3862, 4345, 7673, 7114, 2694, 5004, 6808, 7426, 1530, 7372, 2567, 5617, 1571, 4268, 4058, 4125, 627,  5701,
-    2187, 4144, 5070, 2626, 6219, 4864, 858,  992,  1363, 7815, 2526, 7092, 6642, 5996, 1745, 6827, 1030, 5307, 4250, 6842,
-    5781, 3754, 6185, 2882, 261,  6195, 5180, 2470, 2649, 2917, 5275, 5055, 1540, 240,  6570, 868,  7452, 278,  5170, 2242,
-    8003, 3546, 2125, 515,  5726, 6728, 1682, 3364, 5479, 2943, 6744, 656,  3261, 3300, 5265, 4602, 2398, 2760, 6895, 2969,
-    6301, 4404, 5502, 1217, 3736, 5102, 3552, 704,  7522, 6139, 2907, 4453, 3681, 7870, 226,  5640, 6694, 7145, 1417, 2990,
-    2311, 4420, 178,  1397, 470,  4697, 7082, 5374, 1436, 8129, 3532, 390,  1179, 6497, 6955, 804,  1071, 2131, 4017, 6364,
-    1477, 6346, 1353, 4221, 3838, 2148, 7659, 4192, 1961, 555,  3401, 7501, 3379, 4526, 442,  4718, 7739, 6998, 6632, 1789,
-    7748, 5879, 1486, 479,  3242, 610,  1321, 4948, 7531, 3270, 5790, 7461, 5870, 2738, 6817, 6228, 3108, 4859, 5776, 6296,
-    799,  1784, 6170, 6978, 6530, 6451, 7539, 1079, 3233, 2195, 3744, 1548, 3615, 1013, 212,  2339, 7784, 1646, 977,  5946,
-    6522, 1232, 6600, 71,   601,  2047, 6175, 4897, 6782, 698,  1065, 7268, 7987, 1807, 6983, 7180, 521,  7274, 7600, 2673,
-    4939, 5751, 4240, 7938, 3153, 579,  2087, 2101, 5624, 2767, 586,  5886, 6443, 3346, 1918, 2262, 1312, 4880, 5297, 919,
-    8096, 5566, 1876, 3320, 4583, 6543, 1130, 5138, 248,  5110, 4152, 1105, 2139, 3278, 3354, 1240, 5031, 5912, 6394, 6024,
-    6924, 3657, 2281, 6874, 5768, 6535, 8064, 1336, 3829, 1700, 5716, 7969, 324,  6456, 6119, 3047, 5400, 2601, 896,  4377,
-    5466, 3883, 6089, 4823, 7650, 3999, 7993, 5732, 1493, 2094, 6902, 1578, 6909, 100,  371,  7198, 6288, 4575, 3493, 7850,
-    4183, 534,  505,  7242, 1615, 3086, 4496, 3571, 7800, 5194, 775,  951,  5433, 1664, 2824, 3638, 3392, 763,  2933, 4629,
-    7544, 1601, 5214, 1200, 2552, 2787, 3939, 353,  4851, 1122, 140,  3955, 7492, 5421, 6734, 1813, 3781, 5096, 4011, 2667,
-    7644, 5415, 4437, 7309, 1084, 5663, 3416, 5233, 546,  128,  5255, 4360, 1712, 2080, 93,   3804, 2324, 2024, 1461, 422,
-    3100, 5130, 2497, 3207, 1952, 2540, 3290, 6765, 3708, 7438, 3858, 5066, 6838, 5051, 4598, 2965, 466,  1432, 3375, 3238,
-    1780, 1228, 694,  4876, 1872, 5712, 892,  3489, 3634, 349,  4356, 3800, 1776, 1868, 1380, 5580, 6623, 5554, 3726, 2585,
-    3001, 7412, 4317, 5926, 3439, 3766, 7031, 815,  1384, 4959, 2860, 290,  7730, 6012, 7512, 7686, 3588, 3146, 7191, 2200,
-    5584, 5897, 5844, 6151, 791,  3312, 4984, 5957, 6989, 1688, 4443, 1049, 4750, 6214, 3749, 4399, 6950, 6627, 4892, 7175,
-    5763, 319,  1596, 5658, 3370, 7186, 4394, 7315, 4275, 2976, 2108, 486,  2207, 4110, 3811, 1585, 6162, 5558, 2059, 7048,
-    4517, 4563, 5492, 826,  7209, 3730, 6358, 7594, 3993, 7486, 1043, 4388, 1905, 5149, 6470, 7570, 4709, 4811, 6885, 1292,
-    7010, 572,  364,  4103, 5347, 962,  8169, 6939, 6970, 8088, 1553, 7320, 433,  2589, 2750, 6321, 1853, 715,  3005, 5814,
-    4280, 3620, 667,  3196, 6853, 3021, 4087, 3917, 7136, 6558, 1520, 879,  1890, 7917, 730,  46,   8020, 7716, 1999, 1941,
-    3607, 6866, 5015, 17,   6685, 2637, 7416, 681,  2482, 6421, 4729, 3129, 7385, 7472, 4321, 2013, 6408, 6710, 4042, 6375,
-    1408, 1733, 7104, 2847, 1090, 1911, 527,  5485, 7350, 4549, 1146, 82,   1005, 2273, 5930, 2166, 2981, 1018, 2684, 5831,
-    5155, 5669, 2949, 7280, 3065, 408,  7059, 7298, 7331, 4466, 2370, 3443, 217,  2113, 7889, 7581, 7357, 2351, 7628, 301,
-    5968, 4615, 1160, 3770, 2331, 6916, 5591, 5354, 5631, 3249, 4065, 6308, 2723, 6133, 1347, 7932, 5460, 1116, 4978, 5652,
-    7344, 402,  4772, 4834, 7861, 2895, 4335, 7035, 3218, 2255, 4176, 819,  2344, 491,  2420, 5244, 204,  3649, 8040, 4204,
-    3672, 2386, 3966, 7162, 1926, 6608, 4025, 5798, 5078, 2456, 6578, 3560, 148,  2505, 3501, 8072, 1388, 4992, 1561, 2067,
-    4963, 4796, 4910, 5520, 6257, 642,  2212, 7789, 5938, 5023, 5599, 8048, 169,  6055, 5607, 115,  7606, 6750, 3422, 6476,
-    8149, 1264, 4778, 752,  2864, 4646, 932,  842,  2302, 5689, 4115, 1651, 2441, 3339, 498,  4556, 294,  2434, 7951, 2813,
-    969,  5904, 107,  2031, 4411, 4132, 617,  2774, 3176, 853,  2877, 1212, 1174, 7734, 2042, 1802, 8059, 6114, 1195, 5228,
-    461,  3583, 6209, 8083, 662,  2679, 7576, 5239, 6252, 2297, 3460, 4840, 7776, 6016, 6047, 6241, 4688, 3465, 982,  3816,
-    5536, 7516, 4215, 4234, 3877, 4845, 5951, 1590, 4543, 3059, 746,  3454, 5365, 6660, 2616, 6275, 28,   6436, 7235, 4510,
-    7621, 3332, 7829, 3928, 1638, 6386, 161,  6036, 7073, 7690, 2177, 5387, 7699, 6669, 3592, 3474, 6064, 5001, 5698, 4141,
-    1742, 1027, 2646, 6567, 2122, 3258, 2395, 2904, 7867, 5371, 387,  6343, 552,  4715, 4945, 3267, 6167, 6527, 7781, 6597,
-    1062, 4936, 3150, 5294, 5563, 1237, 6021, 1697, 2598, 4820, 7195, 4572, 772,  5430, 2549, 137,  4008, 543,  1709, 3287,
-    7435, 4873, 3486, 5551, 3763, 287,  6148, 3309, 4889, 5760, 2204, 2056, 6355, 4706, 7007, 2747, 712,  876,  43,   2634,
-    7469, 6372, 79,   2270, 7056, 7328, 5965, 5588, 1344, 7858, 3215, 3963, 6605, 2064, 5517, 6052, 1261, 839,  2810, 5901,
-    2039, 8056, 6249, 6044, 4212, 5362, 25,   2174, 6666, 2901, 6340, 4933, 4817, 134,  3306, 5757, 76,   7053, 1258, 6246,
-    6337, 6334, 1830, 5848, 1833, 1305, 7843, 6155, 1153, 2427, 7836, 7958, 593,  1328, 634,  5509, 1468, 378,  5851, 8176,
-    1983, 1836, 4341, 2622, 4246, 5271, 5261, 6891, 4693, 8125, 4522, 606,  795,  6518, 6778, 1308, 3316, 7965, 4373, 7846,
-    2820, 3935, 5251, 89,   1224, 5708, 4955, 5893, 6946, 6158, 7205, 429,  5810, 677,  2009, 2162, 2366, 1156, 4331, 4172,
-    4988, 4792, 4642, 2430, 1170, 7772, 5532, 7069, 3470, 5290, 4568, 2052, 5961, 2806, 1826, 7839, 6514, 7961, 4788, 2802,
-    6488, 6588, 2222, 3519, 1760, 987,  6180, 5497, 6492, 6993, 596,  7982, 1331, 3042, 5209, 3411, 1427, 3141, 4745, 6965,
-    3191, 5826, 7884, 2415, 637,  5684, 4683, 3872, 6592, 1692, 5512, 1253, 8120, 5285, 1755, 58,   2226, 4447, 1471, 5745,
-    6083, 3949, 785,  313,  1140, 7292, 8143, 2291, 381,  4927, 1977, 906,  5854, 912,  6281, 7041, 4608, 7944, 1298, 4366,
-    63,   3821, 4902, 831,  3523, 1053, 8179, 7255, 8188, 1986, 4754, 1764, 7214, 6787, 5541, 2231, 1718, 7016, 3159, 2404,
-    3224, 34,   5860, 1839, 7898, 4074, 3975, 4344, 7113, 2693, 7425, 1529, 5616, 1570, 4124, 626,  2186, 2625, 6218, 991,
-    1362, 7091, 6641, 6826, 5306, 4249, 3753, 6184, 6194, 5179, 2916, 5274, 1539, 867,  7451, 2241, 8002, 514,  5725, 3363,
-    2942, 6743, 3299, 5264, 2759, 6894, 4403, 5501, 3735, 703,  7521, 4452, 3680, 5639, 6693, 2989, 4419, 177,  4696, 7081,
-    8128, 3531, 6496, 6954, 1070, 6363, 1476, 4220, 3837, 4191, 1960, 7500, 4525, 441,  6997, 6631, 5878, 1485, 609,  1320,
-    7530, 7460, 5869, 6227, 3107, 6295, 798,  6977, 6450, 7538, 2194, 3743, 1012, 211,  1645, 976,  6521, 70,   600,  4896,
-    6781, 7267, 7986, 7179, 7273, 7599, 5750, 4239, 578,  2086, 2766, 585,  6442, 2261, 1311, 918,  8095, 3319, 4582, 5137,
-    5109, 4151, 3277, 3353, 5911, 6393, 3656, 2280, 5767, 1335, 3828, 7968, 323,  3046, 5399, 4376, 3882, 6088, 3998, 7992,
-    2093, 6901, 99,   370,  6287, 7849, 4182, 7241, 1614, 3570, 7799, 950,  1663, 2823, 762,  2932, 1600, 5213, 2786, 3938,
-    4850, 3954, 7491, 1812, 3780, 2666, 7643, 7308, 5662, 3415, 127,  5254, 2079, 92,   2023, 1460, 3099, 3206, 1951, 6764,
-    3707, 5065, 6837, 2964, 1431, 3374, 1227, 693,  5711, 891,  348,  4355, 1775, 5579, 6622, 2584, 3000, 5925, 3438, 814,
-    4958, 2859, 6011, 7511, 3145, 7190, 5896, 5843, 790,  5956, 6988, 1048, 4749, 4398, 6949, 7174, 318,  1595, 7185, 4393,
-    2975, 2107, 4109, 3810, 6161, 7047, 4516, 825,  7208, 7593, 3992, 4387, 5148, 6469, 4810, 6884, 571,  363,  961,  8168,
-    6969, 7319, 432,  6320, 1852, 5813, 4279, 3195, 3020, 4086, 6557, 1519, 7916, 729,  7715, 1998, 3606, 16,   6684, 680,
-    2481, 3128, 7384, 2012, 6709, 4041, 1732, 7103, 1910, 526,  4548, 1145, 1004, 2165, 2980, 5830, 5154, 7279, 3064, 7297,
-    4465, 2369, 2112, 7888, 2350, 7627, 4614, 1159, 2330, 5353, 5630, 6307, 2722, 7931, 5459, 5651, 401,  4771, 2894, 4334,
-    2254, 4175, 490,  2419, 203,  4203, 3671, 7161, 1925, 5797, 5077, 3559, 2504, 3500, 4991, 1560, 4795, 4909, 641,  2211,
-    5937, 8047, 168,  114,  7605, 6475, 8148, 751,  4645, 931,  5688, 4114, 3338, 497,  2433, 7950, 968,  2030, 4410, 2773,
-    3175, 1211, 1173, 1801, 6113, 1194, 3582, 6208, 2678, 7575, 2296, 3459, 7775, 6240, 4687, 3815, 5535, 4233, 3876, 1589,
-    3058, 745,  6659, 2615, 6435, 7234, 3331, 7828, 1637, 6035, 7072, 5386, 7698, 3473, 6063, 4140, 1026, 2645, 3257, 2394,
-    5370, 386,  4714, 4944, 6166, 6596, 1061, 5293, 5562, 1696, 2597, 4571, 5429, 2548, 542,  1708, 4872, 3485, 286,  6147,
-    4888, 2055, 6354, 2746, 711,  2633, 7468, 2269, 7327, 5964, 7857, 3214, 2063, 5516, 838,  2809, 2038, 6043, 4211, 2173,
-    6665, 4932, 4816, 5756, 7052, 1257, 6333, 1829, 1304, 7842, 2426, 7835, 592,  5508, 1467, 8175, 1982, 2621, 4245, 6890,
-    8124, 4521, 6517, 6777, 7964, 4372, 3934, 5250, 1223, 5892, 6945, 428,  5809, 2161, 2365, 4171, 4791, 4641, 7771, 5531,
-    5289, 4567, 2805, 1825, 6513, 2801, 6487, 3518, 1759, 5496, 6491, 7981, 3041, 5208, 3140, 4744, 5825, 7883, 5683, 4682,
-    6591, 1252, 8119, 57,   2225, 5744, 6082, 312,  7291, 8142, 4926, 1976, 911,  6280, 7943, 1297, 62,   830,  3522, 7254,
-    8187, 1763, 7213, 2230, 7015, 3158, 33,   5859, 4073, 3974, 2692, 7424, 5615, 625,  2185, 990,  1361, 6825, 5305, 6183,
-    5178, 2915, 866,  7450, 513,  5724, 6742, 3298, 2758, 5500, 3734, 4451, 3679, 2988, 4418, 7080, 3530, 6495, 6362, 1475,
-    4190, 1959, 440,  6996, 5877, 1319, 7529, 6226, 3106, 6976, 6449, 3742, 210,  1644, 69,   599,  7266, 7985, 7598, 5749,
-    577,  584,  6441, 917,  8094, 5136, 5108, 3352, 6392, 3655, 1334, 3827, 3045, 5398, 6087, 3997, 2092, 369,  6286, 7240,
-    1613, 949,  1662, 2931, 5212, 2785, 3953, 7490, 2665, 7642, 3414, 126,  2078, 1459, 3098, 6763, 3706, 2963, 1430, 692,
-    890,  347,  5578, 6621, 5924, 3437, 2858, 6010, 3144, 5842, 789,  1047, 4748, 7173, 317,  4392, 2106, 4108, 7046, 4515,
-    7592, 3991, 6468, 4809, 570,  8167, 6968, 6319, 1851, 3194, 3019, 1518, 728,  7714, 15,   6683, 3127, 7383, 4040, 1731,
-    1909, 1144, 1003, 5829, 5153, 7296, 4464, 7887, 7626, 4613, 5352, 5629, 7930, 5458, 4770, 2893, 2253, 2418, 202,  7160,
-    1924, 3558, 2503, 1559, 4908, 640,  8046, 167,  6474, 8147, 930,  5687, 3337, 7949, 967,  2772, 3174, 1800, 6112, 6207,
-    7574, 2295, 6239, 4686, 4232, 3875, 744,  6658, 6434, 7827, 1636, 5385, 7697, 4139, 1025, 2393, 385,  4713, 6595, 1060,
-    1695, 2596, 2547, 541,  4871, 6146, 4887, 2745, 710,  2268, 7326, 3213, 5515, 837,  6042, 4210, 4931, 4815, 1256, 6332,
-    1303, 7834, 591,  8174, 1981, 6889, 8123, 6776, 4371, 3933, 5891, 6944, 2160, 2364, 4640, 7770, 5288, 1824, 6512, 3517,
-    1758, 7980, 3040, 4743, 7882, 5682, 1251, 8118, 5743, 6081, 8141, 4925, 910,  1296, 61,   7253, 8186, 2229, 7014, 5858,
-    3973, 2691, 624,  2184, 6824, 5304, 2914, 865,  512,  3297, 2757, 4450, 3678, 7079, 3529, 1474, 1958, 439,  1318, 7528,
-    6975, 6448, 1643, 68,   7265, 5748, 576,  916,  8093, 3351, 6391, 3826, 5397, 6086, 368,  6285, 948,  1661, 2784, 3952,
-    2664, 125,  2077, 6762, 3705, 691,  889,  6620, 3436, 2857, 5841, 788,  7172, 316,  4107, 7045, 7591, 4808, 569,  6318,
-    1850, 1517, 727,  6682, 7382, 4039, 1143, 1002, 7295, 4463, 4612, 5351, 7929, 2892, 2252, 7159, 1923, 1558, 4907, 166,
-    8146, 929,  7948, 966,  1799, 6111, 2294, 6238, 4231, 6657, 6433, 5384, 7696, 2392, 384,  1059, 2595, 2546, 6145, 4886,
-    2267, 7325, 836,  6041, 4930, 6331, 1302, 8173, 1980, 6775, 4370, 6943, 2363, 4639, 1823, 6511, 7979, 3039, 5681, 1250,
-    5742, 4924, 909,  7252, 8185, 5857, 3972, 2183, 5303, 2913, 3296, 2756, 7078, 3528, 438,  1317, 6974, 67,   7264, 915,
-    8092, 3825, 5396, 6284, 1660, 2783, 124,  2076, 690,  888,  2856, 5840, 7171, 7044, 7590, 6317, 1849, 6681, 7381, 1001,
-    4462, 4611, 2891, 2251, 1557, 4906, 928,  7947, 1798, 6237, 4230, 5383, 7695, 1058, 2594, 4885, 7324, 835,  6330, 1301,
-    6774, 4369, 4638, 1822, 7978, 1249, 5741, 7251, 8184, 2182, 5302, 2755, 3527, 437,  66,   7263, 3824, 5395, 2782, 123,
-    689,  5839, 7170, 6316, 1848, 1000, 4461, 2250, 4905, 927,  6236, 4229, 1057, 2593, 834,  6329, 6773, 1821, 7977, 7250,
-    8183, 2754, 3526, 7262, 5394, 2781, 5838, 7169, 999,  4460, 926,  6235, 1056, 6328, 6772, 7249, 8182, 7261, 5393, 7168,
-    4459, 925,  6327, 6771, 7260, 5392, 924,  6326, 7259, 6325, 7258};
@@ -67,17 +67,16 @@ void EventLoaderCLICpix2::initialize() {
     }
 
     // Open the data file for later
-    m_file.open(m_filename.c_str());
+    m_file.open(m_filename);
 
     // Compression flags
     comp = true;
     sp_comp = true;
 
-    std::streampos oldpos;
-    std::string line;
+    std::string_view line;
 
     // Parse the header:
-    while(getline(m_file, line)) {
+    while(m_file.getline(line)) {
 
         if(!line.length()) {
             continue;
@@ -88,19 +87,18 @@ void EventLoaderCLICpix2::initialize() {
 
         // Replicate header to new file:
         LOG(DEBUG) << "Detected file header: " << line;
-        oldpos = m_file.tellg();
 
         // Search for compression settings:
-        std::string::size_type n = line.find(" sp_comp:");
-        if(n != std::string::npos) {
+        auto n = line.find(" sp_comp:");
+        if(n != std::string_view::npos) {
             LOG(DEBUG) << "Value read for sp_comp: " << line.substr(n + 9, 1);
-            sp_comp = static_cast<bool>(std::stoi(line.substr(n + 9, 1)));
+            sp_comp = static_cast<bool>(std::stoi(std::string(line.substr(n + 9, 1))));
             LOG(INFO) << "Superpixel Compression: " << (sp_comp ? "ON" : "OFF");
         }
         n = line.find(" comp:");
-        if(n != std::string::npos) {
+        if(n != std::string_view::npos) {
             LOG(DEBUG) << "Value read for comp: " << line.substr(n + 6, 1);
-            comp = static_cast<bool>(std::stoi(line.substr(n + 6, 1)));
+            comp = static_cast<bool>(std::stoi(std::string(line.substr(n + 6, 1))));
             LOG(INFO) << "     Pixel Compression: " << (comp ? "ON" : "OFF");
         }
     }
@@ -192,7 +190,7 @@ StatusCode EventLoaderCLICpix2::run(const std::shared_ptr<Clipboard>& clipboard)
     PixelVector pixels;
     long long int shutterStartTimeInt = 0, shutterStopTimeInt = 0;
     double shutterStartTime = 0, shutterStopTime = 0;
-    string datastring;
+    std::string_view datastring;
     int npixels = 0;
     bool shutterOpen = false;
     std::vector<uint32_t> rawData;
@@ -201,25 +199,25 @@ StatusCode EventLoaderCLICpix2::run(const std::shared_ptr<Clipboard>& clipboard)
     bool legacy_format = false;
 
     // Read file and load data
-    while(getline(m_file, datastring)) {
+    while(m_file.getline(datastring)) {
 
         // Check if this is a header
-        if(datastring.find("=====") != string::npos) {
-            std::istringstream header(datastring);
-            std::string guff;
-            int frameNumber;
-            header >> guff >> frameNumber >> guff;
+        if(datastring.find("=====") != std::string_view::npos) {
+            int frameNumber = 0;
+            next_token(datastring);
+            next_integer(datastring, frameNumber);
             LOG(DEBUG) << "Found next header, frame number = " << frameNumber;
             break;
         }
         // If there is a colon, then this is a timestamp
-        else if(datastring.find(":") != string::npos) {
+        else if(datastring.find(':') != std::string_view::npos) {
             legacy_format = true;
-            istringstream timestamp(datastring);
-            char colon;
-            int value;
-            long long int time;
-            timestamp >> value >> colon >> time;
+            int value = 0;
+            long long int time = 0;
+            next_integer(datastring, value);
+            skip_whitespace(datastring);
+            datastring.remove_prefix(std::min<size_t>(datastring.size(), 1));
+            next_integer(datastring, time);
             LOG(DEBUG) << "Found timestamp: " << time;
             if(value == 3) {
                 shutterOpen = true;
@@ -230,7 +228,9 @@ StatusCode EventLoaderCLICpix2::run(const std::shared_ptr<Clipboard>& clipboard)
             }
         } else {
             // Otherwise pixel data
-            rawData.push_back(static_cast<unsigned int>(std::atoi(datastring.c_str())));
+            long long int word = 0;
+            next_integer(datastring, word);
+            rawData.push_back(static_cast<uint32_t>(word));
         }
     }
 
@@ -343,7 +343,7 @@ StatusCode EventLoaderCLICpix2::run(const std::shared_ptr<Clipboard>& clipboard)
             }
 
             // when calibration is not available, set charge = tot
-            auto pixel = std::make_shared<Pixel>(m_detector->getName(), col, row, tot, tot, timestamp);
+            auto pixel = make_pooled<Pixel>(m_detector->getName(), col, row, tot, tot, timestamp);
 
             if(tot == 0 && discardZeroToT) {
                 hHitMapDiscarded->Fill(col, row);
@@ -26,6 +26,7 @@
 #include "objects/Cluster.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/Track.hpp"
+#include "tools/line_reader.h"
 
 #include "CLICpix2/clicpix2_frameDecoder.hpp"
 #include "CLICpix2/clicpix2_pixels.hpp"
@@ -59,7 +60,7 @@ namespace corryvreckan {
         int m_eventNumber;
         std::string m_filename;
         std::string m_matrix;
-        std::ifstream m_file;
+        LineReader m_file;
 
         TH2F* hHitMap;
         TH2F* hMaskMap;
@@ -123,7 +123,7 @@ StatusCode EventLoaderEUDAQ::run(const std::shared_ptr<Clipboard>& clipboard) {
                 }
 
                 // when calibration is not available, set charge = tot, timestamp not available -> set to 0
-                auto pixel = std::make_shared<Pixel>(
+                auto pixel = make_pooled<Pixel>(
                     detectorID, col, row, static_cast<int>(plane.GetPixel(ipix)), plane.GetPixel(ipix), 0.);
 
                 // Pixel gets timestamp of trigger assigned:
@@ -32,6 +32,8 @@ EventLoaderEUDAQ2::EventLoaderEUDAQ2(Configuration& config, std::shared_ptr<Dete
     config_.setDefault<double>("skip_time", 0.);
     config_.setDefault<int>("buffer_depth", 0);
     config_.setDefault<int>("shift_triggers", 0);
+    config_.setDefault<size_t>("prefetch_depth", 0);
+    config_.setDefault<unsigned int>("decoder_workers", 1);
     config_.setDefault<bool>("inclusive", true);
     config_.setDefault<std::string>("eudaq_loglevel", "ERROR");
 
@@ -46,6 +48,8 @@ EventLoaderEUDAQ2::EventLoaderEUDAQ2(Configuration& config, std::shared_ptr<Dete
     adjust_event_times_ = config_.getMatrix<std::string>("adjust_event_times", {});
     buffer_depth_ = config_.get<int>("buffer_depth");
     shift_triggers_ = config_.get<int>("shift_triggers");
+    prefetch_depth_ = config_.get<size_t>("prefetch_depth");
+    decoder_workers_ = config_.get<unsigned int>("decoder_workers");
     inclusive_ = config_.get<bool>("inclusive");
     sync_by_trigger_ = config_.get<bool>("sync_by_trigger");
 
@@ -83,9 +87,22 @@ EventLoaderEUDAQ2::EventLoaderEUDAQ2(Configuration& config, std::shared_ptr<Dete
     if(shift_triggers_ < 0) {
         throw InvalidValueError(config_, "shift_triggers", "Trigger shift needs to be positive (or zero).");
     }
+    if(decoder_workers_ == 0) {
+        throw InvalidValueError(config_, "decoder_workers", "number of workers should be strictly more than zero");
+    }
+}
+
+EventLoaderEUDAQ2::~EventLoaderEUDAQ2() {
+    stop_read_ahead();
 }
 
 void EventLoaderEUDAQ2::initialize() {
+    // Skip the data before the partition of the run processed by this process
+    auto partition_begin = get_partition_begin_time();
+    if(partition_begin > skip_time_) {
+        LOG(INFO) << "Skipping data before partition start at " << Units::display(partition_begin, {"us", "ms", "s"});
+        skip_time_ = partition_begin;
+    }
 
     // Declare histograms
     std::string title = ";EUDAQ event start time[ms];# entries";
@@ -198,6 +215,25 @@ void EventLoaderEUDAQ2::initialize() {
                 "Parameter needs 3 values per row: [\"event type\", shift event start, shift event end]");
         }
     }
+
+    // Start reading and decoding events ahead of their processing
+    if(prefetch_depth_ > 0) {
+        LOG(DEBUG) << "Reading ahead " << prefetch_depth_ << " events, decoding with " << decoder_workers_ << " workers";
+        auto log_level = corryvreckan::Log::getReportingLevel();
+        auto log_format = corryvreckan::Log::getFormat();
+        ThreadPool::registerThreadCount(decoder_workers_);
+        decoder_pool_ = std::make_unique<ThreadPool>(
+            decoder_workers_, static_cast<unsigned int>(prefetch_depth_) + decoder_workers_, [log_level, log_format]() {
+                // Initialize the threads to the same log level and format as the master setting
+                corryvreckan::Log::setReportingLevel(log_level);
+                corryvreckan::Log::setFormat(log_format);
+            });
+        reader_thread_ = std::thread([this, log_level, log_format]() {
+            corryvreckan::Log::setReportingLevel(log_level);
+            corryvreckan::Log::setFormat(log_format);
+            read_ahead();
+        });
+    }
 }
 
 std::shared_ptr<eudaq::StandardEvent> EventLoaderEUDAQ2::get_next_sorted_std_event() {
@@ -220,14 +256,51 @@ std::shared_ptr<eudaq::StandardEvent> EventLoaderEUDAQ2::get_next_std_event() {
 
     // Check if we still have a decoded event in the cache or if we need to read and decode new ones:
     while(events_decoded_.empty()) {
+        std::vector<eudaq::StandardEventSP> decoded_events;
+
+        if(prefetch_depth_ > 0) {
+            // Take the next event from the read-ahead queue, waiting for it to be read and decoded:
+            std::unique_lock<std::mutex> lock{prefetch_mutex_};
+            prefetch_condition_.wait(lock, [this]() { return !events_prefetched_.empty(); });
 
+            // The end-of-file marker is kept in the queue for subsequent calls
+            if(!events_prefetched_.front().valid()) {
+                throw EndOfFile();
+            }
+            auto future = std::move(events_prefetched_.front());
+            events_prefetched_.pop_front();
+            lock.unlock();
+            prefetch_condition_.notify_all();
+
+            // Rethrows exceptions from reading or decoding the event
+            decoded_events = future.get();
+        } else {
+            auto event = read_next_raw_event();
+            if(!event) {
+                throw EndOfFile();
+            }
+            decoded_events = decode_event(event);
+        }
+
+        for(auto& decoded_event : decoded_events) {
+            events_decoded_.push(std::move(decoded_event));
+        }
+    }
+
+    auto stdevt = events_decoded_.front();
+    events_decoded_.pop();
+    return stdevt;
+}
+
+eudaq::EventSPC EventLoaderEUDAQ2::read_next_raw_event() {
+    while(true) {
         // Check if we need a new raw event or if we still have some in the cache:
         if(events_raw_.empty()) {
             LOG(TRACE) << "Reading new EUDAQ event from file";
             auto new_event = reader_->GetNextEvent();
             if(!new_event) {
                 LOG(DEBUG) << "Reached EOF";
-                throw EndOfFile();
+                return nullptr;
             }
             // Build buffer from all sub-events:
             auto subevents = new_event->GetSubEvents();
@@ -248,33 +321,97 @@ std::shared_ptr<eudaq::StandardEvent> EventLoaderEUDAQ2::get_next_std_event() {
             LOG(DEBUG) << "Found EUDAQ2 BORE event, ignoring it";
             continue;
         }
+        return event;
+    }
+}
 
-        // Create new StandardEvent and attempt to decode the raw event
-        auto decoded_event = eudaq::StandardEvent::MakeShared();
-        if(eudaq::StdEventConverter::Convert(event, decoded_event, eudaq_config_)) {
-            // Decoding succeeded, let's add it to the FIFO with all its subevents:
-            for(const auto& subevent : decoded_event->GetSubEvents()) {
-                // Make sure this is a decoded event:
-                auto decoded_subevent = std::dynamic_pointer_cast<const eudaq::StandardEvent>(subevent);
-                if(decoded_subevent == nullptr) {
-                    LOG(WARNING) << "Decoded EUDAQ2 StandardEvent " << decoded_event->GetDescription()
-                                 << " contained undecoded subevent - discarded";
-                    continue;
-                }
-
-                // Remove const'ness - we might have to alter it later on:
-                events_decoded_.push(std::const_pointer_cast<eudaq::StandardEvent>(decoded_subevent));
+std::vector<eudaq::StandardEventSP> EventLoaderEUDAQ2::decode_event(const eudaq::EventSPC& event) const {
+    std::vector<eudaq::StandardEventSP> decoded_events;
+
+    // Create new StandardEvent and attempt to decode the raw event
+    auto decoded_event = eudaq::StandardEvent::MakeShared();
+    if(eudaq::StdEventConverter::Convert(event, decoded_event, eudaq_config_)) {
+        // Decoding succeeded, let's add it to the FIFO with all its subevents:
+        for(const auto& subevent : decoded_event->GetSubEvents()) {
+            // Make sure this is a decoded event:
+            auto decoded_subevent = std::dynamic_pointer_cast<const eudaq::StandardEvent>(subevent);
+            if(decoded_subevent == nullptr) {
+                LOG(WARNING) << "Decoded EUDAQ2 StandardEvent " << decoded_event->GetDescription()
+                             << " contained undecoded subevent - discarded";
+                continue;
             }
-            events_decoded_.push(decoded_event);
-            LOG(DEBUG) << event->GetDescription() << ": decoding succeeded";
-        } else {
-            LOG(DEBUG) << event->GetDescription() << ": decoding failed";
+
+            // Remove const'ness - we might have to alter it later on:
+            decoded_events.push_back(std::const_pointer_cast<eudaq::StandardEvent>(decoded_subevent));
         }
+        decoded_events.push_back(decoded_event);
+        LOG(DEBUG) << event->GetDescription() << ": decoding succeeded";
+    } else {
+        LOG(DEBUG) << event->GetDescription() << ": decoding failed";
     }
 
-    auto stdevt = events_decoded_.front();
-    events_decoded_.pop();
-    return stdevt;
+    return decoded_events;
+}
+
+void EventLoaderEUDAQ2::read_ahead() {
+    while(true) {
+        // Wait for space in the read-ahead queue:
+        std::unique_lock<std::mutex> lock{prefetch_mutex_};
+        prefetch_condition_.wait(lock, [this]() { return stop_prefetch_ || events_prefetched_.size() < prefetch_depth_; });
+        if(stop_prefetch_) {
+            return;
+        }
+        lock.unlock();
+
+        // Read the next event, exceptions are forwarded to the processing of the event
+        auto promise = std::make_shared<std::promise<std::vector<eudaq::StandardEventSP>>>();
+        eudaq::EventSPC event;
+        bool failed = false;
+        try {
+            event = read_next_raw_event();
+        } catch(...) {
+            promise->set_exception(std::current_exception());
+            failed = true;
+        }
+
+        // Queue the future result in file order, followed by the end-of-file marker if no event is left to read:
+        lock.lock();
+        if(event || failed) {
+            events_prefetched_.push_back(promise->get_future());
+        }
+        if(!event) {
+            events_prefetched_.emplace_back();
+        }
+        lock.unlock();
+        prefetch_condition_.notify_all();
+        if(!event) {
+            return;
+        }
+
+        // Decode the event on one of the workers:
+        decoder_pool_->submit([this, event, promise]() {
+            try {
+                promise->set_value(decode_event(event));
+            } catch(...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+    }
+}
+
+void EventLoaderEUDAQ2::stop_read_ahead() {
+    if(!reader_thread_.joinable()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock{prefetch_mutex_};
+    stop_prefetch_ = true;
+    lock.unlock();
+    prefetch_condition_.notify_all();
+
+    // Destroying the pool releases the reader in case it is waiting to submit an event
+    decoder_pool_->destroy();
+    reader_thread_.join();
 }
 
 void EventLoaderEUDAQ2::retrieve_event_tags(const eudaq::EventSPC evt) {
@@ -492,7 +629,7 @@ PixelVector EventLoaderEUDAQ2::get_pixel_data(std::shared_ptr<eudaq::StandardEve
 
         // when calibration is not available, set charge = raw
         auto pixel = (plane.HasWaveform(i)
-                          ? std::make_shared<Waveform>(
+                          ? make_pooled<Waveform>(
                                 detector_->getName(),
                                 col,
                                 row,
@@ -500,7 +637,7 @@ PixelVector EventLoaderEUDAQ2::get_pixel_data(std::shared_ptr<eudaq::StandardEve
                                 raw,
                                 ts,
                                 Waveform::waveform_t{plane.GetWaveform(i), plane.GetWaveformX0(i), plane.GetWaveformDX(i)})
-                          : std::make_shared<Pixel>(detector_->getName(), col, row, raw, raw, ts));
+                          : make_pooled<Pixel>(detector_->getName(), col, row, raw, raw, ts));
 
         hitmap->Fill(col, row);
         hPixelTimes->Fill(static_cast<double>(Units::convert(ts, "ms")));
@@ -699,6 +836,7 @@ StatusCode EventLoaderEUDAQ2::run(const std::shared_ptr<Clipboard>& clipboard) {
 }
 
 void EventLoaderEUDAQ2::finalize(const std::shared_ptr<ReadonlyClipboard>&) {
+    stop_read_ahead();
 
     LOG(INFO) << "Found " << hits_ << " hits in the data.";
 }
@@ -12,8 +12,13 @@
  * Refer to the User's Manual for more details.
  */
 
+#include <condition_variable>
+#include <deque>
+#include <future>
 #include <iostream>
+#include <mutex>
 #include <queue>
+#include <thread>
 #include <vector>
 
 #include <TCanvas.h>
@@ -27,6 +32,7 @@
 #include <eudaq/StdEventConverter.hh>
 
 #include "core/module/Module.hpp"
+#include "core/utils/ThreadPool.hpp"
 #include "objects/Cluster.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/Track.hpp"
@@ -49,6 +55,11 @@ namespace corryvreckan {
          */
         EventLoaderEUDAQ2(Configuration& config, std::shared_ptr<Detector> detector);
 
+        /**
+         * @brief Stop the read-ahead of events if still running
+         */
+        ~EventLoaderEUDAQ2() override;
+
         /**
          * @brief [Initialise this module]
          */
@@ -74,6 +85,29 @@ namespace corryvreckan {
          */
         std::shared_ptr<eudaq::StandardEvent> get_next_std_event();
 
+        /**
+         * @brief Read the next (sub-) event from file, skipping Begin-of-Run events if requested
+         * @return Next raw EUDAQ event or nullptr if the end of the file has been reached
+         */
+        eudaq::EventSPC read_next_raw_event();
+
+        /**
+         * @brief Decode a raw event into StandardEvents. This function may be called concurrently from decoder workers.
+         * @param event Raw EUDAQ event to decode
+         * @return Decoded sub-events followed by the decoded event itself, or no events if decoding failed
+         */
+        std::vector<eudaq::StandardEventSP> decode_event(const eudaq::EventSPC& event) const;
+
+        /**
+         * @brief Body of the read-ahead thread, reading raw events and handing them to the decoder workers in order
+         */
+        void read_ahead();
+
+        /**
+         * @brief Stop the read-ahead thread and the decoder workers
+         */
+        void stop_read_ahead();
+
         /**
          * @brief Check whether the current EUDAQ StandardEvent is within the defined Corryvreckan event
          * @param  clipboard  Shared pointer to the event clipboard
@@ -118,6 +152,8 @@ namespace corryvreckan {
         Matrix<std::string> adjust_event_times_;
         int buffer_depth_;
         int shift_triggers_;
+        size_t prefetch_depth_{};
+        unsigned int decoder_workers_{};
 
         size_t hits_ = 0;
 
@@ -128,6 +164,15 @@ namespace corryvreckan {
         std::queue<eudaq::EventSPC> events_raw_;
         std::queue<eudaq::StandardEventSP> events_decoded_;
 
+        // Read-ahead of events: the reader thread hands raw events to the decoder workers and queues the future results in
+        // the order of the file. An invalid future marks the end of the file.
+        std::thread reader_thread_;
+        std::unique_ptr<ThreadPool> decoder_pool_;
+        std::deque<std::future<std::vector<eudaq::StandardEventSP>>> events_prefetched_;
+        std::mutex prefetch_mutex_;
+        std::condition_variable prefetch_condition_;
+        bool stop_prefetch_{};
+
         // Currently processed decoded EUDAQ StandardEvent:
         std::shared_ptr<eudaq::StandardEvent> event_;
 
@@ -11,6 +11,7 @@
 #include "EventLoaderFASTPIX.h"
 #include <TMath.h>
 #include <TMultiGraph.h>
+#include <cstring>
 #include "objects/SpidrSignal.hpp"
 
 using namespace corryvreckan;
@@ -18,7 +19,12 @@ using namespace corryvreckan;
 EventLoaderFASTPIX::EventLoaderFASTPIX(Configuration& config, std::shared_ptr<Detector> detector)
     : Module(config, detector), m_detector(detector) {
 
-    m_inputFile.open(config_.getPath("input_file"), std::ifstream::binary);
+    config_.setDefault<size_t>("read_block_size", 1 << 20);
+    config_.setDefault<size_t>("read_ahead_blocks", 0);
+
+    m_inputFile.open(config_.getPath("input_file"),
+                     config_.get<size_t>("read_block_size"),
+                     config_.get<size_t>("read_ahead_blocks"));
 
     m_timeScaler = config_.get("time_scaler", 0.999994);
 }
@@ -117,23 +123,22 @@ void EventLoaderFASTPIX::initialize() {
     m_scope_t0 = 0;
 
     m_triggerSync = false;
+    m_eof = false;
 
     uint16_t version = 0;
 
-    if(!m_inputFile) {
+    if(!m_inputFile.is_open()) {
         throw ModuleError("Could not open file");
     }
 
-    m_inputFile.read(reinterpret_cast<char*>(&version), sizeof version);
+    m_inputFile.read(version);
     LOG(INFO) << "Reading file format version " << version;
 
     if(version != 0) {
         throw ModuleError("Invalid file format version " + std::to_string(static_cast<unsigned>(version)));
     }
 
-    m_inputFile.read(reinterpret_cast<char*>(&m_blockSize), sizeof m_blockSize);
-
-    if(m_blockSize == 0) {
+    if(!m_inputFile.read(m_blockSize) || m_blockSize == 0) {
         throw ModuleError("Invalid data block size");
     }
 }
@@ -162,12 +167,23 @@ bool EventLoaderFASTPIX::loadEvent(PixelVector& deviceData,
     uint16_t event_flags;
     uint16_t event_meta;
 
-    m_prevEvent = m_inputFile.tellg();
+    m_prevEvent = m_inputFile.tell();
 
-    m_inputFile.read(reinterpret_cast<char*>(&event_timestamp), sizeof event_timestamp);
-    m_inputFile.read(reinterpret_cast<char*>(&event_flags), sizeof event_flags);
-    m_inputFile.read(reinterpret_cast<char*>(&event_meta), sizeof event_meta);
-    m_inputFile.read(reinterpret_cast<char*>(&event_size), sizeof event_size);
+    // Decode the event header from the read buffer
+    const size_t header_size = sizeof event_timestamp + sizeof event_flags + sizeof event_meta + sizeof event_size;
+    const char* header = m_inputFile.fetch(header_size);
+    if(header == nullptr) {
+        LOG(WARNING) << "Incomplete event header at end of file";
+        m_eof = true;
+        return false;
+    }
+    std::memcpy(&event_timestamp, header, sizeof event_timestamp);
+    header += sizeof event_timestamp;
+    std::memcpy(&event_flags, header, sizeof event_flags);
+    header += sizeof event_flags;
+    std::memcpy(&event_meta, header, sizeof event_meta);
+    header += sizeof event_meta;
+    std::memcpy(&event_size, header, sizeof event_size);
 
     LOG(DEBUG) << "Event timestamp: " << event_timestamp;
     LOG(DEBUG) << "Event size: " << event_size;
@@ -201,13 +217,24 @@ bool EventLoaderFASTPIX::loadEvent(PixelVector& deviceData,
     int seed_col = 0;
     int seed_row = 0;
 
-    for(uint16_t i = 0; i < event_size; i++) {
-        uint16_t idx;
-        double tot, px_timestamp;
+    // All pixels of the event are decoded from one contiguous record in the read buffer
+    uint16_t idx;
+    double tot, px_timestamp;
+    const size_t pixel_size = sizeof idx + sizeof tot + sizeof px_timestamp;
+    const char* pixel_data = m_inputFile.fetch(static_cast<size_t>(event_size) * pixel_size);
+    if(pixel_data == nullptr) {
+        LOG(WARNING) << "Incomplete event data at end of file";
+        m_eof = true;
+        return false;
+    }
 
-        m_inputFile.read(reinterpret_cast<char*>(&idx), sizeof idx);
-        m_inputFile.read(reinterpret_cast<char*>(&tot), sizeof tot);
-        m_inputFile.read(reinterpret_cast<char*>(&px_timestamp), sizeof px_timestamp);
+    for(uint16_t i = 0; i < event_size; i++) {
+        std::memcpy(&idx, pixel_data, sizeof idx);
+        pixel_data += sizeof idx;
+        std::memcpy(&tot, pixel_data, sizeof tot);
+        pixel_data += sizeof tot;
+        std::memcpy(&px_timestamp, pixel_data, sizeof px_timestamp);
+        pixel_data += sizeof px_timestamp;
 
         hitmap->SetBinContent(idx + 1, hitmap->GetBinContent(idx + 1) + 1);
         pixel_timestamps->Fill(px_timestamp);
@@ -232,7 +259,7 @@ bool EventLoaderFASTPIX::loadEvent(PixelVector& deviceData,
 
         col = col - (row - (row & 1)) / 2;
 
-        auto pixel = std::make_shared<Pixel>(
+        auto pixel = make_pooled<Pixel>(
             detectorID, col, row, static_cast<int>(tot), tot, spidr_timestamp + px_timestamp + m_detector->timeOffset());
         deviceData.push_back(pixel);
     }
@@ -251,10 +278,8 @@ bool EventLoaderFASTPIX::loadEvent(PixelVector& deviceData,
 }
 
 double EventLoaderFASTPIX::getRawTimestamp() {
-    double timestamp;
-
-    m_inputFile.read(reinterpret_cast<char*>(&timestamp), sizeof timestamp);
-    m_inputFile.seekg(-static_cast<int>(sizeof timestamp), std::ios_base::cur);
+    double timestamp = 0;
+    m_inputFile.peek(timestamp);
 
     return timestamp * 1e9;
 }
@@ -287,10 +312,18 @@ StatusCode EventLoaderFASTPIX::run(const std::shared_ptr<Clipboard>& clipboard)
     std::map<std::string, std::string> discardTags;
 
     for(;;) {
+        // Stop at the end of the file, the timestamp of the next event is read without consuming it
+        double raw_timestamp;
+        if(m_eof || !m_inputFile.peek(raw_timestamp)) {
+            LOG(DEBUG) << "Reached end of file";
+            m_eof = true;
+            break;
+        }
+
         // Oscilloscope triggers are aligned to SPIDR timestamps/triggers. Time offsets should be compensated in the
         // EventLoaderTimestamp module and not in this event loader to assign both triggers and pixel data to the correct
         // event.
-        LOG(DEBUG) << "Raw timestamp: " << getRawTimestamp();
+        LOG(DEBUG) << "Raw timestamp: " << raw_timestamp * 1e9;
         double timestamp = getTimestamp();
         auto position = event->getTimestampPosition(timestamp);
 
@@ -331,7 +364,7 @@ StatusCode EventLoaderFASTPIX::run(const std::shared_ptr<Clipboard>& clipboard)
                        m_triggerNumber) { // SPIDR trigger belongs to previous Fastpix trigger
                         LOG(INFO) << "Rewinding Fastpix trigger";
                         m_triggerNumber--;
-                        m_inputFile.seekg(m_prevEvent, std::ios_base::beg);
+                        m_inputFile.seek(m_prevEvent);
 
                         loadEvent(deviceData, eventTags, triggers[trigger_index].second);
                     } else {
@@ -398,6 +431,11 @@ StatusCode EventLoaderFASTPIX::run(const std::shared_ptr<Clipboard>& clipboard)
         }
     }
 
+    if(m_eof && deviceData.empty()) {
+        LOG(INFO) << "No more data in input file";
+        return StatusCode::EndRun;
+    }
+
     if(!deviceData.empty()) {
         clipboard->putData(deviceData, m_detector->getName());
     }
@@ -18,6 +18,7 @@
 #include "objects/Cluster.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/Track.hpp"
+#include "tools/block_reader.h"
 
 namespace corryvreckan {
     /** @ingroup Modules
@@ -82,7 +83,7 @@ namespace corryvreckan {
         size_t m_incompleteEvents;
         size_t m_noiseEvents;
 
-        std::streampos m_prevEvent;
+        size_t m_prevEvent;
 
         double m_prevTriggerTime;
         double m_prevScopeTriggerTime;
@@ -91,7 +92,8 @@ namespace corryvreckan {
         double m_spidr_t0;
         double m_scope_t0;
 
-        std::ifstream m_inputFile;
+        BlockReader m_inputFile;
+        bool m_eof;
 
         std::vector<double> m_scopeTriggerNumbers;
         std::vector<double> m_scopeTriggerTimestamps;
@@ -9,6 +9,7 @@
  */
 
 #include "EventLoaderMuPixTelescope.h"
+#include <algorithm>
 #include <string>
 #include "dirent.h"
 #include "objects/Cluster.hpp"
@@ -31,6 +32,7 @@ EventLoaderMuPixTelescope::EventLoaderMuPixTelescope(Configuration& config, std:
     config_.setDefault<uint>("ckdivend", 0);
     config_.setDefault<uint>("ckdivend2", 7);
     config_.setDefault<bool>("use_both_timestamps", false);
+    config_.setDefault<size_t>("read_ahead_frames", 0);
 
     use_both_timestamps_ = config_.get<bool>("use_both_timestamps");
     nbitsTS_ = config_.get<uint>("nbits_timestamp");
@@ -41,6 +43,7 @@ EventLoaderMuPixTelescope::EventLoaderMuPixTelescope(Configuration& config, std:
     inputDirectory_ = config_.getPath("input_directory");
     buffer_depth_ = config.get<unsigned>("buffer_depth");
     isSorted_ = config_.get<bool>("is_sorted");
+    read_ahead_frames_ = config_.get<size_t>("read_ahead_frames");
     if(config.count({"run", "input_file"}) > 1) {
         throw InvalidCombinationError(config, {"run", "input_file"}, "run and input_file are mutually exclusive.");
     } else if(config_.has("input_file")) {
@@ -90,7 +93,7 @@ void EventLoaderMuPixTelescope::initialize() {
         types_[tag_] = typeString_to_typeID.at(detector->getType());
         LOG(INFO) << "Detector " << detector->getType() << "is assigned to type id " << types_.at(tag_);
         names_[tag_] = detector->getName();
-        pixelbuffers_[tag_]; // create an empty map entry
+        pixelbuffers_.emplace(tag_, TimeSortedBuffer<std::shared_ptr<Pixel>>(Units::get<double>(1, "us")));
         pixels_[tag_];
     }
 
@@ -125,6 +128,24 @@ void EventLoaderMuPixTelescope::initialize() {
     if(!blockFile_->open_read()) {
         throw MissingDataError("Cannot read data file: " + input_file_);
     }
+
+    // Read and decode frames in batches in a background thread
+    if(read_ahead_frames_ > 0) {
+        const size_t batch_size = std::min<size_t>(read_ahead_frames_, 1024);
+        const size_t batches = (read_ahead_frames_ + batch_size - 1) / batch_size;
+        LOG(DEBUG) << "Reading ahead " << batches << " batches of " << batch_size << " frames";
+        read_ahead_ = std::make_unique<ReadAheadThread<std::vector<TelescopeFrame>>>(
+            [this, batch_size](std::vector<TelescopeFrame>& frames) {
+                frames.resize(batch_size);
+                size_t count = 0;
+                while(count < frames.size() && blockFile_->read_next(frames[count])) {
+                    count++;
+                }
+                frames.resize(count);
+                return count > 0;
+            },
+            batches);
+    }
     TDirectory* dir = getROOTDirectory();
 
     // create the histograms for all sensor
@@ -180,9 +201,14 @@ void EventLoaderMuPixTelescope::initialize() {
         title = name + "Delay of chip events wrt. telescope frame;fpga clock@ chip clock 0;#events";
         chip_delay[name] = new TH1F("chip_delay", title.c_str(), 2048, -1023, 1023);
     }
+
+    hts_ToT_mp10_ = hts_ToT["mp10_0"];
+    ts_TS1_ToT_mp10_ = ts_TS1_ToT["mp10_0"];
+    ts1_ts2_mp10_ = ts1_ts2["mp10_0"];
 }
 
 void EventLoaderMuPixTelescope::finalize(const std::shared_ptr<ReadonlyClipboard>&) {
+    read_ahead_.reset();
 
     for(auto d : tags_)
         LOG(INFO) << names_.at(d) << ": Number of hits put to clipboard: " << stored_.at(d)
@@ -193,16 +219,17 @@ void EventLoaderMuPixTelescope::finalize(const std::shared_ptr<ReadonlyClipboard
 
 StatusCode EventLoaderMuPixTelescope::read_sorted(const std::shared_ptr<Clipboard>& clipboard) {
     PixelVector hits;
-    if(!blockFile_->read_next(tf_)) {
+    if(!read_frame()) {
         return StatusCode::EndRun;
     }
     for(uint i = 0; i < tf_.num_hits(); ++i) {
         RawHit h = tf_.get_hit(i);
         auto tag = h.tag() & uint(~0x3);
-        if(names_.count(tag) != 1) {
+        auto name = names_.find(tag);
+        if(name == names_.end()) {
             throw RuntimeError("Unknown pixel tag read in data: " + to_string(tag));
         }
-        pixels_[tag].push_back(read_hit(h, tag, tf_.timestamp()));
+        pixels_[tag].push_back(read_hit(h, tag, name->second, tf_.timestamp()));
     }
     // If no event is defined create one
     if(!clipboard->isEventDefined()) {
@@ -234,37 +261,45 @@ StatusCode EventLoaderMuPixTelescope::read_unsorted(const std::shared_ptr<Clipbo
     }
 
     for(auto t : tags_) {
+        // Look up the buffers and histograms of this sensor once for all its hits
+        auto& buffer = pixelbuffers_.at(t);
+        auto& pixels = pixels_.at(t);
+        const auto& name = names_.at(t);
+        auto* discarded_hitmap = hdiscardedHitmap.at(name);
+        auto* hitmap = hHitMap.at(name);
+        auto* pixel_tot = hPixelToT.at(name);
+        auto* timestamp = hTimeStamp.at(name);
+
         while(true) {
-            if(pixelbuffers_.at(t).size() == 0 && !eof_)
+            if(buffer.size() == 0 && !eof_)
                 fillBuffer();
-            if(pixelbuffers_.at(t).size() == 0) {
+            if(buffer.size() == 0) {
                 LOG(DEBUG) << "Buffer " << t << " empty";
                 return StatusCode::EndRun;
             }
-            auto pixel = pixelbuffers_.at(t).top();
-            if(pixelbuffers_.at(t).size() && (pixel->timestamp() < clipboard->getEvent()->start())) {
+            auto pixel = buffer.top();
+            if(buffer.size() && (pixel->timestamp() < clipboard->getEvent()->start())) {
                 LOG(DEBUG) << " Old hit found: " << Units::display(pixel->timestamp(), "us") << " vs prev end ("
                            << eventNo_ - 1 << ")\t" << Units::display(prev_event_end_, "us") << " and current start \t"
                            << Units::display(clipboard->getEvent()->start(), "us")
                            << " and duration: " << clipboard->getEvent()->duration()
                            << "and number of triggers: " << clipboard->getEvent()->triggerList().size();
                 removed_.at(t)++;
-                hdiscardedHitmap.at(names_.at(t))->Fill(pixel->column(), pixel->row());
-                pixelbuffers_.at(t).pop(); // remove top element
+                discarded_hitmap->Fill(pixel->column(), pixel->row());
+                buffer.pop(); // remove top element
                 continue;
-            } else if(pixelbuffers_.at(t).size() && (pixel->timestamp() < clipboard->getEvent()->end()) &&
+            } else if(buffer.size() && (pixel->timestamp() < clipboard->getEvent()->end()) &&
                       (pixel->timestamp() > clipboard->getEvent()->start())) {
                 LOG(DEBUG) << " Adding pixel hit: " << Units::display(pixel->timestamp(), "us") << " vs prev end ("
                            << eventNo_ - 1 << ")\t" << Units::display(prev_event_end_, "us") << " and current start \t"
                            << Units::display(clipboard->getEvent()->start(), "us")
                            << " and duration: " << Units::display(clipboard->getEvent()->duration(), "us");
-                pixels_.at(t).push_back(pixel);
-                hHitMap.at(names_.at(t))->Fill(pixel.get()->column(), pixel.get()->row());
-                hPixelToT.at(names_.at(t))->Fill(pixel.get()->raw());
-                // hPixelToT.at(names_.at(t))->Fill(pixel.get()->raw());
+                pixels.push_back(pixel);
+                hitmap->Fill(pixel.get()->column(), pixel.get()->row());
+                pixel_tot->Fill(pixel.get()->raw());
                 // display the 10 bit timestamp distribution
-                hTimeStamp.at(names_.at(t))->Fill(fmod((pixel.get()->timestamp() / 8.), pow(2, 10)));
-                pixelbuffers_.at(t).pop(); // remove top element
+                timestamp->Fill(fmod((pixel.get()->timestamp() / 8.), pow(2, 10)));
+                buffer.pop(); // remove top element
             } else {
                 break;
             }
@@ -291,7 +326,10 @@ StatusCode EventLoaderMuPixTelescope::read_unsorted(const std::shared_ptr<Clipbo
     return StatusCode::NoData;
 }
 
-std::shared_ptr<Pixel> EventLoaderMuPixTelescope::read_hit(const RawHit& h, uint tag, long unsigned int corrected_fpgaTime) {
+std::shared_ptr<Pixel> EventLoaderMuPixTelescope::read_hit(const RawHit& h,
+                                                           uint tag,
+                                                           const std::string& name,
+                                                           long unsigned int corrected_fpgaTime) {
 
     uint16_t time = 0x0;
     // TS can be sampled on both edges - keep this optional
@@ -308,17 +346,17 @@ std::shared_ptr<Pixel> EventLoaderMuPixTelescope::read_hit(const RawHit& h, uint
 
     double time_shifted = static_cast<double>(time) * static_cast<double>(ckdivend_ + 1);
 
-    ts1_ts2["mp10_0"]->Fill(h.get_ts2(), h.timestamp_raw());
+    ts1_ts2_mp10_->Fill(h.get_ts2(), h.timestamp_raw());
     double px_timestamp = clockToTime_ * (static_cast<double>((corrected_fpgaTime >> 1) & 0xFFFFFFFFFF800) + time_shifted) -
                           static_cast<double>(timeOffset_.at(tag));
 
-    hts_ToT["mp10_0"]->Fill(static_cast<double>(h.tot_decoded()));
+    hts_ToT_mp10_->Fill(static_cast<double>(h.tot_decoded()));
 
     // store the ToT information if reasonable
     double tot_timestamp = clockToTime_ * (static_cast<double>(h.tot_decoded()) * multiplierToT_);
 
-    ts_TS1_ToT["mp10_0"]->Fill(static_cast<double>((static_cast<uint>(px_timestamp / 8)) & timestampMaskExtended_),
-                               (static_cast<double>(static_cast<uint>(tot_timestamp / 8) & timestampMaskExtended_)));
+    ts_TS1_ToT_mp10_->Fill(static_cast<double>((static_cast<uint>(px_timestamp / 8)) & timestampMaskExtended_),
+                           (static_cast<double>(static_cast<uint>(tot_timestamp / 8) & timestampMaskExtended_)));
 
     double tot = tot_timestamp - (time_shifted * clockToTime_);
 
@@ -326,7 +364,7 @@ std::shared_ptr<Pixel> EventLoaderMuPixTelescope::read_hit(const RawHit& h, uint
     while(tot < 0)
         tot += maxToT_;
 
-    return std::make_shared<Pixel>(names_.at(tag), h.column(), h.row(), tot, tot, px_timestamp);
+    return make_pooled<Pixel>(name, h.column(), h.row(), tot, tot, px_timestamp);
 }
 
 void EventLoaderMuPixTelescope::fillBuffer() {
@@ -344,7 +382,7 @@ void EventLoaderMuPixTelescope::fillBuffer() {
         return;
     }
     while(!buffers_full) {
-        if(blockFile_->read_next(tf_)) {
+        if(read_frame()) {
             //      std::cout << "Reading hit: "<< tf_.timestamp() <<std::endl;
             // no hits in data - can only happen if the zero suppression is switched off, skip the event
             if(tf_.num_hits() == 0) {
@@ -354,12 +392,18 @@ void EventLoaderMuPixTelescope::fillBuffer() {
             RawHit h = tf_.get_hit(0);
             // tag does not match - continue reading if data is not sorted
             uint tag = h.tag() & (~0x3);
-            if(names_.count(tag) != 1) {
+            auto name = names_.find(tag);
+            if(name == names_.end()) {
                 throw RuntimeError("Unknown pixel tag read in data: " + to_string(tag));
             }
-            // all hits in one frame are from the same sensor. Copy them
+            // all hits in one frame are from the same sensor. Look up its buffer and histograms once and copy the hits
+            const auto type = types_.at(tag);
+            auto& buffer = pixelbuffers_.at(tag);
+            auto* fpga_vs_chip = raw_fpga_vs_chip.at(name->second);
+            auto* fpga_vs_chip_corrected = raw_fpga_vs_chip_corrected.at(name->second);
+            auto* delay = chip_delay.at(name->second);
             for(uint i = 0; i < tf_.num_hits(); ++i) {
-                h = tf_.get_hit(i, types_.at(tag));
+                h = tf_.get_hit(i, type);
                 LOG(TRACE) << "Filling buffer with " << h;
 
                 // this assumes a few things:
@@ -368,16 +412,15 @@ void EventLoaderMuPixTelescope::fillBuffer() {
                 // just take 10 bits from the hit timestamp
                 raw_time = h.timestamp_raw() & 0x3FF;
                 // get the fpga time +1bit just for plots
-                raw_fpga_vs_chip.at(names_.at(tag))->Fill(raw_time, static_cast<double>(corrected_fpgaTime & 0x7FF));
-                chip_delay.at(names_.at(tag))->Fill(static_cast<double>((corrected_fpgaTime & 0x3FF) - raw_time));
+                fpga_vs_chip->Fill(raw_time, static_cast<double>(corrected_fpgaTime & 0x7FF));
+                delay->Fill(static_cast<double>((corrected_fpgaTime & 0x3FF) - raw_time));
                 // if the chip timestamp is smaller than the fpga we have a bit flip on the 11th bit
                 if(((corrected_fpgaTime & 0x3FF) < raw_time)) { // && (corrected_fpgaTime>1024)) {
                     corrected_fpgaTime -= 1024;
                 }
-                raw_fpga_vs_chip_corrected.at(names_.at(tag))
-                    ->Fill(raw_time, static_cast<double>(corrected_fpgaTime & 0x7FF));
+                fpga_vs_chip_corrected->Fill(raw_time, static_cast<double>(corrected_fpgaTime & 0x7FF));
 
-                pixelbuffers_.at(tag).push(read_hit(h, tag, (corrected_fpgaTime * 4)));
+                buffer.push(read_hit(h, tag, name->second, (corrected_fpgaTime * 4)));
             }
             buffers_full = true;
             for(auto t : tags_) {
@@ -393,6 +436,24 @@ void EventLoaderMuPixTelescope::fillBuffer() {
         }
     }
 }
+
+bool EventLoaderMuPixTelescope::read_frame() {
+    if(read_ahead_ == nullptr) {
+        return blockFile_->read_next(tf_);
+    }
+
+    // Take the next frame of the current batch, retrieving the next batch from the read-ahead thread if necessary
+    while(frame_index_ >= frames_.size()) {
+        frame_index_ = 0;
+        if(!read_ahead_->next(frames_)) {
+            frames_.clear();
+            return false;
+        }
+    }
+    std::swap(tf_, frames_[frame_index_++]);
+    return true;
+}
+
 std::map<std::string, int> EventLoaderMuPixTelescope::typeString_to_typeID = {{"mupix8", MP8_SORTED_TS2},
                                                                               {"mupix9", MP10_SORTED_TS2},
                                                                               {"mupix10", MP10_UNSORTED_GS1_GS2},
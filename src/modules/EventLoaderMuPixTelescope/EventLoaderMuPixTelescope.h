@@ -13,8 +13,10 @@
 #include <TH1F.h>
 #include <TH2F.h>
 #include <iostream>
-#include <queue>
+#include <memory>
 #include "core/module/Module.hpp"
+#include "core/utils/ReadAheadThread.hpp"
+#include "tools/time_sorted_buffer.h"
 
 // mupix telescope includes
 #include "blockfile.hpp"
@@ -52,8 +54,16 @@ namespace corryvreckan {
         StatusCode read_sorted(const std::shared_ptr<Clipboard>& clipboard);
         StatusCode read_unsorted(const std::shared_ptr<Clipboard>& clipboard);
 
-        std::shared_ptr<Pixel> read_hit(const RawHit& h, uint tag, unsigned long corrected_fpgaTime);
+        std::shared_ptr<Pixel>
+        read_hit(const RawHit& h, uint tag, const std::string& name, unsigned long corrected_fpgaTime);
         void fillBuffer();
+
+        /*
+         * @brief Read the next telescope frame into tf_, taking it from the read-ahead thread if enabled
+         * @return Bool which is false when reaching the end-of-file and true otherwise
+         */
+        bool read_frame();
+
         std::vector<uint> tags_{};
         double prev_event_end_{};
         std::map<uint, int> types_{};
@@ -67,13 +77,8 @@ namespace corryvreckan {
         std::map<uint, std::string> names_{};
         std::string input_file_{};
         std::vector<std::shared_ptr<Detector>> detectors_;
-        struct CompareTimeGreater {
-            bool operator()(const std::shared_ptr<Pixel>& a, const std::shared_ptr<Pixel>& b) {
-                return a->timestamp() > b->timestamp();
-            }
-        };
-        // Buffer of timesorted pixel hits: (need to use greater here!)
-        std::map<uint, std::priority_queue<std::shared_ptr<Pixel>, PixelVector, CompareTimeGreater>> pixelbuffers_;
+        // Buffer of timesorted pixel hits
+        std::map<uint, TimeSortedBuffer<std::shared_ptr<Pixel>>> pixelbuffers_;
         std::map<uint, PixelVector> pixels_{};
         std::string inputDirectory_;
         bool isSorted_;
@@ -93,6 +98,12 @@ namespace corryvreckan {
         BlockFile* blockFile_;
         TelescopeFrame tf_;
 
+        // Frames read ahead in batches by a background thread, and the batch currently decoded
+        size_t read_ahead_frames_{};
+        std::unique_ptr<ReadAheadThread<std::vector<TelescopeFrame>>> read_ahead_;
+        std::vector<TelescopeFrame> frames_;
+        size_t frame_index_{};
+
         // Histograms
         std::map<std::string, TH1F*> hPixelToT;
         std::map<std::string, TH1F*> hts_ToT;
@@ -107,6 +118,11 @@ namespace corryvreckan {
         std::map<std::string, TH1F*> chip_delay;
         std::map<std::string, TH2F*> ts1_ts2;
 
+        // Histograms filled for every hit, looked up once
+        TH1F* hts_ToT_mp10_{};
+        TH2F* ts_TS1_ToT_mp10_{};
+        TH2F* ts1_ts2_mp10_{};
+
         static std::map<std::string, int> typeString_to_typeID;
     };
 
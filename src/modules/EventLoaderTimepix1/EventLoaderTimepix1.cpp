@@ -104,7 +104,7 @@ StatusCode EventLoaderTimepix1::run(const std::shared_ptr<Clipboard>& clipboard)
     if(!m_fileOpen) {
         if(m_fileNumber < m_inputFilenames.size()) {
             // Open the file
-            m_currentFile.open(m_inputFilenames[m_fileNumber].c_str());
+            m_currentFile.open(m_inputFilenames[m_fileNumber]);
             LOG(DEBUG) << "Opened file: " << m_inputFilenames[m_fileNumber];
             m_fileOpen = true;
             m_fileNumber++;
@@ -116,8 +116,8 @@ StatusCode EventLoaderTimepix1::run(const std::shared_ptr<Clipboard>& clipboard)
     }
 
     // Keep running over current file
-    string data;
-    int row, col, tot;
+    std::string_view data;
+    int row = 0, col = 0, tot = 0;
     long long int time;
     string device;
     bool fileFinished = true;
@@ -134,10 +134,10 @@ StatusCode EventLoaderTimepix1::run(const std::shared_ptr<Clipboard>& clipboard)
     }
 
     // Then continue with the file
-    while(getline(m_currentFile, data)) {
+    while(m_currentFile.getline(data)) {
 
         // Check if the data read is a header or not (presence of # symbol)
-        if(data.find("#") != string::npos) {
+        if(data.find('#') != std::string_view::npos) {
 
             // Get time and detector id from header
             processHeader(data, device, time);
@@ -153,7 +153,7 @@ StatusCode EventLoaderTimepix1::run(const std::shared_ptr<Clipboard>& clipboard)
             if(time > m_eventTime) {
                 LOG(DEBUG) << "- jumping to next event since new event time is " << time;
                 m_eventTime = time;
-                m_prevHeader = data;
+                m_prevHeader = std::string(data);
                 fileFinished = false;
                 break;
             }
@@ -166,10 +166,11 @@ StatusCode EventLoaderTimepix1::run(const std::shared_ptr<Clipboard>& clipboard)
         } else {
 
             // load the real event data, and make a new pixel object
-            istringstream detectorData(data);
-            detectorData >> col >> row >> tot;
+            next_integer(data, col);
+            next_integer(data, row);
+            next_integer(data, tot);
             // when calibration is not available -> set charge = tot, timestamp not available -> set to 0.
-            auto pixel = std::make_shared<Pixel>(m_currentDevice, col, row, tot, tot, 0.);
+            auto pixel = make_pooled<Pixel>(m_currentDevice, col, row, tot, tot, 0.);
             // FIXME to work properly, m_eventTime needs to be converted to nanoseconds!
             pixel->timestamp(static_cast<double>(m_eventTime));
             dataContainers[m_currentDevice].push_back(pixel);
@@ -203,15 +204,14 @@ StatusCode EventLoaderTimepix1::run(const std::shared_ptr<Clipboard>& clipboard)
     return StatusCode::Success;
 }
 
-void EventLoaderTimepix1::processHeader(string header, string& device, long long int& time) {
+void EventLoaderTimepix1::processHeader(std::string_view header, string& device, long long int& time) {
     // time = stod(header.substr(header.find("Start time : ")+13,13));
 
-    string timestring = header.substr(header.find("Start time : ") + 13, 13);
-    std::istringstream timestream(timestring);
-    timestream >> time;
+    auto timestring = header.substr(header.find("Start time : ") + 13, 13);
+    next_integer(timestring, time);
 
-    device =
-        header.substr(header.find("ChipboardID : ") + 14, header.find(" # DACs") - (header.find("ChipboardID : ") + 14));
+    device = std::string(
+        header.substr(header.find("ChipboardID : ") + 14, header.find(" # DACs") - (header.find("ChipboardID : ") + 14)));
 }
 
 void EventLoaderTimepix1::finalize(const std::shared_ptr<ReadonlyClipboard>&) {
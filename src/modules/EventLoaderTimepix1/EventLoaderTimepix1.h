@@ -16,6 +16,7 @@
 #include <sstream>
 #include <string>
 #include "core/module/Module.hpp"
+#include "tools/line_reader.h"
 
 namespace corryvreckan {
     /** @ingroup Modules
@@ -34,7 +35,7 @@ namespace corryvreckan {
 
     private:
         static bool sortByTime(std::string filename1, std::string filename2);
-        void processHeader(std::string, std::string&, long long int&);
+        void processHeader(std::string_view, std::string&, long long int&);
 
         // Member variables
         int m_eventNumber;
@@ -43,7 +44,7 @@ namespace corryvreckan {
         bool m_fileOpen;
         size_t m_fileNumber;
         long long int m_eventTime;
-        std::ifstream m_currentFile;
+        LineReader m_currentFile;
         std::string m_currentDevice;
         std::string m_prevHeader;
     };
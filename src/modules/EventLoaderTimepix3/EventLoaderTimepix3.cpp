@@ -28,6 +28,10 @@ EventLoaderTimepix3::EventLoaderTimepix3(Configuration& config, std::shared_ptr<
 
     config_.setDefault<size_t>("buffer_depth", 1000);
     m_buffer_depth = config_.get<size_t>("buffer_depth");
+    config_.setDefault<size_t>("read_block_size", 262144);
+    m_read_block_size = config_.get<size_t>("read_block_size");
+    config_.setDefault<size_t>("read_ahead_blocks", 0);
+    m_read_ahead_blocks = config_.get<size_t>("read_ahead_blocks");
 
     // Take input directory from global parameters
     m_inputDirectory = config_.getPath("input_directory");
@@ -46,125 +50,22 @@ void EventLoaderTimepix3::initialize() {
     } else {
         LOG(INFO) << "Using buffer_depth = " << m_buffer_depth;
     }
-
-    // File structure is RunX/ChipID/files.dat
-
-    // Open the root directory
-    DIR* directory = opendir(m_inputDirectory.c_str());
-    if(directory == nullptr) {
-        throw ModuleError("Directory " + m_inputDirectory + " does not exist");
-    } else {
-        LOG(TRACE) << "Found directory " << m_inputDirectory;
+    if(m_read_block_size < 1) {
+        throw InvalidValueError(config_, "read_block_size", "Read block size must be larger than 0.");
     }
-    dirent* entry;
-    dirent* file;
 
-    // Buffer for file names:
-    std::vector<std::string> detector_files;
-
-    // Read the entries in the folder
-    while((entry = readdir(directory))) {
-
-        // Ignore UNIX functional directories:
-        if(std::string(entry->d_name).at(0) == '.') {
-            continue;
+    // Find the data files of this detector. Other files might be trimdac files with the list of masked pixels
+    auto files = spidr::find_data_files(m_inputDirectory, m_detector->getName(), [this](const std::string& filename) {
+        if(filename.substr(filename.find_last_of('/') + 1).find("trimdac") != string::npos) {
+            // Apply the pixel masking
+            maskPixels(filename);
         }
-
-        // If these are folders then the name is the chip ID
-        // For some file systems, dirent only returns DT_UNKNOWN - in this case, check the dir. entry starts with "W"
-        if(entry->d_type == DT_DIR || (entry->d_type == DT_UNKNOWN && std::string(entry->d_name).at(0) == 'W')) {
-
-            // Only read files from correct directory:
-            if(entry->d_name != m_detector->getName()) {
-                continue;
-            }
-            LOG(DEBUG) << "Found directory for detector " << entry->d_name;
-
-            // Open the folder for this device
-            string dataDirName = m_inputDirectory + "/" + entry->d_name;
-            DIR* dataDir = opendir(dataDirName.c_str());
-
-            // Get all of the files for this chip
-            while((file = readdir(dataDir))) {
-                string filename = dataDirName + "/" + file->d_name;
-
-                // Check if file has extension .dat
-                if(string(file->d_name).find(".dat") != string::npos) {
-                    LOG(INFO) << "Enqueuing data file for " << entry->d_name << ": " << filename;
-                    detector_files.push_back(filename);
-                }
-
-                // If not a data file, it might be a trimdac file, with the list of masked pixels etc.
-                if(string(file->d_name).find("trimdac") != string::npos) {
-                    // Apply the pixel masking
-                    maskPixels(filename);
-                }
-            }
-        }
-    }
-
-    // Check that we have files for this detector and sort them correctly:
-    if(detector_files.empty()) {
-        throw ModuleError("No data file found for detector " + m_detector->getName() + " in input directory " +
-                          m_inputDirectory);
-    }
-
-    // Initialise null values for later
-    m_syncTime = 0;
-    m_clearedHeader = false;
-    m_syncTimeTDC = 0;
-    m_TDCoverflowCounter = 0;
-    m_prevTriggerNumber = 0;
-    m_triggerOverflowCounter = 0;
-    eof_reached = false;
-
-    // Sort all files by extracting the "serial number" from the file name while ignoring the timestamp:
-    std::sort(detector_files.begin(), detector_files.end(), [](std::string a, std::string b) {
-        auto get_serial = [](std::string name) {
-            const auto pos1 = name.find_last_of('-');
-            const auto pos2 = name.find_last_of('.');
-            return name.substr(pos1 + 1, pos2 - pos1 - 1);
-        };
-        return std::stoi(get_serial(a)) < std::stoi(get_serial(b));
     });
+    m_stream = std::make_unique<spidr::Stream>(files, m_detector->getName(), m_read_block_size, m_read_ahead_blocks);
+    eof_reached = false;
 
-    // Open them:
-    for(auto& filename : detector_files) {
-
-        auto new_file = std::make_unique<std::ifstream>(filename);
-        if(new_file->is_open()) {
-            LOG(DEBUG) << "Opened data file for " << m_detector->getName() << ": " << filename;
-
-            // The header is repeated in every new data file, thus skip it for all.
-            uint32_t headerID;
-            if(!new_file->read(reinterpret_cast<char*>(&headerID), sizeof headerID)) {
-                throw ModuleError("Cannot read header ID for " + m_detector->getName() + " in file " + filename);
-            }
-            if(headerID != 1380208723) {
-                throw ModuleError("Incorrect header ID for " + m_detector->getName() + " in file " + filename + ": " +
-                                  std::to_string(headerID));
-            }
-            LOG(TRACE) << "Header ID: \"" << headerID << "\"";
-
-            // Skip the rest of the file header
-            uint32_t headerSize;
-            if(!new_file->read(reinterpret_cast<char*>(&headerSize), sizeof headerSize)) {
-                throw ModuleError("Cannot read header size for " + m_detector->getName() + " in file " + filename);
-            }
-
-            // Skip the full header:
-            new_file->seekg(headerSize);
-            LOG(TRACE) << "Skipped header (" << headerSize << "b)";
-
-            // Store the file in the data vector:
-            m_files.push_back(std::move(new_file));
-        } else {
-            throw ModuleError("Could not open data file " + filename);
-        }
-    }
-
-    // Set the file iterator to the first file for every detector:
-    m_file_iterator = m_files.begin();
+    // Processes of later partitions of the run decode the data of all preceding partitions
+    m_partitioned = getConfigManager()->getGlobalConfiguration().get<double>("_partition_begin", 0.) > 0;
 
     // Calibration
     pixelToT_beforecalibration = new TH1F("pixelToT", "pixelToT", 100, -0.5, 199.5);
@@ -244,7 +145,7 @@ StatusCode EventLoaderTimepix3::run(const std::shared_ptr<Clipboard>& clipboard)
     LOG(TRACE) << "== New event";
 
     // If all files for this detector have been read, end the run:
-    if(m_file_iterator == m_files.end()) {
+    if(m_stream->eof()) {
         return StatusCode::Failure;
     }
 
@@ -337,307 +238,213 @@ void EventLoaderTimepix3::loadCalibration(std::string path, char delim, std::vec
     f.close();
 }
 
-bool EventLoaderTimepix3::decodeNextWord() {
-    std::string detectorID = m_detector->getName();
-
-    // Check if current file is at its end and move to the next:
-    if((*m_file_iterator)->eof()) {
-        m_file_iterator++;
-        LOG(INFO) << "Starting to read next file for " << detectorID << ": " << (*m_file_iterator).get();
-    }
-
-    // Check if the last file is finished:
-    if(m_file_iterator == m_files.end()) {
-        LOG(INFO) << "EOF for all files of " << detectorID;
-        eof_reached = true;
-        return false;
-    }
-
-    // Now read the data packets.
-    ULong64_t pixdata = 0;
-
-    // If we can't read data anymore, jump to begin of loop:
-    if(!(*m_file_iterator)->read(reinterpret_cast<char*>(&pixdata), sizeof pixdata)) {
-        LOG(INFO) << "No more data in current file for " << detectorID << ": " << (*m_file_iterator).get();
-        return true;
+void EventLoaderTimepix3::prepare(const uint64_t* pixdata, size_t words) {
+    // Extract the pixel packet bit fields for the full block. The calculation does not depend on the packet header or on
+    // previous packets, such that the loop can be vectorized. Only the entries of pixel data packets are used later.
+    m_block_col.resize(words);
+    m_block_row.resize(words);
+    m_block_tot.resize(words);
+    m_block_time.resize(words);
+    uint16_t* cols = m_block_col.data();
+    uint16_t* rows = m_block_row.data();
+    uint16_t* tots = m_block_tot.data();
+    uint64_t* times = m_block_time.data();
+    for(size_t i = 0; i < words; i++) {
+        const uint64_t dcol = (pixdata[i] & 0x0FE0000000000000) >> 52;
+        const uint64_t spix = (pixdata[i] & 0x001F800000000000) >> 45;
+        const uint64_t pix = (pixdata[i] & 0x0000700000000000) >> 44;
+        const uint64_t col = dcol + pix / 4;
+        cols[i] = static_cast<uint16_t>(col);
+        rows[i] = static_cast<uint16_t>(spix + (pix & 0x3));
+
+        const uint64_t data = (pixdata[i] & 0x00000FFFFFFF0000) >> 16;
+        tots[i] = static_cast<uint16_t>((data & 0x00003FF0) >> 4);
+        const uint64_t spidrTime = pixdata[i] & 0x000000000000FFFF;
+        const uint64_t ftoa = data & 0x0000000F;
+        const uint64_t toa = (data & 0x0FFFC000) >> 14;
+
+        // Timestamp without the upper bits from the heartbeat, adjusted for the phase of the double column
+        times[i] = (((spidrTime << 18) + (toa << 4) + (15 - ftoa)) << 8) + ((col / 2 - 1) % 16) * 256;
     }
+}
 
-    LOG(TRACE) << "0x" << hex << pixdata << dec << " - " << pixdata;
-
-    // Get the header (first 4 bits) and do things depending on what it is
-    // 0x4 is the "heartbeat" signal, 0xA and 0xB are pixel data
-    const UChar_t header = static_cast<UChar_t>((pixdata & 0xF000000000000000) >> 60) & 0xF;
-
-    // Use header 0x4 to get the long timestamps (called syncTime here)
-    if(header == 0x4) {
-        LOG(TRACE) << "Found syncTime data";
-
-        // The 0x4 header tells us that it is part of the timestamp
-        // There is a second 4-bit header that says if it is the most
-        // or least significant part of the timestamp
-        const UChar_t header2 = ((pixdata & 0x0F00000000000000) >> 56) & 0xF;
-
-        // This is a bug fix. There appear to be errant packets with garbage data
-        // - source to be tracked down.
-        // Between the data and the header the intervening bits should all be 0,
-        // check if this is the case
-        const UChar_t intermediateBits = ((pixdata & 0x00FF000000000000) >> 48) & 0xFF;
-        if(intermediateBits != 0x00) {
-            LOG(DEBUG) << "Detector " << detectorID << ": intermediateBits error";
-            return true;
-        }
-
-        // 0x4 is the least significant part of the timestamp
-        if(header2 == 0x4) {
-            // The data is shifted 16 bits to the right, then 12 to the left in
-            // order to match the timestamp format (net 4 right)
-            m_syncTime = (m_syncTime & 0xFFFFF00000000000) + ((pixdata & 0x0000FFFFFFFF0000) >> 4);
-        }
-        // 0x5 is the most significant part of the timestamp
-        if(header2 == 0x5) {
-            // The data is shifted 16 bits to the right, then 44 to the left in
-            // order to match the timestamp format (net 28 left)
-            m_syncTime = (m_syncTime & 0x00000FFFFFFFFFFF) + ((pixdata & 0x00000000FFFF0000) << 28);
-            if(!m_clearedHeader && static_cast<double>(m_syncTime) / (4096. * 40000000.) < 6.) {
-                m_clearedHeader = true;
-                LOG(DEBUG) << detectorID << ": Cleared header";
-            }
-        }
-    }
+void EventLoaderTimepix3::control(uint64_t pixdata) {
+    std::string detectorID = m_detector->getName();
 
-    // In data taking during 2015 there was sometimes still data left in the buffers at the start of
-    // a run. For that reason we keep skipping data until this "header" data has been cleared, when
-    // the heart beat signal starts from a low number (~few seconds max)
-    if(!m_clearedHeader) {
-        LOG(TRACE) << "Header not cleared, skipping data block.";
-        return true;
+    // These packets should only come from the DUT. Otherwise ignore and throw warning.
+    // (We observed these packets a few times per run in various telescope planes in the
+    // November 2018 test beam.)
+    if(!m_detector->isDUT()) {
+        LOG(WARNING)
+            /* << "Current time: " << Units::display(event->start(), {"s", "ms", "us", "ns"}) */
+            << " detector " << detectorID << " "
+            << "header == 0x0! (indicates power pulsing.) Ignoring this.";
+        return;
     }
+    // Note that the following code is probably outdated and/or not much tested
+    // (Estel used her private code for her power-pulsing studies.) To be fixed!
 
-    // Header 0x06 and 0x07 are the start and stop signals for power pulsing
-    if(header == 0x0) {
-        // These packets should only come from the DUT. Otherwise ignore and throw warning.
-        // (We observed these packets a few times per run in various telescope planes in the
-        // November 2018 test beam.)
-        if(!m_detector->isDUT()) {
-            LOG(WARNING)
-                /* << "Current time: " << Units::display(event->start(), {"s", "ms", "us", "ns"}) */
-                << " detector " << detectorID << " "
-                << "header == 0x0! (indicates power pulsing.) Ignoring this.";
-            return true;
-        }
-        // Note that the following code is probably outdated and/or not much tested
-        // (Estel used her private code for her power-pulsing studies.) To be fixed!
-
-        // Get the second part of the header
-        const UChar_t header2 = ((pixdata & 0x0F00000000000000) >> 56) & 0xF;
-
-        // New implementation of power pulsing signals from Adrian
-        if(header2 == 0x6) {
-            LOG(TRACE) << "Found power pulsing - start";
+    // Get the second part of the header
+    const UChar_t header2 = ((pixdata & 0x0F00000000000000) >> 56) & 0xF;
 
-            // Read time stamp and convert to nanoseconds
-            const double timestamp = static_cast<double>((pixdata & 0x0000000FFFFFFFFF) << 12) / (4096 * 0.04);
-            const uint64_t controlbits = ((pixdata & 0x00F0000000000000) >> 52) & 0xF;
+    // New implementation of power pulsing signals from Adrian
+    if(header2 == 0x6) {
+        LOG(TRACE) << "Found power pulsing - start";
 
-            const uint64_t powerOn = ((controlbits & 0x2) >> 1);
-            const uint64_t shutterClosed = ((controlbits & 0x1));
+        // Read time stamp and convert to nanoseconds
+        const double timestamp = static_cast<double>((pixdata & 0x0000000FFFFFFFFF) << 12) / (4096 * 0.04);
+        const uint64_t controlbits = ((pixdata & 0x00F0000000000000) >> 52) & 0xF;
 
-            auto powerSignal = (powerOn ? std::make_shared<SpidrSignal>("powerOn", timestamp)
-                                        : std::make_shared<SpidrSignal>("powerOff", timestamp));
+        const uint64_t powerOn = ((controlbits & 0x2) >> 1);
+        const uint64_t shutterClosed = ((controlbits & 0x1));
 
-            sorted_signals_.push(powerSignal);
-            LOG(DEBUG) << "Power is " << (powerOn ? "on" : "off") << " power! Time: " << Units::display(timestamp, "ns");
+        auto powerSignal = (powerOn ? std::make_shared<SpidrSignal>("powerOn", timestamp)
+                                    : std::make_shared<SpidrSignal>("powerOff", timestamp));
 
-            LOG(TRACE) << "Shutter closed: " << hex << shutterClosed << dec;
+        sorted_signals_.push(powerSignal);
+        LOG(DEBUG) << "Power is " << (powerOn ? "on" : "off") << " power! Time: " << Units::display(timestamp, "ns");
 
-            auto shutterSignal = (shutterClosed ? std::make_shared<SpidrSignal>("shutterClosed", timestamp)
-                                                : std::make_shared<SpidrSignal>("shutterOpen", timestamp));
-            if(!shutterClosed) {
-                sorted_signals_.push(shutterSignal);
-                m_shutterOpen = true;
-                LOG(TRACE) << "Have opened shutter with signal " << shutterSignal->type() << " at time "
-                           << Units::display(timestamp, "ns");
-            }
+        LOG(TRACE) << "Shutter closed: " << hex << shutterClosed << dec;
 
-            if(shutterClosed && m_shutterOpen) {
-                sorted_signals_.push(shutterSignal);
-                m_shutterOpen = false;
-                LOG(TRACE) << "Have closed shutter with signal " << shutterSignal->type() << " at time "
-                           << Units::display(timestamp, "ns");
-            }
-
-            LOG(DEBUG) << "Shutter is " << (shutterClosed ? "closed" : "open")
-                       << ". Time: " << Units::display(timestamp, "ns");
+        auto shutterSignal = (shutterClosed ? std::make_shared<SpidrSignal>("shutterClosed", timestamp)
+                                            : std::make_shared<SpidrSignal>("shutterOpen", timestamp));
+        if(!shutterClosed) {
+            sorted_signals_.push(shutterSignal);
+            m_shutterOpen = true;
+            LOG(TRACE) << "Have opened shutter with signal " << shutterSignal->type() << " at time "
+                       << Units::display(timestamp, "ns");
         }
 
-        /*
-        // 0x6 is power on
-        if(header2 == 0x6){
-            const double timestamp = ((pixdata & 0x0000000FFFFFFFFF) << 12 ) / (4096 * 0.04);
-            auto signal = std::make_shared<SpidrSignal>("powerOn",timestamp);
-            spidrData.push_back(signal);
-            LOG(DEBUG) <<"Turned on power! Time: " << Units::display(timestamp, "ns");
-        }
-        // 0x7 is power off
-        if(header2 == 0x7){
-            const double timestamp = ((pixdata & 0x0000000FFFFFFFFF) << 12 ) / (4096 * 0.04);
-            auto signal = std::make_shared<SpidrSignal>("powerOff",timestamp);
-            spidrData.push_back(signal);
-            LOG(DEBUG) <<"Turned off power! Time: " << Units::display(timestamp, "ns");
+        if(shutterClosed && m_shutterOpen) {
+            sorted_signals_.push(shutterSignal);
+            m_shutterOpen = false;
+            LOG(TRACE) << "Have closed shutter with signal " << shutterSignal->type() << " at time "
+                       << Units::display(timestamp, "ns");
         }
-            */
-    }
-
-    // Header 0x6 indicate trigger data
-    if(header == 0x6) {
-        const UChar_t header2 = ((pixdata & 0x0F00000000000000) >> 56) & 0xF;
-        if(header2 == 0xF) {
-            unsigned int stamp = (pixdata & 0x1E0) >> 5;
-            long long int timestamp_raw = static_cast<long long int>(pixdata & 0xFFFFFFFFE00) >> 9;
-            long long int timestamp = 0;
-            int triggerNumber = ((pixdata & 0xFFF00000000000) >> 44);
-
-            int intermediate = (pixdata & 0x1F);
-            if(intermediate != 0) {
-                return true;
-            }
 
-            if(triggerNumber < m_prevTriggerNumber) {
-                m_triggerOverflowCounter++;
-            }
-
-            // if jump back in time is larger than 1 sec, overflow detected...
-            if((m_syncTimeTDC - timestamp_raw) > 0x1312d000) {
-                m_TDCoverflowCounter++;
-            }
+        LOG(DEBUG) << "Shutter is " << (shutterClosed ? "closed" : "open")
+                   << ". Time: " << Units::display(timestamp, "ns");
+    }
 
-            timestamp = timestamp_raw + (static_cast<long long int>(m_TDCoverflowCounter) << 35);
+    /*
+    // 0x6 is power on
+    if(header2 == 0x6){
+        const double timestamp = ((pixdata & 0x0000000FFFFFFFFF) << 12 ) / (4096 * 0.04);
+        auto signal = std::make_shared<SpidrSignal>("powerOn",timestamp);
+        spidrData.push_back(signal);
+        LOG(DEBUG) <<"Turned on power! Time: " << Units::display(timestamp, "ns");
+    }
+    // 0x7 is power off
+    if(header2 == 0x7){
+        const double timestamp = ((pixdata & 0x0000000FFFFFFFFF) << 12 ) / (4096 * 0.04);
+        auto signal = std::make_shared<SpidrSignal>("powerOff",timestamp);
+        spidrData.push_back(signal);
+        LOG(DEBUG) <<"Turned off power! Time: " << Units::display(timestamp, "ns");
+    }
+        */
+}
 
-            double triggerTime =
-                (static_cast<double>(timestamp) + static_cast<double>(stamp) / 12) / (8. * 0.04); // 320 MHz clock
+void EventLoaderTimepix3::trigger(double time, int id) {
+    sorted_signals_.push(std::make_shared<SpidrSignal>("trigger", time, id));
+}
 
-            m_syncTimeTDC = timestamp_raw;
+void EventLoaderTimepix3::pixel(uint64_t, size_t index, unsigned long long int sync_time) {
+    std::string detectorID = m_detector->getName();
 
-            int triggerID = triggerNumber + (m_triggerOverflowCounter << 12);
-            m_prevTriggerNumber = triggerNumber;
+    // The pixel information has been decoded from the relevant bits when reading the block
+    const UShort_t col = m_block_col[index];
+    const UShort_t row = m_block_row[index];
 
-            auto triggerSignal = std::make_shared<SpidrSignal>("trigger", triggerTime, triggerID);
-            sorted_signals_.push(triggerSignal);
-        }
+    // Check if this pixel is masked
+    if(m_detector->masked(col, row)) {
+        LOG(DEBUG) << "Detector " << detectorID << ": pixel " << col << "," << row << " masked";
+        return;
     }
 
-    // Header 0xA and 0xB indicate pixel data
-    if(header == 0xA || header == 0xB) {
-        LOG(TRACE) << "Found pixel data";
-
-        // Decode the pixel information from the relevant bits
-        const UShort_t dcol = static_cast<UShort_t>((pixdata & 0x0FE0000000000000) >> 52);
-        const UShort_t spix = static_cast<UShort_t>((pixdata & 0x001F800000000000) >> 45);
-        const UShort_t pix = static_cast<UShort_t>((pixdata & 0x0000700000000000) >> 44);
-        const UShort_t col = static_cast<UShort_t>(dcol + pix / 4);
-        const UShort_t row = static_cast<UShort_t>(spix + (pix & 0x3));
-
-        // Check if this pixel is masked
-        if(m_detector->masked(col, row)) {
-            LOG(DEBUG) << "Detector " << detectorID << ": pixel " << col << "," << row << " masked";
-            return true;
-        }
-
-        // Get the rest of the data from the pixel
-        // const UShort_t pixno = col * 256 + row;
-        const UInt_t data = static_cast<UInt_t>((pixdata & 0x00000FFFFFFF0000) >> 16);
-        const unsigned int tot = (data & 0x00003FF0) >> 4;
-        const uint64_t spidrTime(pixdata & 0x000000000000FFFF);
-        const uint64_t ftoa(data & 0x0000000F);
-        const uint64_t toa((data & 0x0FFFC000) >> 14);
-
-        // Calculate the timestamp.
-        unsigned long long int time =
-            (((spidrTime << 18) + (toa << 4) + (15 - ftoa)) << 8) + (m_syncTime & 0xFFFFFC0000000000);
-
-        // Adjusting phases for double column shift
-        time += ((static_cast<unsigned long long int>(col) / 2 - 1) % 16) * 256;
+    // Calculate the timestamp.
+    const unsigned int tot = m_block_tot[index];
+    unsigned long long int time = m_block_time[index] + (sync_time & 0xFFFFFC0000000000);
 
-        // The time from the pixels has a maximum value of ~26 seconds. We compare the pixel time to the "heartbeat"
-        // signal (which has an overflow of ~4 years) and check if the pixel time has wrapped back around to 0
+    // The time from the pixels has a maximum value of ~26 seconds. We compare the pixel time to the "heartbeat"
+    // signal (which has an overflow of ~4 years) and check if the pixel time has wrapped back around to 0
 
-        // If the counter overflow happens before reading the new heartbeat
-        //      while( abs(m_syncTime-time) > 0x0000020000000000 ){
-        while(static_cast<long long>(m_syncTime) - static_cast<long long>(time) > 0x0000020000000000) {
-            time += 0x0000040000000000;
-        }
+    // If the counter overflow happens before reading the new heartbeat
+    //      while( abs(m_syncTime-time) > 0x0000020000000000 ){
+    while(static_cast<long long>(sync_time) - static_cast<long long>(time) > 0x0000020000000000) {
+        time += 0x0000040000000000;
+    }
 
-        // Convert final timestamp into ns and add the timing offset (in nano seconds) from the detectors file (if any)
-        const double timestamp = static_cast<double>(time) / (4096. / 25.) + m_detector->timeOffset();
+    // Convert final timestamp into ns and add the timing offset (in nano seconds) from the detectors file (if any)
+    const double timestamp = static_cast<double>(time) / (4096. / 25.) + m_detector->timeOffset();
+    const bool histogram = (timestamp >= m_histogramStart);
 
+    if(histogram) {
         pixelToT_beforecalibration->Fill(static_cast<int>(tot));
+    }
 
-        // Apply calibration if applyCalibration is true
-        if(applyCalibration && m_detector->isDUT()) {
-            LOG(DEBUG) << "Applying calibration to DUT";
-            size_t scol = static_cast<size_t>(col);
-            size_t srow = static_cast<size_t>(row);
-            float a = vtot.at(256 * srow + scol).at(2);
-            float b = vtot.at(256 * srow + scol).at(3);
-            float c = vtot.at(256 * srow + scol).at(4);
-            float t = vtot.at(256 * srow + scol).at(5);
-
-            float toa_c = vtoa.at(256 * srow + scol).at(2);
-            float toa_t = vtoa.at(256 * srow + scol).at(3);
-            float toa_d = vtoa.at(256 * srow + scol).at(4);
-
-            // Calculating calibrated tot and toa
-            float fvolts = (sqrt(a * a * t * t + 2 * a * b * t + 4 * a * c - 2 * a * t * static_cast<float>(tot) + b * b -
-                                 2 * b * static_cast<float>(tot) + static_cast<float>(tot * tot)) +
-                            a * t - b + static_cast<float>(tot)) /
-                           (2 * a);
-            double fcharge = fvolts * 1e-3 * 3e-15 * 6241.509 * 1e15; // capacitance is 3 fF or 18.7 e-/mV
-
-            /* Note 1: fvolts is the inverse to f(x) = a*x + b - c/(x-t). Note the +/- signs! */
-            /* Note 2: The capacitance is actually smaller than 3 fC, more like 2.5 fC. But there is an offset when when
-             * using testpulses. Multiplying the voltage value with 20 [e-/mV] is a good approximation but means one is
-             * over estimating the input capacitance to compensate the missing information of the offset. */
-
-            float t_shift = toa_c / (fvolts - toa_t) + toa_d;
+    // Apply calibration if applyCalibration is true
+    if(applyCalibration && m_detector->isDUT()) {
+        LOG(DEBUG) << "Applying calibration to DUT";
+        size_t scol = static_cast<size_t>(col);
+        size_t srow = static_cast<size_t>(row);
+        float a = vtot.at(256 * srow + scol).at(2);
+        float b = vtot.at(256 * srow + scol).at(3);
+        float c = vtot.at(256 * srow + scol).at(4);
+        float t = vtot.at(256 * srow + scol).at(5);
+
+        float toa_c = vtoa.at(256 * srow + scol).at(2);
+        float toa_t = vtoa.at(256 * srow + scol).at(3);
+        float toa_d = vtoa.at(256 * srow + scol).at(4);
+
+        // Calculating calibrated tot and toa
+        float fvolts = (sqrt(a * a * t * t + 2 * a * b * t + 4 * a * c - 2 * a * t * static_cast<float>(tot) + b * b -
+                             2 * b * static_cast<float>(tot) + static_cast<float>(tot * tot)) +
+                        a * t - b + static_cast<float>(tot)) /
+                       (2 * a);
+        double fcharge = fvolts * 1e-3 * 3e-15 * 6241.509 * 1e15; // capacitance is 3 fF or 18.7 e-/mV
+
+        /* Note 1: fvolts is the inverse to f(x) = a*x + b - c/(x-t). Note the +/- signs! */
+        /* Note 2: The capacitance is actually smaller than 3 fC, more like 2.5 fC. But there is an offset when when
+         * using testpulses. Multiplying the voltage value with 20 [e-/mV] is a good approximation but means one is
+         * over estimating the input capacitance to compensate the missing information of the offset. */
+
+        float t_shift = toa_c / (fvolts - toa_t) + toa_d;
+        if(histogram) {
             timeshiftPlot->Fill(static_cast<double>(Units::convert(t_shift, "ns")));
-            const double ftimestamp = timestamp - t_shift;
-            LOG(DEBUG) << "Time shift= " << Units::display(t_shift, {"s", "ns"});
-            LOG(DEBUG) << "Timestamp calibrated = " << Units::display(ftimestamp, {"s", "ns"});
+        }
+        const double ftimestamp = timestamp - t_shift;
+        LOG(DEBUG) << "Time shift= " << Units::display(t_shift, {"s", "ns"});
+        LOG(DEBUG) << "Timestamp calibrated = " << Units::display(ftimestamp, {"s", "ns"});
 
-            if(col >= m_detector->nPixels().X() || row >= m_detector->nPixels().Y()) {
-                LOG(WARNING) << "Pixel address " << col << ", " << row << " is outside of pixel matrix.";
-            }
-            // creating new pixel object with calibrated values of tot and toa
-            // when calibration is not available, set charge = tot
-            auto pixel = std::make_shared<Pixel>(detectorID, col, row, static_cast<int>(tot), tot, ftimestamp);
-            pixel->setCharge(fcharge);
-            sorted_pixels_.push(pixel);
+        if(col >= m_detector->nPixels().X() || row >= m_detector->nPixels().Y()) {
+            LOG(WARNING) << "Pixel address " << col << ", " << row << " is outside of pixel matrix.";
+        }
+        // storing pixel hit with calibrated values of tot and toa
+        sorted_pixels_.push({ftimestamp, fcharge, col, row, static_cast<uint16_t>(tot)});
+        LOG(DEBUG) << "Pixel Charge = " << fcharge << "; ToT value = " << tot;
+        if(histogram) {
             hHitMap->Fill(col, row);
-            LOG(DEBUG) << "Pixel Charge = " << fcharge << "; ToT value = " << tot;
             pixelToT_aftercalibration->Fill(fcharge);
-        } else {
-            LOG(DEBUG) << "Pixel hit at " << Units::display(timestamp, {"s", "ns"});
-            // creating new pixel object with non-calibrated values of tot and toa
-            // when calibration is not available, set charge = tot
-            auto pixel = std::make_shared<Pixel>(detectorID, col, row, static_cast<int>(tot), tot, timestamp);
-            sorted_pixels_.push(pixel);
+        }
+    } else {
+        LOG(DEBUG) << "Pixel hit at " << Units::display(timestamp, {"s", "ns"});
+        // storing pixel hit with non-calibrated values of tot and toa
+        // when calibration is not available, set charge = tot
+        sorted_pixels_.push({timestamp, static_cast<double>(tot), col, row, static_cast<uint16_t>(tot)});
+        if(histogram) {
             hHitMap->Fill(col, row);
         }
-
-        m_prevTime = time;
     }
 
-    return true;
+    m_prevTime = time;
 }
 
 void EventLoaderTimepix3::fillBuffer() {
     // read data from file and fill timesorted buffer
-    while(sorted_pixels_.size() < m_buffer_depth && !eof_reached) {
-        // decodeNextWord returns false when EOF is reached and true otherwise
-        if(!decodeNextWord()) {
-            LOG(TRACE) << "decodeNextWord returns false: reached EOF.";
-            break;
-        }
+    // decode returns false when EOF is reached and true otherwise
+    if(!eof_reached && !m_stream->decode(*this)) {
+        LOG(TRACE) << "decode returns false: reached EOF.";
+        eof_reached = true;
     }
 }
 
@@ -650,27 +457,35 @@ bool EventLoaderTimepix3::loadData(const std::shared_ptr<Clipboard>& clipboard,
     auto event = clipboard->getEvent();
 
     LOG(DEBUG) << "Loading data for device " << detectorID;
+    if(m_partitioned) {
+        // Only the events of the partition are loaded, earlier hits are not histogrammed
+        m_histogramStart = event->start();
+        m_partitioned = false;
+    }
     fillBuffer();
 
     // Now we have data buffered into the temporary storage. We will sort this by time, and then load
     // the data from one event onto it.
 
     while(!sorted_pixels_.empty()) {
-        auto pixel = sorted_pixels_.top();
+        const auto& hit = sorted_pixels_.top();
 
-        auto position = event->getTimestampPosition(pixel->timestamp());
+        auto position = event->getTimestampPosition(hit.timestamp);
 
         if(position == Event::Position::AFTER) {
             LOG(DEBUG) << "Stopping processing event, pixel is after "
                           "event window ("
-                       << Units::display(pixel->timestamp(), {"s", "us", "ns"}) << " > "
+                       << Units::display(hit.timestamp, {"s", "us", "ns"}) << " > "
                        << Units::display(event->end(), {"s", "us", "ns"}) << ")";
             break;
         } else if(position == Event::Position::BEFORE) {
-            LOG(TRACE) << "Skipping pixel, is before event window (" << Units::display(pixel->timestamp(), {"s", "us", "ns"})
+            LOG(TRACE) << "Skipping pixel, is before event window (" << Units::display(hit.timestamp, {"s", "us", "ns"})
                        << " < " << Units::display(event->start(), {"s", "us", "ns"}) << ")";
             sorted_pixels_.pop();
         } else {
+            // Pixel objects are only created for hits within the event
+            auto pixel = make_pooled<Pixel>(detectorID, hit.col, hit.row, hit.tot, hit.tot, hit.timestamp);
+            pixel->setCharge(hit.charge);
             devicedata.push_back(pixel);
             sorted_pixels_.pop();
         }
@@ -14,11 +14,14 @@
 #include <TCanvas.h>
 #include <TH1F.h>
 #include <TH2F.h>
-#include <queue>
+#include <cstdint>
+#include <limits>
 #include <stdio.h>
 #include "core/module/Module.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/SpidrSignal.hpp"
+#include "tools/spidr.h"
+#include "tools/time_sorted_buffer.h"
 
 namespace corryvreckan {
     /** @ingroup Modules
@@ -50,7 +53,6 @@ namespace corryvreckan {
         TH2F* pixelTOAParameterT;
         TH1F* timeshiftPlot;
 
-        bool decodeNextWord();
         void fillBuffer();
         bool loadData(const std::shared_ptr<Clipboard>& clipboard, PixelVector&, SpidrSignalVector&);
         void loadCalibration(std::string path, char delim, std::vector<std::vector<float>>& dat);
@@ -66,33 +68,53 @@ namespace corryvreckan {
         std::vector<std::vector<float>> vtot;
         std::vector<std::vector<float>> vtoa;
 
+        // Handlers for the packets decoded from the data stream
+        friend class spidr::Stream;
+        bool full() const { return sorted_pixels_.size() >= m_buffer_depth; }
+        void prepare(const uint64_t* pixdata, size_t words);
+        void control(uint64_t pixdata);
+        void trigger(double time, int id);
+        void pixel(uint64_t pixdata, size_t index, unsigned long long int sync_time);
+
         // Member variables
-        std::vector<std::unique_ptr<std::ifstream>> m_files;
-        std::vector<std::unique_ptr<std::ifstream>>::iterator m_file_iterator;
+        std::unique_ptr<spidr::Stream> m_stream;
 
         bool eof_reached;
         size_t m_buffer_depth;
-        unsigned long long int m_syncTime;
-        bool m_clearedHeader;
-        long long int m_syncTimeTDC;
-        int m_TDCoverflowCounter;
+        size_t m_read_block_size;
+        size_t m_read_ahead_blocks;
+
+        // Bit fields of pixel data packets of the current block of raw data. They are extracted for the full block at once
+        // and are only valid for words with pixel headers.
+        std::vector<uint16_t> m_block_col;
+        std::vector<uint16_t> m_block_row;
+        std::vector<uint16_t> m_block_tot;
+        std::vector<uint64_t> m_block_time;
 
         long long int m_currentEvent;
 
         unsigned long long int m_prevTime;
         bool m_shutterOpen;
-        int m_prevTriggerNumber;
-        int m_triggerOverflowCounter;
 
-        template <typename T> struct CompareTimeGreater {
-            bool operator()(const std::shared_ptr<T> a, const std::shared_ptr<T> b) {
-                return a->timestamp() > b->timestamp();
-            }
+        // Hits before the first event of a partition are decoded, but have been histogrammed by the preceding partition
+        bool m_partitioned{};
+        double m_histogramStart{std::numeric_limits<double>::lowest()};
+
+        // Decoded pixel hit, only converted to a Pixel object when it is placed on the clipboard
+        struct PixelHit {
+            double timestamp;
+            double charge;
+            uint16_t col;
+            uint16_t row;
+            uint16_t tot;
+        };
+        struct PixelHitTimestamp {
+            double operator()(const PixelHit& hit) const { return hit.timestamp; }
         };
 
-        std::priority_queue<std::shared_ptr<Pixel>, PixelVector, CompareTimeGreater<Pixel>> sorted_pixels_;
-        std::priority_queue<std::shared_ptr<SpidrSignal>, SpidrSignalVector, CompareTimeGreater<SpidrSignal>>
-            sorted_signals_;
+        // Buffers of time-sorted hits and signals, using buckets of 1us
+        TimeSortedBuffer<PixelHit, PixelHitTimestamp> sorted_pixels_{Units::get<double>(1, "us")};
+        TimeSortedBuffer<std::shared_ptr<SpidrSignal>> sorted_signals_{Units::get<double>(1, "us")};
     };
 } // namespace corryvreckan
 #endif // TIMEPIX3EVENTLOADER_H
@@ -12,12 +12,13 @@
 #include <TH1F.h>
 #include <TH2F.h>
 #include <iostream>
-#include <queue>
 #include "core/module/Module.hpp"
 #include "objects/Cluster.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/SpidrSignal.hpp"
 #include "objects/Track.hpp"
+#include "tools/spidr.h"
+#include "tools/time_sorted_buffer.h"
 
 namespace corryvreckan {
     /** @ingroup Modules
@@ -50,40 +51,35 @@ namespace corryvreckan {
          */
         void finalize(const std::shared_ptr<ReadonlyClipboard>& clipboard) override;
 
-        bool decodeNextWord();
         void fillBuffer();
 
     private:
+        // Handlers for the packets decoded from the data stream, only triggers are used
+        friend class spidr::Stream;
+        bool full() const { return sorted_signals_.size() >= m_buffer_depth; }
+        void prepare(const uint64_t*, size_t) {}
+        void control(uint64_t) {}
+        void trigger(double time, int id);
+        void pixel(uint64_t, size_t, unsigned long long int) {}
+
         std::shared_ptr<Detector> m_detector;
 
         // configuration parameters:
         std::string m_inputDirectory;
 
         // Member variables
-        std::vector<std::unique_ptr<std::ifstream>> m_files;
-        std::vector<std::unique_ptr<std::ifstream>>::iterator m_file_iterator;
+        std::unique_ptr<spidr::Stream> m_stream;
 
         bool eof_reached;
         size_t m_buffer_depth;
-        unsigned long long int m_syncTime;
-        bool m_clearedHeader;
-        long long int m_syncTimeTDC;
-        int m_TDCoverflowCounter;
+        size_t m_read_block_size;
+        size_t m_read_ahead_blocks;
         double m_eventLength;
 
-        int m_prevTriggerNumber;
-        int m_triggerOverflowCounter;
-
         double m_time_offset;
 
-        template <typename T> struct CompareTimeGreater {
-            bool operator()(const std::shared_ptr<T> a, const std::shared_ptr<T> b) {
-                return a->timestamp() > b->timestamp();
-            }
-        };
-
-        std::priority_queue<std::shared_ptr<SpidrSignal>, SpidrSignalVector, CompareTimeGreater<SpidrSignal>>
-            sorted_signals_;
+        // Buffer of time-sorted triggers, using buckets of 1us
+        TimeSortedBuffer<std::shared_ptr<SpidrSignal>> sorted_signals_{Units::get<double>(1, "us")};
     };
 
 } // namespace corryvreckan
@@ -10,6 +10,7 @@
 
 #include "FileReader.h"
 
+#include <algorithm>
 #include <climits>
 #include <string>
 #include <utility>
@@ -112,6 +113,22 @@ void FileReader::initialize() {
         exclude_.insert(exc_arr.begin(), exc_arr.end());
     }
 
+    // Read the detectors for which objects should be read
+    if(config_.has("detectors")) {
+        auto det_arr = config_.getArray<std::string>("detectors");
+        detectors_.insert(det_arr.begin(), det_arr.end());
+    }
+
+    // Momentum of the particles, used to refit tracks read from columns
+    config_.setDefault<double>("momentum", Units::get<double>(5, "GeV"));
+    momentum_ = config_.get<double>("momentum");
+
+    // Read the position in the file to start from
+    if(config_.has("start_time") && config_.has("start_event")) {
+        throw InvalidCombinationError(
+            config_, {"start_time", "start_event"}, "start_time and start_event parameter are mutually exclusive");
+    }
+
     // Initialize the call map from the tuple of available objects
     object_creator_map_ = gen_creator_map<corryvreckan::OBJECTS>();
 
@@ -132,6 +149,11 @@ void FileReader::initialize() {
                 event_tree_ = tree;
                 continue;
             }
+            if(tree->GetName() == std::string("EventIndex")) {
+                LOG(DEBUG) << "Found event index tree";
+                index_tree_ = tree;
+                continue;
+            }
 
             // Check if a version of this tree has already been read
             if(tree_names.find(tree->GetName()) != tree_names.end()) {
@@ -146,6 +168,7 @@ void FileReader::initialize() {
                (!exclude_.empty() && exclude_.find(tree->GetName()) != exclude_.end())) {
                 LOG(TRACE) << "Ignoring tree with " << tree->GetName()
                            << " objects because it has been excluded or not explicitly included";
+                complete_read_ = false;
                 continue;
             }
 
@@ -153,7 +176,84 @@ void FileReader::initialize() {
         }
     }
 
-    if(trees_.empty()) {
+    // Bind the columns of pixels and clusters if the file has been written in columns format
+    auto* columns_dir = input_file_->GetDirectory("columns");
+    if(columns_dir != nullptr) {
+        auto get_tree = [&](const std::string& name) -> TTree* {
+            if((!include_.empty() && include_.find(name) == include_.end()) ||
+               (!exclude_.empty() && exclude_.find(name) != exclude_.end())) {
+                complete_read_ = false;
+                return nullptr;
+            }
+            TTree* tree = nullptr;
+            columns_dir->GetObject(name.c_str(), tree);
+            return tree;
+        };
+        pixel_tree_ = get_tree("Pixel");
+        cluster_tree_ = get_tree("Cluster");
+        track_tree_ = get_tree("Track");
+        if(track_tree_ != nullptr && cluster_tree_ == nullptr) {
+            LOG(WARNING) << "Tracks stored as columns can only be recreated from their clusters and are not read";
+            track_tree_ = nullptr;
+            complete_read_ = false;
+        }
+        if(track_tree_ != nullptr) {
+            if(track_tree_->GetBranch("type") != nullptr) {
+                track_tree_->SetBranchAddress("type", &track_columns_.type);
+            }
+            if(track_tree_->GetBranch("timestamp") != nullptr) {
+                track_tree_->SetBranchAddress("timestamp", &track_columns_.timestamp);
+            }
+        }
+
+        for(auto& detector : get_detectors()) {
+            auto name = detector->getName();
+            if(!detectors_.empty() && detectors_.find(name) == detectors_.end()) {
+                continue;
+            }
+            // Bind all columns which are present in the tree
+            auto bind = [&name](TTree* tree, const std::string& column_name, auto** column) {
+                auto branch_name = name + "_" + column_name;
+                if(tree->GetBranch(branch_name.c_str()) != nullptr) {
+                    tree->SetBranchAddress(branch_name.c_str(), column);
+                }
+            };
+            if(pixel_tree_ != nullptr && pixel_tree_->GetBranch((name + "_column").c_str()) != nullptr) {
+                auto& columns = pixel_columns_[name];
+                bind(pixel_tree_, "column", &columns.column);
+                bind(pixel_tree_, "row", &columns.row);
+                bind(pixel_tree_, "raw", &columns.raw);
+                bind(pixel_tree_, "charge", &columns.charge);
+                bind(pixel_tree_, "timestamp", &columns.timestamp);
+            }
+            if(cluster_tree_ != nullptr && cluster_tree_->GetBranch((name + "_column").c_str()) != nullptr) {
+                auto& columns = cluster_columns_[name];
+                bind(cluster_tree_, "column", &columns.column);
+                bind(cluster_tree_, "row", &columns.row);
+                bind(cluster_tree_, "charge", &columns.charge);
+                bind(cluster_tree_, "x", &columns.x);
+                bind(cluster_tree_, "y", &columns.y);
+                bind(cluster_tree_, "z", &columns.z);
+                bind(cluster_tree_, "local_x", &columns.local_x);
+                bind(cluster_tree_, "local_y", &columns.local_y);
+                bind(cluster_tree_, "local_z", &columns.local_z);
+                bind(cluster_tree_, "error_x", &columns.error_x);
+                bind(cluster_tree_, "error_y", &columns.error_y);
+                bind(cluster_tree_, "timestamp", &columns.timestamp);
+                bind(cluster_tree_, "split", &columns.split);
+                bind(cluster_tree_, "size", &columns.size);
+                bind(cluster_tree_, "pixels", &columns.pixels);
+                if(track_tree_ != nullptr) {
+                    bind(track_tree_, "cluster", &track_columns_.cluster[name]);
+                }
+            }
+        }
+        LOG(DEBUG) << "Reading columns of " << pixel_columns_.size() << " detectors with pixels and "
+                   << cluster_columns_.size() << " detectors with clusters"
+                   << (track_tree_ != nullptr ? ", recreating tracks from their clusters" : "");
+    }
+
+    if(trees_.empty() && pixel_tree_ == nullptr && cluster_tree_ == nullptr && track_tree_ == nullptr) {
         throw ModuleError("Provided ROOT file does not contain any trees, module cannot read any data");
     }
 
@@ -180,6 +280,14 @@ void FileReader::initialize() {
         for(int i = 0; i < branches->GetEntries(); i++) {
             auto* branch = static_cast<TBranch*>(branches->At(i));
 
+            // Do not read the branches of detectors which have not been selected
+            if(!detectors_.empty() && branch->GetName() != std::string("global") &&
+               detectors_.find(branch->GetName()) == detectors_.end()) {
+                LOG(TRACE) << "Ignoring branch " << branch->GetName() << " of tree " << tree->GetName();
+                tree->SetBranchStatus(branch->GetName(), false);
+                continue;
+            }
+
             // Add a new vector of objects and bind it to the branch
             object_info object_inf;
             object_inf.objects = new std::vector<Object*>;
@@ -209,6 +317,81 @@ void FileReader::initialize() {
             }
         }
     }
+
+    // Load the index of events if the file provides one
+    if(index_tree_ != nullptr) {
+        double end{};
+        Long64_t entry{};
+        UInt_t objects{};
+        index_tree_->SetBranchAddress("end", &end);
+        index_tree_->SetBranchAddress("entry", &entry);
+        index_tree_->SetBranchAddress("objects", &objects);
+
+        index_end_.resize(static_cast<size_t>(event_tree_->GetEntries()));
+        index_objects_.resize(index_end_.size(), UINT_MAX);
+        for(Long64_t i = 0; i < index_tree_->GetEntries(); i++) {
+            index_tree_->GetEntry(i);
+            if(entry >= 0 && static_cast<size_t>(entry) < index_end_.size()) {
+                index_end_[static_cast<size_t>(entry)] = end;
+                index_objects_[static_cast<size_t>(entry)] = objects;
+            }
+        }
+        index_tree_->ResetBranchAddresses();
+        LOG(DEBUG) << "Read index of " << index_tree_->GetEntries() << " events";
+    } else {
+        LOG(DEBUG) << "File does not contain an event index, searching events in the event tree";
+    }
+
+    // Find the first event to read
+    if(config_.has("start_time")) {
+        event_num_ = find_entry(config_.get<double>("start_time"));
+    } else {
+        event_num_ = static_cast<Long64_t>(config_.get<unsigned long>("start_event", 0));
+    }
+    first_event_ = event_num_;
+    if(first_event_ >= event_tree_->GetEntries()) {
+        throw InvalidValueError(config_,
+                                config_.has("start_time") ? "start_time" : "start_event",
+                                "file only contains data for " + std::to_string(event_tree_->GetEntries()) + " events");
+    }
+
+    // Skip to the partition of the run processed by this instance of the framework
+    auto& global_config = getConfigManager()->getGlobalConfiguration();
+    if(global_config.has("_partition_begin")) {
+        auto begin = global_config.get<double>("_partition_begin");
+        if(global_config.get<bool>("_partition_by_time")) {
+            // If the partition starts after the last event, the last event ends the run of this partition
+            event_num_ = std::min(std::max(event_num_, find_entry(begin)), event_tree_->GetEntries() - 1);
+        } else {
+            // Events are counted by the framework, only the event definitions are read for preceding events
+            skip_until_ = first_event_ + static_cast<Long64_t>(begin);
+        }
+    }
+
+    if(event_num_ > 0) {
+        LOG(INFO) << "Starting to read from event " << event_num_;
+    }
+}
+
+Long64_t FileReader::find_entry(double time) {
+    if(!index_end_.empty()) {
+        return static_cast<Long64_t>(std::upper_bound(index_end_.begin(), index_end_.end(), time) - index_end_.begin());
+    }
+
+    // Without index, perform a binary search reading only the event definitions
+    Long64_t first = 0;
+    Long64_t count = event_tree_->GetEntries();
+    while(count > 0) {
+        auto step = count / 2;
+        event_tree_->GetEntry(first + step);
+        if(event_->end() <= time) {
+            first += step + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
 }
 
 StatusCode FileReader::run(const std::shared_ptr<Clipboard>& clipboard) {
@@ -223,6 +406,20 @@ StatusCode FileReader::run(const std::shared_ptr<Clipboard>& clipboard) {
     event_tree_->GetEntry(event_num_);
     clipboard->putEvent(std::make_shared<Event>(*event_));
     read_cnt_++;
+    event_cnt_++;
+
+    // Objects are neither read for events skipped by the framework nor for events without objects according to the index
+    auto index = static_cast<size_t>(event_num_);
+    bool no_objects = (index < index_objects_.size() && index_objects_[index] == 0);
+    if(event_num_ < skip_until_ || no_objects) {
+        LOG(TRACE) << "Not reading any objects for this event";
+        return next_event();
+    }
+    if(index < index_objects_.size()) {
+        indexed_cnt_ += index_objects_[index];
+    }
+
+    read_columns(clipboard);
 
     for(auto& tree : trees_) {
         LOG(TRACE) << "Reading tree \"" << tree->GetName() << "\"";
@@ -262,6 +459,156 @@ StatusCode FileReader::run(const std::shared_ptr<Clipboard>& clipboard) {
         read_cnt_ += objects->size();
     }
 
+    return next_event();
+}
+
+void FileReader::read_columns(const std::shared_ptr<Clipboard>& clipboard) {
+    if(pixel_tree_ != nullptr) {
+        pixel_tree_->GetEntry(event_num_);
+    }
+    if(cluster_tree_ != nullptr) {
+        cluster_tree_->GetEntry(event_num_);
+    }
+    if(track_tree_ != nullptr) {
+        track_tree_->GetEntry(event_num_);
+    }
+
+    // Clusters of every track, collected from the index of the track cluster on every detector
+    size_t track_count = (track_columns_.type != nullptr ? track_columns_.type->size() : 0);
+    std::vector<std::vector<const Cluster*>> track_clusters(track_count);
+
+    // Pixels are kept to be referenced by the clusters of the same detector
+    std::map<std::string, PixelVector> detector_pixels;
+    for(auto& [detector_name, columns] : pixel_columns_) {
+        if(columns.column == nullptr || columns.column->empty()) {
+            continue;
+        }
+
+        auto& pixels = detector_pixels[detector_name];
+        for(size_t i = 0; i < columns.column->size(); i++) {
+            pixels.push_back(make_pooled<Pixel>(detector_name,
+                                                columns.column->at(i),
+                                                columns.row != nullptr ? columns.row->at(i) : 0,
+                                                columns.raw != nullptr ? columns.raw->at(i) : 1,
+                                                columns.charge != nullptr ? columns.charge->at(i) : 1.,
+                                                columns.timestamp != nullptr ? columns.timestamp->at(i) : 0.));
+        }
+        LOG(TRACE) << "- " << pixels.size() << " Pixel, detector " << detector_name;
+        read_cnt_ += pixels.size();
+        clipboard->putData(pixels, detector_name);
+    }
+
+    for(auto& [detector_name, columns] : cluster_columns_) {
+        if(columns.column == nullptr || columns.column->empty()) {
+            continue;
+        }
+
+        const auto& pixels = detector_pixels[detector_name];
+        auto value = [](const std::vector<float>* column, size_t i) {
+            return column != nullptr ? static_cast<double>(column->at(i)) : 0.;
+        };
+
+        ClusterVector clusters;
+        size_t pixel_offset = 0;
+        for(size_t i = 0; i < columns.column->size(); i++) {
+            auto cluster = make_pooled<Cluster>();
+            cluster->setDetectorID(detector_name);
+            cluster->setTimestamp(columns.timestamp != nullptr ? columns.timestamp->at(i) : 0.);
+
+            // Add the pixels first, the cluster widths are derived from them
+            auto size = (columns.size != nullptr ? static_cast<size_t>(columns.size->at(i)) : 0);
+            for(size_t j = pixel_offset; columns.pixels != nullptr && j < pixel_offset + size; j++) {
+                auto index = columns.pixels->at(j);
+                if(index >= 0 && static_cast<size_t>(index) < pixels.size()) {
+                    cluster->addPixel(pixels[static_cast<size_t>(index)].get());
+                }
+            }
+            pixel_offset += size;
+
+            cluster->setColumn(value(columns.column, i));
+            cluster->setRow(value(columns.row, i));
+            cluster->setCharge(value(columns.charge, i));
+            cluster->setClusterCentre(
+                ROOT::Math::XYZPoint(value(columns.x, i), value(columns.y, i), value(columns.z, i)));
+            cluster->setClusterCentreLocal(
+                ROOT::Math::XYZPoint(value(columns.local_x, i), value(columns.local_y, i), value(columns.local_z, i)));
+            cluster->setErrorX(value(columns.error_x, i));
+            cluster->setErrorY(value(columns.error_y, i));
+            cluster->setSplit(columns.split != nullptr && columns.split->at(i) != 0);
+            clusters.push_back(std::move(cluster));
+        }
+
+        auto track_cluster = track_columns_.cluster.find(detector_name);
+        if(track_cluster != track_columns_.cluster.end() && track_cluster->second != nullptr) {
+            for(size_t i = 0; i < std::min(track_count, track_cluster->second->size()); i++) {
+                auto index = track_cluster->second->at(i);
+                if(index >= 0 && static_cast<size_t>(index) < clusters.size()) {
+                    track_clusters[i].push_back(clusters[static_cast<size_t>(index)].get());
+                }
+            }
+        }
+        LOG(TRACE) << "- " << clusters.size() << " Cluster, detector " << detector_name;
+        read_cnt_ += clusters.size();
+        clipboard->putData(std::move(clusters), detector_name);
+    }
+
+    // Tracks are recreated from their clusters, which are kept alive by the clipboard
+    TrackVector tracks;
+    for(size_t i = 0; i < track_count; i++) {
+        auto timestamp = (track_columns_.timestamp != nullptr ? track_columns_.timestamp->at(i) : 0.);
+        auto track = create_track(track_columns_.type->at(i), timestamp, track_clusters[i]);
+        if(track != nullptr) {
+            tracks.push_back(std::move(track));
+        }
+    }
+    if(!tracks.empty()) {
+        LOG(TRACE) << "- " << tracks.size() << " Track";
+        read_cnt_ += tracks.size();
+        clipboard->putData(std::move(tracks));
+    }
+}
+
+std::shared_ptr<Track>
+FileReader::create_track(const std::string& type, double timestamp, const std::vector<const Cluster*>& clusters) {
+    // Map the stored type of the track to the track model it has been created with
+    std::string model;
+    if(type == "StraightLineTrack") {
+        model = "straightline";
+    } else if(type == "GblTrack") {
+        model = "gbl";
+    } else {
+        if(unknown_track_types_.insert(type).second) {
+            LOG(WARNING) << "Tracks of type " << type << " cannot be recreated from columns and are not read";
+        }
+        return nullptr;
+    }
+
+    auto track = Track::Factory(model);
+    for(const auto* cluster : clusters) {
+        track->addCluster(cluster);
+    }
+    track->setTimestamp(timestamp);
+    track->setParticleMomentum(momentum_);
+
+    // Register all planes as the tracking does, passive layers contribute to the scattering as well
+    for(auto& detector : get_detectors()) {
+        if(detector->isAuxiliary()) {
+            continue;
+        }
+        track->registerPlane(
+            detector->getName(), detector->displacement().z(), detector->materialBudget(), detector->toLocal());
+    }
+
+    try {
+        track->fit();
+    } catch(TrackError& e) {
+        LOG(DEBUG) << "Track with " << clusters.size() << " clusters cannot be refitted: " << e.what();
+        return nullptr;
+    }
+    return track;
+}
+
+StatusCode FileReader::next_event() {
     event_num_++;
 
     if(event_num_ >= event_tree_->GetEntries()) {
@@ -273,14 +620,24 @@ StatusCode FileReader::run(const std::shared_ptr<Clipboard>& clipboard) {
 }
 
 void FileReader::finalize(const std::shared_ptr<ReadonlyClipboard>&) {
-    int branch_count = 0;
-    for(auto& tree : trees_) {
-        branch_count += tree->GetListOfBranches()->GetEntries();
-    }
-    branch_count += event_tree_->GetListOfBranches()->GetEntries();
+    // Only count the branches which have been read, excluding those of detectors which have not been selected
+    auto branch_count = object_info_array_.size();
+    branch_count += static_cast<size_t>(event_tree_->GetListOfBranches()->GetEntries());
 
     // Print statistics
     LOG(INFO) << "Read " << read_cnt_ << " objects from " << branch_count << " branches";
+    LOG(INFO) << "Read " << event_cnt_ << " events starting from event " << first_event_;
+
+    // If all objects are read, their number has to agree with the number of objects written according to the index
+    if(complete_read_ && detectors_.empty() && !index_objects_.empty()) {
+        auto object_cnt = read_cnt_ - event_cnt_;
+        if(object_cnt == indexed_cnt_) {
+            LOG(INFO) << "Number of objects read agrees with the event index";
+        } else {
+            LOG(WARNING) << "Read " << object_cnt << " objects, but the event index lists " << indexed_cnt_
+                         << " objects for the events read";
+        }
+    }
 
     // Close the file
     input_file_->Close();
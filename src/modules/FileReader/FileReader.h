@@ -9,12 +9,16 @@
 
 #include <functional>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 #include <TFile.h>
 #include <TTree.h>
 
 #include "core/module/Module.hpp"
+#include "objects/Cluster.hpp"
+#include "objects/Track.hpp"
 
 namespace corryvreckan {
     /**
@@ -58,6 +62,65 @@ namespace corryvreckan {
         void finalize(const std::shared_ptr<ReadonlyClipboard>& clipboard) override;
 
     private:
+        /**
+         * @brief Find the first event in the file which ends after the given time
+         * @param time Time to search for
+         * @return Entry number of the event, or the number of entries if no such event exists
+         */
+        Long64_t find_entry(double time);
+
+        /**
+         * @brief Advance to the next event of the file
+         * @return Status code requesting the end of the run if the file contains no further events
+         */
+        StatusCode next_event();
+
+        /**
+         * @brief Create the pixels, clusters and tracks of the current event from the columns written by the FileWriter
+         * @param clipboard Clipboard of the event to store the objects on
+         */
+        void read_columns(const std::shared_ptr<Clipboard>& clipboard);
+
+        /**
+         * @brief Columns of the pixels of one detector, missing columns remain nullptr
+         */
+        struct PixelColumns {
+            std::vector<int>*column{}, *row{}, *raw{};
+            std::vector<float>* charge{};
+            std::vector<double>* timestamp{};
+        };
+
+        /**
+         * @brief Columns of the clusters of one detector, missing columns remain nullptr
+         */
+        struct ClusterColumns {
+            std::vector<float>*column{}, *row{}, *charge{};
+            std::vector<float>*x{}, *y{}, *z{}, *local_x{}, *local_y{}, *local_z{}, *error_x{}, *error_y{};
+            std::vector<double>* timestamp{};
+            std::vector<char>* split{};
+            std::vector<int>*size{}, *pixels{};
+        };
+
+        /**
+         * @brief Columns of the tracks with the index of their cluster on every detector, missing columns remain nullptr
+         */
+        struct TrackColumns {
+            std::vector<std::string>* type{};
+            std::vector<double>* timestamp{};
+            std::map<std::string, std::vector<int>*> cluster;
+        };
+
+        /**
+         * @brief Create a track from its stored type and clusters and refit it
+         * @param type Type of the track as stored by the FileWriter module
+         * @param timestamp Timestamp of the track
+         * @param clusters Clusters the track consists of
+         * @return Fitted track, or nullptr if the track cannot be recreated
+         */
+        std::shared_ptr<Track> create_track(const std::string& type,
+                                            double timestamp,
+                                            const std::vector<const Cluster*>& clusters);
+
         /**
          * @brief Internal object storing objects and information to construct a message from tree
          */
@@ -70,6 +133,9 @@ namespace corryvreckan {
         std::set<std::string> include_;
         std::set<std::string> exclude_;
 
+        // Detectors to read objects for, all if empty
+        std::set<std::string> detectors_;
+
         // File containing the objects
         std::unique_ptr<TFile> input_file_;
 
@@ -78,14 +144,40 @@ namespace corryvreckan {
         TTree* event_tree_{nullptr};
         Event* event_{};
 
+        // Index of the events in the file, containing the end of every event and its number of objects
+        TTree* index_tree_{nullptr};
+        std::vector<double> index_end_;
+        std::vector<UInt_t> index_objects_;
+
+        // Trees and columns of pixels, clusters and tracks stored as flat columns
+        TTree* pixel_tree_{nullptr};
+        TTree* cluster_tree_{nullptr};
+        TTree* track_tree_{nullptr};
+        std::map<std::string, PixelColumns> pixel_columns_;
+        std::map<std::string, ClusterColumns> cluster_columns_;
+        TrackColumns track_columns_;
+
+        // Momentum assumed for refitting tracks read from columns, and types of tracks which cannot be recreated
+        double momentum_{};
+        std::set<std::string> unknown_track_types_;
+
         // List of objects and detector information converted from the trees
         std::list<object_info> object_info_array_;
 
-        // Statistics for total amount of objects stored
+        // Statistics for total amount of objects stored and events read
         unsigned long read_cnt_{};
+        unsigned long event_cnt_{};
+
+        // Number of objects listed in the event index for the events read, and whether all objects of the file are read
+        unsigned long indexed_cnt_{};
+        bool complete_read_{true};
 
         // Counter for number of events read:
-        int event_num_{};
+        Long64_t event_num_{};
+
+        // First event read from the file and first event for which the objects are read
+        Long64_t first_event_{};
+        Long64_t skip_until_{};
 
         // Internal map to construct an object from it's type index
         ObjectCreatorMap object_creator_map_;
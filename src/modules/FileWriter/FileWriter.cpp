@@ -11,25 +11,35 @@
 #include "FileWriter.h"
 
 #include <fstream>
+#include <mutex>
 #include <string>
 #include <utility>
 
+#include <Compression.h>
 #include <TBranchElement.h>
 #include <TClass.h>
+#include <TROOT.h>
 
 #include "core/utils/log.h"
 #include "core/utils/type.h"
 
 #include "objects/Object.hpp"
+#include "objects/Track.hpp"
 
 using namespace corryvreckan;
 
 FileWriter::FileWriter(Configuration& config, std::vector<std::shared_ptr<Detector>> detectors)
-    : Module(config, std::move(detectors)) {}
+    : Module(config, std::move(detectors)) {
+    // The output file is written by a single process
+    disallow_partitions();
+}
 /**
  * @note Objects cannot be stored in smart pointers due to internal ROOT logic
  */
 FileWriter::~FileWriter() {
+    // Stop the writer thread before the objects it writes from are deleted
+    writer_.reset();
+
     // Delete all object pointers
     for(auto& index_data : write_list_) {
         delete index_data.second;
@@ -39,10 +49,46 @@ FileWriter::~FileWriter() {
 void FileWriter::initialize() {
     // Create output file
     config_.setDefault<std::string>("file_name", "data");
+    config_.setDefault<OutputFormat>("format", OutputFormat::OBJECTS);
+    config_.setDefault<CompressionAlgorithm>("compression_algorithm", CompressionAlgorithm::DEFAULT);
+    config_.setDefault<int>("basket_size", 32000);
+    config_.setDefault<int>("write_queue_depth", 0);
+
+    format_ = config_.get<OutputFormat>("format");
+    basket_size_ = config_.get<int>("basket_size");
+    if(basket_size_ <= 0) {
+        throw InvalidValueError(config_, "basket_size", "basket size should be strictly more than zero");
+    }
+
     output_file_name_ = createOutputFile(config_.get<std::string>("file_name"), "root", true);
     output_file_ = std::make_unique<TFile>(output_file_name_.c_str(), "RECREATE");
     output_file_->cd();
 
+    // Set the compression of the output file
+    switch(config_.get<CompressionAlgorithm>("compression_algorithm")) {
+    case CompressionAlgorithm::ZLIB:
+        output_file_->SetCompressionAlgorithm(ROOT::RCompressionSetting::EAlgorithm::kZLIB);
+        break;
+    case CompressionAlgorithm::LZMA:
+        output_file_->SetCompressionAlgorithm(ROOT::RCompressionSetting::EAlgorithm::kLZMA);
+        break;
+    case CompressionAlgorithm::LZ4:
+        output_file_->SetCompressionAlgorithm(ROOT::RCompressionSetting::EAlgorithm::kLZ4);
+        break;
+    case CompressionAlgorithm::ZSTD:
+        output_file_->SetCompressionAlgorithm(ROOT::RCompressionSetting::EAlgorithm::kZSTD);
+        break;
+    default:
+        break;
+    }
+    if(config_.has("compression_level")) {
+        auto level = config_.get<int>("compression_level");
+        if(level < 0 || level > 9) {
+            throw InvalidValueError(config_, "compression_level", "compression level should be between 0 and 9");
+        }
+        output_file_->SetCompressionLevel(level);
+    }
+
     // Read include and exclude list
     if(config_.has("include") && config_.has("exclude")) {
         throw InvalidValueError(config_, "exclude", "include and exclude parameter are mutually exclusive");
@@ -56,97 +102,277 @@ void FileWriter::initialize() {
 
     // Create event tree:
     event_tree_ = std::make_unique<TTree>("Event", (std::string("Tree of Events").c_str()));
-    event_tree_->Bronch("global", "corryvreckan::Event", &event_);
+    event_tree_->Bronch("global", "corryvreckan::Event", &event_, basket_size_);
+
+    // Create index of the events, allowing readers to locate events without reading the object trees:
+    index_tree_ = std::make_unique<TTree>("EventIndex", "Index of Events");
+    index_tree_->Branch("start", &index_start_);
+    index_tree_->Branch("end", &index_end_);
+    index_tree_->Branch("entry", &index_entry_);
+    index_tree_->Branch("objects", &index_objects_);
+
+    // Start the writer thread, which fills the trees concurrently to the processing of events by other threads
+    auto write_queue_depth = config_.get<int>("write_queue_depth");
+    if(write_queue_depth < 0) {
+        throw InvalidValueError(config_, "write_queue_depth", "queue depth cannot be negative");
+    } else if(write_queue_depth > 0) {
+        ROOT::EnableThreadSafety();
+        writer_ = std::make_unique<WriterThread>(static_cast<size_t>(write_queue_depth));
+        LOG(DEBUG) << "Writing events in background thread, queueing up to " << write_queue_depth << " events";
+    }
+
+    if(format_ == OutputFormat::COLUMNS) {
+        // Trees of columns are stored in a separate directory to distinguish them from trees of objects
+        auto* columns_dir = output_file_->mkdir("columns");
+        columns_dir->cd();
+
+        auto add_column = [this](TTree* tree, const std::string& name, auto* column) {
+            tree->Branch(name.c_str(), column, basket_size_);
+        };
+        if(is_written("Pixel")) {
+            pixel_tree_ = std::make_unique<TTree>("Pixel", "Columns of Pixel properties");
+            for(auto& detector : get_detectors()) {
+                auto& columns = pixel_columns_[detector->getName()];
+                auto prefix = detector->getName() + "_";
+                add_column(pixel_tree_.get(), prefix + "column", &columns.column);
+                add_column(pixel_tree_.get(), prefix + "row", &columns.row);
+                add_column(pixel_tree_.get(), prefix + "raw", &columns.raw);
+                add_column(pixel_tree_.get(), prefix + "charge", &columns.charge);
+                add_column(pixel_tree_.get(), prefix + "timestamp", &columns.timestamp);
+            }
+        }
+        if(is_written("Cluster")) {
+            cluster_tree_ = std::make_unique<TTree>("Cluster", "Columns of Cluster properties");
+            for(auto& detector : get_detectors()) {
+                auto& columns = cluster_columns_[detector->getName()];
+                auto prefix = detector->getName() + "_";
+                add_column(cluster_tree_.get(), prefix + "column", &columns.column);
+                add_column(cluster_tree_.get(), prefix + "row", &columns.row);
+                add_column(cluster_tree_.get(), prefix + "charge", &columns.charge);
+                add_column(cluster_tree_.get(), prefix + "x", &columns.x);
+                add_column(cluster_tree_.get(), prefix + "y", &columns.y);
+                add_column(cluster_tree_.get(), prefix + "z", &columns.z);
+                add_column(cluster_tree_.get(), prefix + "local_x", &columns.local_x);
+                add_column(cluster_tree_.get(), prefix + "local_y", &columns.local_y);
+                add_column(cluster_tree_.get(), prefix + "local_z", &columns.local_z);
+                add_column(cluster_tree_.get(), prefix + "error_x", &columns.error_x);
+                add_column(cluster_tree_.get(), prefix + "error_y", &columns.error_y);
+                add_column(cluster_tree_.get(), prefix + "timestamp", &columns.timestamp);
+                add_column(cluster_tree_.get(), prefix + "split", &columns.split);
+                add_column(cluster_tree_.get(), prefix + "size", &columns.size);
+                add_column(cluster_tree_.get(), prefix + "pixels", &columns.pixels);
+                add_column(cluster_tree_.get(), prefix + "track", &columns.track);
+            }
+        }
+        if(is_written("Track")) {
+            track_tree_ = std::make_unique<TTree>("Track", "Columns of Track properties");
+            add_column(track_tree_.get(), "type", &track_columns_.type);
+            add_column(track_tree_.get(), "chi2", &track_columns_.chi2);
+            add_column(track_tree_.get(), "ndof", &track_columns_.ndof);
+            add_column(track_tree_.get(), "x", &track_columns_.x);
+            add_column(track_tree_.get(), "y", &track_columns_.y);
+            add_column(track_tree_.get(), "direction_x", &track_columns_.direction_x);
+            add_column(track_tree_.get(), "direction_y", &track_columns_.direction_y);
+            add_column(track_tree_.get(), "direction_z", &track_columns_.direction_z);
+            add_column(track_tree_.get(), "timestamp", &track_columns_.timestamp);
+            add_column(track_tree_.get(), "clusters", &track_columns_.clusters);
+
+            // Clusters of the tracks are referenced by their index in the cluster columns of their detector
+            for(const auto& columns : cluster_columns_) {
+                add_column(track_tree_.get(), columns.first + "_cluster", &track_columns_.cluster[columns.first]);
+            }
+        }
+        output_file_->cd();
+    }
 }
 
-StatusCode FileWriter::run(const std::shared_ptr<Clipboard>& clipboard) {
-    // Acquire ROOT TProcessID resource lock and reset PIDs:
-    auto root_lock = root_process_lock();
+bool FileWriter::is_written(const std::string& class_name) const {
+    return (include_.empty() || include_.find(class_name) != include_.end()) &&
+           (exclude_.empty() || exclude_.find(class_name) == exclude_.end());
+}
 
+StatusCode FileWriter::run(const std::shared_ptr<Clipboard>& clipboard) {
     if(!clipboard->isEventDefined()) {
         ModuleError("No Clipboard event defined, cannot continue");
     }
 
-    // Read event from clipboard and write to tree:
-    event_ = clipboard->getEvent().get();
-    event_tree_->Fill();
-    write_cnt_++;
+    auto data = std::make_shared<EventData>();
+    data->event = clipboard->getEvent();
+
+    if(format_ == OutputFormat::COLUMNS) {
+        // Columns for the writer thread are collected separately, otherwise directly into the columns bound to the trees
+        if(writer_ != nullptr) {
+            for(const auto& columns : pixel_columns_) {
+                data->pixel_columns[columns.first];
+            }
+            for(const auto& columns : cluster_columns_) {
+                data->cluster_columns[columns.first];
+            }
+            for(const auto& columns : track_columns_.cluster) {
+                data->track_columns.cluster[columns.first];
+            }
+            data->object_count =
+                collect_columns(clipboard, data->pixel_columns, data->cluster_columns, data->track_columns);
+        } else {
+            data->object_count = collect_columns(clipboard, pixel_columns_, cluster_columns_, track_columns_);
+        }
+    } else {
+        // Acquire ROOT TProcessID resource lock and reset PIDs:
+        auto root_lock = root_process_lock();
+        try {
+            collect_objects(clipboard, *data);
+        } catch(...) {
+            return StatusCode::NoData;
+        }
+
+        // Without writer thread, the objects are written while still holding the lock
+        if(writer_ == nullptr) {
+            write_event(*data);
+            return StatusCode::Success;
+        }
+    }
+
+    if(writer_ != nullptr) {
+        writer_->submit([this, data]() {
+            // Streaming objects accesses the TProcessIDs, which are reset by other threads reading or writing objects
+            std::unique_lock<std::mutex> root_lock;
+            if(format_ == OutputFormat::OBJECTS) {
+                root_lock = root_process_lock();
+            }
+            write_event(*data);
+
+            // Release the objects while holding the lock, deleting referenced objects updates their TProcessID
+            data->objects.clear();
+        });
+    } else {
+        write_event(*data);
+    }
+
+    return StatusCode::Success;
+}
 
-    auto data = clipboard->getAll();
-    LOG(DEBUG) << "Clipboard has " << data.size() << " different object types.";
+void FileWriter::collect_objects(const std::shared_ptr<Clipboard>& clipboard, EventData& data) {
+    auto blocks = clipboard->getAll();
+    LOG(DEBUG) << "Clipboard has " << blocks.size() << " different object types.";
 
-    for(auto& block : data) {
+    for(auto& block : blocks) {
         try {
             auto type_idx = block.first;
             auto class_name = corryvreckan::demangle(type_idx.name());
-            auto class_name_full = corryvreckan::demangle(type_idx.name(), true);
             LOG(TRACE) << "Received objects of type \"" << class_name << "\" in " << block.second.size() << " blocks";
 
             // Check if these objects should be stored
-            if((!include_.empty() && include_.find(class_name) == include_.end()) ||
-               (!exclude_.empty() && exclude_.find(class_name) != exclude_.end())) {
+            if(!is_written(class_name)) {
                 LOG(TRACE) << "Ignoring object " << corryvreckan::demangle(type_idx.name())
                            << " because it has been excluded or not explicitly included";
                 continue;
             }
 
             for(auto& detector_block : block.second) {
-                // Get the detector name
-                std::string detector_name;
-                if(!detector_block.first.empty()) {
-                    detector_name = detector_block.first;
-                }
-
                 auto objects = std::static_pointer_cast<ObjectVector>(detector_block.second);
-                LOG(TRACE) << " - " << detector_name << ": " << objects->size();
-
-                // Create a new branch of the correct type if this object has not been received before
-                auto index_tuple = std::make_tuple(type_idx, detector_name);
-                if(write_list_.find(index_tuple) == write_list_.end()) {
-
-                    // Add vector of objects to write to the write list
-                    write_list_[index_tuple] = new std::vector<Object*>();
-                    auto addr = &write_list_[index_tuple];
-
-                    auto new_tree = (trees_.find(class_name) == trees_.end());
-                    if(new_tree) {
-                        // Create new tree
-                        output_file_->cd();
-                        trees_.emplace(
-                            class_name,
-                            std::make_unique<TTree>(class_name.c_str(), (std::string("Tree of ") + class_name).c_str()));
-                    }
-
-                    std::string branch_name = detector_name.empty() ? "global" : detector_name;
-
-                    trees_[class_name]->Bronch(
-                        branch_name.c_str(), (std::string("std::vector<") + class_name_full + "*>").c_str(), addr);
-
-                    if(new_tree) {
-                        LOG(DEBUG) << "Pre-filling new tree of " << class_name << " with " << last_event_ << " empty events";
-                        for(unsigned int i = 0; i < last_event_; ++i) {
-                            trees_[class_name]->Fill();
-                        }
-                    } else {
-                        LOG(DEBUG) << "Pre-filling new branch " << branch_name << " of " << class_name << " with "
-                                   << last_event_ << " empty events";
-                        auto* branch = trees_[class_name]->GetBranch(branch_name.c_str());
-                        for(unsigned int i = 0; i < last_event_; ++i) {
-                            branch->Fill();
-                        }
-                    }
-                }
+                LOG(TRACE) << " - " << detector_block.first << ": " << objects->size();
 
-                // Fill the branch vector
+                // Replace the history of the objects by persistent references before they are written
                 for(auto& object : *objects) {
                     object->petrifyHistory();
-                    ++write_cnt_;
-                    write_list_[index_tuple]->push_back(object.get());
                 }
+                data.object_count += objects->size();
+                data.objects.emplace_back(type_idx, detector_block.first, std::move(objects));
             }
         } catch(...) {
             LOG(WARNING) << "Cannot process object of type" << corryvreckan::demangle(block.first.name());
-            return StatusCode::NoData;
+            throw;
+        }
+    }
+}
+
+void FileWriter::write_event(EventData& data) {
+    // Write event to tree:
+    event_ = data.event.get();
+    event_tree_->Fill();
+    write_cnt_ += 1 + data.object_count;
+
+    if(format_ == OutputFormat::COLUMNS) {
+        // Columns collected for the writer thread replace the content of the columns bound to the trees
+        if(writer_ != nullptr) {
+            for(auto& [detector_name, columns] : data.pixel_columns) {
+                std::swap(pixel_columns_.at(detector_name), columns);
+            }
+            for(auto& [detector_name, columns] : data.cluster_columns) {
+                std::swap(cluster_columns_.at(detector_name), columns);
+            }
+            // Columns are swapped individually, the trees are bound to the columns of this module
+            auto& track_columns = data.track_columns;
+            std::swap(track_columns_.type, track_columns.type);
+            std::swap(track_columns_.chi2, track_columns.chi2);
+            std::swap(track_columns_.x, track_columns.x);
+            std::swap(track_columns_.y, track_columns.y);
+            std::swap(track_columns_.direction_x, track_columns.direction_x);
+            std::swap(track_columns_.direction_y, track_columns.direction_y);
+            std::swap(track_columns_.direction_z, track_columns.direction_z);
+            std::swap(track_columns_.timestamp, track_columns.timestamp);
+            std::swap(track_columns_.ndof, track_columns.ndof);
+            std::swap(track_columns_.clusters, track_columns.clusters);
+            for(auto& [detector_name, columns] : track_columns.cluster) {
+                std::swap(track_columns_.cluster.at(detector_name), columns);
+            }
+        }
+        for(auto* tree : {pixel_tree_.get(), cluster_tree_.get(), track_tree_.get()}) {
+            if(tree != nullptr) {
+                tree->Fill();
+            }
+        }
+        last_event_++;
+        fill_index(data.object_count);
+        return;
+    }
+
+    for(auto& [type_idx, detector_name, objects] : data.objects) {
+        auto class_name = corryvreckan::demangle(type_idx.name());
+
+        // Create a new branch of the correct type if this object has not been received before
+        auto index_tuple = std::make_tuple(type_idx, detector_name);
+        if(write_list_.find(index_tuple) == write_list_.end()) {
+            auto class_name_full = corryvreckan::demangle(type_idx.name(), true);
+
+            // Add vector of objects to write to the write list
+            write_list_[index_tuple] = new std::vector<Object*>();
+            auto addr = &write_list_[index_tuple];
+
+            auto new_tree = (trees_.find(class_name) == trees_.end());
+            if(new_tree) {
+                // Create new tree
+                output_file_->cd();
+                trees_.emplace(class_name,
+                               std::make_unique<TTree>(class_name.c_str(), (std::string("Tree of ") + class_name).c_str()));
+            }
+
+            std::string branch_name = detector_name.empty() ? "global" : detector_name;
+
+            trees_[class_name]->Bronch(branch_name.c_str(),
+                                       (std::string("std::vector<") + class_name_full + "*>").c_str(),
+                                       addr,
+                                       basket_size_);
+
+            if(new_tree) {
+                LOG(DEBUG) << "Pre-filling new tree of " << class_name << " with " << last_event_ << " empty events";
+                for(unsigned int i = 0; i < last_event_; ++i) {
+                    trees_[class_name]->Fill();
+                }
+            } else {
+                LOG(DEBUG) << "Pre-filling new branch " << branch_name << " of " << class_name << " with " << last_event_
+                           << " empty events";
+                auto* branch = trees_[class_name]->GetBranch(branch_name.c_str());
+                for(unsigned int i = 0; i < last_event_; ++i) {
+                    branch->Fill();
+                }
+            }
+        }
+
+        // Fill the branch vector
+        auto* write_list = write_list_[index_tuple];
+        for(auto& object : *objects) {
+            write_list->push_back(object.get());
         }
     }
 
@@ -160,15 +386,173 @@ StatusCode FileWriter::run(const std::shared_ptr<Clipboard>& clipboard) {
         tree.second->Fill();
     }
 
+    // Add the event to the index
+    fill_index(data.object_count);
+
     // Clear the current message list
     for(auto& index_data : write_list_) {
         index_data.second->clear();
     }
+}
 
-    return StatusCode::Success;
+void FileWriter::fill_index(unsigned long objects) {
+    index_start_ = event_->start();
+    index_end_ = event_->end();
+    index_entry_ = static_cast<Long64_t>(last_event_ - 1);
+    index_objects_ = static_cast<UInt_t>(objects);
+    index_tree_->Fill();
+}
+
+/**
+ * Clear all given columns, keeping their allocated memory for the next event
+ */
+template <typename... T> static void clear_columns(std::vector<T>&... columns) {
+    (columns.clear(), ...);
+}
+
+unsigned long FileWriter::collect_columns(const std::shared_ptr<Clipboard>& clipboard,
+                                         std::map<std::string, PixelColumns>& pixel_columns,
+                                         std::map<std::string, ClusterColumns>& cluster_columns,
+                                         TrackColumns& track_columns) {
+    unsigned long object_count = 0;
+
+    // Tracks are indexed first, such that clusters can refer to the track they are part of
+    cluster_track_.clear();
+    cluster_index_.clear();
+    if(track_tree_ != nullptr) {
+        auto& columns = track_columns;
+        clear_columns(columns.type,
+                      columns.chi2,
+                      columns.x,
+                      columns.y,
+                      columns.direction_x,
+                      columns.direction_y,
+                      columns.direction_z,
+                      columns.timestamp,
+                      columns.ndof,
+                      columns.clusters);
+
+        const auto& tracks = clipboard->getData<Track>();
+        for(size_t i = 0; i < tracks.size(); i++) {
+            const auto& track = tracks[i];
+            auto clusters = track->getClusters();
+            for(const auto* cluster : clusters) {
+                cluster_track_.emplace(cluster, static_cast<int>(i));
+            }
+
+            auto intercept = track->getIntercept(0.);
+            auto direction = track->getDirection(0.);
+            columns.type.push_back(track->getType());
+            columns.chi2.push_back(static_cast<float>(track->getChi2()));
+            columns.ndof.push_back(static_cast<int>(track->getNdof()));
+            columns.x.push_back(static_cast<float>(intercept.X()));
+            columns.y.push_back(static_cast<float>(intercept.Y()));
+            columns.direction_x.push_back(static_cast<float>(direction.X()));
+            columns.direction_y.push_back(static_cast<float>(direction.Y()));
+            columns.direction_z.push_back(static_cast<float>(direction.Z()));
+            columns.timestamp.push_back(track->timestamp());
+            columns.clusters.push_back(static_cast<int>(clusters.size()));
+        }
+        object_count += tracks.size();
+    }
+
+    // Pixels are indexed by their position in the columns of their detector
+    pixel_index_.clear();
+    for(auto& [detector_name, columns] : pixel_columns) {
+        clear_columns(columns.column, columns.row, columns.raw, columns.charge, columns.timestamp);
+
+        const auto& pixels = clipboard->getData<Pixel>(detector_name);
+        for(const auto& pixel : pixels) {
+            pixel_index_.emplace(pixel.get(), static_cast<int>(columns.column.size()));
+            columns.column.push_back(pixel->column());
+            columns.row.push_back(pixel->row());
+            columns.raw.push_back(pixel->raw());
+            columns.charge.push_back(static_cast<float>(pixel->charge()));
+            columns.timestamp.push_back(pixel->timestamp());
+        }
+        object_count += pixels.size();
+    }
+
+    for(auto& [detector_name, columns] : cluster_columns) {
+        clear_columns(columns.column,
+                      columns.row,
+                      columns.charge,
+                      columns.x,
+                      columns.y,
+                      columns.z,
+                      columns.local_x,
+                      columns.local_y,
+                      columns.local_z,
+                      columns.error_x,
+                      columns.error_y,
+                      columns.timestamp,
+                      columns.split,
+                      columns.size,
+                      columns.pixels,
+                      columns.track);
+
+        const auto& clusters = clipboard->getData<Cluster>(detector_name);
+        for(const auto& cluster : clusters) {
+            auto global = cluster->global();
+            auto local = cluster->local();
+            columns.column.push_back(static_cast<float>(cluster->column()));
+            columns.row.push_back(static_cast<float>(cluster->row()));
+            columns.charge.push_back(static_cast<float>(cluster->charge()));
+            columns.x.push_back(static_cast<float>(global.X()));
+            columns.y.push_back(static_cast<float>(global.Y()));
+            columns.z.push_back(static_cast<float>(global.Z()));
+            columns.local_x.push_back(static_cast<float>(local.X()));
+            columns.local_y.push_back(static_cast<float>(local.Y()));
+            columns.local_z.push_back(static_cast<float>(local.Z()));
+            columns.error_x.push_back(static_cast<float>(cluster->errorX()));
+            columns.error_y.push_back(static_cast<float>(cluster->errorY()));
+            columns.timestamp.push_back(cluster->timestamp());
+            columns.split.push_back(static_cast<char>(cluster->isSplit()));
+
+            // Refer to the pixels written for this event, or -1 if they have not been written
+            auto pixels = cluster->pixels();
+            columns.size.push_back(static_cast<int>(pixels.size()));
+            for(const auto* pixel : pixels) {
+                auto index = pixel_index_.find(pixel);
+                columns.pixels.push_back(index != pixel_index_.end() ? index->second : -1);
+            }
+            auto track = cluster_track_.find(cluster.get());
+            columns.track.push_back(track != cluster_track_.end() ? track->second : -1);
+            cluster_index_.emplace(cluster.get(), static_cast<int>(columns.column.size() - 1));
+        }
+        object_count += clusters.size();
+    }
+
+    // Tracks refer to their cluster on every detector once all clusters have been indexed, clusters may be shared
+    if(track_tree_ != nullptr) {
+        const auto& tracks = clipboard->getData<Track>();
+        for(auto& [detector_name, columns] : track_columns.cluster) {
+            columns.assign(tracks.size(), -1);
+        }
+        for(size_t i = 0; i < tracks.size(); i++) {
+            for(const auto* cluster : tracks[i]->getClusters()) {
+                auto columns = track_columns.cluster.find(cluster->detectorID());
+                auto index = cluster_index_.find(cluster);
+                if(columns != track_columns.cluster.end() && index != cluster_index_.end()) {
+                    columns->second[i] = index->second;
+                }
+            }
+        }
+    }
+
+    return object_count;
 }
 
 void FileWriter::finalize(const std::shared_ptr<ReadonlyClipboard>&) {
+    // Wait for the writer thread to write all queued events
+    if(writer_ != nullptr) {
+        writer_->finish();
+        LOG(INFO) << "Writer thread queued at most " << writer_->getMaxQueueDepth() << " events, "
+                  << writer_->getMeanQueueDepth() << " on average" << std::endl
+                  << "Processing waited " << writer_->getStallCount() << " times for the writer thread, in total "
+                  << writer_->getStallTime() << "s";
+    }
+
     LOG(TRACE) << "Writing objects to file";
     output_file_->cd();
 
@@ -178,6 +562,11 @@ void FileWriter::finalize(const std::shared_ptr<ReadonlyClipboard>&) {
         branch_count += tree.second->GetListOfBranches()->GetEntries();
     }
     branch_count += event_tree_->GetListOfBranches()->GetEntries();
+    for(auto* tree : {pixel_tree_.get(), cluster_tree_.get(), track_tree_.get()}) {
+        if(tree != nullptr) {
+            branch_count += tree->GetListOfBranches()->GetEntries();
+        }
+    }
 
     // Create main config directory
     TDirectory* config_dir = output_file_->mkdir("config");
@@ -8,14 +8,41 @@
  */
 
 #include <map>
+#include <memory>
 #include <string>
+#include <tuple>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
 
 #include <TFile.h>
 #include <TTree.h>
 
 #include "core/module/Module.hpp"
+#include "core/utils/WriterThread.hpp"
+#include "objects/Cluster.hpp"
+#include "objects/Pixel.hpp"
 
 namespace corryvreckan {
+    /**
+     * @brief Layout of the data written to the file
+     */
+    enum class OutputFormat {
+        OBJECTS = 0, ///< Objects with their full content and history
+        COLUMNS,     ///< Flat columns of the properties of pixels, clusters and tracks
+    };
+
+    /**
+     * @brief Compression algorithm of the output file
+     */
+    enum class CompressionAlgorithm {
+        DEFAULT = 0, ///< Default algorithm of the ROOT installation
+        ZLIB,
+        LZMA,
+        LZ4,
+        ZSTD,
+    };
+
     /**
      * @ingroup Modules
      * @brief Module to write object data to ROOT trees in file for persistent storage
@@ -24,6 +51,12 @@ namespace corryvreckan {
      * Reads the whole clipboard. Creates a tree as soon as a new type of object is encountered and
      * saves the data in those objects to tree for every event. The tree name is the class name of the object. A separate
      * branch is created for every combination of detector name and message name that outputs this object.
+     *
+     * Alternatively, pixels, clusters and tracks can be written as flat columns of their properties with one vector per
+     * property and detector, which are considerably faster to write and read and require less storage.
+     *
+     * The data of every event is first collected from the clipboard. It is either written directly, or handed to a writer
+     * thread which fills the trees while the following events are processed.
      */
     class FileWriter : public Module {
     public:
@@ -55,6 +88,94 @@ namespace corryvreckan {
         void finalize(const std::shared_ptr<ReadonlyClipboard>& clipboard) override;
 
     private:
+
+        /**
+         * @brief Check whether objects of a given type should be written
+         * @param class_name Name of the object type without namespace
+         * @return True if the objects should be written, false if they are excluded or not explicitly included
+         */
+        bool is_written(const std::string& class_name) const;
+
+        /**
+         * @brief Columns of the pixels of one detector
+         */
+        struct PixelColumns {
+            std::vector<int> column, row, raw;
+            std::vector<float> charge;
+            std::vector<double> timestamp;
+        };
+
+        /**
+         * @brief Columns of the clusters of one detector, referring to their pixels and track by index
+         */
+        struct ClusterColumns {
+            std::vector<float> column, row, charge;
+            std::vector<float> x, y, z, local_x, local_y, local_z, error_x, error_y;
+            std::vector<double> timestamp;
+            std::vector<char> split;
+            std::vector<int> size, pixels, track;
+        };
+
+        /**
+         * @brief Columns of the tracks, with their intercept and direction at z = 0 and their cluster on every detector
+         */
+        struct TrackColumns {
+            std::vector<std::string> type;
+            std::vector<float> chi2, x, y, direction_x, direction_y, direction_z;
+            std::vector<double> timestamp;
+            std::vector<int> ndof, clusters;
+            std::map<std::string, std::vector<int>> cluster;
+        };
+
+        /**
+         * @brief Data of one event collected from the clipboard, holding the objects until they have been written
+         */
+        struct EventData {
+            std::shared_ptr<Event> event;
+            // Objects to write with their type and detector name
+            std::vector<std::tuple<std::type_index, std::string, std::shared_ptr<ObjectVector>>> objects;
+            // Columns of the event if they are not collected directly into the columns bound to the trees
+            std::map<std::string, PixelColumns> pixel_columns;
+            std::map<std::string, ClusterColumns> cluster_columns;
+            TrackColumns track_columns;
+            unsigned long object_count{};
+        };
+
+        /**
+         * @brief Collect the objects to write from the clipboard and petrify their history
+         * @param clipboard Clipboard of the event
+         * @param data Event data to add the objects to
+         */
+        void collect_objects(const std::shared_ptr<Clipboard>& clipboard, EventData& data);
+
+        /**
+         * @brief Collect the pixels, clusters and tracks of the event as flat columns
+         * @param clipboard Clipboard of the event
+         * @param pixel_columns Pixel columns per detector to fill
+         * @param cluster_columns Cluster columns per detector to fill
+         * @param track_columns Track columns to fill
+         * @return Number of collected objects
+         */
+        unsigned long collect_columns(const std::shared_ptr<Clipboard>& clipboard,
+                                      std::map<std::string, PixelColumns>& pixel_columns,
+                                      std::map<std::string, ClusterColumns>& cluster_columns,
+                                      TrackColumns& track_columns);
+
+        /**
+         * @brief Fill the collected data of one event into the trees, creating trees and branches for new objects
+         * @param data Event data to write
+         */
+        void write_event(EventData& data);
+
+        /**
+         * @brief Add the current event to the event index
+         * @param objects Number of objects written for the event
+         */
+        void fill_index(unsigned long objects);
+
+        OutputFormat format_{OutputFormat::OBJECTS};
+        int basket_size_{};
+
         // Object names to include or exclude from writing
         std::set<std::string> include_;
         std::set<std::string> exclude_;
@@ -68,6 +189,26 @@ namespace corryvreckan {
         std::unique_ptr<TTree> event_tree_;
         Event* event_{};
 
+        // Index of all events with their time frame, tree entry and number of stored objects
+        std::unique_ptr<TTree> index_tree_;
+        double index_start_{};
+        double index_end_{};
+        Long64_t index_entry_{};
+        UInt_t index_objects_{};
+
+        // Columns of the current event and their trees
+        std::map<std::string, PixelColumns> pixel_columns_;
+        std::map<std::string, ClusterColumns> cluster_columns_;
+        TrackColumns track_columns_;
+        std::unique_ptr<TTree> pixel_tree_;
+        std::unique_ptr<TTree> cluster_tree_;
+        std::unique_ptr<TTree> track_tree_;
+
+        // Position of pixels and clusters within their columns and index of the track containing a cluster
+        std::unordered_map<const Pixel*, int> pixel_index_;
+        std::unordered_map<const Cluster*, int> cluster_index_;
+        std::unordered_map<const Cluster*, int> cluster_track_;
+
         // Last event processed
         unsigned int last_event_{0};
 
@@ -76,5 +217,8 @@ namespace corryvreckan {
 
         // Statistical information about number of objects
         unsigned long write_cnt_{};
+
+        // Thread filling the trees in the background, if enabled
+        std::unique_ptr<WriterThread> writer_;
     };
 } // namespace corryvreckan
@@ -13,7 +13,10 @@
 using namespace corryvreckan;
 
 JSONWriter::JSONWriter(Configuration& config, std::vector<std::shared_ptr<Detector>> detectors)
-    : Module(config, std::move(detectors)) {}
+    : Module(config, std::move(detectors)) {
+    // The output file is written by a single process
+    disallow_partitions();
+}
 
 void JSONWriter::initialize() {
 
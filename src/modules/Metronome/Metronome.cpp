@@ -31,6 +31,17 @@ void Metronome::initialize() {
     m_eventEnd = m_eventStart + m_eventLength;
 
     m_triggers = config_.get<uint32_t>("skip_triggers", 0ul);
+
+    // Advance to the first event of the partition processed by this process, accumulating the times as in run()
+    auto partition_begin = get_partition_begin_time();
+    while(m_eventStart < partition_begin) {
+        m_eventStart = m_eventEnd;
+        m_eventEnd += m_eventLength;
+        m_triggers += m_triggersPerEvent;
+    }
+    if(partition_begin > 0) {
+        LOG(INFO) << "Starting partition with event at " << Units::display(m_eventStart, {"us", "ms", "s"});
+    }
 }
 
 StatusCode Metronome::run(const std::shared_ptr<Clipboard>& clipboard) {
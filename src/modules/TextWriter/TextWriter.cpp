@@ -13,7 +13,10 @@
 using namespace corryvreckan;
 
 TextWriter::TextWriter(Configuration& config, std::vector<std::shared_ptr<Detector>> detectors)
-    : Module(config, std::move(detectors)) {}
+    : Module(config, std::move(detectors)) {
+    // The output file is written by a single process
+    disallow_partitions();
+}
 
 void TextWriter::initialize() {
 
@@ -13,7 +13,6 @@
 #include <TDirectory.h>
 
 #include "tools/cuts.h"
-#include "tools/kdtree.h"
 
 using namespace corryvreckan;
 using namespace std;
@@ -21,6 +20,9 @@ using namespace std;
 Tracking4D::Tracking4D(Configuration& config, std::vector<std::shared_ptr<Detector>> detectors)
     : Module(config, std::move(detectors)) {
 
+    // Tracks are reconstructed independently per event, the module can process multiple events concurrently
+    allow_multithreading();
+
     // Backwards compatibility: also allow timing_cut to be used for time_cut_abs and spatial_cut for spatial_cut_abs
     config_.setAlias("time_cut_abs", "timing_cut", true);
     config_.setAlias("spatial_cut_abs", "spatial_cut", true);
@@ -34,6 +36,8 @@ Tracking4D::Tracking4D(Configuration& config, std::vector<std::shared_ptr<Detect
     config_.setDefault<bool>("volume_scattering", false);
     config_.setDefault<bool>("reject_by_roi", false);
     config_.setDefault<bool>("unique_cluster_usage", false);
+    config_.setDefault<XYVector>("seed_slope", {0, 0});
+    config_.setDefault<unsigned int>("workers", 1);
 
     if(config_.count({"time_cut_rel", "time_cut_abs"}) == 0) {
         config_.setDefault("time_cut_rel", 3.0);
@@ -67,6 +71,17 @@ Tracking4D::Tracking4D(Configuration& config, std::vector<std::shared_ptr<Detect
     use_volume_scatterer_ = config_.get<bool>("volume_scattering");
     reject_by_ROI_ = config_.get<bool>("reject_by_roi");
     unique_cluster_usage_ = config_.get<bool>("unique_cluster_usage");
+    workers_ = config_.get<unsigned int>("workers");
+    if(workers_ == 0) {
+        throw InvalidValueError(config_, "workers", "number of workers should be strictly more than zero");
+    }
+
+    // Optional pre-selection of reference cluster pairs along the expected beam direction
+    seed_slope_ = config_.get<XYVector>("seed_slope");
+    use_seed_spatial_cut_ = config_.has("seed_spatial_cut_abs");
+    if(use_seed_spatial_cut_) {
+        seed_spatial_cut_ = config_.get<XYVector>("seed_spatial_cut_abs");
+    }
 
     // print a warning if volumeScatterer are used as this causes fit failures
     // that are still not understood
@@ -83,26 +98,50 @@ Tracking4D::Tracking4D(Configuration& config, std::vector<std::shared_ptr<Detect
 
 void Tracking4D::initialize() {
 
+    // Clipboard collections accessed for every event
+    for(auto& detector : get_regular_detectors(!exclude_DUT_)) {
+        cluster_collections_.emplace(detector, Clipboard::registerCollection<Cluster>(detector->getName()));
+    }
+
+    // Timers for the individual stages of the track finding
+    tree_building_timer_ = create_stage_timer("tree_building");
+    seeding_timer_ = create_stage_timer("seeding");
+    track_finding_timer_ = create_stage_timer("track_finding");
+
+    // Create thread pool for the track finding within single events
+    if(workers_ > 1) {
+        ThreadPool::registerThreadCount(workers_);
+        thread_pool_ = std::make_unique<ThreadPool>(
+            workers_,
+            workers_ * 1024,
+            [log_level = corryvreckan::Log::getReportingLevel(), log_format = corryvreckan::Log::getFormat()]() {
+                // Initialize the threads to the same log level and format as the master setting
+                corryvreckan::Log::setReportingLevel(log_level);
+                corryvreckan::Log::setFormat(log_format);
+            });
+    }
+
     // Set up histograms
     std::string title = "Track #chi^{2};#chi^{2};events";
-    trackChi2 = new TH1F("trackChi2", title.c_str(), 300, 0, 3 * max_plot_chi2_);
+    trackChi2 = create_histogram<TH1F>("trackChi2", title.c_str(), 300, 0, 3 * max_plot_chi2_);
     title = "Track #chi^{2}/ndof;#chi^{2}/ndof;events";
-    trackChi2ndof = new TH1F("trackChi2ndof", title.c_str(), 500, 0, max_plot_chi2_);
+    trackChi2ndof = create_histogram<TH1F>("trackChi2ndof", title.c_str(), 500, 0, max_plot_chi2_);
     title = "Clusters per track;clusters;tracks";
-    clustersPerTrack = new TH1F("clustersPerTrack", title.c_str(), 10, -0.5, 9.5);
+    clustersPerTrack = create_histogram<TH1F>("clustersPerTrack", title.c_str(), 10, -0.5, 9.5);
     title = "Track multiplicity;tracks;events";
-    tracksPerEvent = new TH1F("tracksPerEvent", title.c_str(), 100, -0.5, 99.5);
+    tracksPerEvent = create_histogram<TH1F>("tracksPerEvent", title.c_str(), 100, -0.5, 99.5);
     title = "Track angle X;angle_{x} [rad];events";
-    trackAngleX = new TH1F("trackAngleX", title.c_str(), 2000, -0.01, 0.01);
+    trackAngleX = create_histogram<TH1F>("trackAngleX", title.c_str(), 2000, -0.01, 0.01);
     title = "Track angle Y;angle_{y} [rad];events";
-    trackAngleY = new TH1F("trackAngleY", title.c_str(), 2000, -0.01, 0.01);
+    trackAngleY = create_histogram<TH1F>("trackAngleY", title.c_str(), 2000, -0.01, 0.01);
     title = "Track time within event;track time - event start;events";
-    trackTime = new TH1F("trackTime", title.c_str(), 1000, 0, 460.8);
+    trackTime = create_histogram<TH1F>("trackTime", title.c_str(), 1000, 0, 460.8);
     title = "Track time with respect to first trigger;track time - trigger;events";
-    trackTimeTrigger = new TH1F("trackTimeTrigger", title.c_str(), 1000, -230.4, 230.4);
+    trackTimeTrigger = create_histogram<TH1F>("trackTimeTrigger", title.c_str(), 1000, -230.4, 230.4);
     title = "Track time with respect to first trigger vs. track chi2;track time - trigger;track #chi^{2};events";
-    trackTimeTriggerChi2 = new TH2F("trackTimeTriggerChi2", title.c_str(), 1000, -230.4, 230.4, 15, 0, 15);
-    tracksVsTime = new TH1F("tracksVsTime", "Number of tracks vs. time; time [s]; # entries", 3e6, 0, 3e3);
+    trackTimeTriggerChi2 = create_histogram<TH2F>("trackTimeTriggerChi2", title.c_str(), 1000, -230.4, 230.4, 15, 0, 15);
+    tracksVsTime = create_shared_histogram<TH1F>(
+        "tracksVsTime", "Number of tracks vs. time; time [s]; # entries", 3e6, 0, 3e3);
 
     // Loop over all planes
     for(auto& detector : get_regular_detectors(true)) {
@@ -117,18 +156,18 @@ void Tracking4D::initialize() {
         local_directory->cd();
 
         title = detectorID + " kink X;kink [rad];events";
-        kinkX[detectorID] = new TH1F("kinkX", title.c_str(), 500, -0.01, -0.01);
+        kinkX[detectorID] = create_histogram<TH1F>("kinkX", title.c_str(), 500, -0.01, -0.01);
         title = detectorID + " kinkY ;kink [rad];events";
-        kinkY[detectorID] = new TH1F("kinkY", title.c_str(), 500, -0.01, -0.01);
+        kinkY[detectorID] = create_histogram<TH1F>("kinkY", title.c_str(), 500, -0.01, -0.01);
 
-        local_intersects_[detectorID] = new TH2F("local_intersect",
-                                                 "local intersect, col, row",
-                                                 detector->nPixels().X(),
-                                                 0,
-                                                 detector->nPixels().X(),
-                                                 detector->nPixels().Y(),
-                                                 0,
-                                                 detector->nPixels().Y());
+        local_intersects_[detectorID] = create_histogram<TH2F>("local_intersect",
+                                                               "local intersect, col, row",
+                                                               detector->nPixels().X(),
+                                                               0,
+                                                               detector->nPixels().X(),
+                                                               detector->nPixels().Y(),
+                                                               0,
+                                                               detector->nPixels().Y());
 
         // Do not create plots for detectors not participating in the tracking:
         if(exclude_DUT_ && detector->isDUT()) {
@@ -138,108 +177,108 @@ void Tracking4D::initialize() {
         TDirectory* local_res = local_directory->mkdir("local_residuals");
         local_res->cd();
         title = detectorID + "Local Residual X;x-x_{track} [mm];events";
-        residualsX_local[detectorID] =
-            new TH1F("LocalResidualsX", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
+        residualsX_local[detectorID] = create_histogram<TH1F>(
+            "LocalResidualsX", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
         title = detectorID + "Local  Residual X, cluster column width 1;x-x_{track} [mm];events";
-        residualsXwidth1_local[detectorID] = new TH1F(
+        residualsXwidth1_local[detectorID] = create_histogram<TH1F>(
             "LocalResidualsXwidth1", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
         title = detectorID + "Local  Residual X, cluster column width  2;x-x_{track} [mm];events";
-        residualsXwidth2_local[detectorID] = new TH1F(
+        residualsXwidth2_local[detectorID] = create_histogram<TH1F>(
             "LocalResidualsXwidth2", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
         title = detectorID + "Local  Residual X, cluster column width  3;x-x_{track} [mm];events";
-        residualsXwidth3_local[detectorID] = new TH1F(
+        residualsXwidth3_local[detectorID] = create_histogram<TH1F>(
             "LocalResidualsXwidth3", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
         title = detectorID + "Local  Residual Y;y-y_{track} [mm];events";
-        residualsY_local[detectorID] =
-            new TH1F("LocalResidualsY", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
+        residualsY_local[detectorID] = create_histogram<TH1F>(
+            "LocalResidualsY", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
         title = detectorID + "Local  Residual Y, cluster row width 1;y-y_{track} [mm];events";
-        residualsYwidth1_local[detectorID] = new TH1F(
+        residualsYwidth1_local[detectorID] = create_histogram<TH1F>(
             "LocalResidualsYwidth1", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
         title = detectorID + "Local  Residual Y, cluster row width 2;y-y_{track} [mm];events";
-        residualsYwidth2_local[detectorID] = new TH1F(
+        residualsYwidth2_local[detectorID] = create_histogram<TH1F>(
             "LocalResidualsYwidth2", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
         title = detectorID + "Local  Residual Y, cluster row width 3;y-y_{track} [mm];events";
-        residualsYwidth3_local[detectorID] = new TH1F(
+        residualsYwidth3_local[detectorID] = create_histogram<TH1F>(
             "LocalResidualsYwidth3", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
 
         title = detectorID + " Pull X;x-x_{track}/resolution;events";
-        pullX_local[detectorID] = new TH1F("LocalpullX", title.c_str(), 500, -5, 5);
+        pullX_local[detectorID] = create_histogram<TH1F>("LocalpullX", title.c_str(), 500, -5, 5);
 
         title = detectorID + " Pull Y;y-y_{track}/resolution;events";
-        pullY_local[detectorID] = new TH1F("Localpully", title.c_str(), 500, -5, 5);
+        pullY_local[detectorID] = create_histogram<TH1F>("Localpully", title.c_str(), 500, -5, 5);
         // global
         TDirectory* global_res = local_directory->mkdir("global_residuals");
         global_res->cd();
         title = detectorID + "global Residual X;x-x_{track} [mm];events";
-        residualsX_global[detectorID] =
-            new TH1F("GlobalResidualsX", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
+        residualsX_global[detectorID] = create_histogram<TH1F>(
+            "GlobalResidualsX", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
 
         title = detectorID + " global  Residual X vs. global position X;x-x_{track} [mm];x [mm]";
-        residualsX_vs_positionX_global[detectorID] = new TH2F("GlobalResidualsX_vs_GlobalPositionX",
-                                                              title.c_str(),
-                                                              500,
-                                                              -3 * detector->getPitch().X(),
-                                                              3 * detector->getPitch().X(),
-                                                              400,
-                                                              -detector->getSize().X() / 1.5,
-                                                              detector->getSize().X() / 1.5);
+        residualsX_vs_positionX_global[detectorID] = create_histogram<TH2F>("GlobalResidualsX_vs_GlobalPositionX",
+                                                                            title.c_str(),
+                                                                            500,
+                                                                            -3 * detector->getPitch().X(),
+                                                                            3 * detector->getPitch().X(),
+                                                                            400,
+                                                                            -detector->getSize().X() / 1.5,
+                                                                            detector->getSize().X() / 1.5);
         title = detectorID + " global  Residual X vs. global position Y;x-x_{track} [mm];y [mm]";
-        residualsX_vs_positionY_global[detectorID] = new TH2F("GlobalResidualsX_vs_GlobalPositionY",
-                                                              title.c_str(),
-                                                              500,
-                                                              -3 * detector->getPitch().X(),
-                                                              3 * detector->getPitch().X(),
-                                                              400,
-                                                              -detector->getSize().Y() / 1.5,
-                                                              detector->getSize().Y() / 1.5);
+        residualsX_vs_positionY_global[detectorID] = create_histogram<TH2F>("GlobalResidualsX_vs_GlobalPositionY",
+                                                                            title.c_str(),
+                                                                            500,
+                                                                            -3 * detector->getPitch().X(),
+                                                                            3 * detector->getPitch().X(),
+                                                                            400,
+                                                                            -detector->getSize().Y() / 1.5,
+                                                                            detector->getSize().Y() / 1.5);
 
         title = detectorID + "global  Residual X, cluster column width 1;x-x_{track} [mm];events";
-        residualsXwidth1_global[detectorID] = new TH1F(
+        residualsXwidth1_global[detectorID] = create_histogram<TH1F>(
             "GlobalResidualsXwidth1", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
         title = detectorID + "global  Residual X, cluster column width  2;x-x_{track} [mm];events";
-        residualsXwidth2_global[detectorID] = new TH1F(
+        residualsXwidth2_global[detectorID] = create_histogram<TH1F>(
             "GlobalResidualsXwidth2", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
         title = detectorID + "global  Residual X, cluster column width  3;x-x_{track} [mm];events";
-        residualsXwidth3_global[detectorID] = new TH1F(
+        residualsXwidth3_global[detectorID] = create_histogram<TH1F>(
             "GlobalResidualsXwidth3", title.c_str(), 500, -3 * detector->getPitch().X(), 3 * detector->getPitch().X());
         title = detectorID + " Pull X;x-x_{track}/resolution;events";
-        pullX_global[detectorID] = new TH1F("GlobalpullX", title.c_str(), 500, -5, 5);
+        pullX_global[detectorID] = create_histogram<TH1F>("GlobalpullX", title.c_str(), 500, -5, 5);
         title = detectorID + "global  Residual Y;y-y_{track} [mm];events";
-        residualsY_global[detectorID] =
-            new TH1F("GlobalResidualsY", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
+        residualsY_global[detectorID] = create_histogram<TH1F>(
+            "GlobalResidualsY", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
 
         title = detectorID + " global  Residual Y vs. global position Y;y-y_{track} [mm];y [mm]";
-        residualsY_vs_positionY_global[detectorID] = new TH2F("GlobalResidualsY_vs_GlobalPositionY",
-                                                              title.c_str(),
-                                                              500,
-                                                              -3 * detector->getPitch().Y(),
-                                                              3 * detector->getPitch().Y(),
-                                                              400,
-                                                              -detector->getSize().Y() / 1.5,
-                                                              detector->getSize().Y() / 1.5);
+        residualsY_vs_positionY_global[detectorID] = create_histogram<TH2F>("GlobalResidualsY_vs_GlobalPositionY",
+                                                                            title.c_str(),
+                                                                            500,
+                                                                            -3 * detector->getPitch().Y(),
+                                                                            3 * detector->getPitch().Y(),
+                                                                            400,
+                                                                            -detector->getSize().Y() / 1.5,
+                                                                            detector->getSize().Y() / 1.5);
         title = detectorID + " global  Residual Y vs. global position X;y-y_{track} [mm];x [mm]";
-        residualsY_vs_positionX_global[detectorID] = new TH2F("GlobalResidualsY_vs_GlobalPositionX",
-                                                              title.c_str(),
-                                                              500,
-                                                              -3 * detector->getPitch().Y(),
-                                                              3 * detector->getPitch().Y(),
-                                                              400,
-                                                              -detector->getSize().X() / 1.5,
-                                                              detector->getSize().X() / 1.5);
+        residualsY_vs_positionX_global[detectorID] = create_histogram<TH2F>("GlobalResidualsY_vs_GlobalPositionX",
+                                                                            title.c_str(),
+                                                                            500,
+                                                                            -3 * detector->getPitch().Y(),
+                                                                            3 * detector->getPitch().Y(),
+                                                                            400,
+                                                                            -detector->getSize().X() / 1.5,
+                                                                            detector->getSize().X() / 1.5);
 
         title = detectorID + "global  Residual Y, cluster row width 1;y-y_{track} [mm];events";
-        residualsYwidth1_global[detectorID] = new TH1F(
+        residualsYwidth1_global[detectorID] = create_histogram<TH1F>(
             "GlobalResidualsYwidth1", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
         title = detectorID + "global  Residual Y, cluster row width 2;y-y_{track} [mm];events";
-        residualsYwidth2_global[detectorID] = new TH1F(
+        residualsYwidth2_global[detectorID] = create_histogram<TH1F>(
             "GlobalResidualsYwidth2", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
         title = detectorID + "global  Residual Y, cluster row width 3;y-y_{track} [mm];events";
-        residualsYwidth3_global[detectorID] = new TH1F(
+        residualsYwidth3_global[detectorID] = create_histogram<TH1F>(
             "GlobalResidualsYwidth3", title.c_str(), 500, -3 * detector->getPitch().Y(), 3 * detector->getPitch().Y());
         title = detectorID + " Pull Y;y-y_{track}/resolution;events";
-        pullY_global[detectorID] = new TH1F("Globalpully", title.c_str(), 500, -5, 5);
+        pullY_global[detectorID] = create_histogram<TH1F>("Globalpully", title.c_str(), 500, -5, 5);
 
-        residualsZ_global[detectorID] = new TH1F("GlobalResidualsz", title.c_str(), 500, -0.1, 0.1);
+        residualsZ_global[detectorID] = create_histogram<TH1F>("GlobalResidualsz", title.c_str(), 500, -0.1, 0.1);
         title = detectorID + "global  Residual Z, cluster row width 1;z_{track}-z [mm];events";
     }
 }
@@ -248,7 +287,7 @@ double Tracking4D::calculate_average_timestamp(const Track* track) {
     double sum_weighted_time = 0;
     double sum_weights = 0;
     for(auto& cluster : track->getClusters()) {
-        double weight = 1 / (time_cuts_[get_detector(cluster->getDetectorID())]);
+        double weight = 1 / (time_cuts_.at(get_detector(cluster->getDetectorID())));
         double time_of_flight = static_cast<double>(Units::convert(cluster->global().z(), "mm") / (299.792458));
         sum_weights += weight;
         sum_weighted_time += (static_cast<double>(Units::convert(cluster->timestamp(), "ns")) - time_of_flight) * weight;
@@ -256,6 +295,196 @@ double Tracking4D::calculate_average_timestamp(const Track* track) {
     return (sum_weighted_time / sum_weights);
 }
 
+std::shared_ptr<Track> Tracking4D::find_track(const std::map<std::shared_ptr<Detector>, KDTree<Cluster>>& trees,
+                                              Cluster* clusterFirst,
+                                              Cluster* clusterLast,
+                                              const std::shared_ptr<Detector>& reference_first,
+                                              const std::shared_ptr<Detector>& reference_last,
+                                              double time_cut_ref_track) {
+    // The track finding is based on a straight line. Therefore a refTrack to extrapolate to the next plane is used
+    StraightLineTrack refTrack;
+    refTrack.addCluster(clusterFirst);
+    refTrack.addCluster(clusterLast);
+    auto averageTimestamp = calculate_average_timestamp(&refTrack);
+    refTrack.setTimestamp(averageTimestamp);
+
+    // Make a new track
+    auto track = Track::Factory(track_model_);
+    track->addCluster(clusterFirst);
+    track->addCluster(clusterLast);
+
+    track->setTimestamp(averageTimestamp);
+    if(use_volume_scatterer_) {
+        track->setVolumeScatter(volume_radiation_length_);
+    }
+    track->setParticleMomentum(momentum_);
+
+    // Loop over each subsequent plane and look for a cluster within the timing cuts
+    size_t detector_nr = 2;
+    // Get all detectors here to also include passive layers which might contribute to scattering
+    for(auto& detector : get_detectors()) {
+        if(detector->isAuxiliary()) {
+            continue;
+        }
+        auto detectorID = detector->getName();
+        LOG(TRACE) << "added material budget for " << detectorID << " at z = " << detector->displacement().z();
+        track->registerPlane(detectorID, detector->displacement().z(), detector->materialBudget(), detector->toLocal());
+
+        if(detector == reference_first || detector == reference_last) {
+            continue;
+        }
+
+        if(exclude_DUT_ && detector->isDUT()) {
+            LOG(DEBUG) << "Skipping DUT plane.";
+            continue;
+        }
+
+        if(detector->isPassive()) {
+            LOG(DEBUG) << "Skipping passive plane.";
+            continue;
+        }
+
+        // Determine whether a track can still be assembled given the number of current hits and the number of
+        // detectors to come. Reduces computing time.
+        detector_nr++;
+        if(refTrack.getNClusters() + (trees.size() - detector_nr + 1) < min_hits_on_track_) {
+            LOG(DEBUG) << "No chance to find a track - too few detectors left: " << refTrack.getNClusters() << " + "
+                       << trees.size() << " - " << detector_nr << " < " << min_hits_on_track_;
+            continue;
+        }
+
+        if(trees.count(detector) == 0) {
+            LOG(TRACE) << "Skipping detector " << detector->getName() << " as it has 0 clusters.";
+            continue;
+        }
+
+        // Get all neighbors within the timing cut
+        LOG(DEBUG) << "Searching for neighboring cluster on device " << detector->getName();
+        LOG(DEBUG) << "- reference time is " << Units::display(refTrack.timestamp(), {"ns", "us", "s"});
+        Cluster* closestCluster = nullptr;
+
+        // Use spatial cut only as initial value (check if cluster is ellipse defined by cuts is done below):
+        double closestClusterDistance = sqrt(spatial_cuts_.at(detector).x() * spatial_cuts_.at(detector).x() +
+                                             spatial_cuts_.at(detector).y() * spatial_cuts_.at(detector).y());
+
+        double timeCut = std::max(time_cut_ref_track, time_cuts_.at(detector));
+        LOG(DEBUG) << "Using timing cut of " << Units::display(timeCut, {"ns", "us", "s"});
+
+        auto neighbors = trees.at(detector).getAllElementsInTimeWindow(refTrack.timestamp(), timeCut);
+
+        LOG(DEBUG) << "- found " << neighbors.size() << " neighbors within the correct time window";
+
+        // Now look for the spatially closest cluster on the next plane
+        refTrack.fit();
+
+        PositionVector3D<Cartesian3D<double>> interceptPoint = detector->getLocalIntercept(&refTrack);
+        double interceptX = interceptPoint.X();
+        double interceptY = interceptPoint.Y();
+
+        for(size_t ne = 0; ne < neighbors.size(); ne++) {
+            auto newCluster = neighbors[ne].get();
+
+            // Calculate the distance to the previous plane's cluster/intercept
+            double distanceX = interceptX - newCluster->local().x();
+            double distanceY = interceptY - newCluster->local().y();
+            double distance = sqrt(distanceX * distanceX + distanceY * distanceY);
+
+            // Check if newCluster lies within ellipse defined by spatial cuts around intercept,
+            // following this example:
+            // https://www.geeksforgeeks.org/check-if-a-point-is-inside-outside-or-on-the-ellipse/
+            //
+            // ellipse defined by: x^2/a^2 + y^2/b^2 = 1: on ellipse,
+            //                                       > 1: outside,
+            //                                       < 1: inside
+            // Continue if outside of ellipse:
+
+            const auto& spatial_cut = spatial_cuts_.at(detector);
+            double norm = (distanceX * distanceX) / (spatial_cut.x() * spatial_cut.x()) +
+                          (distanceY * distanceY) / (spatial_cut.y() * spatial_cut.y());
+
+            if(norm > 1) {
+                LOG(DEBUG) << "Cluster outside the cuts. Normalized distance: " << norm;
+                continue;
+            }
+
+            // If this is the closest keep it for now
+            if(distance < closestClusterDistance) {
+                closestClusterDistance = distance;
+                closestCluster = newCluster;
+            }
+        }
+
+        if(closestCluster == nullptr) {
+            LOG(DEBUG) << "No cluster within spatial cut";
+            continue;
+        }
+
+        // Add the cluster to the track
+        refTrack.addCluster(closestCluster);
+        track->addCluster(closestCluster);
+        averageTimestamp = calculate_average_timestamp(&refTrack);
+        refTrack.setTimestamp(averageTimestamp);
+        track->setTimestamp(averageTimestamp);
+
+        LOG(DEBUG) << "- added cluster to track";
+    }
+
+    // check if track has required detector(s):
+    auto foundRequiredDetector = [this](Track* t) {
+        for(auto& requireDet : require_detectors_) {
+            if(!requireDet.empty() && !t->hasDetector(requireDet)) {
+                LOG(DEBUG) << "No cluster from required detector " << requireDet << " on the track.";
+                return false;
+            }
+        }
+        return true;
+    };
+    if(!foundRequiredDetector(track.get())) {
+        return nullptr;
+    }
+
+    // Now should have a track with one cluster from each plane
+    if(track->getNClusters() < min_hits_on_track_) {
+        LOG(DEBUG) << "Not enough clusters on the track, found " << track->getNClusters() << " but " << min_hits_on_track_
+                   << " required.";
+        return nullptr;
+    }
+
+    // Fit the track
+    track->fit();
+
+    if(reject_by_ROI_ && track->isFitted()) {
+        // check if the track is within ROI for all detectors
+        auto ds = get_regular_detectors(!exclude_DUT_);
+        auto out_of_roi =
+            std::find_if(ds.begin(), ds.end(), [track](const auto& d) { return !d->isWithinROI(track.get()); });
+        if(out_of_roi != ds.end()) {
+            LOG(DEBUG) << "Rejecting track outside of ROI of detector " << out_of_roi->get()->getName();
+            return nullptr;
+        }
+    }
+    // save the track
+    if(!track->isFitted()) {
+        LOG_N(WARNING, 100) << "Rejected a track due to failure in fitting";
+        return nullptr;
+    }
+
+    if(timestamp_from_.empty()) {
+        // Improve the track timestamp by taking the average of all planes
+        auto timestamp = calculate_average_timestamp(track.get());
+        track->setTimestamp(timestamp);
+        LOG(DEBUG) << "Using average cluster timestamp of " << Units::display(timestamp, "us") << " as track timestamp.";
+    } else {
+        // use timestamp of required detector:
+        double track_timestamp = track->getClusterFromDetector(timestamp_from_)->timestamp();
+        LOG(DEBUG) << "Using timestamp of detector " << timestamp_from_
+                   << " as track timestamp: " << Units::display(track_timestamp, "us");
+        track->setTimestamp(track_timestamp);
+    }
+
+    return track;
+}
+
 StatusCode Tracking4D::run(const std::shared_ptr<Clipboard>& clipboard) {
 
     LOG(DEBUG) << "Start of event";
@@ -263,9 +492,10 @@ StatusCode Tracking4D::run(const std::shared_ptr<Clipboard>& clipboard) {
     map<std::shared_ptr<Detector>, KDTree<Cluster>> trees;
 
     std::shared_ptr<Detector> reference_first, reference_last;
+    auto tree_building = tree_building_timer_->measure();
     for(auto& detector : get_regular_detectors(!exclude_DUT_)) {
         // Get the clusters
-        auto tempClusters = clipboard->getData<Cluster>(detector->getName());
+        auto tempClusters = clipboard->getData(cluster_collections_.at(detector));
         LOG(DEBUG) << "Detector " << detector->getName() << " has " << tempClusters.size() << " clusters on the clipboard";
         if(!tempClusters.empty()) {
             // Store them
@@ -287,6 +517,8 @@ StatusCode Tracking4D::run(const std::shared_ptr<Clipboard>& clipboard) {
         }
     }
 
+    tree_building.stop();
+
     // If there are no detectors then stop trying to track
     if(trees.size() < 2) {
         // Fill histogram
@@ -296,204 +528,92 @@ StatusCode Tracking4D::run(const std::shared_ptr<Clipboard>& clipboard) {
         return StatusCode::Success;
     }
 
-    // Output track container
-    TrackVector tracks;
-
     // Time cut for combinations of reference clusters and for reference track with additional detector
-    auto time_cut_ref = std::max(time_cuts_[reference_first], time_cuts_[reference_last]);
-    auto time_cut_ref_track = std::min(time_cuts_[reference_first], time_cuts_[reference_last]);
-    for(auto& clusterFirst : trees[reference_first].getAllElements()) {
-        for(auto& clusterLast : trees[reference_last].getAllElements()) {
-            LOG(DEBUG) << "Looking at next reference cluster pair";
-
-            if(std::fabs(clusterFirst->timestamp() - clusterLast->timestamp()) > time_cut_ref) {
-                LOG(DEBUG) << "Reference clusters not within time cuts.";
-                continue;
-            }
-
-            // The track finding is based on a straight line. Therefore a refTrack to extrapolate to the next plane is used
-            StraightLineTrack refTrack;
-            refTrack.addCluster(clusterFirst.get());
-            refTrack.addCluster(clusterLast.get());
-            auto averageTimestamp = calculate_average_timestamp(&refTrack);
-            refTrack.setTimestamp(averageTimestamp);
-
-            // Make a new track
-            auto track = Track::Factory(track_model_);
-            track->addCluster(clusterFirst.get());
-            track->addCluster(clusterLast.get());
-
-            track->setTimestamp(averageTimestamp);
-            if(use_volume_scatterer_) {
-                track->setVolumeScatter(volume_radiation_length_);
-            }
-            track->setParticleMomentum(momentum_);
-
-            // Loop over each subsequent plane and look for a cluster within the timing cuts
-            size_t detector_nr = 2;
-            // Get all detectors here to also include passive layers which might contribute to scattering
-            for(auto& detector : get_detectors()) {
-                if(detector->isAuxiliary()) {
-                    continue;
-                }
-                auto detectorID = detector->getName();
-                LOG(TRACE) << "added material budget for " << detectorID << " at z = " << detector->displacement().z();
-                track->registerPlane(
-                    detectorID, detector->displacement().z(), detector->materialBudget(), detector->toLocal());
-
-                if(detector == reference_first || detector == reference_last) {
-                    continue;
-                }
-
-                if(exclude_DUT_ && detector->isDUT()) {
-                    LOG(DEBUG) << "Skipping DUT plane.";
-                    continue;
-                }
-
-                if(detector->isPassive()) {
-                    LOG(DEBUG) << "Skipping passive plane.";
-                    continue;
-                }
-
-                // Determine whether a track can still be assembled given the number of current hits and the number of
-                // detectors to come. Reduces computing time.
-                detector_nr++;
-                if(refTrack.getNClusters() + (trees.size() - detector_nr + 1) < min_hits_on_track_) {
-                    LOG(DEBUG) << "No chance to find a track - too few detectors left: " << refTrack.getNClusters() << " + "
-                               << trees.size() << " - " << detector_nr << " < " << min_hits_on_track_;
-                    continue;
-                }
-
-                if(trees.count(detector) == 0) {
-                    LOG(TRACE) << "Skipping detector " << detector->getName() << " as it has 0 clusters.";
-                    continue;
-                }
-
-                // Get all neighbors within the timing cut
-                LOG(DEBUG) << "Searching for neighboring cluster on device " << detector->getName();
-                LOG(DEBUG) << "- reference time is " << Units::display(refTrack.timestamp(), {"ns", "us", "s"});
-                Cluster* closestCluster = nullptr;
-
-                // Use spatial cut only as initial value (check if cluster is ellipse defined by cuts is done below):
-                double closestClusterDistance = sqrt(spatial_cuts_[detector].x() * spatial_cuts_[detector].x() +
-                                                     spatial_cuts_[detector].y() * spatial_cuts_[detector].y());
-
-                double timeCut = std::max(time_cut_ref_track, time_cuts_[detector]);
-                LOG(DEBUG) << "Using timing cut of " << Units::display(timeCut, {"ns", "us", "s"});
-
-                auto neighbors = trees[detector].getAllElementsInTimeWindow(refTrack.timestamp(), timeCut);
-
-                LOG(DEBUG) << "- found " << neighbors.size() << " neighbors within the correct time window";
-
-                // Now look for the spatially closest cluster on the next plane
-                refTrack.fit();
-
-                PositionVector3D<Cartesian3D<double>> interceptPoint = detector->getLocalIntercept(&refTrack);
-                double interceptX = interceptPoint.X();
-                double interceptY = interceptPoint.Y();
-
-                for(size_t ne = 0; ne < neighbors.size(); ne++) {
-                    auto newCluster = neighbors[ne].get();
-
-                    // Calculate the distance to the previous plane's cluster/intercept
-                    double distanceX = interceptX - newCluster->local().x();
-                    double distanceY = interceptY - newCluster->local().y();
-                    double distance = sqrt(distanceX * distanceX + distanceY * distanceY);
-
-                    // Check if newCluster lies within ellipse defined by spatial cuts around intercept,
-                    // following this example:
-                    // https://www.geeksforgeeks.org/check-if-a-point-is-inside-outside-or-on-the-ellipse/
-                    //
-                    // ellipse defined by: x^2/a^2 + y^2/b^2 = 1: on ellipse,
-                    //                                       > 1: outside,
-                    //                                       < 1: inside
-                    // Continue if outside of ellipse:
-
-                    double norm = (distanceX * distanceX) / (spatial_cuts_[detector].x() * spatial_cuts_[detector].x()) +
-                                  (distanceY * distanceY) / (spatial_cuts_[detector].y() * spatial_cuts_[detector].y());
-
-                    if(norm > 1) {
-                        LOG(DEBUG) << "Cluster outside the cuts. Normalized distance: " << norm;
-                        continue;
-                    }
+    auto time_cut_ref = std::max(time_cuts_.at(reference_first), time_cuts_.at(reference_last));
+    auto time_cut_ref_track = std::min(time_cuts_.at(reference_first), time_cuts_.at(reference_last));
+
+    // Sweep a time window over the time-sorted clusters of the last reference plane, such that only reference cluster pairs
+    // compatible in time are ever combined
+    auto seeding = seeding_timer_->measure();
+    auto seeds_first = trees[reference_first].getAllElementsByTime();
+    auto seeds_last = trees[reference_last].getAllElementsByTime();
+    auto window_begin = seeds_last.begin();
+    std::vector<std::pair<Cluster*, Cluster*>> seeds;
+    for(auto& clusterFirst : seeds_first) {
+        while(window_begin != seeds_last.end() && (*window_begin)->timestamp() < clusterFirst->timestamp() - time_cut_ref) {
+            ++window_begin;
+        }
 
-                    // If this is the closest keep it for now
-                    if(distance < closestClusterDistance) {
-                        closestClusterDistance = distance;
-                        closestCluster = newCluster;
-                    }
-                }
+        for(auto window_it = window_begin;
+            window_it != seeds_last.end() && (*window_it)->timestamp() <= clusterFirst->timestamp() + time_cut_ref;
+            ++window_it) {
+            const auto& clusterLast = *window_it;
+            LOG(DEBUG) << "Looking at next reference cluster pair";
 
-                if(closestCluster == nullptr) {
-                    LOG(DEBUG) << "No cluster within spatial cut";
+            // Optionally reject pairs not compatible with the expected beam direction
+            if(use_seed_spatial_cut_) {
+                auto dz = clusterLast->global().z() - clusterFirst->global().z();
+                auto deviation_x = clusterLast->global().x() - clusterFirst->global().x() - seed_slope_.x() * dz;
+                auto deviation_y = clusterLast->global().y() - clusterFirst->global().y() - seed_slope_.y() * dz;
+                if(std::fabs(deviation_x) > seed_spatial_cut_.x() || std::fabs(deviation_y) > seed_spatial_cut_.y()) {
+                    LOG(DEBUG) << "Reference clusters not within seed spatial cuts.";
                     continue;
                 }
+            }
 
-                // Add the cluster to the track
-                refTrack.addCluster(closestCluster);
-                track->addCluster(closestCluster);
-                averageTimestamp = calculate_average_timestamp(&refTrack);
-                refTrack.setTimestamp(averageTimestamp);
-                track->setTimestamp(averageTimestamp);
+            seeds.emplace_back(clusterFirst.get(), clusterLast.get());
+        }
+    }
 
-                LOG(DEBUG) << "- added cluster to track";
-            }
+    seeding.stop();
 
-            // check if track has required detector(s):
-            auto foundRequiredDetector = [this](Track* t) {
-                for(auto& requireDet : require_detectors_) {
-                    if(!requireDet.empty() && !t->hasDetector(requireDet)) {
-                        LOG(DEBUG) << "No cluster from required detector " << requireDet << " on the track.";
-                        return false;
-                    }
-                }
-                return true;
-            };
-            if(!foundRequiredDetector(track.get())) {
-                continue;
+    // Build track candidates for all seeds, either sequentially or distributed over the worker threads. The candidates are
+    // stored by seed index such that the resulting track order does not depend on the scheduling.
+    auto track_finding = track_finding_timer_->measure();
+    std::vector<std::shared_ptr<Track>> candidates(seeds.size());
+    auto find_tracks = [&](size_t begin, size_t end) {
+        for(size_t seed = begin; seed < end; seed++) {
+            candidates[seed] = find_track(
+                trees, seeds[seed].first, seeds[seed].second, reference_first, reference_last, time_cut_ref_track);
+        }
+    };
+    if(thread_pool_ != nullptr && thread_pool_->valid() && seeds.size() > 1) {
+        // Split the seeds in a few blocks per worker to balance the load with little overhead
+        auto block_size = std::max<size_t>(1, seeds.size() / (4 * workers_));
+        std::vector<std::shared_future<void>> futures;
+        size_t submitted = 0;
+        while(submitted < seeds.size()) {
+            auto end = std::min(submitted + block_size, seeds.size());
+            auto future = thread_pool_->submit(find_tracks, submitted, end);
+            if(!future.valid()) {
+                // The pool has been invalidated, no further blocks are accepted
+                break;
             }
+            futures.push_back(std::move(future));
+            submitted = end;
+        }
 
-            // Now should have a track with one cluster from each plane
-            if(track->getNClusters() < min_hits_on_track_) {
-                LOG(DEBUG) << "Not enough clusters on the track, found " << track->getNClusters() << " but "
-                           << min_hits_on_track_ << " required.";
-                continue;
-            }
+        // Wait for all blocks before rethrowing, tasks still running refer to the candidates. The first exception in
+        // submission order is the one invalidating the pool, blocks dropped from its queue fail with a broken promise.
+        for(auto& future : futures) {
+            future.wait();
+        }
+        for(auto& future : futures) {
+            future.get();
+        }
 
-            // Fit the track
-            track->fit();
+        // Find the tracks of the blocks not accepted by the pool here
+        find_tracks(submitted, seeds.size());
+    } else {
+        find_tracks(0, seeds.size());
+    }
 
-            if(reject_by_ROI_ && track->isFitted()) {
-                // check if the track is within ROI for all detectors
-                auto ds = get_regular_detectors(!exclude_DUT_);
-                auto out_of_roi =
-                    std::find_if(ds.begin(), ds.end(), [track](const auto& d) { return !d->isWithinROI(track.get()); });
-                if(out_of_roi != ds.end()) {
-                    LOG(DEBUG) << "Rejecting track outside of ROI of detector " << out_of_roi->get()->getName();
-                    continue;
-                }
-            }
-            // save the track
-            if(track->isFitted()) {
-                tracks.push_back(track);
-            } else {
-                LOG_N(WARNING, 100) << "Rejected a track due to failure in fitting";
-                continue;
-            }
+    track_finding.stop();
 
-            if(timestamp_from_.empty()) {
-                // Improve the track timestamp by taking the average of all planes
-                auto timestamp = calculate_average_timestamp(track.get());
-                track->setTimestamp(timestamp);
-                LOG(DEBUG) << "Using average cluster timestamp of " << Units::display(timestamp, "us")
-                           << " as track timestamp.";
-            } else {
-                // use timestamp of required detector:
-                double track_timestamp = track->getClusterFromDetector(timestamp_from_)->timestamp();
-                LOG(DEBUG) << "Using timestamp of detector " << timestamp_from_
-                           << " as track timestamp: " << Units::display(track_timestamp, "us");
-                track->setTimestamp(track_timestamp);
-            }
+    TrackVector tracks;
+    for(auto& candidate : candidates) {
+        if(candidate != nullptr) {
+            tracks.push_back(std::move(candidate));
         }
     }
 
@@ -514,7 +634,7 @@ StatusCode Tracking4D::run(const std::shared_ptr<Clipboard>& clipboard) {
         if(unique_cluster_usage_ && tracks.size() > 1) {
             // sort by chi2:
             LOG_ONCE(WARNING) << "Rejecting tracks with same hits";
-            std::sort(tracks.begin(), tracks.end(), [](const shared_ptr<Track> a, const shared_ptr<Track> b) {
+            std::stable_sort(tracks.begin(), tracks.end(), [](const shared_ptr<Track> a, const shared_ptr<Track> b) {
                 return (a->getChi2() / static_cast<double>(a->getNdof())) <
                        (b->getChi2() / static_cast<double>(b->getNdof()));
             });
@@ -562,44 +682,44 @@ StatusCode Tracking4D::run(const std::shared_ptr<Clipboard>& clipboard) {
             ROOT::Math::XYZPoint globalRes = track->getGlobalResidual(detectorID);
             ROOT::Math::XYPoint localRes = track->getLocalResidual(detectorID);
 
-            residualsX_local[detectorID]->Fill(localRes.X());
-            residualsX_global[detectorID]->Fill(globalRes.X());
-            residualsX_vs_positionX_global[detectorID]->Fill(globalRes.X(), trackCluster->global().x());
-            residualsX_vs_positionY_global[detectorID]->Fill(globalRes.X(), trackCluster->global().y());
+            residualsX_local.at(detectorID)->Fill(localRes.X());
+            residualsX_global.at(detectorID)->Fill(globalRes.X());
+            residualsX_vs_positionX_global.at(detectorID)->Fill(globalRes.X(), trackCluster->global().x());
+            residualsX_vs_positionY_global.at(detectorID)->Fill(globalRes.X(), trackCluster->global().y());
 
-            pullX_local[detectorID]->Fill(localRes.x() / track->getClusterFromDetector(detectorID)->errorX());
-            pullX_global[detectorID]->Fill(globalRes.x() / track->getClusterFromDetector(detectorID)->errorX());
+            pullX_local.at(detectorID)->Fill(localRes.x() / track->getClusterFromDetector(detectorID)->errorX());
+            pullX_global.at(detectorID)->Fill(globalRes.x() / track->getClusterFromDetector(detectorID)->errorX());
 
-            pullY_local[detectorID]->Fill(localRes.Y() / track->getClusterFromDetector(detectorID)->errorY());
-            pullY_global[detectorID]->Fill(globalRes.Y() / track->getClusterFromDetector(detectorID)->errorY());
+            pullY_local.at(detectorID)->Fill(localRes.Y() / track->getClusterFromDetector(detectorID)->errorY());
+            pullY_global.at(detectorID)->Fill(globalRes.Y() / track->getClusterFromDetector(detectorID)->errorY());
 
             if(trackCluster->columnWidth() == 1) {
-                residualsXwidth1_local[detectorID]->Fill(localRes.X());
-                residualsXwidth1_global[detectorID]->Fill(globalRes.X());
+                residualsXwidth1_local.at(detectorID)->Fill(localRes.X());
+                residualsXwidth1_global.at(detectorID)->Fill(globalRes.X());
             } else if(trackCluster->columnWidth() == 2) {
-                residualsXwidth2_local[detectorID]->Fill(localRes.X());
-                residualsXwidth2_global[detectorID]->Fill(globalRes.X());
+                residualsXwidth2_local.at(detectorID)->Fill(localRes.X());
+                residualsXwidth2_global.at(detectorID)->Fill(globalRes.X());
             } else if(trackCluster->columnWidth() == 3) {
-                residualsXwidth3_local[detectorID]->Fill(localRes.X());
-                residualsXwidth3_global[detectorID]->Fill(globalRes.X());
+                residualsXwidth3_local.at(detectorID)->Fill(localRes.X());
+                residualsXwidth3_global.at(detectorID)->Fill(globalRes.X());
             }
 
-            residualsY_local[detectorID]->Fill(localRes.Y());
-            residualsY_global[detectorID]->Fill(globalRes.Y());
-            residualsY_vs_positionY_global[detectorID]->Fill(globalRes.Y(), trackCluster->global().y());
-            residualsY_vs_positionX_global[detectorID]->Fill(globalRes.Y(), trackCluster->global().x());
+            residualsY_local.at(detectorID)->Fill(localRes.Y());
+            residualsY_global.at(detectorID)->Fill(globalRes.Y());
+            residualsY_vs_positionY_global.at(detectorID)->Fill(globalRes.Y(), trackCluster->global().y());
+            residualsY_vs_positionX_global.at(detectorID)->Fill(globalRes.Y(), trackCluster->global().x());
 
             if(trackCluster->rowWidth() == 1) {
-                residualsYwidth1_local[detectorID]->Fill(localRes.Y());
-                residualsYwidth1_global[detectorID]->Fill(globalRes.Y());
+                residualsYwidth1_local.at(detectorID)->Fill(localRes.Y());
+                residualsYwidth1_global.at(detectorID)->Fill(globalRes.Y());
             } else if(trackCluster->rowWidth() == 2) {
-                residualsYwidth2_local[detectorID]->Fill(localRes.Y());
-                residualsYwidth2_global[detectorID]->Fill(globalRes.Y());
+                residualsYwidth2_local.at(detectorID)->Fill(localRes.Y());
+                residualsYwidth2_global.at(detectorID)->Fill(globalRes.Y());
             } else if(trackCluster->rowWidth() == 3) {
-                residualsYwidth3_local[detectorID]->Fill(localRes.Y());
-                residualsYwidth3_global[detectorID]->Fill(globalRes.Y());
+                residualsYwidth3_local.at(detectorID)->Fill(localRes.Y());
+                residualsYwidth3_global.at(detectorID)->Fill(globalRes.Y());
             }
-            residualsZ_global[detectorID]->Fill(globalRes.Z());
+            residualsZ_global.at(detectorID)->Fill(globalRes.Z());
         }
 
         for(auto& detector : get_regular_detectors(true)) {
@@ -609,7 +729,7 @@ StatusCode Tracking4D::run(const std::shared_ptr<Clipboard>& clipboard) {
             auto row = detector->getRow(local);
             auto col = detector->getColumn(local);
             LOG(TRACE) << "Local col/row intersect of track: " << col << "\t" << row;
-            local_intersects_[det]->Fill(col, row);
+            local_intersects_.at(det)->Fill(col, row);
 
             if(!kinkX.count(det)) {
                 LOG(WARNING) << "Skipping writing kinks due to missing init of histograms for  " << det;
@@ -16,9 +16,11 @@
 #include <TH2F.h>
 #include <iostream>
 #include "core/module/Module.hpp"
+#include "core/utils/ThreadPool.hpp"
 #include "objects/Cluster.hpp"
 #include "objects/Pixel.hpp"
 #include "objects/Track.hpp"
+#include "tools/kdtree.h"
 
 namespace corryvreckan {
     /** @ingroup Modules
@@ -36,47 +38,47 @@ namespace corryvreckan {
 
     private:
         // Histograms
-        TH1F* trackChi2;
-        TH1F* clustersPerTrack;
-        TH1F* trackChi2ndof;
-        TH1F* trackTime;
-        TH1F* trackTimeTrigger;
-        TH2F* trackTimeTriggerChi2;
-        TH1F* tracksPerEvent;
-        TH1F* trackAngleX;
-        TH1F* trackAngleY;
-        TH1F* tracksVsTime;
-        std::map<std::string, TH1F*> residualsX_local;
-        std::map<std::string, TH1F*> residualsXwidth1_local;
-        std::map<std::string, TH1F*> residualsXwidth2_local;
-        std::map<std::string, TH1F*> residualsXwidth3_local;
-        std::map<std::string, TH1F*> pullY_local;
-        std::map<std::string, TH1F*> residualsY_local;
-        std::map<std::string, TH1F*> residualsYwidth1_local;
-        std::map<std::string, TH1F*> residualsYwidth2_local;
-        std::map<std::string, TH1F*> residualsYwidth3_local;
-        std::map<std::string, TH1F*> pullX_local;
+        Histogram<TH1F> trackChi2;
+        Histogram<TH1F> clustersPerTrack;
+        Histogram<TH1F> trackChi2ndof;
+        Histogram<TH1F> trackTime;
+        Histogram<TH1F> trackTimeTrigger;
+        Histogram<TH2F> trackTimeTriggerChi2;
+        Histogram<TH1F> tracksPerEvent;
+        Histogram<TH1F> trackAngleX;
+        Histogram<TH1F> trackAngleY;
+        Histogram<TH1F> tracksVsTime;
+        std::map<std::string, Histogram<TH1F>> residualsX_local;
+        std::map<std::string, Histogram<TH1F>> residualsXwidth1_local;
+        std::map<std::string, Histogram<TH1F>> residualsXwidth2_local;
+        std::map<std::string, Histogram<TH1F>> residualsXwidth3_local;
+        std::map<std::string, Histogram<TH1F>> pullY_local;
+        std::map<std::string, Histogram<TH1F>> residualsY_local;
+        std::map<std::string, Histogram<TH1F>> residualsYwidth1_local;
+        std::map<std::string, Histogram<TH1F>> residualsYwidth2_local;
+        std::map<std::string, Histogram<TH1F>> residualsYwidth3_local;
+        std::map<std::string, Histogram<TH1F>> pullX_local;
 
-        std::map<std::string, TH1F*> residualsX_global;
-        std::map<std::string, TH2F*> residualsX_vs_positionX_global;
-        std::map<std::string, TH2F*> residualsX_vs_positionY_global;
-        std::map<std::string, TH1F*> residualsXwidth1_global;
-        std::map<std::string, TH1F*> residualsXwidth2_global;
-        std::map<std::string, TH1F*> residualsXwidth3_global;
-        std::map<std::string, TH1F*> pullX_global;
-        std::map<std::string, TH1F*> residualsY_global;
-        std::map<std::string, TH2F*> residualsY_vs_positionY_global;
-        std::map<std::string, TH2F*> residualsY_vs_positionX_global;
-        std::map<std::string, TH1F*> residualsYwidth1_global;
-        std::map<std::string, TH1F*> residualsYwidth2_global;
-        std::map<std::string, TH1F*> residualsYwidth3_global;
-        std::map<std::string, TH1F*> pullY_global;
-        std::map<std::string, TH1F*> residualsZ_global;
+        std::map<std::string, Histogram<TH1F>> residualsX_global;
+        std::map<std::string, Histogram<TH2F>> residualsX_vs_positionX_global;
+        std::map<std::string, Histogram<TH2F>> residualsX_vs_positionY_global;
+        std::map<std::string, Histogram<TH1F>> residualsXwidth1_global;
+        std::map<std::string, Histogram<TH1F>> residualsXwidth2_global;
+        std::map<std::string, Histogram<TH1F>> residualsXwidth3_global;
+        std::map<std::string, Histogram<TH1F>> pullX_global;
+        std::map<std::string, Histogram<TH1F>> residualsY_global;
+        std::map<std::string, Histogram<TH2F>> residualsY_vs_positionY_global;
+        std::map<std::string, Histogram<TH2F>> residualsY_vs_positionX_global;
+        std::map<std::string, Histogram<TH1F>> residualsYwidth1_global;
+        std::map<std::string, Histogram<TH1F>> residualsYwidth2_global;
+        std::map<std::string, Histogram<TH1F>> residualsYwidth3_global;
+        std::map<std::string, Histogram<TH1F>> pullY_global;
+        std::map<std::string, Histogram<TH1F>> residualsZ_global;
 
-        std::map<std::string, TH1F*> kinkX;
-        std::map<std::string, TH1F*> kinkY;
+        std::map<std::string, Histogram<TH1F>> kinkX;
+        std::map<std::string, Histogram<TH1F>> kinkY;
 
-        std::map<std::string, TH2F*> local_intersects_;
+        std::map<std::string, Histogram<TH2F>> local_intersects_;
 
         // Cuts for tracking
         double momentum_;
@@ -91,11 +93,43 @@ namespace corryvreckan {
         std::vector<std::string> exclude_from_seed_;
         std::map<std::shared_ptr<Detector>, double> time_cuts_;
         std::map<std::shared_ptr<Detector>, XYVector> spatial_cuts_;
+        bool use_seed_spatial_cut_;
+        XYVector seed_spatial_cut_;
+        XYVector seed_slope_;
         std::string timestamp_from_;
         std::string track_model_;
 
         // Function to calculate the weighted average timestamp from the clusters of a track
         double calculate_average_timestamp(const Track* track);
+
+        /**
+         * @brief Build a track from a pair of reference clusters by adding the closest clusters on all other planes
+         * @param trees Clusters of all detectors with hits in this event
+         * @param clusterFirst Cluster on the first reference plane
+         * @param clusterLast Cluster on the last reference plane
+         * @param reference_first First reference detector
+         * @param reference_last Last reference detector
+         * @param time_cut_ref_track Time cut between the reference track and clusters on other planes
+         * @return Fitted track or nullptr if no track passing all selection criteria could be built
+         */
+        std::shared_ptr<Track> find_track(const std::map<std::shared_ptr<Detector>, KDTree<Cluster>>& trees,
+                                          Cluster* clusterFirst,
+                                          Cluster* clusterLast,
+                                          const std::shared_ptr<Detector>& reference_first,
+                                          const std::shared_ptr<Detector>& reference_last,
+                                          double time_cut_ref_track);
+
+        // Parallel track finding within a single event
+        unsigned int workers_;
+        std::unique_ptr<ThreadPool> thread_pool_;
+
+        // Clipboard collections of the clusters of all tracking detectors
+        std::map<std::shared_ptr<Detector>, CollectionHandle<Cluster>> cluster_collections_;
+
+        // Execution time of the stages of the track finding
+        std::shared_ptr<StageTimer> tree_building_timer_;
+        std::shared_ptr<StageTimer> seeding_timer_;
+        std::shared_ptr<StageTimer> track_finding_timer_;
     };
 } // namespace corryvreckan
 #endif // TRACKING4D_H
@@ -319,21 +319,18 @@ TrackVector TrackingMultiplet::find_multiplet_tracklets(const streams& stream,
 
                 double timeCut = std::max(time_cut_ref_track, time_cuts_[detector]);
                 LOG(DEBUG) << "Using timing cut of " << Units::display(timeCut, {"ns", "us", "s"});
-                auto neighbours = detector_tree.second.getAllElementsInTimeWindow(trackletCandidate->timestamp(), timeCut);
-
-                if(neighbours.empty()) {
+                auto& tree = detector_tree.second;
+                if(tree.getAllElementsInTimeWindow(trackletCandidate->timestamp(), timeCut).empty()) {
                     LOG(DEBUG) << "No neighbours found within the correct time window.";
                     continue;
                 }
 
-                LOG(DEBUG) << "- found " << neighbours.size() << " neighbours within the correct time window";
-
                 // Now let's see if there's a cluster matching in time and space.
                 Cluster* closestCluster = nullptr;
 
                 // Use spatial cut only as initial value (check if cluster is ellipse defined by cuts is done below):
-                double closestClusterDistance = sqrt(spatial_cuts_[detector].x() * spatial_cuts_[detector].x() +
-                                                     spatial_cuts_[detector].y() * spatial_cuts_[detector].y());
+                const auto& spatial_cut = spatial_cuts_[detector];
+                double closestClusterDistance = sqrt(spatial_cut.x() * spatial_cut.x() + spatial_cut.y() * spatial_cut.y());
 
                 // Now look for the spatially closest cluster on the next plane
                 trackletCandidate->fit();
@@ -343,37 +340,45 @@ TrackVector TrackingMultiplet::find_multiplet_tracklets(const streams& stream,
                 interceptX = interceptPoint.X();
                 interceptY = interceptPoint.Y();
 
-                for(size_t ne = 0; ne < neighbours.size(); ne++) {
-                    Cluster* newCluster = neighbours[ne].get();
-
-                    // Calculate the distance to the previous plane's cluster/intercept
-                    double distanceX = interceptX - newCluster->global().x();
-                    double distanceY = interceptY - newCluster->global().y();
-                    double distance = sqrt(distanceX * distanceX + distanceY * distanceY);
-
-                    // Check if newCluster lies within ellipse defined by spatial cuts around intercept,
-                    // following this example:
-                    // https://www.geeksforgeeks.org/check-if-a-point-is-inside-outside-or-on-the-ellipse/
-                    //
-                    // ellipse defined by: x^2/a^2 + y^2/b^2 = 1: on ellipse,
-                    //                                       > 1: outside,
-                    //                                       < 1: inside
-                    // Continue if outside of ellipse:
-
-                    double norm = (distanceX * distanceX) / (spatial_cuts_[detector].x() * spatial_cuts_[detector].x()) +
-                                  (distanceY * distanceY) / (spatial_cuts_[detector].y() * spatial_cuts_[detector].y());
-
-                    if(norm > 1) {
-                        LOG(DEBUG) << "Cluster outside the cuts. Normalized distance: " << norm;
-                        continue;
-                    }
-
-                    // If this is the closest keep it for now
-                    if(distance < closestClusterDistance) {
-                        closestClusterDistance = distance;
-                        closestCluster = newCluster;
-                    }
-                }
+                // Only clusters within the time window and the rectangle enclosing the spatial cut ellipse are considered
+                tree.forEachElementInWindow(
+                    trackletCandidate->timestamp(),
+                    timeCut,
+                    interceptX,
+                    interceptY,
+                    spatial_cut.x(),
+                    spatial_cut.y(),
+                    [&](const std::shared_ptr<Cluster>& neighbour) {
+                        Cluster* newCluster = neighbour.get();
+
+                        // Calculate the distance to the previous plane's cluster/intercept
+                        double distanceX = interceptX - newCluster->global().x();
+                        double distanceY = interceptY - newCluster->global().y();
+                        double distance = sqrt(distanceX * distanceX + distanceY * distanceY);
+
+                        // Check if newCluster lies within ellipse defined by spatial cuts around intercept,
+                        // following this example:
+                        // https://www.geeksforgeeks.org/check-if-a-point-is-inside-outside-or-on-the-ellipse/
+                        //
+                        // ellipse defined by: x^2/a^2 + y^2/b^2 = 1: on ellipse,
+                        //                                       > 1: outside,
+                        //                                       < 1: inside
+                        // Continue if outside of ellipse:
+
+                        double norm = (distanceX * distanceX) / (spatial_cut.x() * spatial_cut.x()) +
+                                      (distanceY * distanceY) / (spatial_cut.y() * spatial_cut.y());
+
+                        if(norm > 1) {
+                            LOG(DEBUG) << "Cluster outside the cuts. Normalized distance: " << norm;
+                            return;
+                        }
+
+                        // If this is the closest keep it for now
+                        if(distance < closestClusterDistance) {
+                            closestClusterDistance = distance;
+                            closestCluster = newCluster;
+                        }
+                    });
 
                 if(closestCluster == nullptr) {
                     LOG(DEBUG) << "No cluster within spatial cut";
@@ -10,8 +10,11 @@
 
 #include "TreeWriterDUT.h"
 
+#include <utility>
 #include <vector>
 
+#include <TROOT.h>
+
 using namespace corryvreckan;
 using namespace std;
 
@@ -20,9 +23,13 @@ TreeWriterDUT::TreeWriterDUT(Configuration& config, std::shared_ptr<Detector> de
 
     config_.setDefault<std::string>("file_name", "outputTuples.root");
     config_.setDefault<std::string>("tree_name", "tree");
+    config_.setDefault<int>("write_queue_depth", 0);
 
     m_fileName = config_.get<std::string>("file_name");
     m_treeName = config_.get<std::string>("tree_name");
+
+    // The output file is written by a single process
+    disallow_partitions();
 }
 
 /*
@@ -58,32 +65,45 @@ void TreeWriterDUT::initialize() {
     filledEvents = 0;
 
     // Create the output branches
-    m_outputTree->Branch("EventID", &v_clusterEventID);
-    m_outputTree->Branch("clusterSizeX", &v_clusterSizeX);
-    m_outputTree->Branch("clusterSizeY", &v_clusterSizeY);
-    m_outputTree->Branch("pixelX", &v_pixelX);
-    m_outputTree->Branch("pixelY", &v_pixelY);
-    m_outputTree->Branch("pixelToT", &v_pixelToT);
-    m_outputTree->Branch("pixelToA", &v_pixelToA);
-    m_outputTree->Branch("clusterNumPixels", &v_clusterNumPixels);
+    m_outputTree->Branch("EventID", &m_entry.v_clusterEventID);
+    m_outputTree->Branch("clusterSizeX", &m_entry.v_clusterSizeX);
+    m_outputTree->Branch("clusterSizeY", &m_entry.v_clusterSizeY);
+    m_outputTree->Branch("pixelX", &m_entry.v_pixelX);
+    m_outputTree->Branch("pixelY", &m_entry.v_pixelY);
+    m_outputTree->Branch("pixelToT", &m_entry.v_pixelToT);
+    m_outputTree->Branch("pixelToA", &m_entry.v_pixelToA);
+    m_outputTree->Branch("clusterNumPixels", &m_entry.v_clusterNumPixels);
     // Branch for track intercepts
-    m_outputTree->Branch("intercepts", &v_intercepts);
+    m_outputTree->Branch("intercepts", &m_entry.v_intercepts);
+
+    // Start the writer thread filling the tree concurrently to the processing of the next events
+    auto write_queue_depth = config_.get<int>("write_queue_depth");
+    if(write_queue_depth < 0) {
+        throw InvalidValueError(config_, "write_queue_depth", "queue depth cannot be negative");
+    } else if(write_queue_depth > 0) {
+        ROOT::EnableThreadSafety();
+        m_writer = std::make_unique<WriterThread>(static_cast<size_t>(write_queue_depth));
+    }
 }
 
 StatusCode TreeWriterDUT::run(const std::shared_ptr<Clipboard>& clipboard) {
     // Counter for cluster event ID
     eventID++;
 
+    // With the writer thread, the information is collected into a separate entry handed over to the thread
+    auto entry = (m_writer != nullptr ? std::make_shared<TreeEntry>() : nullptr);
+    auto& data = (entry != nullptr ? *entry : m_entry);
+
     // Clear data vectors before storing the cluster information for this event
-    v_intercepts.clear();
-    v_clusterSizeX.clear();
-    v_clusterSizeY.clear();
-    v_clusterEventID.clear();
-    v_pixelX.clear();
-    v_pixelY.clear();
-    v_pixelToT.clear();
-    v_pixelToA.clear();
-    v_clusterNumPixels.clear();
+    data.v_intercepts.clear();
+    data.v_clusterSizeX.clear();
+    data.v_clusterSizeY.clear();
+    data.v_clusterEventID.clear();
+    data.v_pixelX.clear();
+    data.v_pixelY.clear();
+    data.v_pixelToT.clear();
+    data.v_pixelToA.clear();
+    data.v_clusterNumPixels.clear();
 
     // Getting tracks from the clipboard
     auto tracks = clipboard->getData<Track>();
@@ -113,20 +133,20 @@ StatusCode TreeWriterDUT::run(const std::shared_ptr<Clipboard>& clipboard) {
 
         // Calculate the intercept in local coordinates
         trackInterceptLocal = m_detector->globalToLocal(trackIntercept);
-        v_intercepts.push_back(trackInterceptLocal);
+        data.v_intercepts.push_back(trackInterceptLocal);
 
         Cluster* cluster = associatedClusters.front();
 
         // x size
         LOG(DEBUG) << "Gets column width = " << cluster->columnWidth();
-        v_clusterSizeX.push_back(static_cast<double>(cluster->columnWidth()));
+        data.v_clusterSizeX.push_back(static_cast<double>(cluster->columnWidth()));
 
         // y size
         LOG(DEBUG) << "Gets row width = " << cluster->rowWidth();
-        v_clusterSizeY.push_back(static_cast<double>(cluster->rowWidth()));
+        data.v_clusterSizeY.push_back(static_cast<double>(cluster->rowWidth()));
 
         // eventID
-        v_clusterEventID.push_back(eventID);
+        data.v_clusterEventID.push_back(eventID);
         LOG(DEBUG) << "Gets cluster eventID = " << eventID;
 
         // Get the pixels in the current cluster
@@ -140,24 +160,24 @@ StatusCode TreeWriterDUT::run(const std::shared_ptr<Clipboard>& clipboard) {
 
             // x position
             LOG(DEBUG) << "Gets pixel column = " << pixel->column();
-            v_pixelX.push_back(pixel->column());
+            data.v_pixelX.push_back(pixel->column());
 
             // y position
             LOG(DEBUG) << "Gets pixel row = " << pixel->row();
-            v_pixelY.push_back(pixel->row());
+            data.v_pixelY.push_back(pixel->row());
 
             // ToT
             LOG(DEBUG) << "Gets pixel raw value = " << pixel->raw();
-            v_pixelToT.push_back(pixel->raw());
+            data.v_pixelToT.push_back(pixel->raw());
 
             // ToA
             LOG(DEBUG) << "Gets pixel timestamp = " << pixel->timestamp();
-            v_pixelToA.push_back(pixel->timestamp());
+            data.v_pixelToA.push_back(pixel->timestamp());
         }
-        v_clusterNumPixels.push_back(numPixels);
+        data.v_clusterNumPixels.push_back(numPixels);
     }
 
-    if(v_intercepts.empty()) {
+    if(data.v_intercepts.empty()) {
         return StatusCode::NoData;
     }
 
@@ -166,7 +186,14 @@ StatusCode TreeWriterDUT::run(const std::shared_ptr<Clipboard>& clipboard) {
         LOG(DEBUG) << "Events with single associated cluster: " << filledEvents;
     }
     // Fill the tree with the information for this event
-    m_outputTree->Fill();
+    if(m_writer != nullptr) {
+        m_writer->submit([this, entry]() {
+            std::swap(m_entry, *entry);
+            m_outputTree->Fill();
+        });
+    } else {
+        m_outputTree->Fill();
+    }
 
     // Return value telling analysis to keep running
     return StatusCode::Success;
@@ -174,6 +201,22 @@ StatusCode TreeWriterDUT::run(const std::shared_ptr<Clipboard>& clipboard) {
 
 void TreeWriterDUT::finalize(const std::shared_ptr<ReadonlyClipboard>&) {
     LOG(DEBUG) << "Finalise";
+
+    // Wait for the writer thread to fill all queued entries
+    if(m_writer != nullptr) {
+        m_writer->finish();
+        LOG(INFO) << "Writer thread queued at most " << m_writer->getMaxQueueDepth() << " entries, "
+                  << m_writer->getMeanQueueDepth() << " on average" << std::endl
+                  << "Processing waited " << m_writer->getStallCount() << " times for the writer thread, in total "
+                  << m_writer->getStallTime() << "s";
+    }
+
+    // Every event counted has to be filled into the tree, also when filled by the writer thread
+    if(m_outputTree->GetEntries() != filledEvents) {
+        LOG(WARNING) << "Tree contains " << m_outputTree->GetEntries() << " entries, but " << filledEvents
+                     << " events have been filled";
+    }
+
     auto directory = m_outputFile->mkdir("Directory");
     directory->cd();
     LOG(STATUS) << filledEvents << " events written to file " << m_fileName;
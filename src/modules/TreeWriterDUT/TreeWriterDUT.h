@@ -16,8 +16,10 @@
 #include <TFile.h>
 #include <TTree.h>
 #include <iostream>
+#include <memory>
 
 #include "core/module/Module.hpp"
+#include "core/utils/WriterThread.hpp"
 #include "objects/Track.hpp"
 
 namespace corryvreckan {
@@ -28,7 +30,7 @@ namespace corryvreckan {
     public:
         // Constructors and destructors
         TreeWriterDUT(Configuration& config, std::shared_ptr<Detector> detector);
-        ~TreeWriterDUT() {}
+        ~TreeWriterDUT() { m_writer.reset(); }
 
         // Functions
         void initialize() override;
@@ -45,16 +47,22 @@ namespace corryvreckan {
         PositionVector3D<Cartesian3D<double>> trackIntercept;
         PositionVector3D<Cartesian3D<double>> trackInterceptLocal;
 
-        std::vector<int> v_clusterEventID;
-        std::vector<int> v_pixelX;
-        std::vector<int> v_pixelY;
-        std::vector<int> v_pixelToT;
-        std::vector<int> v_clusterNumPixels;
-        std::vector<double> v_pixelToA;
-        std::vector<double> v_clusterSizeX;
-        std::vector<double> v_clusterSizeY;
+        // Content of one tree entry
+        struct TreeEntry {
+            std::vector<int> v_clusterEventID;
+            std::vector<int> v_pixelX;
+            std::vector<int> v_pixelY;
+            std::vector<int> v_pixelToT;
+            std::vector<int> v_clusterNumPixels;
+            std::vector<double> v_pixelToA;
+            std::vector<double> v_clusterSizeX;
+            std::vector<double> v_clusterSizeY;
+            std::vector<PositionVector3D<Cartesian3D<double>>> v_intercepts;
+        };
+
+        // Entry bound to the tree branches
+        TreeEntry m_entry;
         std::vector<std::string> m_objectList;
-        std::vector<PositionVector3D<Cartesian3D<double>>> v_intercepts;
 
         std::map<std::string, Object*> m_objects;
 
@@ -64,6 +72,9 @@ namespace corryvreckan {
         // Config parameters
         std::string m_fileName;
         std::string m_treeName;
+
+        // Thread filling the tree in the background, if enabled
+        std::unique_ptr<WriterThread> m_writer;
     };
 } // namespace corryvreckan
 #endif // TreeWriterDUT_H
@@ -9,6 +9,9 @@
  * Intergovernmental Organization or submit itself to any jurisdiction.
  */
 
+#include <array>
+#include <list>
+
 #include <GblPoint.h>
 #include <GblTrajectory.h>
 #include <Math/Point3D.h>
@@ -35,6 +38,64 @@ Eigen::Matrix<double, 6, 5> GblTrack::toProt =(Eigen::Matrix<double, 6, 5>() <<
                                                                                 1., 0., 0., 0., 0.).finished();
 // clang-format on
 
+namespace corryvreckan {
+    struct GblPlaneGeometry {
+        // Identification of the plane the geometry has been calculated for
+        std::string name;
+        double material_budget{};
+        std::array<double, 12> components{};
+
+        Transform3D to_local;
+        Transform3D to_global;
+        Eigen::Matrix4d rotation;
+        Eigen::Vector4d local_tangent;
+
+        // GBL jacobians from the previous plane, given as constant and part proportional to the distance travelled
+        Eigen::Matrix<double, 5, 5> jacobian_constant;
+        Eigen::Matrix<double, 5, 5> jacobian_distance;
+        Eigen::Matrix<double, 5, 5> volume_constant;
+        Eigen::Matrix<double, 5, 5> volume_distance;
+
+        // Shape of the scatterer precision matrix and squared local slope of the reference track
+        Eigen::Matrix2d scatter_shape;
+        double slope2{};
+    };
+} // namespace corryvreckan
+
+namespace {
+    // extract the rotation from an ROOT::Math::Transfrom3D, store it  in 4x4 matrix to match proteus format
+    Eigen::Matrix4d get_rotation(const Transform3D& in) {
+        Eigen::Matrix4d t = Eigen::Matrix4d::Zero();
+        in.Rotation().GetRotationMatrix(t);
+        return t;
+    }
+
+    // Jacobian from one scatter to the next
+    Eigen::Matrix<double, 6, 6> jac(const Eigen::Vector4d& tangent, const Eigen::Matrix4d& target, double distance) {
+        Eigen::Matrix<double, 4, 3> R;
+        R.col(0) = target.col(0);
+        R.col(1) = target.col(1);
+        R.col(2) = target.col(3);
+        auto S = target * tangent * (1 / tangent[2]);
+
+        Eigen::Matrix<double, 3, 4> F = Eigen::Matrix<double, 3, 4>::Zero();
+        F(0, 0) = 1;
+        F(1, 1) = 1;
+        F(2, 3) = 1;
+        F(0, 2) = -S[0] / S[2];
+        F(1, 2) = -S[1] / S[2];
+        F(2, 2) = -S[3] / S[2];
+        Eigen::Matrix<double, 6, 6> jaco;
+
+        jaco << F * R, (-distance / S[2]) * F * R, Eigen::Matrix3d::Zero(), (1 / S[2]) * F * R;
+        jaco(5, 5) = 1; // a future time component
+        return jaco;
+    }
+
+    // Maximum number of plane configurations kept in the geometry cache of each thread
+    constexpr size_t geometry_cache_size = 8;
+} // namespace
+
 ROOT::Math::XYPoint GblTrack::getKinkAt(const std::string& detectorID) const {
     if(kink_.count(detectorID) == 1) {
         return kink_.at(detectorID);
@@ -48,62 +109,98 @@ void GblTrack::setVolumeScatter(double length) {
     use_volume_scatter_ = true;
 }
 
-void GblTrack::add_plane(std::vector<Plane>::iterator& plane,
-                         Transform3D& prevToGlobal,
-                         Transform3D& prevToLocal,
-                         ROOT::Math::XYZPoint& globalTrackPos,
-                         double total_material) {
-    // lambda to add plane (not the first one) and air scatterers
-    auto globalTangent = Eigen::Vector4d(0, 0, 1, 0);
+const std::vector<GblPlaneGeometry>& GblTrack::get_geometry() const {
+    // The geometry only changes with the alignment, keep the most recently used configurations first
+    static thread_local std::list<std::vector<GblPlaneGeometry>> cache;
 
-    // extract the rotation from an ROOT::Math::Transfrom3D, store it  in 4x4 matrix to match proteus format
-    auto getRotation = [](Transform3D in) {
-        Eigen::Matrix4d t = Eigen::Matrix4d::Zero();
-        in.Rotation().GetRotationMatrix(t);
-        return t;
+    std::vector<std::array<double, 12>> components(planes_.size());
+    for(size_t i = 0; i < planes_.size(); i++) {
+        planes_[i].getToLocal().GetComponents(components[i].begin());
+    }
+    auto matches = [&](const std::vector<GblPlaneGeometry>& geometry) {
+        if(geometry.size() != planes_.size()) {
+            return false;
+        }
+        for(size_t i = 0; i < planes_.size(); i++) {
+            if(geometry[i].name != planes_[i].getName() ||
+               geometry[i].material_budget != planes_[i].getMaterialBudget() ||
+               geometry[i].components != components[i]) {
+                return false;
+            }
+        }
+        return true;
     };
 
+    auto it = std::find_if(cache.begin(), cache.end(), matches);
+    if(it != cache.end()) {
+        cache.splice(cache.begin(), cache, it);
+        return cache.front();
+    }
+
+    LOG(DEBUG) << "Calculating GBL trajectory geometry for " << planes_.size() << " planes";
+    auto globalTangent = Eigen::Vector4d(0, 0, 1, 0);
+    std::vector<GblPlaneGeometry> geometry(planes_.size());
+    for(size_t i = 0; i < planes_.size(); i++) {
+        auto& geo = geometry[i];
+        geo.name = planes_[i].getName();
+        geo.material_budget = planes_[i].getMaterialBudget();
+        geo.components = components[i];
+        geo.to_local = planes_[i].getToLocal();
+        geo.to_global = geo.to_local.Inverse();
+        geo.rotation = get_rotation(geo.to_local);
+
+        Eigen::Vector4d localTangent = geo.rotation * globalTangent;
+        LOG(TRACE) << "Local tan before normalization: " << localTangent;
+        localTangent /= localTangent.z();
+
+        // This can only happen if someone messes up the tracking code. Simply renormalizing would shadow the mistake made at
+        // a different position and therefore the used plane distances would be wrong.
+        if(localTangent(2) != 1) {
+            throw TrackError(typeid(GblTrack),
+                             "wrong normalization of local slope, should be 1 but is " + std::to_string(localTangent(2)));
+        }
+        geo.local_tangent = localTangent;
+
+        // The jacobians are linear in the distance to the previous plane, the first plane refers to itself
+        const auto& prev = geometry[i == 0 ? 0 : i - 1];
+        Eigen::Vector4d prevTan = get_rotation(prev.to_local) * globalTangent;
+        Eigen::Matrix4d toTarget = geo.rotation * get_rotation(prev.to_global);
+        geo.jacobian_constant = toGbl * jac(prevTan, toTarget, 0) * toProt;
+        geo.jacobian_distance = toGbl * jac(prevTan, toTarget, 1) * toProt - geo.jacobian_constant;
+        geo.volume_constant = toGbl * jac(prevTan, Eigen::Matrix4d::Identity(), 0) * toProt;
+        geo.volume_distance = toGbl * jac(prevTan, Eigen::Matrix4d::Identity(), 1) * toProt - geo.volume_constant;
+
+        Eigen::Vector2d localSlope(localTangent(0), localTangent(1));
+        geo.slope2 = localSlope.squaredNorm();
+        geo.scatter_shape(0, 0) = 1 + localSlope(1) * localSlope(1);
+        geo.scatter_shape(1, 1) = 1 + localSlope(0) * localSlope(0);
+        geo.scatter_shape(0, 1) = geo.scatter_shape(1, 0) = -(localSlope(0) * localSlope(1));
+    }
+
+    cache.push_front(std::move(geometry));
+    if(cache.size() > geometry_cache_size) {
+        cache.pop_back();
+    }
+    return cache.front();
+}
+
+void GblTrack::add_plane(std::vector<Plane>::iterator& plane,
+                         const GblPlaneGeometry& geometry,
+                         ROOT::Math::XYZPoint& globalTrackPos,
+                         double total_material) {
     // Mapping of parameters in proteus - I would like to get rid of these conversions once it works
     // For now they will stay here as changing this will cause the jacobian setup to be more messy right now
-    auto tmp_local = plane->getToLocal() * globalTrackPos;
+    auto tmp_local = geometry.to_local * globalTrackPos;
     auto localPosTrack = Eigen::Vector4d{tmp_local.x(), tmp_local.y(), tmp_local.z(), 1};
-    Eigen::Vector4d localTangent = getRotation(plane->getToLocal()) * globalTangent;
+    const auto& localTangent = geometry.local_tangent;
     double dist = localPosTrack[2];
-    LOG(TRACE) << "Rotation: " << getRotation(plane->getToLocal());
-    LOG(TRACE) << "Local tan before normalization: " << localTangent;
+    LOG(TRACE) << "Rotation: " << geometry.rotation;
     LOG(TRACE) << "Distance: " << dist;
 
-    localTangent /= localTangent.z();
     localPosTrack -= dist * localTangent;
     // add the local track pos for future reference - e.g. dut position:
     local_track_points_[plane->getName()] = ROOT::Math::XYPoint(localPosTrack(0), localPosTrack(1));
 
-    Eigen::Vector4d prevTan = getRotation(prevToLocal) * globalTangent;
-    Eigen::Matrix4d toTarget = getRotation(plane->getToLocal()) * getRotation(prevToGlobal);
-
-    // lambda Jacobian from one scatter to the next
-    auto jac = [](const Eigen::Vector4d& tangent, const Eigen::Matrix4d& target, double distance) {
-        Eigen::Matrix<double, 4, 3> R;
-        R.col(0) = target.col(0);
-        R.col(1) = target.col(1);
-        R.col(2) = target.col(3);
-        auto S = target * tangent * (1 / tangent[2]);
-
-        Eigen::Matrix<double, 3, 4> F = Eigen::Matrix<double, 3, 4>::Zero();
-        F(0, 0) = 1;
-        F(1, 1) = 1;
-        F(2, 3) = 1;
-        F(0, 2) = -S[0] / S[2];
-        F(1, 2) = -S[1] / S[2];
-        F(2, 2) = -S[3] / S[2];
-        Jacobian jaco;
-
-        jaco << F * R, (-distance / S[2]) * F * R, Eigen::Matrix3d::Zero(), (1 / S[2]) * F * R;
-        jaco(5, 5) = 1; // a future time component
-        return jaco;
-    };
-    auto myjac = jac(prevTan, toTarget, dist);
-
     // Layout if volume scattering active
     // |        |        |       |
     // |  frac1 | frac2  | frac1 |
@@ -111,50 +208,37 @@ void GblTrack::add_plane(std::vector<Plane>::iterator& plane,
     double frac1 = 0.21, frac2 = 0.58;
 
     // lambda to add a scatterer to a GBLPoint
-    auto addScattertoGblPoint = [this, &total_material, &localTangent](GblPoint& point, double material) {
-        Eigen::Matrix<double, 2, 2> scatter;
-
+    auto addScattertoGblPoint = [this, &total_material, &geometry](GblPoint& point, double material) {
         // lambda to calculate the scattering theta, beta2 assumed to be one and the momentum in MeV
         auto scatteringTheta = [this](double mbCurrent, double mbTotal) -> double {
             return (13.6 / momentum_ * sqrt(mbCurrent) * (1 + 0.038 * log(mbTotal)));
         };
 
-        // This can only happen if someone messes up the tracking code. Simply renormalizing would shadow the mistake made at
-        // a different position and therefore the used plane distances would be wrong.
-        if(localTangent(2) != 1) {
-            throw TrackError(typeid(GblTrack),
-                             "wrong normalization of local slope, should be 1 but is " + std::to_string(localTangent(2)));
-        }
-        Eigen::Vector2d localSlope(localTangent(0), localTangent(1));
-        auto scale =
-            1 / scatteringTheta(material * (1 + localSlope.squaredNorm()), total_material) / (1 + localSlope.squaredNorm());
-        scatter(0, 0) = 1 + localSlope(1) * localSlope(1);
-        scatter(1, 1) = 1 + localSlope(0) * localSlope(0);
-        scatter(0, 1) = scatter(1, 0) = -(localSlope(0) * localSlope(1));
-        scatter *= (scale * scale);
-        point.addScatterer(Eigen::Vector2d::Zero(), scatter);
+        auto scale = 1 / scatteringTheta(material * (1 + geometry.slope2), total_material) / (1 + geometry.slope2);
+        point.addScatterer(Eigen::Vector2d::Zero(), Eigen::Matrix2d(geometry.scatter_shape * (scale * scale)));
     };
 
+    Eigen::Matrix<double, 5, 5> transformedJac;
     // special treatment of first point on trajectory
     if(gblpoints_.empty()) {
-        myjac = Jacobian::Identity();
-        myjac(0, 0) = 1;
+        transformedJac = toGbl * Jacobian::Identity() * toProt;
         // Adding volume scattering if requested
     } else if(use_volume_scatter_) {
-        myjac = jac(prevTan, toTarget, frac1 * dist);
-        GblPoint pVolume(toGbl * myjac * toProt);
+        transformedJac = geometry.jacobian_constant + frac1 * dist * geometry.jacobian_distance;
+        GblPoint pVolume(transformedJac);
         addScattertoGblPoint(pVolume, fabs(dist) / 2. / scattering_length_volume_);
         gblpoints_.push_back(pVolume);
         // We have already rotated to the next local coordinate system
-        myjac = jac(prevTan, Eigen::Matrix4d::Identity(), frac2 * dist);
-        GblPoint pVolume2(toGbl * myjac * toProt);
+        transformedJac = geometry.volume_constant + frac2 * dist * geometry.volume_distance;
+        GblPoint pVolume2(transformedJac);
         addScattertoGblPoint(pVolume2, fabs(dist) / 2. / scattering_length_volume_);
         gblpoints_.push_back(pVolume2);
-        myjac = jac(prevTan, Eigen::Matrix4d::Identity(), frac1 * dist);
+        transformedJac = geometry.volume_constant + frac1 * dist * geometry.volume_distance;
+    } else {
+        transformedJac = geometry.jacobian_constant + dist * geometry.jacobian_distance;
     }
-    auto transformedJac = toGbl * myjac * toProt;
     GblPoint point(transformedJac);
-    addScattertoGblPoint(point, plane->getMaterialBudget());
+    addScattertoGblPoint(point, geometry.material_budget);
 
     auto addMeasurementtoGblPoint = [&localTangent, &localPosTrack, &globalTrackPos, this](GblPoint& pt,
                                                                                            std::vector<Plane>::iterator& p) {
@@ -185,12 +269,10 @@ void GblTrack::add_plane(std::vector<Plane>::iterator& plane,
     if(plane->hasCluster()) {
         addMeasurementtoGblPoint(point, plane);
     }
-    prevToGlobal = plane->getToGlobal();
-    prevToLocal = plane->getToLocal();
     gblpoints_.push_back(point);
     plane_to_gblpoint_[plane->getName()] = unsigned(gblpoints_.size()); // gbl starts counting at 1
     globalTrackPos = // Constant switching between ROOT and EIGEN is really a pain...
-        plane->getToGlobal() *
+        geometry.to_global *
         ROOT::Math::XYZPoint(localPosTrack(0), localPosTrack(1), localPosTrack(2)); // reference slope stays unchanged
 }
 
@@ -223,17 +305,16 @@ void GblTrack::prepare_gblpoints() {
         total_material += (planes_.back().getPosition() - planes_.front().getPosition()) / scattering_length_volume_;
     }
 
-    // Prepare transformations for first plane:
-    auto prevToGlobal = planes_.front().getToGlobal();
-    auto prevToLocal = planes_.front().getToLocal();
+    // Geometry of the trajectory, shared with all other tracks through the same planes
+    const auto& geometry = get_geometry();
     auto globalTrackPos = get_seed_cluster()->global();
     globalTrackPos.SetZ(0);
 
     // First GblPoint
     auto pl = planes_.begin();
     // add all other points
-    for(; pl != planes_.end(); ++pl) {
-        add_plane(pl, prevToGlobal, prevToLocal, globalTrackPos, total_material);
+    for(size_t i = 0; pl != planes_.end(); ++pl, ++i) {
+        add_plane(pl, geometry[i], globalTrackPos, total_material);
     }
 
     // Make sure we missed nothing
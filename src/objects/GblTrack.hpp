@@ -15,6 +15,9 @@
 #include "Track.hpp"
 
 namespace corryvreckan {
+    // Geometry-dependent part of the GBL trajectory at one plane, shared by all tracks crossing the same planes
+    struct GblPlaneGeometry;
+
     /**
      * @ingroup Objects
      * @brief GblTrack object
@@ -97,9 +100,17 @@ namespace corryvreckan {
          */
         void prepare_gblpoints();
 
+        /**
+         * @brief Get the geometry of the trajectory through the current planes
+         * @return Geometry for each plane, in the order of the planes
+         *
+         * The geometry only depends on the planes and their alignment. It is cached for the last few sets of planes seen by
+         * the calling thread and only recalculated when a plane or its transformation changes.
+         */
+        const std::vector<GblPlaneGeometry>& get_geometry() const;
+
         void add_plane(std::vector<Plane>::iterator& plane,
-                       Transform3D& prevToGlobal,
-                       Transform3D& prevToLocal,
+                       const GblPlaneGeometry& geometry,
                        ROOT::Math::XYZPoint& globalTrackPos,
                        double total_material);
 
@@ -9,12 +9,28 @@
  */
 
 #include "StraightLineTrack.hpp"
-#include "Eigen/Dense"
 #include "Track.hpp"
 #include "exceptions.h"
 
+#include <limits>
+
 using namespace corryvreckan;
 
+namespace {
+    /**
+     * Solve the normal equations of the weighted least-squares fit v = state + slope * z in closed form. Returns their
+     * determinant, the parameters are not meaningful if it vanishes.
+     */
+    inline double solve_line(double sw, double swz, double swzz, double swv, double swvz, double& state, double& slope) {
+        const double det = sw * swzz - swz * swz;
+        // Avoid dividing by zero for singular tracks, which are flagged by the determinant
+        const double inv = 1. / (det != 0. ? det : 1.);
+        state = (swzz * swv - swz * swvz) * inv;
+        slope = (sw * swvz - swz * swv) * inv;
+        return det;
+    }
+} // namespace
+
 ROOT::Math::XYPoint StraightLineTrack::distance(const Cluster* cluster) const {
 
     // Get the StraightLineTrack X and Y at the cluster z position
@@ -102,10 +118,11 @@ double StraightLineTrack::operator()(const double* parameters) {
 void StraightLineTrack::fit() {
 
     isFitted_ = false;
-    Eigen::Matrix4d mat(Eigen::Matrix4d::Zero());
-    Eigen::Vector4d vec(Eigen::Vector4d::Zero());
+    // Weighted sums of the normal equations, the fits in x and y are independent of each other
+    double sw_x = 0., swz_x = 0., swzz_x = 0., swv_x = 0., swvz_x = 0.;
+    double sw_y = 0., swz_y = 0., swzz_y = 0., swv_y = 0., swvz_y = 0.;
 
-    // Loop over all clusters and fill the matrices
+    // Loop over all clusters and fill the sums
     for(auto& cl : track_clusters_) {
         auto* cluster = cl.get();
         if(cluster == nullptr) {
@@ -116,33 +133,34 @@ void StraightLineTrack::fit() {
         double x = cluster->global().x();
         double y = cluster->global().y();
         double z = cluster->global().z();
-        double ex2 = cluster->errorX() * cluster->errorX();
-        double ey2 = cluster->errorY() * cluster->errorY();
-
-        // Fill the matrices
-        vec += Eigen::Vector4d((x / ex2), (x * z / ex2), (y / ey2), (y * z / ey2));
-        Eigen::Vector4d pos(x, x, y, y);
-        Eigen::Matrix2d err;
-        err << 1, z, z, z * z;
-        mat.topLeftCorner(2, 2) += err / ex2;
-        mat.bottomRightCorner(2, 2) += err / ey2;
+        double wx = 1. / (cluster->errorX() * cluster->errorX());
+        double wy = 1. / (cluster->errorY() * cluster->errorY());
+
+        sw_x += wx;
+        swz_x += wx * z;
+        swzz_x += wx * z * z;
+        swv_x += wx * x;
+        swvz_x += wx * x * z;
+        sw_y += wy;
+        swz_y += wy * z;
+        swzz_y += wy * z * z;
+        swv_y += wy * y;
+        swvz_y += wy * y * z;
     }
 
+    // Get the StraightLineTrack parameters
+    double state_x = 0., slope_x = 0., state_y = 0., slope_y = 0.;
+    const double det_x = solve_line(sw_x, swz_x, swzz_x, swv_x, swvz_x, state_x, slope_x);
+    const double det_y = solve_line(sw_y, swz_y, swzz_y, swv_y, swvz_y, state_y, slope_y);
+
     // Check for singularities.
-    if(fabs(mat.determinant()) < std::numeric_limits<double>::epsilon()) {
+    if(fabs(det_x * det_y) < std::numeric_limits<double>::epsilon()) {
         throw TrackFitError(typeid(this), "Martix inversion in straight line fit failed");
     }
-    // Get the StraightLineTrack parameters
-    Eigen::Vector4d res = mat.inverse() * vec;
 
     // Set the StraightLineTrack parameters
-    m_state.SetX(res(0));
-    m_state.SetY(res(2));
-    m_state.SetZ(0.);
-
-    m_direction.SetX(res(1));
-    m_direction.SetY(res(3));
-    m_direction.SetZ(1.);
+    m_state.SetXYZ(state_x, state_y, 0.);
+    m_direction.SetXYZ(slope_x, slope_y, 1.);
 
     // Calculate the chi2
     this->calculateChi2();
@@ -11,6 +11,7 @@
 #include "Track.hpp"
 #include "exceptions.h"
 
+#include "core/utils/ObjectPool.hpp"
 #include "core/utils/type.h"
 
 using namespace corryvreckan;
@@ -254,9 +255,9 @@ Track::Plane* Track::get_plane(std::string detetorID) {
 
 std::shared_ptr<Track> corryvreckan::Track::Factory(const std::string& trackModel) {
     if(trackModel == "straightline") {
-        return std::make_shared<StraightLineTrack>();
+        return make_pooled<StraightLineTrack>();
     } else if(trackModel == "gbl") {
-        return std::make_shared<GblTrack>();
+        return make_pooled<GblTrack>();
     } else {
         throw UnknownTrackModel(typeid(Track), trackModel);
     }
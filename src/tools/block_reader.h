@@ -0,0 +1,222 @@
+/**
+ * @file
+ * @brief Utility to read binary data files in large blocks, optionally ahead of their decoding
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_BLOCK_READER_H
+#define CORRYVRECKAN_BLOCK_READER_H
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/utils/ReadAheadThread.hpp"
+
+namespace corryvreckan {
+
+    /**
+     * @brief Reader returning the contents of a binary file from a reusable buffer
+     *
+     * The file is read in large blocks, records are decoded directly from the buffer instead of reading every field from
+     * the file separately. Optionally, a number of blocks is read ahead by a background thread while the current block is
+     * decoded. Seeking to a position still held in the buffer does not access the file.
+     */
+    class BlockReader {
+    public:
+        /**
+         * @brief Construct a reader without file
+         */
+        BlockReader() = default;
+
+        /**
+         * @brief Stop reading ahead before the file is closed
+         */
+        ~BlockReader() { close(); }
+
+        /// @{
+        /**
+         * @brief Block readers can neither be copied nor moved
+         */
+        BlockReader(const BlockReader&) = delete;
+        BlockReader& operator=(const BlockReader&) = delete;
+        BlockReader(BlockReader&&) = delete;
+        BlockReader& operator=(BlockReader&&) = delete;
+        /// @}
+
+        /**
+         * @brief Open a file for reading, closing the previous one
+         * @param path       Path of the file
+         * @param block_size Number of bytes read from the file at once
+         * @param read_ahead Number of blocks read ahead by a background thread, zero to read blocks when they are needed
+         */
+        void open(const std::string& path, size_t block_size = 1 << 20, size_t read_ahead = 0) {
+            close();
+            file_.clear();
+            file_.open(path, std::ios::binary);
+            block_size_ = std::max<size_t>(block_size, 1);
+            read_ahead_blocks_ = read_ahead;
+            reset(0);
+        }
+
+        /**
+         * @brief Close the file
+         */
+        void close() {
+            read_ahead_.reset();
+            file_.close();
+            file_finished_ = true;
+        }
+
+        /**
+         * @brief Check whether a file is open
+         * @return True if the file has been opened successfully
+         */
+        bool is_open() const { return file_.is_open(); }
+
+        /**
+         * @brief Obtain the next bytes of the file and advance the position past them
+         * @param length Number of bytes
+         * @return Pointer to the bytes, valid until the next call to the reader, or nullptr if the file ends before
+         */
+        const char* fetch(size_t length) {
+            if(!fill(length)) {
+                return nullptr;
+            }
+            const char* data = buffer_.data() + position_;
+            position_ += length;
+            return data;
+        }
+
+        /**
+         * @brief Read a value stored in the file in the byte order of this machine
+         * @param value Value to read, unchanged if the file ends before
+         * @return True if the value has been read
+         */
+        template <typename T> bool read(T& value) {
+            const char* data = fetch(sizeof(T));
+            if(data == nullptr) {
+                return false;
+            }
+            std::memcpy(&value, data, sizeof(T));
+            return true;
+        }
+
+        /**
+         * @brief Read a value without advancing the position
+         * @param value Value to read, unchanged if the file ends before
+         * @return True if the value has been read
+         */
+        template <typename T> bool peek(T& value) {
+            if(!fill(sizeof(T))) {
+                return false;
+            }
+            std::memcpy(&value, buffer_.data() + position_, sizeof(T));
+            return true;
+        }
+
+        /**
+         * @brief Get the current position in the file
+         * @return Offset in bytes from the start of the file
+         */
+        size_t tell() const { return offset_ + position_; }
+
+        /**
+         * @brief Move to a position in the file, reading from the file again only if it is not held in the buffer
+         * @param position Offset in bytes from the start of the file
+         */
+        void seek(size_t position) {
+            if(position >= offset_ && position <= offset_ + end_) {
+                position_ = position - offset_;
+                return;
+            }
+
+            read_ahead_.reset();
+            file_.clear();
+            file_.seekg(static_cast<std::streamoff>(position));
+            reset(position);
+        }
+
+    private:
+        // Discard the buffer and continue reading from the current position of the file
+        void reset(size_t offset) {
+            offset_ = offset;
+            position_ = 0;
+            end_ = 0;
+            file_finished_ = !file_.is_open() || !file_;
+            if(read_ahead_blocks_ > 0 && !file_finished_) {
+                read_ahead_ = std::make_unique<ReadAheadThread<std::vector<char>>>(
+                    [this](std::vector<char>& block) { return read_block(block); }, read_ahead_blocks_);
+            }
+        }
+
+        // Read the next block of the file, only called from the read-ahead thread if it is running
+        bool read_block(std::vector<char>& block) {
+            block.resize(block_size_);
+            file_.read(block.data(), static_cast<std::streamsize>(block.size()));
+            block.resize(static_cast<size_t>(file_.gcount()));
+            return !block.empty();
+        }
+
+        // Make sure the given number of bytes after the current position are held in the buffer
+        bool fill(size_t length) {
+            while(end_ - position_ < length) {
+                if(file_finished_) {
+                    return false;
+                }
+
+                // Move the remaining bytes to the front and append the next block of the file
+                const size_t rest = end_ - position_;
+                if(rest > 0) {
+                    std::memmove(buffer_.data(), buffer_.data() + position_, rest);
+                }
+                offset_ += position_;
+                position_ = 0;
+                end_ = rest;
+
+                if(read_ahead_ != nullptr) {
+                    if(!read_ahead_->next(block_)) {
+                        file_finished_ = true;
+                        continue;
+                    }
+                    buffer_.resize(std::max(buffer_.size(), end_ + block_.size()));
+                    std::memcpy(buffer_.data() + end_, block_.data(), block_.size());
+                    end_ += block_.size();
+                } else {
+                    buffer_.resize(std::max(buffer_.size(), end_ + block_size_));
+                    file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+                    const auto count = static_cast<size_t>(file_.gcount());
+                    end_ += count;
+                    if(!file_ || count == 0) {
+                        file_finished_ = true;
+                    }
+                }
+            }
+            return true;
+        }
+
+        std::ifstream file_;
+        size_t block_size_{1};
+        size_t read_ahead_blocks_{};
+        bool file_finished_{true};
+
+        // Buffered bytes of the file starting at the given offset, and the current position within them
+        std::vector<char> buffer_;
+        size_t offset_{};
+        size_t position_{};
+        size_t end_{};
+
+        // Blocks read by the background thread, destroyed before the file
+        std::vector<char> block_;
+        std::unique_ptr<ReadAheadThread<std::vector<char>>> read_ahead_;
+    };
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_BLOCK_READER_H
@@ -2,7 +2,7 @@
  * @file
  * @brief Definition of KDTree
  *
- * @copyright Copyright (c) 2017-2020 CERN and the Corryvreckan authors.
+ * @copyright Copyright (c) 2017-2022 CERN and the Corryvreckan authors.
  * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
  * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
  * Intergovernmental Organization or submit itself to any jurisdiction.
@@ -11,20 +11,52 @@
 #ifndef CORRYVRECKAN_KDTREE__H
 #define CORRYVRECKAN_KDTREE__H 1
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <vector>
 
-#include <TKDTree.h>
-
 #include "core/utils/exceptions.h"
 
 namespace corryvreckan {
     /**
-     * @brief This class is effectively just a wrapper for the root TKDTreeID class that handles data format conversions
+     * @brief Spatio-temporal index for fast neighbor lookup of objects in time and space
+     *
+     * The elements are stored in an array sorted by their timestamp, such that time windows are found by binary search and
+     * returned as contiguous range without copying any element. For lookups in space, the elements are additionally
+     * sorted into a uniform grid covering their bounding box, with the number of cells chosen to match the number of
+     * elements. Combined queries in time and space iterate over whichever of the two candidate sets is smaller.
+     *
+     * All internal buffers are retained when rebuilding the index, and further elements can be added to an existing index
+     * without sorting the full data set again.
      */
     template <typename T> class KDTree {
-
     public:
+        using Element = std::shared_ptr<T>;
+        using ElementIterator = typename std::vector<Element>::const_iterator;
+
+        /**
+         * @brief Contiguous range of elements, sorted by their timestamp
+         *
+         * The range refers to the storage of the index and is invalidated when the index is rebuilt.
+         */
+        class Range {
+        public:
+            Range(ElementIterator begin, ElementIterator end) : begin_(begin), end_(end) {}
+
+            ElementIterator begin() const { return begin_; }
+            ElementIterator end() const { return end_; }
+            size_t size() const { return static_cast<size_t>(std::distance(begin_, end_)); }
+            bool empty() const { return begin_ == end_; }
+            const Element& operator[](size_t index) const { return *(begin_ + static_cast<std::ptrdiff_t>(index)); }
+
+        private:
+            ElementIterator begin_;
+            ElementIterator end_;
+        };
+
         /**
          * @brief Required default constructor
          */
@@ -35,72 +67,51 @@ namespace corryvreckan {
         ~KDTree() = default;
 
         /**
-         * @brief Build trees in space and time from input data
-         * @param input Vector of elements to construct trees for
+         * @brief Build index in space and time from input data, replacing all previously stored elements
+         * @param input Vector of elements to construct the index for
          */
-        void buildTrees(const std::vector<std::shared_ptr<T>>& input) {
-            // Store the vector of element pointers
+        void buildTrees(const std::vector<Element>& input) {
             elements_ = input;
+            sorted_.clear();
+            times_.clear();
+            insert_sorted(input);
+        }
 
-            // Create the data for the ROOT KDTree
-            size_t npoints = elements_.size();
-            times_ = new double[npoints];
-            xpositions_ = new double[npoints];
-            ypositions_ = new double[npoints];
-
-            // Fill the timing and position data from the elements
-            for(size_t element = 0; element < npoints; element++) {
-                times_[element] = elements_.at(element)->timestamp();
-                xpositions_[element] = get_position(elements_.at(element)).x();
-                ypositions_[element] = get_position(elements_.at(element)).y();
-            }
-
-            // Place the data into the tree and build the structure
-            kdtree_time_ = std::make_unique<TKDTreeID>(static_cast<int>(npoints), 1, 1);
-            // WARNING the TKDTreeID assumes ownership of the data!
-            kdtree_time_->SetData(0, times_);
-            kdtree_time_->Build();
-            kdtree_time_->SetOwner(kTRUE);
-
-            // Place the data into the tree and build the structure
-            kdtree_space_ = std::make_unique<TKDTreeID>(static_cast<int>(npoints), 2, 1);
-            // WARNING the TKDTreeID assumes ownership of the data!
-            kdtree_space_->SetData(0, xpositions_);
-            kdtree_space_->SetData(1, ypositions_);
-            kdtree_space_->Build();
-            kdtree_space_->SetOwner(kTRUE);
+        /**
+         * @brief Add elements to an existing index
+         * @param input Vector of elements to add to the index
+         *
+         * The new elements are sorted separately and merged with the already stored ones, the spatial grid is rebuilt.
+         */
+        void addElements(const std::vector<Element>& input) {
+            elements_.insert(elements_.end(), input.begin(), input.end());
+            insert_sorted(input);
         }
 
         /**
-         * @brief Return all registered elements
+         * @brief Return all registered elements in the order they were provided
          */
-        std::vector<std::shared_ptr<T>> getAllElements() const { return elements_; };
+        const std::vector<Element>& getAllElements() const { return elements_; };
+
+        /**
+         * @brief Return all registered elements sorted by their timestamp
+         */
+        Range getAllElementsByTime() const { return {sorted_.begin(), sorted_.end()}; }
 
         /**
          * @brief Get all neighboring elements within time range
          * @param timestamp  Reference time to return neighbors for
          * @param timeWindow Time range for neighbor search
+         * @return Range of all elements with a time difference of at most timeWindow, sorted by time
          */
-        std::vector<std::shared_ptr<T>> getAllElementsInTimeWindow(const double timestamp, const double timeWindow) const {
-            if(!kdtree_time_) {
-                throw RuntimeError("time tree not initialized");
-            }
-
-            // Get iterators of all elements within the time window
-            std::vector<int> results;
-            kdtree_time_->FindInRange(const_cast<double*>(&timestamp), timeWindow, results);
-
-            // Turn this into a vector of elements
-            std::vector<std::shared_ptr<T>> result_elements;
-            for(size_t res = 0; res < results.size(); res++) {
-                result_elements.push_back(elements_[static_cast<size_t>(results[res])]);
-            }
-            return result_elements;
+        Range getAllElementsInTimeWindow(const double timestamp, const double timeWindow) const {
+            auto indices = time_window(timestamp, timeWindow);
+            return {sorted_.begin() + static_cast<std::ptrdiff_t>(indices.first),
+                    sorted_.begin() + static_cast<std::ptrdiff_t>(indices.second)};
         }
 
         // Function to get back all elements within a given time period with respect to a element
-        std::vector<std::shared_ptr<T>> getAllElementsInTimeWindow(const std::shared_ptr<T>& element,
-                                                                   const double timeWindow) const {
+        Range getAllElementsInTimeWindow(const Element& element, const double timeWindow) const {
             return getAllElementsInTimeWindow(element->timestamp(), timeWindow);
         }
 
@@ -109,23 +120,68 @@ namespace corryvreckan {
          * @param element Element to return neighbors for
          * @param window  Radius for neighbor selection
          */
-        std::vector<std::shared_ptr<T>> getAllElementsInSpaceWindow(const std::shared_ptr<T>& element,
-                                                                    const double window) const {
-            if(!kdtree_space_) {
-                throw RuntimeError("space tree not initialized");
+        std::vector<Element> getAllElementsInSpaceWindow(const Element& element, const double window) const {
+            auto position = get_position(element);
+            std::vector<Element> result_elements;
+            for_each_in_box(position.x(), position.y(), window, window, [&](size_t index) {
+                auto dx = positions_x_[index] - position.x();
+                auto dy = positions_y_[index] - position.y();
+                if(dx * dx + dy * dy <= window * window) {
+                    result_elements.push_back(sorted_[index]);
+                }
+            });
+            return result_elements;
+        }
+
+        /**
+         * @brief Visit all elements within a time window and a rectangular window in space
+         * @param timestamp  Reference time
+         * @param timeWindow Maximum time difference to the reference time
+         * @param x          Reference position in x
+         * @param y          Reference position in y
+         * @param windowX    Maximum distance to the reference position in x
+         * @param windowY    Maximum distance to the reference position in y
+         * @param func       Callable invoked with every matching element
+         *
+         * No memory is allocated. The elements are visited in time order if the time window holds fewer candidates than
+         * the spatial grid cells, and in grid order otherwise.
+         */
+        template <typename Func>
+        void forEachElementInWindow(const double timestamp,
+                                    const double timeWindow,
+                                    const double x,
+                                    const double y,
+                                    const double windowX,
+                                    const double windowY,
+                                    Func&& func) const {
+            if(sorted_.empty()) {
+                return;
             }
 
-            // Get iterators of all clusters within the time window
-            std::vector<int> results;
-            double position[2] = {get_position(element).x(), get_position(element).y()};
-            kdtree_space_->FindInRange(position, window, results);
+            auto time_indices = time_window(timestamp, timeWindow);
+            auto cells = grid_cells(x, y, windowX, windowY);
 
-            // Turn this into a vector of clusters
-            std::vector<std::shared_ptr<T>> result_elements;
-            for(size_t res = 0; res < results.size(); res++) {
-                result_elements.push_back(elements_[static_cast<size_t>(results[res])]);
+            // Count candidates in the grid cells to decide which lookup to iterate over
+            size_t grid_candidates = 0;
+            for(size_t cell_y = cells.y_min; cell_y <= cells.y_max; cell_y++) {
+                auto row = cell_y * grid_size_x_;
+                grid_candidates += cell_offsets_[row + cells.x_max + 1] - cell_offsets_[row + cells.x_min];
+            }
+
+            auto visit = [&](size_t index) {
+                if(std::fabs(times_[index] - timestamp) <= timeWindow && std::fabs(positions_x_[index] - x) <= windowX &&
+                   std::fabs(positions_y_[index] - y) <= windowY) {
+                    func(sorted_[index]);
+                }
+            };
+
+            if(time_indices.second - time_indices.first <= grid_candidates) {
+                for(size_t index = time_indices.first; index < time_indices.second; index++) {
+                    visit(index);
+                }
+            } else {
+                for_each_in_cells(cells, visit);
             }
-            return result_elements;
         }
 
         /**
@@ -133,17 +189,89 @@ namespace corryvreckan {
          * @param  element Object to search neighbor for
          * @return         Closest neighbor to element
          */
-        std::shared_ptr<T> getClosestSpaceNeighbor(const std::shared_ptr<T>& element) const {
-            if(!kdtree_space_) {
+        Element getClosestSpaceNeighbor(const Element& element) const {
+            if(sorted_.empty()) {
                 throw RuntimeError("space tree not initialized");
             }
 
-            // Get the closest cluster to this one
-            int result;
-            double distance;
-            double position[2] = {get_position(element).x(), get_position(element).y()};
-            kdtree_space_->FindNearestNeighbors(position, 1, &result, &distance);
-            return elements_[static_cast<size_t>(result)];
+            auto position = get_position(element);
+            const auto x = position.x();
+            const auto y = position.y();
+            const auto center_x = clamp_cell(x, min_x_, cell_width_x_, grid_size_x_);
+            const auto center_y = clamp_cell(y, min_y_, cell_width_y_, grid_size_y_);
+
+            // Search the grid in rings of cells around the cell of the element. Elements with equal distance are resolved
+            // by their time order, as for a linear scan.
+            size_t closest = sorted_.size();
+            auto closest_distance = std::numeric_limits<double>::max();
+            auto visit = [&](size_t index) {
+                auto dx = positions_x_[index] - x;
+                auto dy = positions_y_[index] - y;
+                auto distance = dx * dx + dy * dy;
+                if(distance < closest_distance || (distance == closest_distance && index < closest)) {
+                    closest_distance = distance;
+                    closest = index;
+                }
+            };
+
+            for(size_t ring = 0;; ring++) {
+                const bool left = (center_x >= ring);
+                const bool right = (center_x + ring < grid_size_x_);
+                const bool bottom = (center_y >= ring);
+                const bool top = (center_y + ring < grid_size_y_);
+                if(!left && !right && !bottom && !top) {
+                    break;
+                }
+
+                const auto x_min = left ? center_x - ring : 0;
+                const auto x_max = right ? center_x + ring : grid_size_x_ - 1;
+                const auto y_min = bottom ? center_y - ring : 0;
+                const auto y_max = top ? center_y + ring : grid_size_y_ - 1;
+                if(ring == 0) {
+                    for_each_in_cells({x_min, x_max, y_min, y_max}, visit);
+                } else {
+                    // Only the outermost rows and columns of the box belong to this ring
+                    if(bottom) {
+                        for_each_in_cells({x_min, x_max, y_min, y_min}, visit);
+                    }
+                    if(top) {
+                        for_each_in_cells({x_min, x_max, y_max, y_max}, visit);
+                    }
+                    const auto inner_y_min = bottom ? y_min + 1 : y_min;
+                    const auto inner_y_max = top ? y_max - 1 : y_max;
+                    if(inner_y_min <= inner_y_max) {
+                        if(left) {
+                            for_each_in_cells({x_min, x_min, inner_y_min, inner_y_max}, visit);
+                        }
+                        if(right) {
+                            for_each_in_cells({x_max, x_max, inner_y_min, inner_y_max}, visit);
+                        }
+                    }
+                }
+
+                // Stop once all cells outside the searched box are further away than the closest element found
+                auto bound = std::numeric_limits<double>::max();
+                if(x_min > 0) {
+                    bound = std::min(bound, x - (min_x_ + static_cast<double>(x_min) * cell_width_x_));
+                }
+                if(x_max + 1 < grid_size_x_) {
+                    bound = std::min(bound, min_x_ + static_cast<double>(x_max + 1) * cell_width_x_ - x);
+                }
+                if(y_min > 0) {
+                    bound = std::min(bound, y - (min_y_ + static_cast<double>(y_min) * cell_width_y_));
+                }
+                if(y_max + 1 < grid_size_y_) {
+                    bound = std::min(bound, min_y_ + static_cast<double>(y_max + 1) * cell_width_y_ - y);
+                }
+                if(bound == std::numeric_limits<double>::max()) {
+                    break;
+                }
+                bound = std::max(bound, 0.);
+                if(closest < sorted_.size() && closest_distance < bound * bound) {
+                    break;
+                }
+            }
+            return sorted_[closest];
         };
 
         /**
@@ -151,38 +279,158 @@ namespace corryvreckan {
          * @param  element Object to search neighbor for
          * @return         Closest neighbor to element
          */
-        std::shared_ptr<T> getClosestTimeNeighbor(const std::shared_ptr<T>& element) const {
-            if(!kdtree_time_) {
+        Element getClosestTimeNeighbor(const Element& element) const {
+            if(sorted_.empty()) {
                 throw RuntimeError("time tree not initialized");
             }
 
-            // Get the closest cluster to this one
-            int result;
-            double distance;
-            kdtree_time_->FindNearestNeighbors(element->timestamp(), 1, &result, &distance);
-            return elements_[static_cast<size_t>(result)];
+            auto timestamp = element->timestamp();
+            auto upper = static_cast<size_t>(std::lower_bound(times_.begin(), times_.end(), timestamp) - times_.begin());
+            if(upper == times_.size()) {
+                return sorted_.back();
+            } else if(upper == 0) {
+                return sorted_.front();
+            }
+            return (timestamp - times_[upper - 1] <= times_[upper] - timestamp) ? sorted_[upper - 1] : sorted_[upper];
         };
 
     private:
-        // Input data for TKDTreeID classes
-        // Sorry for the data format, that's how ROOT consumes them. It also assumes ownership.
-        double* xpositions_;
-        double* ypositions_;
-        double* times_;
+        // Inclusive range of grid cells
+        struct CellRange {
+            size_t x_min, x_max, y_min, y_max;
+        };
 
         /**
          * @brief Helper function to obtain position from template specialization to different objects
          * @param  element The object to get the position from
          * @return         Position of the element
          */
-        XYZPoint get_position(const std::shared_ptr<T>& element) const;
+        XYZPoint get_position(const Element& element) const;
+
+        /**
+         * @brief Merge elements into the time-sorted storage and rebuild the spatial grid
+         * @param input Elements to be added
+         */
+        void insert_sorted(const std::vector<Element>& input) {
+            auto previous = sorted_.size();
+            sorted_.insert(sorted_.end(), input.begin(), input.end());
+
+            // Only the new elements need to be sorted, they are then merged with the existing ones
+            auto compare = [](const Element& a, const Element& b) { return a->timestamp() < b->timestamp(); };
+            auto middle = sorted_.begin() + static_cast<std::ptrdiff_t>(previous);
+            std::stable_sort(middle, sorted_.end(), compare);
+            std::inplace_merge(sorted_.begin(), middle, sorted_.end(), compare);
+
+            times_.resize(sorted_.size());
+            positions_x_.resize(sorted_.size());
+            positions_y_.resize(sorted_.size());
+            for(size_t index = 0; index < sorted_.size(); index++) {
+                auto position = get_position(sorted_[index]);
+                times_[index] = sorted_[index]->timestamp();
+                positions_x_[index] = position.x();
+                positions_y_[index] = position.y();
+            }
+
+            build_grid();
+        }
+
+        /**
+         * @brief Sort the elements into a uniform grid with roughly one element per cell using a counting sort
+         */
+        void build_grid() {
+            if(sorted_.empty()) {
+                grid_size_x_ = grid_size_y_ = 0;
+                return;
+            }
+
+            auto x_range = std::minmax_element(positions_x_.begin(), positions_x_.end());
+            auto y_range = std::minmax_element(positions_y_.begin(), positions_y_.end());
+            min_x_ = *x_range.first;
+            min_y_ = *y_range.first;
+
+            grid_size_x_ = grid_size_y_ = std::max<size_t>(1, static_cast<size_t>(std::sqrt(sorted_.size())));
+            // Extend the cells slightly such that the maximum position falls into the last cell
+            cell_width_x_ = std::max((*x_range.second - min_x_) / static_cast<double>(grid_size_x_) * (1 + 1e-9),
+                                     std::numeric_limits<double>::min());
+            cell_width_y_ = std::max((*y_range.second - min_y_) / static_cast<double>(grid_size_y_) * (1 + 1e-9),
+                                     std::numeric_limits<double>::min());
+
+            cell_offsets_.assign(grid_size_x_ * grid_size_y_ + 1, 0);
+            cell_index_.resize(sorted_.size());
+            for(size_t index = 0; index < sorted_.size(); index++) {
+                cell_index_[index] = cell_of(positions_x_[index], positions_y_[index]);
+                cell_offsets_[cell_index_[index] + 1]++;
+            }
+            std::partial_sum(cell_offsets_.begin(), cell_offsets_.end(), cell_offsets_.begin());
+
+            // Fill the cells in time order, keeping one running insert position per cell
+            cell_entries_.resize(sorted_.size());
+            cell_fill_.assign(cell_offsets_.begin(), cell_offsets_.end() - 1);
+            for(size_t index = 0; index < sorted_.size(); index++) {
+                cell_entries_[cell_fill_[cell_index_[index]]++] = index;
+            }
+        }
+
+        size_t clamp_cell(double coordinate, double minimum, double width, size_t size) const {
+            auto cell = std::floor((coordinate - minimum) / width);
+            if(!(cell > 0)) {
+                return 0;
+            }
+            return static_cast<size_t>(std::min(cell, static_cast<double>(size - 1)));
+        }
+
+        size_t cell_of(double x, double y) const {
+            return clamp_cell(y, min_y_, cell_width_y_, grid_size_y_) * grid_size_x_ +
+                   clamp_cell(x, min_x_, cell_width_x_, grid_size_x_);
+        }
+
+        CellRange grid_cells(double x, double y, double window_x, double window_y) const {
+            return {clamp_cell(x - window_x, min_x_, cell_width_x_, grid_size_x_),
+                    clamp_cell(x + window_x, min_x_, cell_width_x_, grid_size_x_),
+                    clamp_cell(y - window_y, min_y_, cell_width_y_, grid_size_y_),
+                    clamp_cell(y + window_y, min_y_, cell_width_y_, grid_size_y_)};
+        }
+
+        template <typename Func> void for_each_in_cells(const CellRange& cells, Func&& func) const {
+            for(size_t cell_y = cells.y_min; cell_y <= cells.y_max; cell_y++) {
+                auto row = cell_y * grid_size_x_;
+                for(size_t entry = cell_offsets_[row + cells.x_min]; entry < cell_offsets_[row + cells.x_max + 1]; entry++) {
+                    func(cell_entries_[entry]);
+                }
+            }
+        }
+
+        template <typename Func>
+        void for_each_in_box(double x, double y, double window_x, double window_y, Func&& func) const {
+            if(sorted_.empty()) {
+                return;
+            }
+            for_each_in_cells(grid_cells(x, y, window_x, window_y), std::forward<Func>(func));
+        }
+
+        std::pair<size_t, size_t> time_window(double timestamp, double window) const {
+            auto lower = std::lower_bound(times_.begin(), times_.end(), timestamp - window);
+            auto upper = std::upper_bound(lower, times_.end(), timestamp + window);
+            return {static_cast<size_t>(lower - times_.begin()), static_cast<size_t>(upper - times_.begin())};
+        }
+
+        // Storage for input data in original order
+        std::vector<Element> elements_;
 
-        // Trees for lookup in space and time
-        std::unique_ptr<TKDTreeID> kdtree_space_;
-        std::unique_ptr<TKDTreeID> kdtree_time_;
+        // Elements sorted by time together with their time and position for cache-friendly access
+        std::vector<Element> sorted_;
+        std::vector<double> times_;
+        std::vector<double> positions_x_;
+        std::vector<double> positions_y_;
 
-        // Storage for input data
-        std::vector<std::shared_ptr<T>> elements_;
+        // Uniform grid in space, storing the indices of sorted elements per cell in consecutive blocks
+        double min_x_{}, min_y_{};
+        double cell_width_x_{1}, cell_width_y_{1};
+        size_t grid_size_x_{}, grid_size_y_{};
+        std::vector<size_t> cell_offsets_;
+        std::vector<size_t> cell_entries_;
+        std::vector<size_t> cell_index_;
+        std::vector<size_t> cell_fill_;
     };
 
     // Template specialization for Cluster
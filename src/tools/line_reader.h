@@ -0,0 +1,196 @@
+/**
+ * @file
+ * @brief Utilities to read text data files line by line without allocating memory for every line
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_LINE_READER_H
+#define CORRYVRECKAN_LINE_READER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace corryvreckan {
+
+    /**
+     * @brief Reader returning the lines of a text file as views into an internal buffer
+     *
+     * The file is read in large blocks into a buffer which is reused for the full file. Lines are returned without the
+     * line break and remain valid until the next line is requested. Lines longer than the buffer enlarge it.
+     */
+    class LineReader {
+    public:
+        /**
+         * @brief Construct a reader without file
+         */
+        LineReader() = default;
+
+        /**
+         * @brief Open a file for reading
+         * @param path       Path of the file
+         * @param block_size Number of bytes read from the file at once
+         */
+        explicit LineReader(const std::string& path, size_t block_size = 1 << 20) { open(path, block_size); }
+
+        /**
+         * @brief Open a file for reading, closing the previous one
+         * @param path       Path of the file
+         * @param block_size Number of bytes read from the file at once
+         */
+        void open(const std::string& path, size_t block_size = 1 << 20) {
+            file_.close();
+            file_.clear();
+            file_.open(path, std::ios::binary);
+            buffer_.resize(std::max<size_t>(block_size, 1));
+            position_ = 0;
+            end_ = 0;
+            file_finished_ = !file_.is_open();
+            eof_ = false;
+        }
+
+        /**
+         * @brief Close the file
+         */
+        void close() {
+            file_.close();
+            file_finished_ = true;
+            position_ = end_;
+        }
+
+        /**
+         * @brief Check whether a file is open
+         * @return True if the file has been opened successfully
+         */
+        bool is_open() const { return file_.is_open(); }
+
+        /**
+         * @brief Check whether reading a line has failed because the end of the file was reached
+         * @return True if no more lines are available
+         */
+        bool eof() const { return eof_; }
+
+        /**
+         * @brief Read the next line
+         * @param line View of the line without line break, valid until the next call
+         * @return True if a line has been read, false at the end of the file
+         */
+        bool getline(std::string_view& line) {
+            while(true) {
+                const char* begin = buffer_.data() + position_;
+                const auto* newline = static_cast<const char*>(std::memchr(begin, '\n', end_ - position_));
+                if(newline != nullptr) {
+                    line = trim_line(begin, static_cast<size_t>(newline - begin));
+                    position_ = static_cast<size_t>(newline - buffer_.data()) + 1;
+                    return true;
+                }
+
+                // Return the last line if it is not terminated by a line break
+                if(file_finished_) {
+                    if(position_ < end_) {
+                        line = trim_line(begin, end_ - position_);
+                        position_ = end_;
+                        return true;
+                    }
+                    eof_ = true;
+                    return false;
+                }
+
+                // Move the incomplete line to the front and append the next block of the file
+                const size_t rest = end_ - position_;
+                std::memmove(buffer_.data(), begin, rest);
+                position_ = 0;
+                end_ = rest;
+                if(end_ == buffer_.size()) {
+                    buffer_.resize(2 * buffer_.size());
+                }
+                file_.read(buffer_.data() + end_, static_cast<std::streamsize>(buffer_.size() - end_));
+                const auto count = static_cast<size_t>(file_.gcount());
+                end_ += count;
+                if(!file_ || count == 0) {
+                    file_finished_ = true;
+                }
+            }
+        }
+
+    private:
+        static std::string_view trim_line(const char* begin, size_t length) {
+            // Remove carriage returns of Windows line endings
+            if(length > 0 && begin[length - 1] == '\r') {
+                length--;
+            }
+            return {begin, length};
+        }
+
+        std::ifstream file_;
+        std::vector<char> buffer_;
+        size_t position_{};
+        size_t end_{};
+        bool file_finished_{true};
+        bool eof_{};
+    };
+
+    /**
+     * @brief Remove leading spaces and tabs from a text
+     * @param text Text to modify
+     */
+    inline void skip_whitespace(std::string_view& text) {
+        size_t pos = 0;
+        while(pos < text.size() && (text[pos] == ' ' || text[pos] == '\t')) {
+            pos++;
+        }
+        text.remove_prefix(pos);
+    }
+
+    /**
+     * @brief Extract the next whitespace-separated token from a text
+     * @param text Text to read from, the token is removed from its front
+     * @return View of the token, empty if the end of the text has been reached
+     */
+    inline std::string_view next_token(std::string_view& text) {
+        skip_whitespace(text);
+        size_t pos = 0;
+        while(pos < text.size() && text[pos] != ' ' && text[pos] != '\t') {
+            pos++;
+        }
+        auto token = text.substr(0, pos);
+        text.remove_prefix(pos);
+        return token;
+    }
+
+    /**
+     * @brief Parse the next integer number from a text, skipping leading whitespace
+     * @param text  Text to read from, the number is removed from its front on success
+     * @param value Parsed value, unchanged if no number could be parsed
+     * @return True if a number has been parsed
+     */
+    template <typename T> bool next_integer(std::string_view& text, T& value) {
+        skip_whitespace(text);
+        const auto* begin = text.data();
+        const auto* end = begin + text.size();
+        // Accept an explicit plus sign, but not followed by another sign
+        if(begin != end && *begin == '+') {
+            begin++;
+            if(begin != end && *begin == '-') {
+                return false;
+            }
+        }
+        auto result = std::from_chars(begin, end, value);
+        if(result.ec != std::errc()) {
+            return false;
+        }
+        text.remove_prefix(static_cast<size_t>(result.ptr - text.data()));
+        return true;
+    }
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_LINE_READER_H
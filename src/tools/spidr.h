@@ -0,0 +1,428 @@
+/**
+ * @file
+ * @brief Utilities to read and decode raw data files written by the SPIDR readout system
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_SPIDR_H
+#define CORRYVRECKAN_SPIDR_H
+
+#include <algorithm>
+#include <cstdint>
+#include <dirent.h>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/module/exceptions.h"
+#include "core/utils/ReadAheadThread.hpp"
+#include "core/utils/log.h"
+
+namespace corryvreckan {
+    namespace spidr {
+
+        /**
+         * @brief Find the data files of a detector, sorted by their serial number
+         * @param  directory Input directory containing one directory per detector, named after the detector
+         * @param  detector  Name of the detector
+         * @param  other     Function called with the path of every other file found in the directory of the detector
+         * @return           Paths of all files with extension .dat, sorted by the serial number of the file name
+         *
+         * The file structure is RunX/ChipID/files.dat. The files of a run are consecutive in time, such that reading them
+         * in order of their serial number yields a single stream of data.
+         */
+        inline std::vector<std::string> find_data_files(const std::string& directory,
+                                                        const std::string& detector,
+                                                        const std::function<void(const std::string&)>& other = {}) {
+            // Open the root directory
+            DIR* root = opendir(directory.c_str());
+            if(root == nullptr) {
+                throw ModuleError("Directory " + directory + " does not exist");
+            } else {
+                LOG(TRACE) << "Found directory " << directory;
+            }
+
+            std::vector<std::string> files;
+            dirent* entry;
+            while((entry = readdir(root))) {
+                std::string name = entry->d_name;
+
+                // Ignore UNIX functional directories:
+                if(name.at(0) == '.') {
+                    continue;
+                }
+
+                // If these are folders then the name is the chip ID
+                // For some file systems, dirent only returns DT_UNKNOWN - in this case, check the dir. entry starts with "W"
+                if(entry->d_type != DT_DIR && (entry->d_type != DT_UNKNOWN || name.at(0) != 'W')) {
+                    continue;
+                }
+
+                // Only read files from correct directory:
+                if(name != detector) {
+                    continue;
+                }
+                LOG(DEBUG) << "Found directory for detector " << name;
+
+                // Get all of the files for this chip
+                std::string data_directory = directory + "/" + name;
+                DIR* data = opendir(data_directory.c_str());
+                if(data == nullptr) {
+                    continue;
+                }
+                dirent* file;
+                while((file = readdir(data))) {
+                    std::string filename = data_directory + "/" + file->d_name;
+
+                    // Check if file has extension .dat
+                    if(std::string(file->d_name).find(".dat") != std::string::npos) {
+                        LOG(INFO) << "Enqueuing data file for " << name << ": " << filename;
+                        files.push_back(filename);
+                    } else if(other) {
+                        other(filename);
+                    }
+                }
+                closedir(data);
+            }
+            closedir(root);
+
+            // Check that we have files for this detector and sort them correctly:
+            if(files.empty()) {
+                throw ModuleError("No data file found for detector " + detector + " in input directory " + directory);
+            }
+
+            // Sort all files by extracting the "serial number" from the file name while ignoring the timestamp:
+            std::sort(files.begin(), files.end(), [](const std::string& a, const std::string& b) {
+                auto get_serial = [](const std::string& name) {
+                    const auto pos1 = name.find_last_of('-');
+                    const auto pos2 = name.find_last_of('.');
+                    return std::stoi(name.substr(pos1 + 1, pos2 - pos1 - 1));
+                };
+                return get_serial(a) < get_serial(b);
+            });
+            return files;
+        }
+
+        /**
+         * @brief Time information of a SPIDR data stream, reconstructed from the heartbeat and trigger packets
+         */
+        class Clock {
+        public:
+            /**
+             * @brief Decode a heartbeat packet (header 0x4) holding a part of the long timestamp
+             * @param pixdata Data packet
+             * @param detector Name of the detector, used for logging
+             */
+            void heartbeat(uint64_t pixdata, const std::string& detector) {
+                LOG(TRACE) << "Found syncTime data";
+
+                // The 0x4 header tells us that it is part of the timestamp
+                // There is a second 4-bit header that says if it is the most
+                // or least significant part of the timestamp
+                const auto header2 = (pixdata & 0x0F00000000000000) >> 56;
+
+                // This is a bug fix. There appear to be errant packets with garbage data
+                // - source to be tracked down.
+                // Between the data and the header the intervening bits should all be 0,
+                // check if this is the case
+                const auto intermediateBits = (pixdata & 0x00FF000000000000) >> 48;
+                if(intermediateBits != 0x00) {
+                    LOG(DEBUG) << "Detector " << detector << ": intermediateBits error";
+                    return;
+                }
+
+                // 0x4 is the least significant part of the timestamp
+                if(header2 == 0x4) {
+                    // The data is shifted 16 bits to the right, then 12 to the left in
+                    // order to match the timestamp format (net 4 right)
+                    sync_time_ = (sync_time_ & 0xFFFFF00000000000) + ((pixdata & 0x0000FFFFFFFF0000) >> 4);
+                }
+                // 0x5 is the most significant part of the timestamp
+                if(header2 == 0x5) {
+                    // The data is shifted 16 bits to the right, then 44 to the left in
+                    // order to match the timestamp format (net 28 left)
+                    sync_time_ = (sync_time_ & 0x00000FFFFFFFFFFF) + ((pixdata & 0x00000000FFFF0000) << 28);
+                    if(!cleared_header_ && static_cast<double>(sync_time_) / (4096. * 40000000.) < 6.) {
+                        cleared_header_ = true;
+                        LOG(DEBUG) << detector << ": Cleared header";
+                    }
+                }
+            }
+
+            /**
+             * @brief Decode a trigger packet (header 0x6)
+             * @param pixdata Data packet
+             * @param time Time of the trigger in nanoseconds
+             * @param id Trigger number, extended beyond the 12 bits of the packet by counting overflows
+             * @return True if the packet is a valid trigger, false otherwise
+             */
+            bool trigger(uint64_t pixdata, double& time, int& id) {
+                const auto header2 = (pixdata & 0x0F00000000000000) >> 56;
+                if(header2 != 0xF) {
+                    return false;
+                }
+
+                const auto stamp = (pixdata & 0x1E0) >> 5;
+                long long int timestamp_raw = static_cast<long long int>(pixdata & 0xFFFFFFFFE00) >> 9;
+                const auto triggerNumber = static_cast<int>((pixdata & 0xFFF00000000000) >> 44);
+
+                if((pixdata & 0x1F) != 0) {
+                    return false;
+                }
+
+                if(triggerNumber < prev_trigger_number_) {
+                    trigger_overflow_counter_++;
+                }
+
+                // if jump back in time is larger than 1 sec, overflow detected...
+                if((sync_time_tdc_ - timestamp_raw) > 0x1312d000) {
+                    tdc_overflow_counter_++;
+                }
+
+                long long int timestamp = timestamp_raw + (static_cast<long long int>(tdc_overflow_counter_) << 35);
+                time = (static_cast<double>(timestamp) + static_cast<double>(stamp) / 12) / (8. * 0.04); // 320 MHz clock
+
+                sync_time_tdc_ = timestamp_raw;
+
+                id = triggerNumber + (trigger_overflow_counter_ << 12);
+                prev_trigger_number_ = triggerNumber;
+                return true;
+            }
+
+            /**
+             * @brief Get the long timestamp of the last heartbeat
+             * @return Timestamp in units of 1/4096 of the 40 MHz clock
+             */
+            unsigned long long int getSyncTime() const { return sync_time_; }
+
+            /**
+             * @brief Check whether the data left in the buffers at the start of the run has been cleared
+             * @return True once the heartbeat has started from a low value
+             */
+            bool isHeaderCleared() const { return cleared_header_; }
+
+        private:
+            unsigned long long int sync_time_{};
+            bool cleared_header_{};
+            long long int sync_time_tdc_{};
+            int tdc_overflow_counter_{};
+            int prev_trigger_number_{};
+            int trigger_overflow_counter_{};
+        };
+
+        /**
+         * @brief Stream of data packets from consecutive SPIDR data files of one detector
+         *
+         * The packets are read from the files in blocks into a reusable buffer. Runs of packets are decoded by dispatching
+         * on the packet header to the handlers of a decoder type given as template parameter, such that the handlers can be
+         * inlined. Heartbeat and trigger packets are decoded by the stream itself, all packets are skipped until the data
+         * left in the buffers at the start of the run has been cleared. A decoder provides the following methods:
+         *
+         * - `bool full() const`: whether decoding should pause, checked before every packet
+         * - `void prepare(const uint64_t* words, size_t size)`: called for every block read before it is decoded
+         * - `void control(uint64_t word)`: packets with header 0x0, e.g. power pulsing signals
+         * - `void trigger(double time, int id)`: valid trigger packets with header 0x6
+         * - `void pixel(uint64_t word, size_t index, unsigned long long int sync_time)`: pixel packets with header 0xA or
+         *   0xB, at the given position within the current block
+         */
+        class Stream {
+        public:
+            /**
+             * @brief Open the data files and skip their headers
+             * @param files Paths of the data files in the order of reading
+             * @param detector Name of the detector, used for logging
+             * @param block_size Number of 64-bit packets read at once
+             * @param read_ahead Number of blocks read ahead by a background thread, zero to read blocks when needed
+             */
+            Stream(const std::vector<std::string>& files, std::string detector, size_t block_size, size_t read_ahead = 0)
+                : detector_(std::move(detector)), block_size_(std::max<size_t>(block_size, 1)) {
+                for(const auto& filename : files) {
+                    auto new_file = std::make_unique<std::ifstream>(filename, std::ios::binary);
+                    if(!new_file->is_open()) {
+                        throw ModuleError("Could not open data file " + filename);
+                    }
+                    LOG(DEBUG) << "Opened data file for " << detector_ << ": " << filename;
+
+                    // The header is repeated in every new data file, thus skip it for all.
+                    uint32_t headerID;
+                    if(!new_file->read(reinterpret_cast<char*>(&headerID), sizeof headerID)) {
+                        throw ModuleError("Cannot read header ID for " + detector_ + " in file " + filename);
+                    }
+                    if(headerID != 1380208723) {
+                        throw ModuleError("Incorrect header ID for " + detector_ + " in file " + filename + ": " +
+                                          std::to_string(headerID));
+                    }
+                    LOG(TRACE) << "Header ID: \"" << headerID << "\"";
+
+                    // Skip the rest of the file header
+                    uint32_t headerSize;
+                    if(!new_file->read(reinterpret_cast<char*>(&headerSize), sizeof headerSize)) {
+                        throw ModuleError("Cannot read header size for " + detector_ + " in file " + filename);
+                    }
+                    new_file->seekg(headerSize);
+                    LOG(TRACE) << "Skipped header (" << headerSize << "b)";
+
+                    files_.push_back(std::move(new_file));
+                }
+                words_.reserve(block_size_);
+                finished_ = files_.empty();
+
+                if(read_ahead > 0 && !finished_) {
+                    read_ahead_ = std::make_unique<ReadAheadThread<std::vector<uint64_t>>>(
+                        [this](std::vector<uint64_t>& block) { return read_file_block(block); }, read_ahead);
+                }
+            }
+
+            /// @{
+            /**
+             * @brief Streams can neither be copied nor moved, the read-ahead thread refers to them
+             */
+            Stream(const Stream&) = delete;
+            Stream& operator=(const Stream&) = delete;
+            Stream(Stream&&) = delete;
+            Stream& operator=(Stream&&) = delete;
+            /// @}
+
+            /**
+             * @brief Decode packets until the decoder is full or all files have been read
+             * @param decoder Decoder handling the packets
+             * @return False if all files have been read, true otherwise
+             */
+            template <typename Decoder> bool decode(Decoder& decoder) {
+                while(!decoder.full()) {
+                    // Read the next block of data if all words of the current one have been decoded:
+                    if(position_ == words_.size()) {
+                        if(!read_block()) {
+                            return false;
+                        }
+                        decoder.prepare(words_.data(), words_.size());
+                    }
+
+                    const uint64_t* words = words_.data();
+                    const size_t size = words_.size();
+                    for(; position_ < size && !decoder.full(); position_++) {
+                        const uint64_t pixdata = words[position_];
+                        LOG(TRACE) << "0x" << std::hex << pixdata << std::dec << " - " << pixdata;
+
+                        // Get the header (first 4 bits) and do things depending on what it is
+                        const auto header = pixdata >> 60;
+
+                        // Use header 0x4 to get the long timestamps (called syncTime here)
+                        if(header == 0x4) {
+                            clock_.heartbeat(pixdata, detector_);
+                            continue;
+                        }
+
+                        // In data taking during 2015 there was sometimes still data left in the buffers at the start of
+                        // a run. For that reason we keep skipping data until this "header" data has been cleared, when
+                        // the heart beat signal starts from a low number (~few seconds max)
+                        if(!clock_.isHeaderCleared()) {
+                            LOG(TRACE) << "Header not cleared, skipping data block.";
+                            continue;
+                        }
+
+                        switch(header) {
+                        case 0x0:
+                            // Header 0x0 indicates power pulsing signals
+                            decoder.control(pixdata);
+                            break;
+                        case 0x6: {
+                            // Header 0x6 indicate trigger data
+                            double time;
+                            int id;
+                            if(clock_.trigger(pixdata, time, id)) {
+                                decoder.trigger(time, id);
+                            }
+                            break;
+                        }
+                        case 0xA:
+                        case 0xB:
+                            // Header 0xA and 0xB indicate pixel data
+                            LOG(TRACE) << "Found pixel data";
+                            decoder.pixel(pixdata, position_, clock_.getSyncTime());
+                            break;
+                        default:
+                            break;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            /**
+             * @brief Check whether all files have been read completely
+             * @return True if no more data is available
+             */
+            bool eof() const { return finished_ && position_ == words_.size(); }
+
+        private:
+            // Replace the current block by the next one, either read directly or taken from the read-ahead thread
+            bool read_block() {
+                position_ = 0;
+                const bool success = (read_ahead_ != nullptr ? read_ahead_->next(words_) : read_file_block(words_));
+                if(!success) {
+                    words_.clear();
+                    finished_ = true;
+                }
+                return success;
+            }
+
+            // Read the next block of packets from the files, only called from the read-ahead thread if it is running
+            bool read_file_block(std::vector<uint64_t>& block) {
+                block.resize(block_size_);
+                size_t words = 0;
+                while(words == 0) {
+                    // Check if the last file is finished:
+                    if(current_ == files_.size()) {
+                        LOG(INFO) << "EOF for all files of " << detector_;
+                        block.clear();
+                        return false;
+                    }
+
+                    // Read a full block of data packets directly into the buffer, an incomplete word at the end of a file
+                    // is dropped
+                    auto& file = files_[current_];
+                    file->read(reinterpret_cast<char*>(block.data()),
+                               static_cast<std::streamsize>(block_size_ * sizeof(uint64_t)));
+                    words = static_cast<size_t>(file->gcount()) / sizeof(uint64_t);
+
+                    // Move to the next file if no data is left in the current one:
+                    if(words == 0) {
+                        LOG(INFO) << "No more data in current file for " << detector_ << ": " << file.get();
+                        file.reset();
+                        current_++;
+                        if(current_ != files_.size()) {
+                            LOG(INFO) << "Starting to read next file for " << detector_ << ": " << files_[current_].get();
+                        }
+                    }
+                }
+                block.resize(words);
+                LOG(TRACE) << "Read block of " << words << " words for " << detector_;
+                return true;
+            }
+
+            std::string detector_;
+            size_t block_size_;
+
+            std::vector<std::unique_ptr<std::ifstream>> files_;
+            size_t current_{};
+
+            // Block of raw data words read from the current file and the position of the next word to decode
+            std::vector<uint64_t> words_;
+            size_t position_{};
+            bool finished_{};
+
+            Clock clock_;
+
+            // Thread reading blocks ahead of their decoding, stopped before the files are closed
+            std::unique_ptr<ReadAheadThread<std::vector<uint64_t>>> read_ahead_;
+        };
+    } // namespace spidr
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_SPIDR_H
@@ -0,0 +1,191 @@
+/**
+ * @file
+ * @brief Definition of a buffer to sort slightly out-of-order data by time
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#ifndef CORRYVRECKAN_TIME_SORTED_BUFFER_H
+#define CORRYVRECKAN_TIME_SORTED_BUFFER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace corryvreckan {
+    /**
+     * @brief Timestamp of objects referred to by pointers, such as pixels or SPIDR signals
+     */
+    struct ObjectTimestamp {
+        template <typename T> double operator()(const T& object) const { return object->timestamp(); }
+    };
+
+    /**
+     * @brief Buffer returning elements in the order of their timestamp, replacing a priority queue for data streams which
+     * are only mildly out of order
+     *
+     * Elements are sorted into buckets of fixed width in time, arranged in a ring covering a window of time after the
+     * bucket currently read. Adding an element to a future bucket takes constant time. When all elements of the current
+     * bucket have been read, the next non-empty bucket is sorted and becomes the current one. Elements belonging to the
+     * current or an earlier bucket are inserted into the sorted current bucket, elements beyond the window of the ring are
+     * kept aside until the window reaches them.
+     *
+     * The interface follows std::priority_queue with the earliest element on top.
+     *
+     * @tparam T    Type of the elements
+     * @tparam Time Function object returning the timestamp of an element
+     */
+    template <typename T, typename Time = ObjectTimestamp> class TimeSortedBuffer {
+    public:
+        /**
+         * @brief Construct an empty buffer
+         * @param bucket_width Width of a bucket in time, should be comparable to the typical distance between elements
+         * @param buckets      Number of buckets in the ring, rounded up to the next power of two
+         * @param time         Function object to obtain the timestamp of an element
+         */
+        explicit TimeSortedBuffer(double bucket_width, size_t buckets = 1024, Time time = Time())
+            : width_(bucket_width), time_(std::move(time)) {
+            size_t size = 1;
+            while(size < buckets) {
+                size <<= 1;
+            }
+            ring_.resize(size);
+            mask_ = size - 1;
+        }
+
+        /**
+         * @brief Add an element to the buffer
+         * @param element Element to add
+         */
+        void push(T element) {
+            const auto key = key_of(time_(element));
+            if(size_ == 0) {
+                // Start the current bucket with the element
+                ready_.clear();
+                cursor_ = 0;
+                ready_key_ = key;
+                ready_.push_back(std::move(element));
+            } else if(key <= ready_key_) {
+                const auto t = time_(element);
+                auto position = std::upper_bound(ready_.begin() + static_cast<std::ptrdiff_t>(cursor_),
+                                                 ready_.end(),
+                                                 t,
+                                                 [this](double value, const T& other) { return value < time_(other); });
+                ready_.insert(position, std::move(element));
+            } else if(key - ready_key_ < static_cast<int64_t>(ring_.size())) {
+                ring_[static_cast<size_t>(key) & mask_].push_back(std::move(element));
+                ring_count_++;
+            } else {
+                far_min_key_ = std::min(far_min_key_, key);
+                far_.push_back(std::move(element));
+            }
+            size_++;
+        }
+
+        /**
+         * @brief Get the earliest element, the buffer must not be empty
+         * @return Reference to the element with the smallest timestamp
+         */
+        const T& top() const { return ready_[cursor_]; }
+
+        /**
+         * @brief Remove the earliest element, the buffer must not be empty
+         */
+        void pop() {
+            ready_[cursor_++] = T();
+            size_--;
+            if(cursor_ == ready_.size()) {
+                ready_.clear();
+                cursor_ = 0;
+                if(size_ > 0) {
+                    advance();
+                }
+            }
+        }
+
+        /**
+         * @brief Get the number of elements in the buffer
+         * @return Number of elements
+         */
+        size_t size() const { return size_; }
+
+        /**
+         * @brief Check whether the buffer is empty
+         * @return True if no elements are buffered
+         */
+        bool empty() const { return size_ == 0; }
+
+    private:
+        int64_t key_of(double time) const { return static_cast<int64_t>(std::floor(time / width_)); }
+
+        // Make the next non-empty bucket the current one
+        void advance() {
+            while(true) {
+                // Jump directly to the elements kept aside if the ring is empty
+                if(ring_count_ == 0) {
+                    ready_key_ = far_min_key_ - 1;
+                }
+                ready_key_++;
+
+                // Move elements kept aside into the ring once they are within its window
+                if(!far_.empty() && far_min_key_ - ready_key_ < static_cast<int64_t>(ring_.size())) {
+                    redistribute();
+                }
+
+                auto& bucket = ring_[static_cast<size_t>(ready_key_) & mask_];
+                if(!bucket.empty()) {
+                    ring_count_ -= bucket.size();
+                    std::swap(ready_, bucket);
+                    std::sort(ready_.begin(), ready_.end(), [this](const T& a, const T& b) { return time_(a) < time_(b); });
+                    return;
+                }
+            }
+        }
+
+        void redistribute() {
+            far_min_key_ = std::numeric_limits<int64_t>::max();
+            auto keep = far_.begin();
+            for(auto& element : far_) {
+                const auto key = key_of(time_(element));
+                if(key - ready_key_ < static_cast<int64_t>(ring_.size())) {
+                    ring_[static_cast<size_t>(key) & mask_].push_back(std::move(element));
+                    ring_count_++;
+                } else {
+                    far_min_key_ = std::min(far_min_key_, key);
+                    if(&*keep != &element) {
+                        *keep = std::move(element);
+                    }
+                    ++keep;
+                }
+            }
+            far_.erase(keep, far_.end());
+        }
+
+        double width_;
+        Time time_;
+
+        // Sorted elements of the current bucket and position of the earliest element not yet removed
+        std::vector<T> ready_;
+        size_t cursor_{};
+        int64_t ready_key_{};
+
+        // Unsorted elements of the following buckets
+        std::vector<std::vector<T>> ring_;
+        size_t mask_{};
+        size_t ring_count_{};
+
+        // Elements beyond the window of the ring
+        std::vector<T> far_;
+        int64_t far_min_key_{std::numeric_limits<int64_t>::max()};
+
+        size_t size_{};
+    };
+} // namespace corryvreckan
+
+#endif // CORRYVRECKAN_TIME_SORTED_BUFFER_H
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+#
+# Compare the positions and orientations of all detectors in two geometry files within the given tolerances
+
+from __future__ import print_function, unicode_literals
+import re
+import sys
+
+# Conversion factors to the framework units, millimeter and radian
+UNITS = {
+    '': 1.,
+    'nm': 1e-6,
+    'um': 1e-3,
+    'mm': 1.,
+    'cm': 10.,
+    'm': 1e3,
+    'urad': 1e-6,
+    'mrad': 1e-3,
+    'rad': 1.,
+    'deg': 3.14159265358979323846 / 180.,
+}
+
+def parse_value(value):
+    """convert a single value with optional unit to framework units"""
+    match = re.match(r'^\s*([-+0-9.eE]+)\s*([a-z]*)\s*$', value)
+    if match is None or match.group(2) not in UNITS:
+        raise ValueError('cannot parse value "{}"'.format(value))
+    return float(match.group(1)) * UNITS[match.group(2)]
+
+def read_geometry(path):
+    """read position and orientation of all detectors from a geometry file"""
+    detectors = {}
+    detector = None
+    with open(path) as f:
+        for line in f:
+            line = line.split('#')[0].strip()
+            section = re.match(r'^\[(.*)\]$', line)
+            if section is not None:
+                detector = detectors.setdefault(section.group(1), {})
+                continue
+            if detector is None or '=' not in line:
+                continue
+            key, value = [part.strip() for part in line.split('=', 1)]
+            if key in ('position', 'orientation'):
+                detector[key] = [parse_value(v) for v in value.strip('"').split(',')]
+    return detectors
+
+def main():
+    if len(sys.argv) != 5:
+        print('Usage: {} <geometry> <reference geometry> <position tolerance> <orientation tolerance>'.format(
+            sys.argv[0]))
+        return 2
+
+    geometry = read_geometry(sys.argv[1])
+    reference = read_geometry(sys.argv[2])
+    tolerances = {'position': parse_value(sys.argv[3]), 'orientation': parse_value(sys.argv[4])}
+
+    failed = False
+    if sorted(geometry) != sorted(reference):
+        print('Detectors differ: {} and {}'.format(sorted(geometry), sorted(reference)))
+        return 1
+    for name in sorted(reference):
+        for key, tolerance in sorted(tolerances.items()):
+            values = geometry[name].get(key)
+            reference_values = reference[name].get(key)
+            if values is None or reference_values is None or len(values) != len(reference_values):
+                print('{}: {} missing or incomplete'.format(name, key))
+                failed = True
+                continue
+            for axis, value, reference_value in zip('XYZ', values, reference_values):
+                difference = abs(value - reference_value)
+                if difference > tolerance:
+                    print('{}: {} {} differs by {:g}, tolerance {:g}'.format(name, key, axis, difference, tolerance))
+                    failed = True
+
+    if failed:
+        return 1
+    print('Geometries agree within tolerances for {} detectors'.format(len(reference)))
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
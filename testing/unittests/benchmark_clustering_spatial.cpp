@@ -0,0 +1,216 @@
+/**
+ * @file
+ * @brief Benchmark comparing the neighbor search of the ClusteringSpatial module using a nested map and a dense hit map
+ *
+ * Both searches are copies of the clustering loop of the module before and after the dense hit map was introduced,
+ * reduced to the grouping of pixels into clusters. Frames with Mimosa26 dimensions are filled with random clusters of up
+ * to six pixels, the clusters found by both searches have to contain the same pixels in the same order.
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+    // Dimensions of a Mimosa26 sensor
+    constexpr int nCols = 1152;
+    constexpr int nRows = 576;
+
+    struct Pixel {
+        int column_;
+        int row_;
+        int column() const { return column_; }
+        int row() const { return row_; }
+    };
+    using PixelVector = std::vector<std::shared_ptr<Pixel>>;
+    using Cluster = std::vector<const Pixel*>;
+
+    // Neighbor search with a nested map of the hits and a map of used pixels
+    std::vector<Cluster> cluster_map(const PixelVector& pixels) {
+        std::vector<Cluster> clusters;
+        std::map<std::shared_ptr<Pixel>, bool> used;
+        std::map<int, std::map<int, std::shared_ptr<Pixel>>> hitmap;
+        for(const auto& pixel : pixels) {
+            hitmap[pixel->column()][pixel->row()] = pixel;
+        }
+
+        for(auto pixel : pixels) {
+            if(used[pixel]) {
+                continue;
+            }
+            Cluster cluster{pixel.get()};
+            used[pixel] = true;
+            bool addedPixel = true;
+            PixelVector neighbors;
+            while(addedPixel) {
+                addedPixel = false;
+                for(int row = pixel->row() - 1; row <= pixel->row() + 1; row++) {
+                    if(row < 0 || row >= nRows) {
+                        continue;
+                    }
+                    for(int col = pixel->column() - 1; col <= pixel->column() + 1; col++) {
+                        if(col < 0 || col >= nCols) {
+                            continue;
+                        }
+                        if(!hitmap[col][row] || used[hitmap[col][row]]) {
+                            continue;
+                        }
+                        cluster.push_back(hitmap[col][row].get());
+                        used[hitmap[col][row]] = true;
+                        neighbors.push_back(hitmap[col][row]);
+                    }
+                }
+                if(!neighbors.empty()) {
+                    addedPixel = true;
+                    pixel = neighbors.back();
+                    neighbors.pop_back();
+                }
+            }
+            clusters.push_back(std::move(cluster));
+        }
+        return clusters;
+    }
+
+    // Neighbor search with a dense hit map of pixel indices, which is cleared again after the frame
+    std::vector<Cluster> cluster_dense(const PixelVector& pixels) {
+        std::vector<Cluster> clusters;
+        static thread_local std::vector<int> hitmap;
+        const auto n_cells = static_cast<size_t>(nCols) * static_cast<size_t>(nRows);
+        if(hitmap.size() < n_cells) {
+            hitmap.resize(n_cells, -1);
+        }
+        auto cell_of = [](int col, int row) {
+            return static_cast<size_t>(col) * static_cast<size_t>(nRows) + static_cast<size_t>(row);
+        };
+        auto in_matrix = [](int col, int row) { return col >= 0 && col < nCols && row >= 0 && row < nRows; };
+
+        for(size_t iP = 0; iP < pixels.size(); iP++) {
+            if(in_matrix(pixels[iP]->column(), pixels[iP]->row())) {
+                hitmap[cell_of(pixels[iP]->column(), pixels[iP]->row())] = static_cast<int>(iP);
+            }
+        }
+
+        std::vector<char> used(pixels.size(), false);
+        std::vector<size_t> neighbors;
+        for(size_t iP = 0; iP < pixels.size(); iP++) {
+            if(used[iP]) {
+                continue;
+            }
+            const Pixel* pixel = pixels[iP].get();
+            Cluster cluster{pixel};
+            used[iP] = true;
+            while(pixel != nullptr) {
+                for(int row = pixel->row() - 1; row <= pixel->row() + 1; row++) {
+                    for(int col = pixel->column() - 1; col <= pixel->column() + 1; col++) {
+                        if(!in_matrix(col, row)) {
+                            continue;
+                        }
+                        auto index = hitmap[cell_of(col, row)];
+                        if(index < 0 || used[static_cast<size_t>(index)]) {
+                            continue;
+                        }
+                        cluster.push_back(pixels[static_cast<size_t>(index)].get());
+                        used[static_cast<size_t>(index)] = true;
+                        neighbors.push_back(static_cast<size_t>(index));
+                    }
+                }
+                pixel = nullptr;
+                if(!neighbors.empty()) {
+                    pixel = pixels[neighbors.back()].get();
+                    neighbors.pop_back();
+                }
+            }
+            clusters.push_back(std::move(cluster));
+        }
+
+        for(const auto& pixel : pixels) {
+            if(in_matrix(pixel->column(), pixel->row())) {
+                hitmap[cell_of(pixel->column(), pixel->row())] = -1;
+            }
+        }
+        return clusters;
+    }
+
+    // Random frames with the given number of clusters of one to six pixels each
+    std::vector<PixelVector> make_frames(size_t n_frames, int clusters_per_frame) {
+        std::mt19937_64 random(20221017);
+        std::vector<PixelVector> frames(n_frames);
+        for(auto& frame : frames) {
+            std::set<std::pair<int, int>> filled;
+            for(int i = 0; i < clusters_per_frame; i++) {
+                const auto column = static_cast<int>(random() % nCols);
+                const auto row = static_cast<int>(random() % nRows);
+                const auto size = 1 + random() % 6;
+                for(size_t j = 0; j < size; j++) {
+                    const int pixel_column = column + static_cast<int>(random() % 3) - 1;
+                    const int pixel_row = row + static_cast<int>(random() % 3) - 1;
+                    if(pixel_column < 0 || pixel_column >= nCols || pixel_row < 0 || pixel_row >= nRows ||
+                       !filled.emplace(pixel_column, pixel_row).second) {
+                        continue;
+                    }
+                    frame.push_back(std::make_shared<Pixel>(Pixel{pixel_column, pixel_row}));
+                }
+            }
+        }
+        return frames;
+    }
+
+    // Run the search on all frames and return the time per frame in microseconds
+    template <typename Search>
+    double measure(Search search, const std::vector<PixelVector>& frames, std::vector<std::vector<Cluster>>& results) {
+        results.clear();
+        const auto start = std::chrono::steady_clock::now();
+        for(const auto& frame : frames) {
+            results.push_back(search(frame));
+        }
+        const auto duration = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start);
+        return duration.count() / static_cast<double>(frames.size());
+    }
+} // namespace
+
+int main(int argc, char** argv) {
+    // The number of frames can be given as argument to obtain more stable timings
+    const size_t n_frames = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 2000);
+
+    size_t failures = 0;
+    std::cout << std::fixed << std::setprecision(1);
+    for(int clusters_per_frame : {5, 50, 500}) {
+        const auto frames = make_frames(n_frames, clusters_per_frame);
+        size_t n_pixels = 0;
+        for(const auto& frame : frames) {
+            n_pixels += frame.size();
+        }
+
+        std::vector<std::vector<Cluster>> clusters_map;
+        std::vector<std::vector<Cluster>> clusters_dense;
+        const auto time_map = measure(cluster_map, frames, clusters_map);
+        const auto time_dense = measure(cluster_dense, frames, clusters_dense);
+
+        std::cout << static_cast<double>(n_pixels) / static_cast<double>(n_frames) << " pixels per frame: nested map "
+                  << time_map << "us, dense hit map " << time_dense << "us per frame, speedup " << time_map / time_dense
+                  << std::endl;
+        if(clusters_map != clusters_dense) {
+            std::cerr << "Clusters differ for " << clusters_per_frame << " clusters per frame" << std::endl;
+            failures++;
+        }
+    }
+
+    if(failures > 0) {
+        std::cerr << failures << " configurations failed" << std::endl;
+        return 1;
+    }
+    std::cout << "Both searches found identical clusters" << std::endl;
+    return 0;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @brief Unit test reading a binary file with the block reader across block boundaries, with and without reading ahead
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "tools/block_reader.h"
+
+using namespace corryvreckan;
+
+namespace {
+    // Read the file in records of random length with occasional seeks and compare the contents to the data written
+    size_t read_file(const std::string& path, const std::vector<char>& data, size_t block_size, size_t read_ahead) {
+        std::mt19937_64 random(block_size + read_ahead);
+        BlockReader reader;
+        reader.open(path, block_size, read_ahead);
+        if(!reader.is_open()) {
+            return 1;
+        }
+
+        size_t errors = 0;
+        size_t position = 0;
+        while(true) {
+            // Mostly short records, sometimes spanning several blocks
+            size_t length = random() % 40;
+            if(random() % 50 == 0) {
+                length = random() % 10000;
+            }
+
+            // Seek backwards, mostly within the buffer but sometimes further
+            if(random() % 97 == 0 && position > 0) {
+                position -= random() % std::min<size_t>(position, random() % 8 != 0 ? 100 : 50000);
+                reader.seek(position);
+            }
+
+            uint32_t value = 0;
+            const bool peeked = reader.peek(value);
+            if(peeked != (position + sizeof(value) <= data.size()) ||
+               (peeked && std::memcmp(&value, data.data() + position, sizeof(value)) != 0)) {
+                errors++;
+            }
+
+            const char* record = reader.fetch(length);
+            if(position + length > data.size()) {
+                // Reading beyond the end of the file fails
+                if(record != nullptr) {
+                    errors++;
+                }
+                break;
+            }
+            if(record == nullptr || std::memcmp(record, data.data() + position, length) != 0) {
+                errors++;
+            }
+            position += length;
+            if(reader.tell() != position) {
+                errors++;
+            }
+        }
+        return errors;
+    }
+} // namespace
+
+int main() {
+    const std::string path = "block_reader.bin";
+    std::mt19937_64 random(20220907);
+    std::vector<char> data(400009);
+    for(auto& byte : data) {
+        byte = static_cast<char>(random());
+    }
+    std::ofstream(path, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size()));
+
+    size_t failures = 0;
+    for(size_t block_size : std::vector<size_t>{61, 997, 4096, 1 << 20}) {
+        for(size_t read_ahead : std::vector<size_t>{0, 1, 4}) {
+            const auto errors = read_file(path, data, block_size, read_ahead);
+            if(errors > 0) {
+                std::cerr << "Block size " << block_size << ", " << read_ahead << " blocks read ahead: " << errors
+                          << " errors" << std::endl;
+                failures++;
+            }
+        }
+    }
+    std::remove(path.c_str());
+
+    if(failures > 0) {
+        std::cerr << failures << " configurations failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All configurations passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file
+ * @brief Unit test reading text files with the line reader across buffer boundaries and parsing numbers from the lines
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "tools/line_reader.h"
+
+using namespace corryvreckan;
+
+namespace {
+    // Write the lines with the given line break, optionally without break after the last line
+    void write_file(const std::string& path,
+                    const std::vector<std::string>& lines,
+                    const std::string& line_break,
+                    bool final_break) {
+        std::ofstream file(path, std::ios::binary);
+        for(size_t i = 0; i < lines.size(); i++) {
+            file << lines[i];
+            if(i + 1 < lines.size() || final_break) {
+                file << line_break;
+            }
+        }
+    }
+
+    // Read all lines of the file and count the differences to the expected lines
+    size_t read_file(const std::string& path, const std::vector<std::string>& lines, size_t block_size) {
+        LineReader reader(path, block_size);
+        if(!reader.is_open()) {
+            return 1;
+        }
+
+        size_t errors = 0;
+        size_t count = 0;
+        std::string_view line;
+        while(reader.getline(line)) {
+            if(count >= lines.size() || line != lines[count]) {
+                errors++;
+            }
+            count++;
+        }
+        if(count != lines.size() || !reader.eof()) {
+            errors++;
+        }
+
+        // Reading after the end of the file keeps failing
+        if(reader.getline(line)) {
+            errors++;
+        }
+        return errors;
+    }
+
+    // Parse a single integer and compare success, value and remaining text to the expectation
+    template <typename T>
+    bool check_integer(std::string_view text, bool success, T expected, std::string_view expected_rest) {
+        T value = 7;
+        const bool parsed = next_integer(text, value);
+        return parsed == success && value == (success ? expected : 7) && text == expected_rest;
+    }
+} // namespace
+
+int main() {
+    const std::string path = "line_reader.txt";
+    size_t failures = 0;
+
+    // Lines of random length including empty ones and a line much longer than the smaller buffers
+    std::mt19937_64 random(20221017);
+    std::vector<std::string> lines;
+    for(size_t i = 0; i < 2000; i++) {
+        const size_t length = (random() % 10 == 0 ? 0 : random() % 100);
+        std::string line;
+        for(size_t j = 0; j < length; j++) {
+            line += static_cast<char>('0' + random() % 40);
+        }
+        lines.push_back(line);
+    }
+    lines[1000] = std::string(50000, 'x');
+    lines.emplace_back("");
+    lines.emplace_back("last");
+
+    for(const std::string line_break : {"\n", "\r\n"}) {
+        for(bool final_break : {true, false}) {
+            write_file(path, lines, line_break, final_break);
+            for(size_t block_size : std::vector<size_t>{1, 2, 7, 64, 4093, 1 << 20}) {
+                const auto errors = read_file(path, lines, block_size);
+                if(errors > 0) {
+                    std::cerr << (line_break == "\n" ? "LF" : "CRLF") << " line breaks, "
+                              << (final_break ? "with" : "without") << " final line break, block size " << block_size
+                              << ": " << errors << " errors" << std::endl;
+                    failures++;
+                }
+            }
+        }
+    }
+
+    // An empty file has no lines, a file with only a line break has one empty line
+    write_file(path, {}, "\n", false);
+    if(read_file(path, {}, 16) > 0) {
+        std::cerr << "Empty file: lines have been read" << std::endl;
+        failures++;
+    }
+    write_file(path, {""}, "\r\n", true);
+    if(read_file(path, {""}, 1) > 0) {
+        std::cerr << "File with single line break: no empty line has been read" << std::endl;
+        failures++;
+    }
+    std::remove(path.c_str());
+
+    // A missing file cannot be opened and has no lines
+    LineReader missing("line_reader_missing.txt");
+    std::string_view line;
+    if(missing.is_open() || missing.getline(line)) {
+        std::cerr << "Missing file could be read" << std::endl;
+        failures++;
+    }
+
+    // Valid, partially valid and malformed numbers
+    const std::vector<bool> integers{
+        check_integer<int>("  42 17", true, 42, " 17"),
+        check_integer<int>("\t-13", true, -13, ""),
+        check_integer<int>("+5", true, 5, ""),
+        check_integer<int>("12x", true, 12, "x"),
+        check_integer<uint64_t>("18446744073709551615", true, UINT64_MAX, ""),
+        check_integer<int>("", false, 0, ""),
+        check_integer<int>("   ", false, 0, ""),
+        check_integer<int>("abc", false, 0, "abc"),
+        check_integer<int>(" -", false, 0, "-"),
+        check_integer<int>("+", false, 0, "+"),
+        check_integer<int>("+-1", false, 0, "+-1"),
+        check_integer<int>("0x1f", true, 0, "x1f"),
+        check_integer<unsigned int>("-3", false, 0u, "-3"),
+        check_integer<uint8_t>("256", false, uint8_t(0), "256"),
+        check_integer<int32_t>("99999999999", false, 0, "99999999999"),
+    };
+    for(size_t i = 0; i < integers.size(); i++) {
+        if(!integers[i]) {
+            std::cerr << "Integer parsing check " << i << " failed" << std::endl;
+            failures++;
+        }
+    }
+
+    // Tokens are separated by spaces and tabs
+    std::string_view text = " \tfirst\t second  ";
+    if(next_token(text) != "first" || next_token(text) != "second" || !next_token(text).empty() || !text.empty()) {
+        std::cerr << "Token splitting failed" << std::endl;
+        failures++;
+    }
+
+    if(failures > 0) {
+        std::cerr << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
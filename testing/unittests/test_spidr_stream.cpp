@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @brief Unit test decoding SPIDR data files across block and file boundaries, with and without reading ahead
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tools/spidr.h"
+
+using namespace corryvreckan;
+
+namespace {
+    using Record = std::pair<uint64_t, unsigned long long int>;
+
+    // Decoder recording all pixel packets with their long timestamp, pausing after a random number of packets
+    class Recorder {
+    public:
+        explicit Recorder(std::mt19937_64& random) : random_(random) {}
+
+        bool full() const { return since_pause_ >= pause_after_; }
+        void resume() {
+            since_pause_ = 0;
+            pause_after_ = random_() % 2000 + 1;
+        }
+
+        void prepare(const uint64_t* words, size_t size) {
+            words_ = words;
+            size_ = size;
+        }
+        void control(uint64_t) {}
+        void trigger(double, int) {}
+        void pixel(uint64_t word, size_t index, unsigned long long int sync_time) {
+            if(index >= size_ || words_[index] != word) {
+                index_errors++;
+            }
+            records.emplace_back(word, sync_time);
+            since_pause_++;
+        }
+
+        std::vector<Record> records;
+        size_t index_errors{};
+
+    private:
+        std::mt19937_64& random_;
+        const uint64_t* words_{};
+        size_t size_{};
+        size_t since_pause_{};
+        size_t pause_after_{1};
+    };
+
+    // Write data files with random headers and packets, an incomplete packet at the end of a file is ignored
+    std::vector<std::string> write_files(std::mt19937_64& random, std::vector<Record>& expected) {
+        std::vector<std::string> files;
+        unsigned long long int sync_time = 0;
+        for(size_t number = 0; number < 4; number++) {
+            const auto path = "spidr_stream_" + std::to_string(number) + ".dat";
+            std::ofstream file(path, std::ios::binary);
+
+            // Header with identifier and size, followed by padding up to its size
+            const uint32_t header_id = 1380208723;
+            const auto header_size = static_cast<uint32_t>(8 + random() % 64);
+            file.write(reinterpret_cast<const char*>(&header_id), sizeof header_id);
+            file.write(reinterpret_cast<const char*>(&header_size), sizeof header_size);
+            file.write(std::string(header_size - 8, '\0').data(), header_size - 8);
+
+            // The first file starts with a heartbeat clearing the header
+            std::vector<uint64_t> words;
+            if(number == 0) {
+                words.push_back(0x4500000000000000);
+            }
+            const auto packets = (number == 2 ? 0 : random() % 100000);
+            for(size_t packet = 0; packet < packets; packet++) {
+                const auto kind = random() % 10;
+                if(kind < 7) {
+                    const uint64_t word = ((0xAULL + (random() & 0x1)) << 60) | (random() & 0x0FFFFFFFFFFFFFFF);
+                    words.push_back(word);
+                    expected.emplace_back(word, sync_time);
+                } else if(kind == 7) {
+                    const auto value = static_cast<uint32_t>(random());
+                    words.push_back(0x4400000000000000 | (static_cast<uint64_t>(value) << 16));
+                    sync_time = static_cast<unsigned long long int>(value) << 12;
+                } else if(kind == 8) {
+                    words.push_back(random() & 0x0FFFFFFFFFFFFFFF);
+                } else {
+                    words.push_back(0x7000000000000000 | (random() & 0x0FFFFFFFFFFFFFFF));
+                }
+            }
+            file.write(reinterpret_cast<const char*>(words.data()),
+                       static_cast<std::streamsize>(words.size() * sizeof(uint64_t)));
+            file.write("\xA0\x01\x02", static_cast<std::streamsize>(random() % 4));
+            files.push_back(path);
+        }
+        return files;
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 random(20220905);
+    std::vector<Record> expected;
+    const auto files = write_files(random, expected);
+
+    size_t failures = 0;
+    for(size_t block_size : std::vector<size_t>{1, 7, 4096, 262144}) {
+        for(size_t read_ahead : std::vector<size_t>{0, 1, 4}) {
+            Recorder recorder(random);
+            spidr::Stream stream(files, "test", block_size, read_ahead);
+            do {
+                recorder.resume();
+            } while(stream.decode(recorder));
+
+            if(recorder.records != expected || recorder.index_errors > 0 || !stream.eof()) {
+                std::cerr << "Block size " << block_size << ", " << read_ahead << " blocks read ahead: decoded "
+                          << recorder.records.size() << " of " << expected.size() << " pixel packets, "
+                          << recorder.index_errors << " index errors" << std::endl;
+                failures++;
+            }
+        }
+    }
+
+    for(const auto& path : files) {
+        std::remove(path.c_str());
+    }
+
+    if(failures > 0) {
+        std::cerr << failures << " configurations failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All configurations passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file
+ * @brief Unit test comparing the time-sorted buffer to a priority queue on randomized streams of elements
+ *
+ * @copyright Copyright (c) 2022 CERN and the Corryvreckan authors.
+ * This software is distributed under the terms of the MIT License, copied verbatim in the file "LICENSE.md".
+ * In applying this license, CERN does not waive the privileges and immunities granted to it by virtue of its status as an
+ * Intergovernmental Organization or submit itself to any jurisdiction.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <queue>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "tools/time_sorted_buffer.h"
+
+using namespace corryvreckan;
+
+namespace {
+    struct Element {
+        Element(double time, size_t id) : time_(time), id_(id) {}
+        double timestamp() const { return time_; }
+        size_t id() const { return id_; }
+
+    private:
+        double time_;
+        size_t id_;
+    };
+
+    struct CompareTime {
+        bool operator()(const std::shared_ptr<Element>& a, const std::shared_ptr<Element>& b) const {
+            return a->timestamp() > b->timestamp();
+        }
+    };
+
+    // Push a random stream of elements to both containers, interleaved with removals and flushed at the end
+    bool run_trial(std::mt19937_64& random, size_t trial) {
+        std::uniform_real_distribution<double> uniform(0., 1.);
+        const double width = std::exp(uniform(random) * 8. - 2.);
+        const auto buckets = static_cast<size_t>(1) << static_cast<size_t>(uniform(random) * 11.);
+        const auto elements = static_cast<size_t>(uniform(random) * 5000.);
+        const double jitter = std::exp(uniform(random) * 10. - 3.);
+
+        TimeSortedBuffer<std::shared_ptr<Element>> buffer(width, buckets);
+        std::priority_queue<std::shared_ptr<Element>, std::vector<std::shared_ptr<Element>>, CompareTime> queue;
+        std::vector<std::pair<double, size_t>> buffer_output;
+        std::vector<std::pair<double, size_t>> queue_output;
+
+        auto pop = [&]() {
+            if(buffer.size() != queue.size() || buffer.empty() != queue.empty()) {
+                return false;
+            }
+            if(queue.empty()) {
+                return true;
+            }
+            buffer_output.emplace_back(buffer.top()->timestamp(), buffer.top()->id());
+            queue_output.emplace_back(queue.top()->timestamp(), queue.top()->id());
+            buffer.pop();
+            queue.pop();
+            return true;
+        };
+
+        double time = uniform(random) * 1e6 - 5e5;
+        for(size_t id = 0; id < elements; id++) {
+            const auto kind = uniform(random);
+            double timestamp = 0;
+            if(kind < 0.2 && !buffer_output.empty()) {
+                // Repeat a timestamp already seen
+                timestamp = buffer_output[static_cast<size_t>(uniform(random) * static_cast<double>(buffer_output.size()))].first;
+            } else if(kind < 0.25) {
+                // Jump far ahead of the window covered by the buckets
+                time += width * static_cast<double>(buckets) * (1. + 10. * uniform(random));
+                timestamp = time;
+            } else if(kind < 0.3) {
+                // Arrive well before the element currently on top
+                timestamp = time - 20. * jitter * uniform(random);
+            } else {
+                time += width * uniform(random);
+                timestamp = std::round(time + jitter * (uniform(random) - 0.5));
+            }
+
+            auto element = std::make_shared<Element>(timestamp, id);
+            buffer.push(element);
+            queue.push(element);
+
+            // Remove elements at random, keeping some in the containers most of the time
+            while(uniform(random) < (queue.size() > 100 ? 0.6 : 0.3)) {
+                if(!pop()) {
+                    std::cerr << "Trial " << trial << ": sizes differ after " << id << " elements" << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        // Flush all remaining elements
+        while(!queue.empty() || !buffer.empty()) {
+            if(!pop()) {
+                std::cerr << "Trial " << trial << ": sizes differ while flushing" << std::endl;
+                return false;
+            }
+        }
+
+        // Elements with equal timestamps may be returned in any order, but the sequence of timestamps has to agree and
+        // every element has to be returned exactly once
+        if(!std::equal(buffer_output.begin(),
+                       buffer_output.end(),
+                       queue_output.begin(),
+                       queue_output.end(),
+                       [](const auto& a, const auto& b) { return a.first == b.first; })) {
+            std::cerr << "Trial " << trial << ": elements returned in different order (bucket width " << width << ", "
+                      << buckets << " buckets)" << std::endl;
+            return false;
+        }
+        std::sort(buffer_output.begin(), buffer_output.end());
+        std::sort(queue_output.begin(), queue_output.end());
+        if(buffer_output != queue_output || buffer_output.size() != elements) {
+            std::cerr << "Trial " << trial << ": elements lost or duplicated" << std::endl;
+            return false;
+        }
+        return true;
+    }
+} // namespace
+
+int main() {
+    std::mt19937_64 random(20220901);
+    size_t failures = 0;
+    for(size_t trial = 0; trial < 500; trial++) {
+        if(!run_trial(random, trial)) {
+            failures++;
+        }
+    }
+
+    if(failures > 0) {
+        std::cerr << failures << " trials failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All trials passed" << std::endl;
+    return 0;
+}